@@ -442,6 +442,89 @@ protected:
         else WriteArray<aiVertexWeight>(&chunk,b->mWeights,b->mNumWeights);
     }
 
+    // -----------------------------------------------------------------------------------
+    void WriteBinaryMeshlets(IOStream * container, const aiMeshletData* data)
+    {
+        AssbinChunkWriter chunk( container, ASSBIN_CHUNK_AIMESHLETS );
+
+        Write<unsigned int>(&chunk,data->mMaxVertices);
+        Write<unsigned int>(&chunk,data->mMaxTriangles);
+        Write<unsigned int>(&chunk,data->mNumMeshlets);
+        Write<unsigned int>(&chunk,data->mNumVertices);
+        Write<unsigned int>(&chunk,data->mNumTriangles);
+
+        for (unsigned int i = 0; i < data->mNumMeshlets;++i) {
+            const aiMeshlet& m = data->mMeshlets[i];
+            Write<unsigned int>(&chunk,m.mVertexOffset);
+            Write<unsigned int>(&chunk,m.mTriangleOffset);
+            Write<unsigned int>(&chunk,m.mNumVertices);
+            Write<unsigned int>(&chunk,m.mNumTriangles);
+            Write<aiVector3D>(&chunk,m.mCenter);
+            Write<float>(&chunk,static_cast<float>(m.mRadius));
+            Write<aiVector3D>(&chunk,m.mConeApex);
+            Write<aiVector3D>(&chunk,m.mConeAxis);
+            Write<float>(&chunk,static_cast<float>(m.mConeCutoff));
+        }
+        WriteArray<unsigned int>(&chunk,data->mVertices,data->mNumVertices);
+        chunk.Write(data->mTriangles,1,data->mNumTriangles*3);
+    }
+
+    // -----------------------------------------------------------------------------------
+    void WriteBinaryQuantizedMesh(IOStream * container, const aiQuantizedMesh* q)
+    {
+        AssbinChunkWriter chunk( container, ASSBIN_CHUNK_AIQUANTIZEDMESH );
+
+        Write<unsigned int>(&chunk,q->mNumVertices);
+
+        // the same bits as for the components of the mesh
+        unsigned int c = 0;
+        if (q->mPositions) {
+            c |= ASSBIN_MESH_HAS_POSITIONS;
+        }
+        if (q->mNormals) {
+            c |= ASSBIN_MESH_HAS_NORMALS;
+        }
+        if (q->mTangents) {
+            c |= ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS;
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS;++n) {
+            if (q->mTextureCoords[n]) {
+                c |= ASSBIN_MESH_HAS_TEXCOORD(n);
+            }
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS;++n) {
+            if (q->mColors[n]) {
+                c |= ASSBIN_MESH_HAS_COLOR(n);
+            }
+        }
+        Write<unsigned int>(&chunk,c);
+
+        if (q->mPositions) {
+            Write<aiMatrix4x4>(&chunk,q->mPositionTransform);
+            chunk.Write(q->mPositions,sizeof(unsigned short),q->mNumVertices*3);
+        }
+        if (q->mNormals) {
+            chunk.Write(q->mNormals,sizeof(short),q->mNumVertices*2);
+        }
+        if (q->mTangents) {
+            chunk.Write(q->mTangents,sizeof(short),q->mNumVertices*3);
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS;++n) {
+            if (q->mTextureCoords[n]) {
+                Write<float>(&chunk,static_cast<float>(q->mTexCoordOffset[n].x));
+                Write<float>(&chunk,static_cast<float>(q->mTexCoordOffset[n].y));
+                Write<float>(&chunk,static_cast<float>(q->mTexCoordScale[n].x));
+                Write<float>(&chunk,static_cast<float>(q->mTexCoordScale[n].y));
+                chunk.Write(q->mTextureCoords[n],sizeof(unsigned short),q->mNumVertices*2);
+            }
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS;++n) {
+            if (q->mColors[n]) {
+                chunk.Write(q->mColors[n],1,q->mNumVertices*4);
+            }
+        }
+    }
+
     // -----------------------------------------------------------------------------------
     void WriteBinaryMesh(IOStream * container, const aiMesh* mesh)
     {
@@ -476,6 +559,12 @@ protected:
             }
             c |= ASSBIN_MESH_HAS_COLOR(n);
         }
+        if (mesh->mMeshlets) {
+            c |= ASSBIN_MESH_HAS_MESHLETS;
+        }
+        if (mesh->mQuantized) {
+            c |= ASSBIN_MESH_HAS_QUANTIZED;
+        }
         Write<unsigned int>(&chunk,c);
 
         aiVector3D minVec, maxVec;
@@ -571,6 +660,16 @@ protected:
                 WriteBinaryBone(&chunk,b);
             }
         }
+
+        // write meshlets
+        if (mesh->mMeshlets) {
+            WriteBinaryMeshlets(&chunk,mesh->mMeshlets);
+        }
+
+        // write quantized vertex components
+        if (mesh->mQuantized) {
+            WriteBinaryQuantizedMesh(&chunk,mesh->mQuantized);
+        }
     }
 
     // -----------------------------------------------------------------------------------
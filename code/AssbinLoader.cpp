@@ -312,6 +312,79 @@ void AssbinImporter::ReadBinaryBone( IOStream * stream, aiBone* b ) {
 static bool fitsIntoUI16(unsigned int mNumVertices) {
     return ( mNumVertices < (1u<<16) );
 }
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadBinaryMeshlets( IOStream * stream, aiMeshletData* data ) {
+    if(Read<uint32_t>(stream) != ASSBIN_CHUNK_AIMESHLETS)
+        throw DeadlyImportError("Magic chunk identifiers are wrong!");
+    /*uint32_t size =*/ Read<uint32_t>(stream);
+
+    data->mMaxVertices = Read<unsigned int>(stream);
+    data->mMaxTriangles = Read<unsigned int>(stream);
+    data->mNumMeshlets = Read<unsigned int>(stream);
+    data->mNumVertices = Read<unsigned int>(stream);
+    data->mNumTriangles = Read<unsigned int>(stream);
+
+    data->mMeshlets = new aiMeshlet[data->mNumMeshlets];
+    for (unsigned int i = 0; i < data->mNumMeshlets;++i) {
+        aiMeshlet& m = data->mMeshlets[i];
+        m.mVertexOffset = Read<unsigned int>(stream);
+        m.mTriangleOffset = Read<unsigned int>(stream);
+        m.mNumVertices = Read<unsigned int>(stream);
+        m.mNumTriangles = Read<unsigned int>(stream);
+        m.mCenter = Read<aiVector3D>(stream);
+        m.mRadius = Read<float>(stream);
+        m.mConeApex = Read<aiVector3D>(stream);
+        m.mConeAxis = Read<aiVector3D>(stream);
+        m.mConeCutoff = Read<float>(stream);
+    }
+    data->mVertices = new unsigned int[data->mNumVertices];
+    ReadArray<unsigned int>(stream,data->mVertices,data->mNumVertices);
+    data->mTriangles = new unsigned char[data->mNumTriangles*3];
+    stream->Read(data->mTriangles,1,data->mNumTriangles*3);
+}
+
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadBinaryQuantizedMesh( IOStream * stream, aiQuantizedMesh* q ) {
+    if(Read<uint32_t>(stream) != ASSBIN_CHUNK_AIQUANTIZEDMESH)
+        throw DeadlyImportError("Magic chunk identifiers are wrong!");
+    /*uint32_t size =*/ Read<uint32_t>(stream);
+
+    q->mNumVertices = Read<unsigned int>(stream);
+    unsigned int c = Read<unsigned int>(stream);
+
+    if (c & ASSBIN_MESH_HAS_POSITIONS) {
+        q->mPositionTransform = Read<aiMatrix4x4>(stream);
+        q->mPositions = new unsigned short[q->mNumVertices*3];
+        ReadArray<unsigned short>(stream,q->mPositions,q->mNumVertices*3);
+    }
+    if (c & ASSBIN_MESH_HAS_NORMALS) {
+        q->mNormals = new short[q->mNumVertices*2];
+        ReadArray<short>(stream,q->mNormals,q->mNumVertices*2);
+    }
+    if (c & ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS) {
+        q->mTangents = new short[q->mNumVertices*3];
+        ReadArray<short>(stream,q->mTangents,q->mNumVertices*3);
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS;++n) {
+        if (!(c & ASSBIN_MESH_HAS_TEXCOORD(n)))
+            continue;
+
+        q->mTexCoordOffset[n].x = Read<float>(stream);
+        q->mTexCoordOffset[n].y = Read<float>(stream);
+        q->mTexCoordScale[n].x = Read<float>(stream);
+        q->mTexCoordScale[n].y = Read<float>(stream);
+        q->mTextureCoords[n] = new unsigned short[q->mNumVertices*2];
+        ReadArray<unsigned short>(stream,q->mTextureCoords[n],q->mNumVertices*2);
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS;++n) {
+        if (!(c & ASSBIN_MESH_HAS_COLOR(n)))
+            continue;
+
+        q->mColors[n] = new unsigned char[q->mNumVertices*4];
+        stream->Read(q->mColors[n],1,q->mNumVertices*4);
+    }
+}
+
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh ) {
     if(Read<uint32_t>(stream) != ASSBIN_CHUNK_AIMESH)
@@ -423,6 +496,18 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh ) {
             ReadBinaryBone(stream,mesh->mBones[a]);
         }
     }
+
+    // read meshlets
+    if (c & ASSBIN_MESH_HAS_MESHLETS) {
+        mesh->mMeshlets = new aiMeshletData();
+        ReadBinaryMeshlets(stream,mesh->mMeshlets);
+    }
+
+    // read quantized vertex components
+    if (c & ASSBIN_MESH_HAS_QUANTIZED) {
+        mesh->mQuantized = new aiQuantizedMesh();
+        ReadBinaryQuantizedMesh(stream,mesh->mQuantized);
+    }
 }
 
 // -----------------------------------------------------------------------------------
@@ -52,6 +52,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 struct aiMesh;
 struct aiNode;
 struct aiBone;
+struct aiMeshletData;
+struct aiQuantizedMesh;
 struct aiMaterial;
 struct aiMaterialProperty;
 struct aiNodeAnim;
@@ -90,6 +92,8 @@ public:
     void ReadBinaryNode( IOStream * stream, aiNode** mRootNode, aiNode* parent );
     void ReadBinaryMesh( IOStream * stream, aiMesh* mesh );
     void ReadBinaryBone( IOStream * stream, aiBone* bone );
+    void ReadBinaryMeshlets( IOStream * stream, aiMeshletData* data );
+    void ReadBinaryQuantizedMesh( IOStream * stream, aiQuantizedMesh* q );
     void ReadBinaryMaterial(IOStream * stream, aiMaterial* mat);
     void ReadBinaryMaterialProperty(IOStream * stream, aiMaterialProperty* prop);
     void ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd);
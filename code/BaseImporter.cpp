@@ -66,7 +66,8 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter() AI_NO_EXCEPT
-: m_progress() {
+: m_progress()
+, m_threadPool() {
     // nothing to do here
 }
 
@@ -430,10 +431,20 @@ void BaseImporter::TextFileToBuffer(IOStream* stream,
     }
 
     data.reserve(fileSize+1);
-    data.resize(fileSize);
     if(fileSize > 0) {
-        if(fileSize != stream->Read( &data[0], 1, fileSize)) {
-            throw DeadlyImportError("File read error");
+        // The buffer is converted and parsed in place, so it must be a copy. If
+        // the stream lives in memory anyway, take it from there instead of
+        // clearing the buffer and reading the file in chunks.
+        size_t viewSize = 0;
+        const uint8_t* view = stream->GetContiguousView(viewSize);
+        if (view && viewSize == fileSize && 0 == stream->Tell()) {
+            data.assign(reinterpret_cast<const char*>(view), reinterpret_cast<const char*>(view) + fileSize);
+            stream->Seek(0, aiOrigin_END);
+        } else {
+            data.resize(fileSize);
+            if(fileSize != stream->Read( &data[0], 1, fileSize)) {
+                throw DeadlyImportError("File read error");
+            }
         }
 
         ConvertToUTF8(data);
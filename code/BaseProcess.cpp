@@ -48,13 +48,100 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include "Importer.h"
+#include "ThreadPool.h"
 
 using namespace Assimp;
 
+#ifdef ASSIMP_BUILD_DEBUG
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Captures where the components of a mesh are stored. Used to check whether a per-mesh step
+// keeps to the footprint it declared - replacing an array counts as writing it.
+struct MeshState
+{
+    explicit MeshState(const aiMesh* mesh)
+    : vertices(mesh->mVertices), numVertices(mesh->mNumVertices)
+    , normals(mesh->mNormals)
+    , tangents(mesh->mTangents), bitangents(mesh->mBitangents)
+    , faces(mesh->mFaces), numFaces(mesh->mNumFaces), primitiveTypes(mesh->mPrimitiveTypes)
+    , bones(mesh->mBones), numBones(mesh->mNumBones)
+    , animMeshes(mesh->mAnimMeshes), numAnimMeshes(mesh->mNumAnimMeshes)
+    , meshlets(mesh->mMeshlets)
+    , quantized(mesh->mQuantized)
+    {
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            texCoords[i] = mesh->mTextureCoords[i];
+            numUVComponents[i] = mesh->mNumUVComponents[i];
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            colors[i] = mesh->mColors[i];
+        }
+    }
+
+    // Returns the #MeshComponent's which differ between both states
+    unsigned int Diff(const MeshState& o) const
+    {
+        unsigned int res = 0;
+        if (vertices != o.vertices || numVertices != o.numVertices) {
+            res |= MeshComponent_Positions;
+        }
+        if (normals != o.normals) {
+            res |= MeshComponent_Normals;
+        }
+        if (tangents != o.tangents || bitangents != o.bitangents) {
+            res |= MeshComponent_Tangents;
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            if (texCoords[i] != o.texCoords[i] || numUVComponents[i] != o.numUVComponents[i]) {
+                res |= MeshComponent_TexCoords;
+            }
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            if (colors[i] != o.colors[i]) {
+                res |= MeshComponent_Colors;
+            }
+        }
+        if (faces != o.faces || numFaces != o.numFaces || primitiveTypes != o.primitiveTypes) {
+            res |= MeshComponent_Faces;
+        }
+        if (bones != o.bones || numBones != o.numBones) {
+            res |= MeshComponent_Bones;
+        }
+        if (animMeshes != o.animMeshes || numAnimMeshes != o.numAnimMeshes) {
+            res |= MeshComponent_AnimMeshes;
+        }
+        if (meshlets != o.meshlets) {
+            res |= MeshComponent_Meshlets;
+        }
+        if (quantized != o.quantized) {
+            res |= MeshComponent_Quantized;
+        }
+        return res;
+    }
+
+    const aiVector3D* vertices; unsigned int numVertices;
+    const aiVector3D* normals;
+    const aiVector3D* tangents; const aiVector3D* bitangents;
+    const aiVector3D* texCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    unsigned int numUVComponents[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    const aiColor4D* colors[AI_MAX_NUMBER_OF_COLOR_SETS];
+    const aiFace* faces; unsigned int numFaces; unsigned int primitiveTypes;
+    aiBone** bones; unsigned int numBones;
+    aiAnimMesh** animMeshes; unsigned int numAnimMeshes;
+    const aiMeshletData* meshlets;
+    const aiQuantizedMesh* quantized;
+};
+
+} // namespace
+#endif // ASSIMP_BUILD_DEBUG
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess() AI_NO_EXCEPT
 : shared()
+, threadPool()
+, profiler()
 , progress()
 {
 }
@@ -67,14 +154,23 @@ BaseProcess::~BaseProcess()
 }
 
 // ------------------------------------------------------------------------------------------------
-void BaseProcess::ExecuteOnScene( Importer* pImp)
+void BaseProcess::SetupExecution( Importer* pImp)
 {
-    ai_assert(NULL != pImp && NULL != pImp->Pimpl()->mScene);
-
     progress = pImp->GetProgressHandler();
     ai_assert(progress);
 
+    threadPool = pImp->Pimpl()->mThreadPool;
+    profiler = pImp->Pimpl()->mProfiler;
+
     SetupProperties( pImp );
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecuteOnScene( Importer* pImp)
+{
+    ai_assert(NULL != pImp && NULL != pImp->Pimpl()->mScene);
+
+    SetupExecution( pImp );
 
     // catch exceptions thrown inside the PostProcess-Step
     try
@@ -93,12 +189,141 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ForEachMesh( aiScene* pScene,
+    const std::function<void(aiMesh*, unsigned int)>& fn)
+{
+    ai_assert(NULL != pScene);
+
+    if (NULL == threadPool) {
+        for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+            fn(pScene->mMeshes[a], a);
+        }
+        return;
+    }
+
+    Profiling::Profiler* prof = profiler;
+    threadPool->ParallelFor(0, pScene->mNumMeshes, [pScene, &fn, prof](unsigned int a) {
+        Profiling::ScopedRegion region(prof, "mesh");
+        fn(pScene->mMeshes[a], a);
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecuteMeshPass( aiScene* pScene)
+{
+    ai_assert(NULL != pScene);
+    ai_assert(IsMeshLocal());
+
+    BeginMeshPass(pScene);
+
+    ForEachMesh(pScene, [this](aiMesh* pMesh, unsigned int a) {
+        ExecuteOnMeshChecked(pMesh, a);
+    });
+
+    EndMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecuteOnMeshChecked( aiMesh* pMesh, unsigned int meshIndex)
+{
+#ifdef ASSIMP_BUILD_DEBUG
+    if (NULL != pMesh) {
+        const MeshState before(pMesh);
+        ExecuteOnMesh(pMesh, meshIndex);
+        ai_assert(0 == (MeshState(pMesh).Diff(before) & ~GetMeshFootprint().write));
+        return;
+    }
+#endif
+    ExecuteOnMesh(pMesh, meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecuteFusedOnScene( Importer* pImp,
+    const std::vector<BaseProcess*>& steps)
+{
+    ai_assert(NULL != pImp && NULL != pImp->Pimpl()->mScene);
+    ai_assert(!steps.empty());
+
+    for (BaseProcess* step : steps) {
+        ai_assert(step->IsMeshLocal());
+        step->SetupExecution(pImp);
+    }
+
+    // catch exceptions thrown inside the PostProcess-Steps
+    try
+    {
+        aiScene* pScene = pImp->Pimpl()->mScene;
+        for (BaseProcess* step : steps) {
+            step->BeginMeshPass(pScene);
+        }
+
+        // run each mesh through all steps before moving on to the next one
+        steps.front()->ForEachMesh(pScene, [&steps](aiMesh* pMesh, unsigned int a) {
+            for (BaseProcess* step : steps) {
+                step->ExecuteOnMeshChecked(pMesh, a);
+            }
+        });
+
+        for (BaseProcess* step : steps) {
+            step->EndMeshPass(pScene);
+        }
+
+    } catch( const std::exception& err )    {
+
+        // extract error description
+        pImp->Pimpl()->mErrorString = err.what();
+        ASSIMP_LOG_ERROR(pImp->Pimpl()->mErrorString);
+
+        // and kill the partially imported data
+        delete pImp->Pimpl()->mScene;
+        pImp->Pimpl()->mScene = NULL;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsMeshLocal() const
+{
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint BaseProcess::GetMeshFootprint() const
+{
+    return MeshFootprint();
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::BeginMeshPass( aiScene* /*pScene*/)
+{
+    // the default implementation does nothing
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecuteOnMesh( aiMesh* /*pMesh*/, unsigned int /*meshIndex*/)
+{
+    // only steps which claim to be mesh-local may be driven mesh by mesh
+    ai_assert(false);
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::EndMeshPass( aiScene* /*pScene*/)
+{
+    // the default implementation does nothing
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseProcess::SetupProperties(const Importer* /*pImp*/)
 {
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsEnabledByProperty( const Importer* /*pImp*/) const
+{
+    return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool BaseProcess::RequireVerboseFormat() const
 {
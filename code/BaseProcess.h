@@ -45,13 +45,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_BASEPROCESS_H
 
 #include <map>
+#include <vector>
+#include <functional>
 #include <assimp/GenericProperty.h>
 
 struct aiScene;
+struct aiMesh;
 
 namespace Assimp    {
 
 class Importer;
+class ThreadPool;
+namespace Profiling {
+    class Profiler;
+}
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
@@ -201,6 +208,56 @@ private:
 
 #define AI_SPP_SPATIAL_SORT "$Spat"
 
+// ---------------------------------------------------------------------------
+/** @brief Parts of an aiMesh a per-mesh step may read or write.
+ *
+ *  Used to declare the footprint of BaseProcess::ExecuteOnMesh(), see
+ *  BaseProcess::GetMeshFootprint().
+ */
+enum MeshComponent {
+    /** aiMesh::mVertices and aiMesh::mNumVertices. Steps changing the
+     *  vertex count must declare all per-vertex components as written. */
+    MeshComponent_Positions     = 0x1,
+    /** aiMesh::mNormals */
+    MeshComponent_Normals       = 0x2,
+    /** aiMesh::mTangents and aiMesh::mBitangents */
+    MeshComponent_Tangents      = 0x4,
+    /** aiMesh::mTextureCoords and aiMesh::mNumUVComponents */
+    MeshComponent_TexCoords     = 0x8,
+    /** aiMesh::mColors */
+    MeshComponent_Colors        = 0x10,
+    /** aiMesh::mFaces, aiMesh::mNumFaces and aiMesh::mPrimitiveTypes */
+    MeshComponent_Faces         = 0x20,
+    /** aiMesh::mBones */
+    MeshComponent_Bones         = 0x40,
+    /** aiMesh::mAnimMeshes */
+    MeshComponent_AnimMeshes    = 0x80,
+    /** Not a part of the mesh: the step's EndMeshPass() may add or
+     *  remove meshes of the scene. */
+    MeshComponent_MeshList      = 0x100,
+    /** aiMesh::mMeshlets */
+    MeshComponent_Meshlets      = 0x200,
+    /** aiMesh::mQuantized */
+    MeshComponent_Quantized     = 0x400,
+
+    MeshComponent_All           = 0x7ff
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Declares which parts of a mesh BaseProcess::ExecuteOnMesh()
+ *  reads and writes, a bitwise combination of #MeshComponent.
+ */
+struct MeshFootprint {
+    unsigned int read;
+    unsigned int write;
+
+    MeshFootprint(unsigned int pRead = MeshComponent_All, unsigned int pWrite = MeshComponent_All)
+    : read(pRead)
+    , write(pWrite) {
+        // empty
+    }
+};
+
 // ---------------------------------------------------------------------------
 /** The BaseProcess defines a common interface for all post processing steps.
  * A post processing step is run after a successful import if the caller
@@ -230,6 +287,14 @@ public:
     */
     virtual bool IsActive( unsigned int pFlags) const = 0;
 
+    // -------------------------------------------------------------------
+    /** Returns whether the processing step is enabled through an importer
+     *  property. This is for steps which have no #aiPostProcessSteps flag
+     *  of their own. The default implementation returns false.
+     * @param pImp Importer instance to query the properties from.
+    */
+    virtual bool IsEnabledByProperty( const Importer* pImp) const;
+
     // -------------------------------------------------------------------
     /** Check whether this step expects its input vertex data to be
      *  in verbose format. */
@@ -243,6 +308,21 @@ public:
     */
     void ExecuteOnScene( Importer* pImp);
 
+    // -------------------------------------------------------------------
+    /** Executes a sequence of mesh-local steps, fused into a single pass
+    * over the meshes: each mesh runs through all steps back to back while
+    * its data is still hot in the cache, instead of every step streaming
+    * the whole scene through the cache again.
+    * All BeginMeshPass() calls happen before the first mesh is processed,
+    * all EndMeshPass() calls after the last one. Only the last step of
+    * the sequence may add or remove meshes (#MeshComponent_MeshList).
+    * Like ExecuteOnScene(), the function deletes the scene if a step fails.
+    * @param pImp Importer instance (pImp->mScene must be valid)
+    * @param steps The steps to run, in order of execution.
+    */
+    static void ExecuteFusedOnScene( Importer* pImp,
+        const std::vector<BaseProcess*>& steps);
+
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
@@ -258,6 +338,49 @@ public:
     */
     virtual void Execute( aiScene* pScene) = 0;
 
+    // -------------------------------------------------------------------
+    /** Check whether the step works on each mesh independently.
+    * Such steps implement ExecuteOnMesh() and can be driven mesh by mesh
+    * instead of through Execute(): BeginMeshPass() is called once, then
+    * ExecuteOnMesh() for each mesh - possibly from several threads at
+    * once - and finally EndMeshPass(). The default implementation
+    * returns false.
+    */
+    virtual bool IsMeshLocal() const;
+
+    // -------------------------------------------------------------------
+    /** Returns the parts of a mesh ExecuteOnMesh() reads and writes.
+    * The default implementation claims to read and write everything.
+    */
+    virtual MeshFootprint GetMeshFootprint() const;
+
+    // -------------------------------------------------------------------
+    /** Called once before ExecuteOnMesh() is invoked for the meshes of
+    * the given scene. Allows the step to validate the scene and to
+    * allocate per-mesh storage for its results.
+    * When the step is fused with others (see ExecuteFusedOnScene())
+    * the function runs before the preceding steps have processed any
+    * mesh, so it must not depend on their results.
+    * @param pScene The imported data to work at.
+    */
+    virtual void BeginMeshPass( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    /** Executes the post processing step on a single mesh.
+    * The function may be called concurrently for different meshes of
+    * the same scene, so it may only touch the given mesh and per-mesh
+    * slots of the step's own data.
+    * @param pMesh The mesh to work at.
+    * @param meshIndex Index of the mesh in aiScene::mMeshes.
+    */
+    virtual void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+
+    // -------------------------------------------------------------------
+    /** Called once after ExecuteOnMesh() has been invoked for all meshes.
+    * Allows the step to gather per-mesh results and to update the scene.
+    * @param pScene The imported data to work at.
+    */
+    virtual void EndMeshPass( aiScene* pScene);
 
     // -------------------------------------------------------------------
     /** Assign a new SharedPostProcessInfo to the step. This object
@@ -275,11 +398,57 @@ public:
         return shared;
     }
 
+    // -------------------------------------------------------------------
+    /** Assign the worker pool the step may use to process meshes in
+     *  parallel. ExecuteOnScene() assigns the Importer's pool.
+     * @param pool May be NULL, the step runs single-threaded then.
+    */
+    inline void SetThreadPool(ThreadPool* pool)    {
+        threadPool = pool;
+    }
+
+protected:
+
+    // -------------------------------------------------------------------
+    /** Invokes a function for each mesh of the scene. If a thread pool
+     *  is assigned, the meshes are distributed across its threads, so
+     *  the function must not touch anything but the mesh it is given
+     *  (and per-mesh slots of the step's own data). It must neither
+     *  add nor remove meshes. Exceptions are passed to the caller.
+     * @param pScene The scene whose meshes are to be processed.
+     * @param fn Called with each mesh and its index in pScene->mMeshes.
+    */
+    void ForEachMesh( aiScene* pScene,
+        const std::function<void(aiMesh*, unsigned int)>& fn);
+
+    // -------------------------------------------------------------------
+    /** Runs BeginMeshPass(), ExecuteOnMesh() for all meshes and
+     *  EndMeshPass(). Mesh-local steps implement Execute() with it.
+     * @param pScene The imported data to work at.
+    */
+    void ExecuteMeshPass( aiScene* pScene);
+
+private:
+
+    // -------------------------------------------------------------------
+    /** Prepares the step for execution on the Importer's scene */
+    void SetupExecution( Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Calls ExecuteOnMesh(). Debug builds check the declared footprint. */
+    void ExecuteOnMeshChecked( aiMesh* pMesh, unsigned int meshIndex);
+
 protected:
 
     /** See the doc of #SharedPostProcessInfo for more details */
     SharedPostProcessInfo* shared;
 
+    /** Worker pool to process meshes in parallel, may be NULL */
+    ThreadPool* threadPool;
+
+    /** Records the meshes processed by the worker threads, may be NULL */
+    Profiling::Profiler* profiler;
+
     /** Currently active progress handler */
     ProgressHandler* progress;
 };
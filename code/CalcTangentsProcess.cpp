@@ -50,14 +50,334 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include <assimp/TinyFormatter.h>
 #include <assimp/qnan.h>
+#include "ThreadPool.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string.h>
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// The MikkTSpace generator follows the reference implementation by Morten S. Mikkelsen
+// (mikktspace.c), so its results match those of other tools which use it. Function and flag
+// names refer to the reference where the steps correspond.
+
+// Triangle flags
+enum {
+    MikkDegenerate = 0x1,
+    MikkQuadOneDegenerate = 0x2,
+    MikkGroupWithAny = 0x4,
+    MikkOrientPreserving = 0x8
+};
+
+// A triangle of a face. Quads are split into two triangles, larger polygons into fans.
+struct MikkTriangle {
+    unsigned int vertex[3];         ///< Welded vertex of each corner
+    unsigned char faceCorner[3];    ///< Index of each corner in the face
+    unsigned int face;              ///< The face the triangle was created from
+    int neighbour[3];               ///< Triangle across the edge from corner i to corner i+1
+    int group[3];                   ///< Group of each corner
+    aiVector3D os, ot;              ///< Normalized tangent and bitangent
+    ai_real magS, magT;             ///< Their magnitudes
+    unsigned int flags;
+};
+
+// The tangent space of a face corner
+struct MikkTSpace {
+    aiVector3D os, ot;
+    ai_real magS, magT;
+    unsigned int counter;
+    bool orient;
+};
+
+// The triangles around a vertex which are connected by edges and have the same orientation
+struct MikkGroup {
+    unsigned int vertex;
+    bool orient;
+    unsigned int firstTriangle, numTriangles;
+};
+
+// ------------------------------------------------------------------------------------------------
+inline bool MikkNotZero(ai_real f) {
+    return std::fabs(f) > std::numeric_limits<ai_real>::min();
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool MikkNotZero(const aiVector3D& v) {
+    return MikkNotZero(v.x) || MikkNotZero(v.y) || MikkNotZero(v.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Whether two corners of a vertex end up with the same tangent and bitangent
+inline bool MikkSameTSpace(const MikkTSpace& a, const MikkTSpace& b) {
+    return a.os == b.os && a.orient == b.orient;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Projects v into the plane of the normal n and normalizes it
+inline aiVector3D MikkProject(const aiVector3D& v, const aiVector3D& n) {
+    aiVector3D r = v - n * (n * v);
+    if (MikkNotZero(r)) {
+        r.Normalize();
+    }
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Doubled area of a triangle in texture space, see CalcTexArea
+inline ai_real MikkTexArea(const aiVector3D* tex, const unsigned int vertex[3]) {
+    const aiVector3D& t1 = tex[vertex[0]];
+    const aiVector3D& t2 = tex[vertex[1]];
+    const aiVector3D& t3 = tex[vertex[2]];
+    const ai_real t21x = t2.x - t1.x, t21y = t2.y - t1.y;
+    const ai_real t31x = t3.x - t1.x, t31y = t3.y - t1.y;
+    return std::fabs(t21x * t31y - t21y * t31x);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes the tangent space of a triangle, see InitTriInfo
+void MikkInitTriangle(MikkTriangle& tri, const aiVector3D* pos, const aiVector3D* tex) {
+    tri.os = tri.ot = aiVector3D();
+    tri.magS = tri.magT = 0;
+    tri.flags |= MikkGroupWithAny;
+
+    const aiVector3D& v1 = pos[tri.vertex[0]];
+    const aiVector3D& v2 = pos[tri.vertex[1]];
+    const aiVector3D& v3 = pos[tri.vertex[2]];
+    const aiVector3D& t1 = tex[tri.vertex[0]];
+    const aiVector3D& t2 = tex[tri.vertex[1]];
+    const aiVector3D& t3 = tex[tri.vertex[2]];
+
+    const ai_real t21x = t2.x - t1.x, t21y = t2.y - t1.y;
+    const ai_real t31x = t3.x - t1.x, t31y = t3.y - t1.y;
+    const aiVector3D d1 = v2 - v1, d2 = v3 - v1;
+
+    const ai_real signedAreaSTx2 = t21x * t31y - t21y * t31x;
+    const aiVector3D vOs = d1 * t31y - d2 * t21y;
+    const aiVector3D vOt = d1 * -t31x + d2 * t21x;
+
+    if (signedAreaSTx2 > 0) {
+        tri.flags |= MikkOrientPreserving;
+    }
+    if (MikkNotZero(signedAreaSTx2)) {
+        const ai_real absArea = std::fabs(signedAreaSTx2);
+        const ai_real lenOs = vOs.Length(), lenOt = vOt.Length();
+        const ai_real sign = (tri.flags & MikkOrientPreserving) ? ai_real(1) : ai_real(-1);
+        if (MikkNotZero(lenOs)) {
+            tri.os = vOs * (sign / lenOs);
+        }
+        if (MikkNotZero(lenOt)) {
+            tri.ot = vOt * (sign / lenOt);
+        }
+
+        // the magnitudes are taken before normalization
+        tri.magS = lenOs / absArea;
+        tri.magT = lenOt / absArea;
+
+        // a good triangle
+        if (MikkNotZero(tri.os) && MikkNotZero(tri.ot)) {
+            tri.flags &= ~MikkGroupWithAny;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Averages the tangent spaces of a corner shared by the two triangles of a quad, see AvgTSpace
+MikkTSpace MikkAverage(const MikkTSpace& ts0, const MikkTSpace& ts1) {
+    MikkTSpace res = ts0;
+
+    // averaging equal spaces would change them slightly
+    if (ts0.magS == ts1.magS && ts0.magT == ts1.magT && ts0.os == ts1.os && ts0.ot == ts1.ot) {
+        return res;
+    }
+    res.magS = ai_real(0.5) * (ts0.magS + ts1.magS);
+    res.magT = ai_real(0.5) * (ts0.magT + ts1.magT);
+    res.os = ts0.os + ts1.os;
+    res.ot = ts0.ot + ts1.ot;
+    if (MikkNotZero(res.os)) {
+        res.os.Normalize();
+    }
+    if (MikkNotZero(res.ot)) {
+        res.ot.Normalize();
+    }
+    return res;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Index of the corner of a triangle which refers to the given vertex
+inline unsigned int MikkCornerOf(const MikkTriangle& tri, unsigned int vertex) {
+    return tri.vertex[0] == vertex ? 0 : (tri.vertex[1] == vertex ? 1 : 2);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Tries to add a triangle to a group and continues with its neighbours around the group's
+// vertex, see AssignRecur. The recursion of the reference is replaced by a stack which
+// visits the triangles in the same order.
+void MikkAssignGroup(std::vector<MikkTriangle>& triangles, std::vector<MikkGroup>& groups,
+        std::vector<unsigned int>& groupTriangles, int groupIndex, int first, int second) {
+    MikkGroup& group = groups[groupIndex];
+    std::vector<int> stack;
+    if (second >= 0) {
+        stack.push_back(second);
+    }
+    if (first >= 0) {
+        stack.push_back(first);
+    }
+    while (!stack.empty()) {
+        const int t = stack.back();
+        stack.pop_back();
+
+        MikkTriangle& tri = triangles[t];
+        const unsigned int i = MikkCornerOf(tri, group.vertex);
+        if (tri.group[i] != -1) {
+            continue;
+        }
+        if ((tri.flags & MikkGroupWithAny) && tri.group[0] == -1 && tri.group[1] == -1 && tri.group[2] == -1) {
+            // the first group to take a group-with-anything triangle determines its orientation
+            tri.flags &= ~MikkOrientPreserving;
+            tri.flags |= group.orient ? MikkOrientPreserving : 0;
+        }
+        if (((tri.flags & MikkOrientPreserving) != 0) != group.orient) {
+            continue;
+        }
+
+        groupTriangles.push_back(t);
+        ++group.numTriangles;
+        tri.group[i] = groupIndex;
+
+        const int right = tri.neighbour[i > 0 ? i - 1 : 2];
+        if (right >= 0) {
+            stack.push_back(right);
+        }
+        if (tri.neighbour[i] >= 0) {
+            stack.push_back(tri.neighbour[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes the tangent space of a group by averaging its triangles weighted by their angle
+// at the vertex, see EvalTspace
+MikkTSpace MikkEvalGroup(const MikkGroup& group, const std::vector<MikkTriangle>& triangles,
+        const std::vector<unsigned int>& groupTriangles, const aiVector3D* pos, const aiVector3D* norm) {
+    MikkTSpace res;
+    res.os = res.ot = aiVector3D();
+    res.magS = res.magT = 0;
+    res.counter = 0;
+    res.orient = group.orient;
+    ai_real angleSum = 0;
+
+    const aiVector3D& n = norm[group.vertex];
+    for (unsigned int a = 0; a < group.numTriangles; ++a) {
+        const MikkTriangle& tri = triangles[groupTriangles[group.firstTriangle + a]];
+
+        // only valid triangles contribute
+        if (tri.flags & MikkGroupWithAny) {
+            continue;
+        }
+        const unsigned int i = MikkCornerOf(tri, group.vertex);
+        const aiVector3D vOs = MikkProject(tri.os, n);
+        const aiVector3D vOt = MikkProject(tri.ot, n);
+
+        const aiVector3D& p0 = pos[tri.vertex[i > 0 ? i - 1 : 2]];
+        const aiVector3D& p1 = pos[tri.vertex[i]];
+        const aiVector3D& p2 = pos[tri.vertex[i < 2 ? i + 1 : 0]];
+        const aiVector3D v1 = MikkProject(p0 - p1, n);
+        const aiVector3D v2 = MikkProject(p2 - p1, n);
+
+        // weight the contribution by the angle between the two edges
+        ai_real cosAngle = v1 * v2;
+        cosAngle = cosAngle > 1 ? 1 : (cosAngle < -1 ? -1 : cosAngle);
+        const ai_real angle = static_cast<ai_real>(std::acos(static_cast<double>(cosAngle)));
+
+        res.os += vOs * angle;
+        res.ot += vOt * angle;
+        res.magS += angle * tri.magS;
+        res.magT += angle * tri.magT;
+        angleSum += angle;
+    }
+
+    if (MikkNotZero(res.os)) {
+        res.os.Normalize();
+    }
+    if (MikkNotZero(res.ot)) {
+        res.ot.Normalize();
+    }
+    if (angleSum > 0) {
+        res.magS /= angleSum;
+        res.magT /= angleSum;
+    }
+    return res;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Runs fn(block) for all blocks, on the threads of the pool if given
+void MikkForEachBlock(ThreadPool* pool, unsigned int count, const std::function<void(unsigned int)>& fn) {
+    static const unsigned int BlockSize = 4096;
+    const unsigned int numBlocks = (count + BlockSize - 1) / BlockSize;
+    const std::function<void(unsigned int)> runBlock = [&](unsigned int block) {
+        const unsigned int end = std::min(count, (block + 1) * BlockSize);
+        for (unsigned int i = block * BlockSize; i < end; ++i) {
+            fn(i);
+        }
+    };
+    if (pool) {
+        pool->ParallelFor(0, numBlocks, runBlock);
+    } else {
+        for (unsigned int block = 0; block < numBlocks; ++block) {
+            runBlock(block);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends copies of the given vertices to a per-vertex array
+template <typename T>
+void MikkAppendCopies(T*& data, unsigned int numVertices, const std::vector<unsigned int>& sources) {
+    if (!data) {
+        return;
+    }
+    T* grown = new T[numVertices + sources.size()];
+    std::copy(data, data + numVertices, grown);
+    for (size_t a = 0; a < sources.size(); ++a) {
+        grown[numVertices + a] = data[sources[a]];
+    }
+    delete[] data;
+    data = grown;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends copies of the given vertices to a mesh or an anim mesh, the bones are left alone
+template <class XMesh>
+void MikkAppendVertexCopies(XMesh* mesh, const std::vector<unsigned int>& sources) {
+    const unsigned int numVertices = mesh->mNumVertices;
+    MikkAppendCopies(mesh->mVertices, numVertices, sources);
+    MikkAppendCopies(mesh->mNormals, numVertices, sources);
+    MikkAppendCopies(mesh->mTangents, numVertices, sources);
+    MikkAppendCopies(mesh->mBitangents, numVertices, sources);
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+        MikkAppendCopies(mesh->mColors[a], numVertices, sources);
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+        MikkAppendCopies(mesh->mTextureCoords[a], numVertices, sources);
+    }
+    mesh->mNumVertices = numVertices + static_cast<unsigned int>(sources.size());
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 CalcTangentsProcess::CalcTangentsProcess()
 : configMaxAngle( AI_DEG_TO_RAD(45.f) )
-, configSourceUV( 0 ) {
+, configSourceUV( 0 )
+, configMikkTSpace( false )
+, configSpatialSortMethod( SpatialSort::Method_PlaneSort ) {
     // nothing to do here
 }
 
@@ -87,6 +407,10 @@ void CalcTangentsProcess::SetupProperties(const Importer* pImp)
     configMaxAngle = AI_DEG_TO_RAD(configMaxAngle);
 
     configSourceUV = pImp->GetPropertyInteger(AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX,0);
+    configMikkTSpace = pImp->GetPropertyBool(AI_CONFIG_PP_CT_MIKKTSPACE,false);
+
+    configSpatialSortMethod = pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_METHOD, AI_SPATIAL_SORT_PLANE) == AI_SPATIAL_SORT_GRID ?
+        SpatialSort::Method_HashGrid : SpatialSort::Method_PlaneSort;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -95,12 +419,41 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 {
     ai_assert( NULL != pScene );
 
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CalcTangentsProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint CalcTangentsProcess::GetMeshFootprint() const
+{
+    return MeshFootprint(MeshComponent_Positions | MeshComponent_Normals | MeshComponent_Tangents |
+        MeshComponent_TexCoords | MeshComponent_Faces, MeshComponent_Tangents);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsProcess::BeginMeshPass( aiScene* pScene)
+{
     ASSIMP_LOG_DEBUG("CalcTangentsProcess begin");
 
-    bool bHas = false;
-    for ( unsigned int a = 0; a < pScene->mNumMeshes; a++ ) {
-        if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
-    }
+    meshComputed.assign(pScene->mNumMeshes, 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+    meshComputed[meshIndex] = ProcessMesh(pMesh, meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsProcess::EndMeshPass( aiScene* /*pScene*/)
+{
+    const bool bHas = std::find(meshComputed.begin(), meshComputed.end(), 1) != meshComputed.end();
+    meshComputed.clear();
 
     if ( bHas ) {
         ASSIMP_LOG_INFO("CalcTangentsProcess finished. Tangents have been calculated");
@@ -142,6 +495,11 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         return false;
     }
 
+    if (configMikkTSpace) {
+        ProcessMeshMikkTSpace(pMesh);
+        return true;
+    }
+
     const float angleEpsilon = 0.9999f;
 
     std::vector<bool> vertexDone( pMesh->mNumVertices, false);
@@ -252,7 +610,9 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     }
     if (!vertexFinder)
     {
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
+        _vertexFinder.SetMethod(configSpatialSortMethod);
+        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D), false);
+        _vertexFinder.Finalize(threadPool);
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
     }
@@ -317,3 +677,336 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     }
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Calculates tangents and bi-tangents for the given mesh with the MikkTSpace algorithm
+void CalcTangentsProcess::ProcessMeshMikkTSpace( aiMesh* pMesh)
+{
+    const aiVector3D* meshPos = pMesh->mVertices;
+    const aiVector3D* meshNorm = pMesh->mNormals;
+    const aiVector3D* meshTex = pMesh->mTextureCoords[configSourceUV];
+    const unsigned int numVertices = pMesh->mNumVertices;
+    ThreadPool* pool = (threadPool && threadPool->GetNumThreads() > 1) ? threadPool : NULL;
+
+    // weld vertices with the same position, normal and texture coordinate. Each welded vertex is
+    // represented by the first of its copies.
+    static const unsigned int KeySize = 8;
+    std::vector<ai_real> keys(numVertices * KeySize);
+    for (unsigned int a = 0; a < numVertices; ++a) {
+        ai_real* key = &keys[a * KeySize];
+        key[0] = meshPos[a].x; key[1] = meshPos[a].y; key[2] = meshPos[a].z;
+        key[3] = meshNorm[a].x; key[4] = meshNorm[a].y; key[5] = meshNorm[a].z;
+        key[6] = meshTex[a].x; key[7] = meshTex[a].y;
+    }
+    std::vector<unsigned int> order(numVertices), weld(numVertices);
+    for (unsigned int a = 0; a < numVertices; ++a) {
+        order[a] = a;
+    }
+    std::sort(order.begin(), order.end(), [&keys](unsigned int a, unsigned int b) {
+        const int c = ::memcmp(&keys[a * KeySize], &keys[b * KeySize], KeySize * sizeof(ai_real));
+        return c < 0 || (c == 0 && a < b);
+    });
+    for (unsigned int a = 0, rep = 0; a < numVertices; ++a) {
+        if (a && ::memcmp(&keys[order[a - 1] * KeySize], &keys[order[a] * KeySize], KeySize * sizeof(ai_real))) {
+            rep = a;
+        }
+        weld[order[a]] = order[rep];
+    }
+
+    // one tangent space per face corner
+    std::vector<unsigned int> cornerStart(pMesh->mNumFaces + 1, 0);
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        cornerStart[a + 1] = cornerStart[a] + pMesh->mFaces[a].mNumIndices;
+    }
+
+    // split the faces into triangles, degenerate ones are kept apart
+    std::vector<MikkTriangle> triangles, degenerates;
+    const auto addTriangle = [&](unsigned int face, unsigned int c0, unsigned int c1, unsigned int c2) -> bool {
+        const aiFace& f = pMesh->mFaces[face];
+        MikkTriangle tri;
+        tri.face = face;
+        tri.faceCorner[0] = static_cast<unsigned char>(c0);
+        tri.faceCorner[1] = static_cast<unsigned char>(c1);
+        tri.faceCorner[2] = static_cast<unsigned char>(c2);
+        tri.vertex[0] = weld[f.mIndices[c0]];
+        tri.vertex[1] = weld[f.mIndices[c1]];
+        tri.vertex[2] = weld[f.mIndices[c2]];
+        tri.flags = 0;
+        for (unsigned int i = 0; i < 3; ++i) {
+            tri.neighbour[i] = tri.group[i] = -1;
+        }
+        const aiVector3D& p0 = meshPos[tri.vertex[0]];
+        const aiVector3D& p1 = meshPos[tri.vertex[1]];
+        const aiVector3D& p2 = meshPos[tri.vertex[2]];
+        if (p0 == p1 || p0 == p2 || p1 == p2) {
+            tri.flags |= MikkDegenerate;
+            degenerates.push_back(tri);
+            return true;
+        }
+        triangles.push_back(tri);
+        return false;
+    };
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        const aiFace& face = pMesh->mFaces[a];
+        if (face.mNumIndices == 3) {
+            addTriangle(a, 0, 1, 2);
+        } else if (face.mNumIndices == 4) {
+            // split along the shorter diagonal in texture space, or else in model space
+            const aiVector3D& t0 = meshTex[face.mIndices[0]];
+            const aiVector3D& t1 = meshTex[face.mIndices[1]];
+            const aiVector3D& t2 = meshTex[face.mIndices[2]];
+            const aiVector3D& t3 = meshTex[face.mIndices[3]];
+            const ai_real texDistSq02 = (t2.x - t0.x) * (t2.x - t0.x) + (t2.y - t0.y) * (t2.y - t0.y);
+            const ai_real texDistSq13 = (t3.x - t1.x) * (t3.x - t1.x) + (t3.y - t1.y) * (t3.y - t1.y);
+            bool diagonalIs02;
+            if (texDistSq02 < texDistSq13) {
+                diagonalIs02 = true;
+            } else if (texDistSq13 < texDistSq02) {
+                diagonalIs02 = false;
+            } else {
+                const ai_real distSq02 = (meshPos[face.mIndices[2]] - meshPos[face.mIndices[0]]).SquareLength();
+                const ai_real distSq13 = (meshPos[face.mIndices[3]] - meshPos[face.mIndices[1]]).SquareLength();
+                diagonalIs02 = !(distSq13 < distSq02);
+            }
+
+            const bool degenerate0 = diagonalIs02 ? addTriangle(a, 0, 1, 2) : addTriangle(a, 0, 1, 3);
+            const bool degenerate1 = diagonalIs02 ? addTriangle(a, 0, 2, 3) : addTriangle(a, 1, 2, 3);
+            if (degenerate0 != degenerate1) {
+                // the good triangle takes over the tangent space of the fourth corner
+                (degenerate0 ? degenerates : triangles).back().flags |= MikkQuadOneDegenerate;
+                (degenerate1 ? degenerates : triangles).back().flags |= MikkQuadOneDegenerate;
+            }
+        } else {
+            // not handled by the reference, which expects triangles and quads
+            for (unsigned int i = 1; i + 1 < face.mNumIndices; ++i) {
+                addTriangle(a, 0, i, i + 1);
+            }
+        }
+    }
+    const unsigned int numTriangles = static_cast<unsigned int>(triangles.size());
+
+    MikkForEachBlock(pool, numTriangles, [&](unsigned int t) {
+        MikkInitTriangle(triangles[t], meshPos, meshTex);
+    });
+
+    // force the two halves of healthy quads to the same orientation
+    for (unsigned int t = 0; t + 1 < numTriangles; ++t) {
+        MikkTriangle& triA = triangles[t];
+        MikkTriangle& triB = triangles[t + 1];
+        if (triA.face != triB.face || pMesh->mFaces[triA.face].mNumIndices != 4) {
+            continue;
+        }
+        if ((triA.flags & MikkOrientPreserving) != (triB.flags & MikkOrientPreserving)) {
+            const bool chooseFirst = (triB.flags & MikkGroupWithAny) != 0 ||
+                MikkTexArea(meshTex, triA.vertex) >= MikkTexArea(meshTex, triB.vertex);
+            const MikkTriangle& src = chooseFirst ? triA : triB;
+            MikkTriangle& dst = chooseFirst ? triB : triA;
+            dst.flags = (dst.flags & ~MikkOrientPreserving) | (src.flags & MikkOrientPreserving);
+        }
+        ++t;
+    }
+
+    // find the neighbours across each edge, see BuildNeighborsFast. The edges are sorted by
+    // their vertices and matched with the first unassigned edge in the opposite direction.
+    struct Edge {
+        unsigned int v0, v1, triangle, edge;
+        bool operator < (const Edge& o) const {
+            if (v0 != o.v0) return v0 < o.v0;
+            if (v1 != o.v1) return v1 < o.v1;
+            if (triangle != o.triangle) return triangle < o.triangle;
+            return edge < o.edge;
+        }
+    };
+    std::vector<Edge> edges(numTriangles * 3);
+    for (unsigned int t = 0; t < numTriangles; ++t) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int a = triangles[t].vertex[i], b = triangles[t].vertex[i < 2 ? i + 1 : 0];
+            const Edge e = { std::min(a, b), std::max(a, b), t, i };
+            edges[t * 3 + i] = e;
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (size_t a = 0; a < edges.size(); ++a) {
+        const Edge& ea = edges[a];
+        MikkTriangle& triA = triangles[ea.triangle];
+        if (triA.neighbour[ea.edge] != -1) {
+            continue;
+        }
+        const unsigned int fromA = triA.vertex[ea.edge];
+        for (size_t b = a + 1; b < edges.size() && edges[b].v0 == ea.v0 && edges[b].v1 == ea.v1; ++b) {
+            const Edge& eb = edges[b];
+            MikkTriangle& triB = triangles[eb.triangle];
+            if (triB.vertex[eb.edge] != fromA && triB.neighbour[eb.edge] == -1) {
+                triA.neighbour[ea.edge] = static_cast<int>(eb.triangle);
+                triB.neighbour[eb.edge] = static_cast<int>(ea.triangle);
+                break;
+            }
+        }
+    }
+
+    // build the groups, see Build4RuleGroups
+    std::vector<MikkGroup> groups;
+    std::vector<unsigned int> groupTriangles;
+    groupTriangles.reserve(numTriangles * 3);
+    for (unsigned int t = 0; t < numTriangles; ++t) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            MikkTriangle& tri = triangles[t];
+            if ((tri.flags & MikkGroupWithAny) || tri.group[i] != -1) {
+                continue;
+            }
+            MikkGroup group;
+            group.vertex = tri.vertex[i];
+            group.orient = (tri.flags & MikkOrientPreserving) != 0;
+            group.firstTriangle = static_cast<unsigned int>(groupTriangles.size());
+            group.numTriangles = 1;
+            groupTriangles.push_back(t);
+            tri.group[i] = static_cast<int>(groups.size());
+            groups.push_back(group);
+
+            MikkAssignGroup(triangles, groups, groupTriangles, tri.group[i],
+                tri.neighbour[i], tri.neighbour[i > 0 ? i - 1 : 2]);
+        }
+    }
+
+    // evaluate the groups in parallel, then write them to the corners in order. The default
+    // reference implementation never splits a group by its angular threshold.
+    const unsigned int numGroups = static_cast<unsigned int>(groups.size());
+    std::vector<MikkTSpace> groupSpaces(numGroups);
+    MikkForEachBlock(pool, numGroups, [&](unsigned int g) {
+        groupSpaces[g] = MikkEvalGroup(groups[g], triangles, groupTriangles, meshPos, meshNorm);
+    });
+
+    MikkTSpace defaultSpace;
+    defaultSpace.os = aiVector3D(1, 0, 0);
+    defaultSpace.ot = aiVector3D(0, 1, 0);
+    defaultSpace.magS = defaultSpace.magT = 1;
+    defaultSpace.counter = 0;
+    defaultSpace.orient = false;
+    std::vector<MikkTSpace> spaces(cornerStart.back(), defaultSpace);
+    for (unsigned int g = 0; g < numGroups; ++g) {
+        const MikkGroup& group = groups[g];
+        for (unsigned int a = 0; a < group.numTriangles; ++a) {
+            const MikkTriangle& tri = triangles[groupTriangles[group.firstTriangle + a]];
+            MikkTSpace& out = spaces[cornerStart[tri.face] + tri.faceCorner[MikkCornerOf(tri, group.vertex)]];
+            if (out.counter == 1) {
+                out = MikkAverage(out, groupSpaces[g]);
+                out.counter = 2;
+            } else {
+                out = groupSpaces[g];
+                out.counter = 1;
+            }
+            out.orient = group.orient;
+        }
+    }
+
+    // degenerate triangles take the tangent space of the first good corner of the same vertex,
+    // see DegenEpilogue
+    std::vector<unsigned int> firstGoodCorner(numVertices, UINT_MAX);
+    for (unsigned int t = numTriangles; t-- > 0;) {
+        for (unsigned int i = 3; i-- > 0;) {
+            const MikkTriangle& tri = triangles[t];
+            firstGoodCorner[tri.vertex[i]] = cornerStart[tri.face] + tri.faceCorner[i];
+        }
+    }
+    for (const MikkTriangle& tri : degenerates) {
+        if (tri.flags & MikkQuadOneDegenerate) {
+            continue;
+        }
+        for (unsigned int i = 0; i < 3; ++i) {
+            if (firstGoodCorner[tri.vertex[i]] != UINT_MAX) {
+                spaces[cornerStart[tri.face] + tri.faceCorner[i]] = spaces[firstGoodCorner[tri.vertex[i]]];
+            }
+        }
+    }
+    for (const MikkTriangle& tri : triangles) {
+        if (!(tri.flags & MikkQuadOneDegenerate)) {
+            continue;
+        }
+        // the corner of the quad which isn't part of the good triangle
+        const unsigned int used = (1u << tri.faceCorner[0]) | (1u << tri.faceCorner[1]) | (1u << tri.faceCorner[2]);
+        const unsigned int missing = !(used & 2) ? 1 : (!(used & 4) ? 2 : (!(used & 8) ? 3 : 0));
+        const aiVector3D& missingPos = meshPos[pMesh->mFaces[tri.face].mIndices[missing]];
+        for (unsigned int i = 0; i < 3; ++i) {
+            if (meshPos[pMesh->mFaces[tri.face].mIndices[tri.faceCorner[i]]] == missingPos) {
+                spaces[cornerStart[tri.face] + missing] = spaces[cornerStart[tri.face] + tri.faceCorner[i]];
+                break;
+            }
+        }
+    }
+
+    // the tangent spaces are per corner, but the tangents are stored per vertex. Corners of one vertex
+    // can end up in different groups, i.e. at mirrored texture seams, so a vertex is split for each
+    // further tangent space of its corners. Points and lines have no tangent space and don't split.
+    std::vector<unsigned int> vertexCorner(numVertices, UINT_MAX), firstCopy(numVertices, UINT_MAX);
+    std::vector<unsigned int> copySource, copyCorner, nextCopy;
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        const aiFace& face = pMesh->mFaces[a];
+        if (face.mNumIndices < 3) {
+            continue;
+        }
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            const unsigned int corner = cornerStart[a] + i;
+            const unsigned int p = face.mIndices[i];
+            if (vertexCorner[p] == UINT_MAX) {
+                vertexCorner[p] = corner;
+                continue;
+            }
+            if (MikkSameTSpace(spaces[vertexCorner[p]], spaces[corner])) {
+                continue;
+            }
+            unsigned int c = firstCopy[p];
+            while (c != UINT_MAX && !MikkSameTSpace(spaces[copyCorner[c]], spaces[corner])) {
+                c = nextCopy[c];
+            }
+            if (c == UINT_MAX) {
+                c = static_cast<unsigned int>(copySource.size());
+                copySource.push_back(p);
+                copyCorner.push_back(corner);
+                nextCopy.push_back(firstCopy[p]);
+                firstCopy[p] = c;
+            }
+            face.mIndices[i] = numVertices + c;
+        }
+    }
+
+    if (!copySource.empty()) {
+        MikkAppendVertexCopies(pMesh, copySource);
+        for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+            MikkAppendVertexCopies(pMesh->mAnimMeshes[a], copySource);
+        }
+
+        // the copies have the weights of their vertex
+        for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+            aiBone* bone = pMesh->mBones[a];
+            std::vector<aiVertexWeight> weights(bone->mWeights, bone->mWeights + bone->mNumWeights);
+            for (unsigned int b = 0; b < bone->mNumWeights; ++b) {
+                for (unsigned int c = firstCopy[bone->mWeights[b].mVertexId]; c != UINT_MAX; c = nextCopy[c]) {
+                    weights.push_back(aiVertexWeight(numVertices + c, bone->mWeights[b].mWeight));
+                }
+            }
+            if (weights.size() != bone->mNumWeights) {
+                delete[] bone->mWeights;
+                bone->mNumWeights = static_cast<unsigned int>(weights.size());
+                bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+                std::copy(weights.begin(), weights.end(), bone->mWeights);
+            }
+        }
+        ASSIMP_LOG_DEBUG_F("CalcTangentsProcess: split ", copySource.size(), " vertices with different tangent spaces");
+    }
+
+    // write the tangents, the bitangents are built from the normal and the orientation
+    const ai_real qnan = get_qnan();
+    const unsigned int numOutVertices = pMesh->mNumVertices;
+    pMesh->mTangents = new aiVector3D[numOutVertices];
+    pMesh->mBitangents = new aiVector3D[numOutVertices];
+    for (unsigned int a = 0; a < numOutVertices; ++a) {
+        const unsigned int corner = a < numVertices ? vertexCorner[a] : copyCorner[a - numVertices];
+        if (corner == UINT_MAX) {
+            pMesh->mTangents[a] = pMesh->mBitangents[a] = aiVector3D(qnan);
+            continue;
+        }
+        const MikkTSpace& space = spaces[corner];
+        pMesh->mTangents[a] = space.os;
+        pMesh->mBitangents[a] = (pMesh->mNormals[a] ^ space.os) * (space.orient ? ai_real(1) : ai_real(-1));
+    }
+}
@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CALCTANGENTSPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <assimp/SpatialSort.h>
+#include <vector>
 
 struct aiMesh;
 
@@ -59,7 +61,7 @@ namespace Assimp
  * because the joining of vertices also considers tangents and bitangents for
  * uniqueness.
  */
-class ASSIMP_API_WINONLY CalcTangentsProcess : public BaseProcess
+class ASSIMP_API CalcTangentsProcess : public BaseProcess
 {
 public:
 
@@ -83,6 +85,13 @@ public:
     */
     void SetupProperties(const Importer* pImp);
 
+    // -------------------------------------------------------------------
+    /** The step works on each mesh independently, see BaseProcess. */
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
 
     // setter for configMaxAngle
     inline void SetMaxSmoothAngle(float f)
@@ -90,6 +99,12 @@ public:
         configMaxAngle =f;
     }
 
+    // setter for configMikkTSpace
+    inline void SetMikkTSpace(bool b)
+    {
+        configMikkTSpace = b;
+    }
+
 protected:
 
     // -------------------------------------------------------------------
@@ -99,6 +114,13 @@ protected:
     */
     bool ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
+    // -------------------------------------------------------------------
+    /** Calculates tangents and bitangents for a specific mesh with the
+    * MikkTSpace algorithm, see #AI_CONFIG_PP_CT_MIKKTSPACE.
+    * @param pMesh The mesh to process.
+    */
+    void ProcessMeshMikkTSpace( aiMesh* pMesh);
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * @param pScene The imported data to work at.
@@ -110,6 +132,15 @@ private:
     /** Configuration option: maximum smoothing angle, in radians*/
     float configMaxAngle;
     unsigned int configSourceUV;
+
+    /** Configuration option: use the MikkTSpace algorithm */
+    bool configMikkTSpace;
+
+    /** Configuration option: spatial index used to find close vertices */
+    SpatialSort::Method configSpatialSortMethod;
+
+    /** Per-mesh result of the current pass: tangents computed or not */
+    std::vector<unsigned char> meshComputed;
 };
 
 } // end of namespace Assimp
@@ -1994,20 +1994,13 @@ void ColladaParser::ReadDataArray()
             }
         } else
         {
-            data.mValues.reserve( count);
-
-            for( unsigned int a = 0; a < count; a++)
-            {
-                if( *content == 0)
-                    ThrowException( "Expected more values while reading float_array contents.");
-
-                ai_real value;
-                // read a number
-                content = fast_atoreal_move<ai_real>( content, value);
-                data.mValues.push_back( value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd( &content);
-            }
+            // float arrays can hold millions of values, read them all in one go
+            data.mValues.resize( count);
+            size_t parsed = 0;
+            if( count > 0)
+                fast_atoreal_array( content, content + ::strlen( content), &data.mValues[0], count, &parsed);
+            if( parsed < count)
+                ThrowException( "Expected more values while reading float_array contents.");
         }
     }
 
@@ -2347,15 +2340,20 @@ size_t ColladaParser::ReadPrimitives( Mesh* pMesh, std::vector<InputChannel>& pP
     if (pNumPrimitives > 0) // It is possible to not contain any indices
     {
         const char* content = GetTextContent();
-        while( *content != 0)
+        const char* end = content + ::strlen( content);
+        static const size_t BatchSize = 1024;
+        int values[ BatchSize];
+        size_t parsed = 0;
+        do
         {
-            // read a value.
+            content = strtol10_array( content, end, values, BatchSize, &parsed);
             // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
-            int value = std::max( 0, strtol10( content, &content));
-            indices.push_back( size_t( value));
-            // skip whitespace after it
-            SkipSpacesAndLineEnd( &content);
-        }
+            for( size_t a = 0; a < parsed; a++)
+                indices.push_back( size_t( std::max( 0, values[a])));
+        } while( parsed == BatchSize);
+
+        if( content != end && *content != 0)
+            ThrowException( "Unexpected token in <p> element, expected an index.");
     }
 
 	// complain if the index count doesn't fit
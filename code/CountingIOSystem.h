@@ -0,0 +1,219 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  CountingIOSystem.h
+ *  @brief IOSystem wrapper to count the bytes read during an import.
+ */
+#pragma once
+#ifndef AI_COUNTINGIOSYSTEM_H_INC
+#define AI_COUNTINGIOSYSTEM_H_INC
+
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** Forwards all calls to the wrapped IOSystem and keeps track of the
+ *  number of files opened and bytes read through it. Used by the Importer
+ *  when AI_CONFIG_GLOB_MEASURE_TIME is set.
+ */
+class CountingIOSystem : public IOSystem
+{
+    // -------------------------------------------------------------------
+    class CountingIOStream : public IOStream {
+    public:
+        CountingIOStream(CountingIOSystem* system, IOStream* stream)
+        : mSystem(system)
+        , mStream(stream) {
+            // empty
+        }
+
+        ~CountingIOStream() {
+            mSystem->mWrapped->Close(mStream);
+        }
+
+        size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+            const size_t count = mStream->Read(pvBuffer, pSize, pCount);
+            mSystem->mBytesRead += count * pSize;
+            return count;
+        }
+
+        size_t Write(const void* pvBuffer, size_t pSize, size_t pCount) {
+            return mStream->Write(pvBuffer, pSize, pCount);
+        }
+
+        aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+            return mStream->Seek(pOffset, pOrigin);
+        }
+
+        size_t Tell() const {
+            return mStream->Tell();
+        }
+
+        size_t FileSize() const {
+            return mStream->FileSize();
+        }
+
+        void Flush() {
+            mStream->Flush();
+        }
+
+        const uint8_t* GetContiguousView(size_t& len) {
+            const uint8_t* view = mStream->GetContiguousView(len);
+            if (view) {
+                // readers parse the view instead of reading, count all of it
+                mSystem->mBytesRead += len;
+            }
+            return view;
+        }
+
+    private:
+        CountingIOSystem* mSystem;
+        IOStream* mStream;
+    };
+
+public:
+    /** Constructor. */
+    explicit CountingIOSystem(IOSystem* old)
+    : mWrapped(old)
+    , mBytesRead(0)
+    , mFilesOpened(0) {
+        ai_assert(nullptr != mWrapped);
+    }
+
+    /** Destructor. */
+    ~CountingIOSystem() {
+        // empty
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns the number of bytes read so far. */
+    uint64_t GetBytesRead() const {
+        return mBytesRead;
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns the number of files opened so far. */
+    uint64_t GetFilesOpened() const {
+        return mFilesOpened;
+    }
+
+    // -------------------------------------------------------------------
+    bool Exists( const char* pFile) const {
+        return mWrapped->Exists(pFile);
+    }
+
+    // -------------------------------------------------------------------
+    char getOsSeparator() const {
+        return mWrapped->getOsSeparator();
+    }
+
+    // -------------------------------------------------------------------
+    IOStream* Open( const char* pFile, const char* pMode = "rb") {
+        IOStream* s = mWrapped->Open(pFile, pMode);
+        if (nullptr == s) {
+            return nullptr;
+        }
+        ++mFilesOpened;
+        return new CountingIOStream(this, s);
+    }
+
+    // -------------------------------------------------------------------
+    /** The wrapped stream is closed by the destructor of our stream */
+    void Close( IOStream* pFile) {
+        delete pFile;
+    }
+
+    // -------------------------------------------------------------------
+    bool ComparePaths (const char* one, const char* second) const {
+        return mWrapped->ComparePaths (one,second);
+    }
+
+    // -------------------------------------------------------------------
+    bool PushDirectory(const std::string &path ) {
+        return mWrapped->PushDirectory(path);
+    }
+
+    // -------------------------------------------------------------------
+    const std::string &CurrentDirectory() const {
+        return mWrapped->CurrentDirectory();
+    }
+
+    // -------------------------------------------------------------------
+    size_t StackSize() const {
+        return mWrapped->StackSize();
+    }
+
+    // -------------------------------------------------------------------
+    bool PopDirectory() {
+        return mWrapped->PopDirectory();
+    }
+
+    // -------------------------------------------------------------------
+    bool CreateDirectory(const std::string &path) {
+        return mWrapped->CreateDirectory(path);
+    }
+
+    // -------------------------------------------------------------------
+    bool ChangeDirectory(const std::string &path) {
+        return mWrapped->ChangeDirectory(path);
+    }
+
+    // -------------------------------------------------------------------
+    bool DeleteFile(const std::string &file) {
+        return mWrapped->DeleteFile(file);
+    }
+
+private:
+    IOSystem* mWrapped;
+    std::atomic<uint64_t> mBytesRead;
+    std::atomic<uint64_t> mFilesOpened;
+};
+
+} //!ns Assimp
+
+#endif //AI_COUNTINGIOSYSTEM_H_INC
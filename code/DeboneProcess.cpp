@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers of the post-processing framework
 #include "ProcessHelper.h"
 #include "DeboneProcess.h"
+#include "simd.h"
 #include <stdio.h>
 
 
@@ -438,28 +439,14 @@ void DeboneProcess::ApplyTransform(aiMesh* mesh, const aiMatrix4x4& mat)const
     if (!mat.IsIdentity()) {
 
         if (mesh->HasPositions()) {
-            for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                mesh->mVertices[i] = mat * mesh->mVertices[i];
-            }
+            TransformPositions(mat, mesh->mVertices, mesh->mVertices, mesh->mNumVertices);
         }
-        if (mesh->HasNormals() || mesh->HasTangentsAndBitangents()) {
-            aiMatrix4x4 mWorldIT = mat;
-            mWorldIT.Inverse().Transpose();
-
-            // TODO: implement Inverse() for aiMatrix3x3
-            aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
-
-            if (mesh->HasNormals()) {
-                for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                    mesh->mNormals[i] = (m * mesh->mNormals[i]).Normalize();
-                }
-            }
-            if (mesh->HasTangentsAndBitangents()) {
-                for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                    mesh->mTangents[i]   = (m * mesh->mTangents[i]).Normalize();
-                    mesh->mBitangents[i] = (m * mesh->mBitangents[i]).Normalize();
-                }
-            }
+        if (mesh->HasNormals()) {
+            TransformNormals(mat, mesh->mNormals, mesh->mNormals, mesh->mNumVertices);
+        }
+        if (mesh->HasTangentsAndBitangents()) {
+            TransformNormals(mat, mesh->mTangents, mesh->mTangents, mesh->mNumVertices);
+            TransformNormals(mat, mesh->mBitangents, mesh->mBitangents, mesh->mNumVertices);
         }
     }
 }
@@ -57,13 +57,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <iostream>
 #include <stdio.h>
+#include <mutex>
 
 #ifndef ASSIMP_BUILD_SINGLETHREADED
 #   include <thread>
-#   include <mutex>
     std::mutex loggerMutex;
 #endif
 
+// Post-processing steps may log from several worker threads at once (see
+// AI_CONFIG_GLOB_NUM_THREADS), so writing to the streams is always guarded.
+static std::mutex streamMutex;
+
 namespace Assimp    {
 
 // ----------------------------------------------------------------------------------
@@ -370,6 +374,8 @@ DefaultLogger::~DefaultLogger() {
 void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev ) {
     ai_assert(nullptr != message);
 
+    std::lock_guard<std::mutex> lock(streamMutex);
+
     // Check whether this is a repeated message
     if (! ::strncmp( message,lastMsg, lastLen-1))
     {
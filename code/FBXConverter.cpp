@@ -53,6 +53,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXUtil.h"
 #include "FBXProperties.h"
 #include "FBXImporter.h"
+#include "ThreadPool.h"
+#include "simd.h"
 #include <assimp/StringComparison.h>
 
 #include <assimp/scene.h>
@@ -63,6 +65,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <limits>
 
 namespace Assimp {
 namespace FBX {
@@ -73,19 +76,25 @@ using namespace Util;
 
 #define CONVERT_FBX_TIME(time) static_cast<double>(time) / 46186158000L
 
-FBXConverter::FBXConverter( aiScene* out, const Document& doc )
+FBXConverter::FBXConverter( aiScene* out, const Document& doc, ThreadPool* pool )
 : defaultMaterialIndex()
 , out( out )
-, doc( doc ) {
+, doc( doc )
+, threadPool( pool ) {
     // animations need to be converted first since this will
     // populate the node_anim_chain_bits map, which is needed
     // to determine which nodes need to be generated.
     ConvertAnimations();
     ConvertRootNode();
+    ConvertMeshes();
 
     if ( doc.Settings().readAllMaterials ) {
-        // unfortunately this means we have to evaluate all objects
+        // evaluate all material objects, but not the others
         for( const ObjectMap::value_type& v : doc.Objects() ) {
+            const Token& key = v.second->GetElement().KeyToken();
+            if ( key.end() - key.begin() != 8 || strncmp( key.begin(), "Material", 8 ) ) {
+                continue;
+            }
 
             const Object* ob = v.second->Get();
             if ( !ob ) {
@@ -128,10 +137,11 @@ void FBXConverter::ConvertRootNode() {
     out->mRootNode->mName.Set( "RootNode" );
 
     // root has ID 0
-    ConvertNodes( 0L, *out->mRootNode );
+    const ImportSettings& settings = doc.Settings();
+    ConvertNodes( 0L, *out->mRootNode, aiMatrix4x4(), settings.readGeometry && settings.geometryRootNode.empty() );
 }
 
-void FBXConverter::ConvertNodes( uint64_t id, aiNode& parent, const aiMatrix4x4& parent_transform ) {
+void FBXConverter::ConvertNodes( uint64_t id, aiNode& parent, const aiMatrix4x4& parent_transform, bool read_geometry ) {
     const std::vector<const Connection*>& conns = doc.GetConnectionsByDestinationSequenced( id, "Model" );
 
     std::vector<aiNode*> nodes;
@@ -172,6 +182,11 @@ void FBXConverter::ConvertNodes( uint64_t id, aiNode& parent, const aiMatrix4x4&
 
                 std::string original_name = FixNodeName( model->Name() );
 
+                // the geometry of this subtree is read if it's the one selected
+                const ImportSettings& settings = doc.Settings();
+                const bool read_model_geometry = read_geometry || ( settings.readGeometry &&
+                    !settings.geometryRootNode.empty() && original_name == settings.geometryRootNode );
+
                 // check if any of the nodes in the chain has the name the fbx node
                 // is supposed to have. If there is none, add another node to
                 // preserve the name - people might have scripts etc. that rely
@@ -213,7 +228,9 @@ void FBXConverter::ConvertNodes( uint64_t id, aiNode& parent, const aiMatrix4x4&
                 }
 
                 // attach geometry
-                ConvertModel( *model, *nodes_chain.back(), new_abs_transform );
+                if ( read_model_geometry ) {
+                    ConvertModel( *model, *nodes_chain.back(), new_abs_transform );
+                }
 
                 // check if there will be any child nodes
                 const std::vector<const Connection*>& child_conns
@@ -247,7 +264,7 @@ void FBXConverter::ConvertNodes( uint64_t id, aiNode& parent, const aiMatrix4x4&
                 }
 
                 // attach sub-nodes (if any)
-                ConvertNodes( model->ID(), *last_parent, new_abs_transform );
+                ConvertNodes( model->ID(), *last_parent, new_abs_transform, read_model_geometry );
 
                 if ( doc.Settings().readLights ) {
                     ConvertLights( *model, original_name );
@@ -891,20 +908,56 @@ std::vector<unsigned int> FBXConverter::ConvertMesh( const MeshGeometry& mesh, c
         return temp;
     }
 
+    MeshJob job;
+    job.mesh = &mesh;
+    job.model = &model;
+    job.node_global_transform = node_global_transform;
+
     // one material per mesh maps easily to aiMesh. Multiple material
     // meshes need to be split.
     const MatIndexArray& mindices = mesh.GetMaterialIndices();
+    bool multi_material = false;
     if ( doc.Settings().readMaterials && !mindices.empty() ) {
         const MatIndexArray::value_type base = mindices[ 0 ];
         for( MatIndexArray::value_type index : mindices ) {
             if ( index != base ) {
-                return ConvertMeshMultiMaterial( mesh, model, node_global_transform, nd);
+                multi_material = true;
+                break;
             }
         }
     }
 
-    // faster code-path, just copy the data
-    temp.push_back( ConvertMeshSingleMaterial( mesh, model, node_global_transform, nd) );
+    // materials are converted right away so their indices don't depend
+    // on the order in which the geometry is converted
+    if ( multi_material ) {
+        std::set<MatIndexArray::value_type> had;
+        for( MatIndexArray::value_type index : mindices ) {
+            if ( had.insert( index ).second ) {
+                aiMesh* const out_mesh = SetupEmptyMesh( mesh, nd );
+                ConvertMaterialForMesh( out_mesh, model, mesh, index );
+
+                job.out_meshes.push_back( out_mesh );
+                job.material_indices.push_back( index );
+                temp.push_back( static_cast<unsigned int>( meshes.size() - 1 ) );
+            }
+        }
+    }
+    else {
+        // faster code-path, just copy the data
+        aiMesh* const out_mesh = SetupEmptyMesh( mesh, nd );
+        if ( !doc.Settings().readMaterials || mindices.empty() ) {
+            FBXImporter::LogError( "no material assigned to mesh, setting default material" );
+            out_mesh->mMaterialIndex = GetDefaultMaterial();
+        }
+        else {
+            ConvertMaterialForMesh( out_mesh, model, mesh, mindices[ 0 ] );
+        }
+
+        job.out_meshes.push_back( out_mesh );
+        temp.push_back( static_cast<unsigned int>( meshes.size() - 1 ) );
+    }
+
+    mesh_jobs.push_back( job );
     return temp;
 }
 
@@ -931,12 +984,39 @@ aiMesh* FBXConverter::SetupEmptyMesh( const MeshGeometry& mesh, aiNode& nd)
     return out_mesh;
 }
 
-unsigned int FBXConverter::ConvertMeshSingleMaterial( const MeshGeometry& mesh, const Model& model,
-    const aiMatrix4x4& node_global_transform, aiNode& nd)
+void FBXConverter::ConvertMeshes()
 {
-    const MatIndexArray& mindices = mesh.GetMaterialIndices();
-    aiMesh* const out_mesh = SetupEmptyMesh(mesh, nd);
+    const unsigned int num_jobs = static_cast<unsigned int>( mesh_jobs.size() );
+    const std::function<void(unsigned int)> convert = [this]( unsigned int i ) {
+        const MeshJob& job = mesh_jobs[ i ];
+        if ( job.material_indices.empty() ) {
+            ConvertMeshSingleMaterial( job.out_meshes[ 0 ], *job.mesh, *job.model, job.node_global_transform );
+            return;
+        }
+
+        // the sub meshes of a MeshGeometry share its lazily computed lookup
+        // tables, so they are converted by the same thread
+        for ( size_t j = 0; j < job.out_meshes.size(); ++j ) {
+            ConvertMeshMultiMaterial( job.out_meshes[ j ], *job.mesh, *job.model,
+                job.material_indices[ j ], job.node_global_transform );
+        }
+    };
 
+    if ( threadPool && num_jobs > 1 ) {
+        threadPool->ParallelFor( 0, num_jobs, convert );
+    }
+    else {
+        for ( unsigned int i = 0; i < num_jobs; ++i ) {
+            convert( i );
+        }
+    }
+
+    mesh_jobs.clear();
+}
+
+void FBXConverter::ConvertMeshSingleMaterial( aiMesh* out_mesh, const MeshGeometry& mesh, const Model& model,
+    const aiMatrix4x4& node_global_transform)
+{
     const std::vector<aiVector3D>& vertices = mesh.GetVertices();
     const std::vector<unsigned int>& faces = mesh.GetFaceIndexCounts();
 
@@ -1043,48 +1123,15 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial( const MeshGeometry& mesh,
         std::copy( colors.begin(), colors.end(), out_mesh->mColors[ i ] );
     }
 
-    if ( !doc.Settings().readMaterials || mindices.empty() ) {
-        FBXImporter::LogError( "no material assigned to mesh, setting default material" );
-        out_mesh->mMaterialIndex = GetDefaultMaterial();
-    }
-    else {
-        ConvertMaterialForMesh( out_mesh, model, mesh, mindices[ 0 ] );
-    }
-
     if ( doc.Settings().readWeights && mesh.DeformerSkin() != NULL ) {
         ConvertWeights( out_mesh, model, mesh, node_global_transform, NO_MATERIAL_SEPARATION );
     }
-
-    return static_cast<unsigned int>( meshes.size() - 1 );
-}
-
-std::vector<unsigned int> FBXConverter::ConvertMeshMultiMaterial( const MeshGeometry& mesh, const Model& model,
-    const aiMatrix4x4& node_global_transform, aiNode& nd)
-{
-    const MatIndexArray& mindices = mesh.GetMaterialIndices();
-    ai_assert( mindices.size() );
-
-    std::set<MatIndexArray::value_type> had;
-    std::vector<unsigned int> indices;
-
-    for( MatIndexArray::value_type index : mindices ) {
-        if ( had.find( index ) == had.end() ) {
-
-            indices.push_back( ConvertMeshMultiMaterial( mesh, model, index, node_global_transform, nd) );
-            had.insert( index );
-        }
-    }
-
-    return indices;
 }
 
-unsigned int FBXConverter::ConvertMeshMultiMaterial( const MeshGeometry& mesh, const Model& model,
+void FBXConverter::ConvertMeshMultiMaterial( aiMesh* out_mesh, const MeshGeometry& mesh, const Model& model,
     MatIndexArray::value_type index,
-    const aiMatrix4x4& node_global_transform,
-    aiNode& nd)
+    const aiMatrix4x4& node_global_transform)
 {
-    aiMesh* const out_mesh = SetupEmptyMesh(mesh, nd);
-
     const MatIndexArray& mindices = mesh.GetMaterialIndices();
     const std::vector<aiVector3D>& vertices = mesh.GetVertices();
     const std::vector<unsigned int>& faces = mesh.GetFaceIndexCounts();
@@ -1245,13 +1292,9 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial( const MeshGeometry& mesh, c
         }
     }
 
-    ConvertMaterialForMesh( out_mesh, model, mesh, index );
-
     if ( process_weights ) {
         ConvertWeights( out_mesh, model, mesh, node_global_transform, index, &reverseMapping );
     }
-
-    return static_cast<unsigned int>( meshes.size() - 1 );
 }
 
 void FBXConverter::ConvertWeights( aiMesh* out, const Model& model, const MeshGeometry& geo,
@@ -2020,6 +2063,11 @@ void FBXConverter::ConvertAnimations()
     const float custom = doc.GlobalSettings().CustomFrameRate();
     anim_fps = FrameRateToDouble( fps, custom );
 
+    // the stacks are not even parsed if animations are not read
+    if ( !doc.Settings().readAnimations ) {
+        return;
+    }
+
     const std::vector<const AnimationStack*>& animations = doc.AnimationStacks();
     for( const AnimationStack* stack : animations ) {
         ConvertAnimationStack( *stack );
@@ -2039,6 +2087,79 @@ std::string FBXConverter::FixNodeName( const std::string& name ) {
     return name;
 }
 
+// ------------------------------------------------------------------------------------------------
+// the value of a key relative to an anchor key, in a space in which the keys are interpolated linearly
+static aiVector3D KeyOffset( const aiVectorKey& anchor, const aiVectorKey& key ) {
+    return key.mValue - anchor.mValue;
+}
+
+// slerp(a, b, f) = a * (a^-1 * b)^f, so rotations are interpolated linearly in the logarithm
+// of the rotation relative to the anchor: the rotation axis scaled by half the rotation angle.
+// For small rotations this is close to the quaternion components.
+static aiVector3D KeyOffset( const aiQuatKey& anchor, const aiQuatKey& key ) {
+    aiQuaternion rot = anchor.mValue;
+    rot = rot.Conjugate() * key.mValue;
+
+    // q and -q are the same rotation, slerp takes the shorter way
+    if ( rot.w < 0 ) {
+        rot = aiQuaternion( -rot.w, -rot.x, -rot.y, -rot.z );
+    }
+
+    const aiVector3D axis( rot.x, rot.y, rot.z );
+    const ai_real sine = axis.Length();
+    if ( sine <= ai_real( 0. ) ) {
+        return aiVector3D();
+    }
+    return axis * ( std::atan2( sine, rot.w ) / sine );
+}
+
+// ------------------------------------------------------------------------------------------------
+// drops the keys which are reproduced by interpolating between the keys kept around them,
+// within the given tolerance per component. Works in place and returns the new number of keys.
+//
+// A key is dropped if the line from the last key kept to the key after it passes all keys
+// dropped in between. The slopes of the lines passing a key form an interval per component,
+// the intersection of these intervals is kept up to date so each key is checked in constant time.
+template <typename KeyType>
+static unsigned int DropRedundantKeys( KeyType* keys, unsigned int num_keys, ai_real tolerance ) {
+    if ( num_keys < 3 ) {
+        return num_keys;
+    }
+
+    const ai_real inf = std::numeric_limits<ai_real>::infinity();
+    aiVector3D minSlope( -inf ), maxSlope( inf );
+
+    // keys[out - 1] is the last key kept, the anchor of the lines
+    unsigned int out = 1;
+    for ( unsigned int i = 1; i + 1 < num_keys; ++i ) {
+        const KeyType& a = keys[ out - 1 ];
+        const KeyType& b = keys[ i + 1 ];
+
+        const ai_real time = static_cast<ai_real>( keys[ i ].mTime - a.mTime );
+        const ai_real span = static_cast<ai_real>( b.mTime - a.mTime );
+
+        bool redundant = time > 0 && span > time;
+        if ( redundant ) {
+            const aiVector3D offset = KeyOffset( a, keys[ i ] );
+            const aiVector3D slope = KeyOffset( a, b ) / span;
+            for ( unsigned int c = 0; c < 3; ++c ) {
+                minSlope[ c ] = std::max( minSlope[ c ], ( offset[ c ] - tolerance ) / time );
+                maxSlope[ c ] = std::min( maxSlope[ c ], ( offset[ c ] + tolerance ) / time );
+                redundant = redundant && slope[ c ] >= minSlope[ c ] && slope[ c ] <= maxSlope[ c ];
+            }
+        }
+
+        if ( !redundant ) {
+            keys[ out++ ] = keys[ i ];
+            minSlope = aiVector3D( -inf );
+            maxSlope = aiVector3D( inf );
+        }
+    }
+
+    keys[ out++ ] = keys[ num_keys - 1 ];
+    return out;
+}
+
 void FBXConverter::ConvertAnimationStack( const AnimationStack& st )
 {
     const AnimationLayerList& layers = st.Layers();
@@ -2140,6 +2261,16 @@ void FBXConverter::ConvertAnimationStack( const AnimationStack& st )
         return;
     }
 
+    const ai_real tolerance = doc.Settings().animationKeyTolerance;
+    if ( tolerance > 0 ) {
+        for ( unsigned int c = 0; c < anim->mNumChannels; c++ ) {
+            aiNodeAnim* channel = anim->mChannels[ c ];
+            channel->mNumPositionKeys = DropRedundantKeys( channel->mPositionKeys, channel->mNumPositionKeys, tolerance );
+            channel->mNumRotationKeys = DropRedundantKeys( channel->mRotationKeys, channel->mNumRotationKeys, tolerance );
+            channel->mNumScalingKeys = DropRedundantKeys( channel->mScalingKeys, channel->mNumScalingKeys, tolerance );
+        }
+    }
+
     double start_time_fps = has_local_startstop ? (CONVERT_FBX_TIME(start_time) * anim_fps) : min_time;
     double stop_time_fps = has_local_startstop ? (CONVERT_FBX_TIME(stop_time) * anim_fps) : max_time;
 
@@ -2728,16 +2859,18 @@ FBXConverter::KeyFrameListList FBXConverter::GetKeyframeList( const std::vector<
             //get values within the start/stop time window
             std::shared_ptr<KeyTimeList> Keys( new KeyTimeList() );
             std::shared_ptr<KeyValueList> Values( new KeyValueList() );
-            const size_t count = curve->GetKeys().size();
+            const KeyTimeList& curve_keys = curve->GetKeys();
+            const KeyValueList& curve_values = curve->GetValues();
+            const size_t count = curve_keys.size();
             Keys->reserve( count );
             Values->reserve( count );
             for (size_t n = 0; n < count; n++ )
             {
-                int64_t k = curve->GetKeys().at( n );
+                const int64_t k = curve_keys[ n ];
                 if ( k >= adj_start && k <= adj_stop )
                 {
                     Keys->push_back( k );
-                    Values->push_back( curve->GetValues().at( n ) );
+                    Values->push_back( curve_values[ n ] );
                 }
             }
 
@@ -2763,7 +2896,13 @@ KeyTimeList FBXConverter::GetKeyTimeList( const KeyFrameListList& inputs ) {
 
     keys.reserve( estimate );
 
-    std::vector<unsigned int> next_pos;
+    std::vector<const KeyTimeList*> times;
+    times.reserve( inputs.size() );
+    for( const KeyFrameList& kfl : inputs ) {
+        times.push_back( std::get<0>(kfl).get() );
+    }
+
+    std::vector<size_t> next_pos;
     next_pos.resize( inputs.size(), 0 );
 
     const size_t count = inputs.size();
@@ -2771,10 +2910,10 @@ KeyTimeList FBXConverter::GetKeyTimeList( const KeyFrameListList& inputs ) {
 
         int64_t min_tick = std::numeric_limits<int64_t>::max();
         for ( size_t i = 0; i < count; ++i ) {
-            const KeyFrameList& kfl = inputs[ i ];
+            const KeyTimeList& t = *times[ i ];
 
-            if ( std::get<0>(kfl)->size() > next_pos[ i ] && std::get<0>(kfl)->at( next_pos[ i ] ) < min_tick ) {
-                min_tick = std::get<0>(kfl)->at( next_pos[ i ] );
+            if ( t.size() > next_pos[ i ] && t[ next_pos[ i ] ] < min_tick ) {
+                min_tick = t[ next_pos[ i ] ];
             }
         }
 
@@ -2784,10 +2923,9 @@ KeyTimeList FBXConverter::GetKeyTimeList( const KeyFrameListList& inputs ) {
         keys.push_back( min_tick );
 
         for ( size_t i = 0; i < count; ++i ) {
-            const KeyFrameList& kfl = inputs[ i ];
-
+            const KeyTimeList& t = *times[ i ];
 
-            while ( std::get<0>(kfl)->size() > next_pos[ i ] && std::get<0>(kfl)->at( next_pos[ i ] ) == min_tick ) {
+            while ( t.size() > next_pos[ i ] && t[ next_pos[ i ] ] == min_tick ) {
                 ++next_pos[ i ];
             }
         }
@@ -2803,52 +2941,57 @@ void FBXConverter::InterpolateKeys( aiVectorKey* valOut, const KeyTimeList& keys
     ai_assert( !keys.empty() );
     ai_assert( nullptr != valOut );
 
-    std::vector<unsigned int> next_pos;
-    const size_t count( inputs.size() );
-
-    next_pos.resize( inputs.size(), 0 );
-
-    for( KeyTimeList::value_type time : keys ) {
-        ai_real result[ 3 ] = { def_value.x, def_value.y, def_value.z };
-
-        for ( size_t i = 0; i < count; ++i ) {
-            const KeyFrameList& kfl = inputs[ i ];
-
-            const size_t ksize = std::get<0>(kfl)->size();
-            if (ksize == 0) {
-                continue;
-            }
-            if ( ksize > next_pos[ i ] && std::get<0>(kfl)->at( next_pos[ i ] ) == time ) {
-                ++next_pos[ i ];
-            }
-
-            const size_t id0 = next_pos[ i ]>0 ? next_pos[ i ] - 1 : 0;
-            const size_t id1 = next_pos[ i ] == ksize ? ksize - 1 : next_pos[ i ];
+    const size_t num_keys = keys.size();
+    for ( size_t k = 0; k < num_keys; ++k ) {
+        // magic value to convert fbx times to seconds
+        valOut[ k ].mTime = CONVERT_FBX_TIME( keys[ k ] ) * anim_fps;
+        valOut[ k ].mValue = def_value;
+    }
 
-            // use lerp for interpolation
-            const KeyValueList::value_type valueA = std::get<1>(kfl)->at( id0 );
-            const KeyValueList::value_type valueB = std::get<1>(kfl)->at( id1 );
+    // the key times are sorted
+    min_time = std::min( min_time, valOut[ 0 ].mTime );
+    max_time = std::max( max_time, valOut[ num_keys - 1 ].mTime );
 
-            const KeyTimeList::value_type timeA = std::get<0>(kfl)->at( id0 );
-            const KeyTimeList::value_type timeB = std::get<0>(kfl)->at( id1 );
+    // resample the curves one after the other instead of all of them per key,
+    // each curve overrides the component it maps to. The keys enclosing each
+    // time are looked up first, then the whole curve is interpolated in one batch.
+    std::vector<ai_real> buffer( num_keys * 4 );
+    ai_real* const valuesA = &buffer[ 0 ];
+    ai_real* const valuesB = valuesA + num_keys;
+    ai_real* const offsets = valuesB + num_keys;
+    ai_real* const spans = offsets + num_keys;
 
-            const ai_real factor = timeB == timeA ? ai_real(0.) : static_cast<ai_real>( ( time - timeA ) ) / ( timeB - timeA );
-            const ai_real interpValue = static_cast<ai_real>( valueA + ( valueB - valueA ) * factor );
+    for( const KeyFrameList& kfl : inputs ) {
+        const KeyTimeList& times = *std::get<0>(kfl);
+        const KeyValueList& values = *std::get<1>(kfl);
+        const unsigned int component = std::get<2>(kfl);
 
-            result[ std::get<2>(kfl) ] = interpValue;
+        const size_t ksize = times.size();
+        if (ksize == 0) {
+            continue;
         }
 
-        // magic value to convert fbx times to seconds
-        valOut->mTime = CONVERT_FBX_TIME( time ) * anim_fps;
+        size_t next_pos = 0;
+        for ( size_t k = 0; k < num_keys; ++k ) {
+            const KeyTimeList::value_type time = keys[ k ];
+            if ( ksize > next_pos && times[ next_pos ] == time ) {
+                ++next_pos;
+            }
 
-        min_time = std::min( min_time, valOut->mTime );
-        max_time = std::max( max_time, valOut->mTime );
+            const size_t id0 = next_pos>0 ? next_pos - 1 : 0;
+            const size_t id1 = next_pos == ksize ? ksize - 1 : next_pos;
 
-        valOut->mValue.x = result[ 0 ];
-        valOut->mValue.y = result[ 1 ];
-        valOut->mValue.z = result[ 2 ];
+            valuesA[ k ] = values[ id0 ];
+            valuesB[ k ] = values[ id1 ];
+            offsets[ k ] = static_cast<ai_real>( time - times[ id0 ] );
+            spans[ k ] = static_cast<ai_real>( times[ id1 ] - times[ id0 ] );
+        }
 
-        ++valOut;
+        // use lerp for interpolation, the results are written over the first values
+        InterpolateLinear( valuesA, valuesB, offsets, spans, valuesA, num_keys );
+        for ( size_t k = 0; k < num_keys; ++k ) {
+            valOut[ k ].mValue[ component ] = valuesA[ k ];
+        }
     }
 }
 
@@ -3078,9 +3221,9 @@ void FBXConverter::TransferDataToScene()
 }
 
 // ------------------------------------------------------------------------------------------------
-void ConvertToAssimpScene(aiScene* out, const Document& doc)
+void ConvertToAssimpScene(aiScene* out, const Document& doc, ThreadPool* pool)
 {
-    FBXConverter converter(out,doc);
+    FBXConverter converter(out,doc,pool);
 }
 
 } // !FBX
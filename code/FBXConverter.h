@@ -74,8 +74,9 @@ using NodeNameCache = std::set<std::string>;
  *  Convert a FBX #Document to #aiScene
  *  @param out Empty scene to be populated
  *  @param doc Parsed FBX document 
+ *  @param pool Worker pool for the geometry conversion, may be NULL
  */
-void ConvertToAssimpScene(aiScene* out, const Document& doc);
+void ASSIMP_API ConvertToAssimpScene(aiScene* out, const Document& doc, ThreadPool* pool = NULL);
 
 /** Dummy class to encapsulate the conversion process */
 class FBXConverter {
@@ -106,7 +107,7 @@ public:
     };
 
 public:
-    FBXConverter(aiScene* out, const Document& doc);
+    FBXConverter(aiScene* out, const Document& doc, ThreadPool* pool = NULL);
     ~FBXConverter();
 
 private:
@@ -115,8 +116,10 @@ private:
     void ConvertRootNode();
 
     // ------------------------------------------------------------------------------------------------
-    // collect and assign child nodes
-    void ConvertNodes(uint64_t id, aiNode& parent, const aiMatrix4x4& parent_transform = aiMatrix4x4());
+    // collect and assign child nodes. The geometry of the nodes is only
+    // converted if read_geometry is true, see ImportSettings::geometryRootNode
+    void ConvertNodes(uint64_t id, aiNode& parent, const aiMatrix4x4& parent_transform = aiMatrix4x4(),
+        bool read_geometry = false);
 
     // ------------------------------------------------------------------------------------------------
     void ConvertLights(const Model& model, const std::string &orig_name );
@@ -170,7 +173,8 @@ private:
     void ConvertModel(const Model& model, aiNode& nd, const aiMatrix4x4& node_global_transform);
 
     // ------------------------------------------------------------------------------------------------
-    // MeshGeometry -> aiMesh, return mesh index + 1 or 0 if the conversion failed
+    // MeshGeometry -> aiMesh, returns the indices of the output meshes. Only the empty meshes
+    // and their materials are set up here, the geometry is filled in by ConvertMeshes().
     std::vector<unsigned int> ConvertMesh(const MeshGeometry& mesh, const Model& model,
         const aiMatrix4x4& node_global_transform, aiNode& nd);
 
@@ -178,17 +182,20 @@ private:
     aiMesh* SetupEmptyMesh(const MeshGeometry& mesh, aiNode& nd);
 
     // ------------------------------------------------------------------------------------------------
-    unsigned int ConvertMeshSingleMaterial(const MeshGeometry& mesh, const Model& model,
-        const aiMatrix4x4& node_global_transform, aiNode& nd);
+    // runs the geometry conversion of all meshes set up by ConvertMesh(), on the thread pool
+    // if there is one. The meshes are independent of each other and of the rest of the
+    // converter state, so the order in which they are processed doesn't matter.
+    void ConvertMeshes();
 
     // ------------------------------------------------------------------------------------------------
-    std::vector<unsigned int> ConvertMeshMultiMaterial(const MeshGeometry& mesh, const Model& model,
-        const aiMatrix4x4& node_global_transform, aiNode& nd);
+    // the following are called from ConvertMeshes() and must not touch the converter state
+    void ConvertMeshSingleMaterial(aiMesh* out_mesh, const MeshGeometry& mesh, const Model& model,
+        const aiMatrix4x4& node_global_transform);
 
     // ------------------------------------------------------------------------------------------------
-    unsigned int ConvertMeshMultiMaterial(const MeshGeometry& mesh, const Model& model,
+    void ConvertMeshMultiMaterial(aiMesh* out_mesh, const MeshGeometry& mesh, const Model& model,
         MatIndexArray::value_type index,
-        const aiMatrix4x4& node_global_transform, aiNode& nd);
+        const aiMatrix4x4& node_global_transform);
 
     // ------------------------------------------------------------------------------------------------
     static const unsigned int NO_MATERIAL_SEPARATION = /* std::numeric_limits<unsigned int>::max() */
@@ -424,6 +431,18 @@ private:
     typedef std::map<const Geometry*, std::vector<unsigned int> > MeshMap;
     MeshMap meshes_converted;
 
+    // geometry conversion of a MeshGeometry, deferred to ConvertMeshes()
+    struct MeshJob {
+        const MeshGeometry* mesh;
+        const Model* model;
+        aiMatrix4x4 node_global_transform;
+
+        // output meshes, one per material if the mesh is split by material
+        std::vector<aiMesh*> out_meshes;
+        std::vector<MatIndexArray::value_type> material_indices;
+    };
+    std::vector<MeshJob> mesh_jobs;
+
     // fixed node name -> which trafo chain components have animations?
     typedef std::map<std::string, unsigned int> NodeAnimBitMap;
     NodeAnimBitMap node_anim_chain_bits;
@@ -433,6 +452,7 @@ private:
 
     aiScene* const out;
     const FBX::Document& doc;
+    ThreadPool* const threadPool;
 };
 
 }
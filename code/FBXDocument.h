@@ -109,6 +109,11 @@ public:
         return (flags & FAILED_TO_CONSTRUCT) != 0;
     }
 
+    /** Whether the DOM object has been created by a call to Get() */
+    bool IsConstructed() const {
+        return object.get() != NULL;
+    }
+
     const Element& GetElement() const {
         return element;
     }
@@ -456,16 +461,19 @@ public:
 
     /** Get material links */
     const std::vector<const Material*>& GetMaterials() const {
+        ResolveLinks(Link_Material);
         return materials;
     }
 
     /** Get geometry links */
     const std::vector<const Geometry*>& GetGeometry() const {
+        ResolveLinks(Link_Geometry);
         return geometry;
     }
 
     /** Get node attachments */
     const std::vector<const NodeAttribute*>& GetAttributes() const {
+        ResolveLinks(Link_NodeAttribute);
         return attributes;
     }
 
@@ -473,12 +481,22 @@ public:
     bool IsNull() const;
 
 private:
-    void ResolveLinks(const Element& element, const Document& doc);
+    enum LinkClass {
+        Link_Material = 0x1,
+        Link_Geometry = 0x2,
+        Link_NodeAttribute = 0x4
+    };
+
+    // the linked objects of each class are only parsed once they are asked
+    // for, so the geometry of nodes which are not converted is never read
+    void ResolveLinks(LinkClass link) const;
 
 private:
-    std::vector<const Material*> materials;
-    std::vector<const Geometry*> geometry;
-    std::vector<const NodeAttribute*> attributes;
+    const Document& doc;
+    mutable unsigned int linksResolved;
+    mutable std::vector<const Material*> materials;
+    mutable std::vector<const Geometry*> geometry;
+    mutable std::vector<const NodeAttribute*> attributes;
 
     std::string shading;
     std::string culling;
@@ -1059,7 +1077,7 @@ private:
 };
 
 /** DOM root for a FBX file */
-class Document
+class ASSIMP_API Document
 {
 public:
     Document(const Parser& parser, const ImportSettings& settings);
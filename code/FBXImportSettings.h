@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_FBX_IMPORTSETTINGS_H
 #define INCLUDED_AI_FBX_IMPORTSETTINGS_H
 
+#include <string>
+
 namespace Assimp {
 namespace FBX {
 
@@ -62,8 +64,10 @@ struct ImportSettings
         , readLights(true)
         , readAnimations(true)
         , readWeights(true)
+        , readGeometry(true)
         , preservePivots(true)
         , optimizeEmptyAnimationCurves(true)
+        , animationKeyTolerance(0.f)
         , useLegacyEmbeddedTextureNaming(false)
     {}
 
@@ -113,6 +117,17 @@ struct ImportSettings
      *  Default value is true. */
     bool readWeights;
 
+    /** import geometry? Without geometry, neither meshes nor the
+     *  deformers and materials referenced only by them are parsed, which
+     *  leaves the node skeleton and the animations. Default value is true. */
+    bool readGeometry;
+
+    /** if not empty, geometry is only imported for the node of this name
+     *  and its descendants. The node hierarchy is always complete, but
+     *  the geometry of the remaining nodes is never parsed. Default value
+     *  is empty.*/
+    std::string geometryRootNode;
+
     /** preserve transformation pivots and offsets. Since these can
      *  not directly be represented in assimp, additional dummy
      *  nodes will be generated. Note that settings this to false
@@ -140,6 +155,11 @@ struct ImportSettings
      *  The default value is true. */
     bool optimizeEmptyAnimationCurves;
 
+    /** drop animation keys which deviate at most this much from the
+     *  interpolation of their neighbours. The default value is 0,
+     *  which keeps all keys. */
+    float animationKeyTolerance;
+
     /** use legacy naming for embedded textures eg: (*0, *1, *2)
     **/
     bool useLegacyEmbeddedTextureNaming;
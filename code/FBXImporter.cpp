@@ -133,9 +133,13 @@ void FBXImporter::SetupProperties(const Importer* pImp)
     settings.readCameras = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_CAMERAS, true);
     settings.readLights = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_LIGHTS, true);
     settings.readAnimations = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_ANIMATIONS, true);
+    settings.readWeights = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_WEIGHTS, true);
+    settings.readGeometry = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_GEOMETRY, true);
+    settings.geometryRootNode = pImp->GetPropertyString(AI_CONFIG_IMPORT_FBX_GEOMETRY_ROOT_NODE, "");
     settings.strictMode = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_STRICT_MODE, false);
     settings.preservePivots = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, true);
     settings.optimizeEmptyAnimationCurves = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_OPTIMIZE_EMPTY_ANIMATION_CURVES, true);
+    settings.animationKeyTolerance = pImp->GetPropertyFloat(AI_CONFIG_IMPORT_FBX_ANIMATION_KEY_TOLERANCE, 0.f);
     settings.useLegacyEmbeddedTextureNaming = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_EMBEDDED_TEXTURES_LEGACY_NAMING, false);
 }
 
@@ -153,42 +157,50 @@ void FBXImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOS
     // then becomes very large, too. Assimp doesn't support
     // streaming for its output data structures so the net win with
     // streaming input data would be very low.
+    // binary files are tokenized with explicit bounds, so they can be
+    // parsed in-place if the stream exposes its contents directly.
+    // The ascii tokenizer relies on a terminating zero and needs a copy.
     std::vector<char> contents;
-    contents.resize(stream->FileSize()+1);
-    stream->Read( &*contents.begin(), 1, contents.size()-1 );
-    contents[ contents.size() - 1 ] = 0;
-    const char* const begin = &*contents.begin();
+    const char* begin = nullptr;
+    size_t length = 0;
+    size_t viewSize = 0;
+    const uint8_t* view = stream->GetContiguousView(viewSize);
+    if (view && viewSize == stream->FileSize() && viewSize >= 18 &&
+            !strncmp(reinterpret_cast<const char*>(view),"Kaydara FBX Binary",18)) {
+        begin = reinterpret_cast<const char*>(view);
+        length = viewSize;
+    }
+    else {
+        contents.resize(stream->FileSize()+1);
+        stream->Read( &*contents.begin(), 1, contents.size()-1 );
+        contents[ contents.size() - 1 ] = 0;
+        begin = &*contents.begin();
+        length = contents.size();
+    }
 
     // broadphase tokenizing pass in which we identify the core
     // syntax elements of FBX (brackets, commas, key:value mappings)
-    TokenList tokens;
-    try {
-
-        bool is_binary = false;
-        if (!strncmp(begin,"Kaydara FBX Binary",18)) {
-            is_binary = true;
-            TokenizeBinary(tokens,begin,static_cast<unsigned int>(contents.size()));
-        }
-        else {
-            Tokenize(tokens,begin);
-        }
-
-        // use this information to construct a very rudimentary
-        // parse-tree representing the FBX scope structure
-        Parser parser(tokens, is_binary);
+    TokenArray tokens;
+    bool is_binary = false;
+    if (!strncmp(begin,"Kaydara FBX Binary",18)) {
+        is_binary = true;
+        TokenizeBinary(tokens,begin,static_cast<unsigned int>(length));
+    }
+    else {
+        Tokenize(tokens,begin);
+    }
 
-        // take the raw parse-tree and convert it to a FBX DOM
-        Document doc(parser,settings);
+    // use this information to construct a very rudimentary
+    // parse-tree representing the FBX scope structure. Compressed
+    // binary arrays are inflated in parallel if we got worker threads,
+    // except for geometry which might not be read
+    Parser parser(tokens, is_binary, m_threadPool, &settings);
 
-        // convert the FBX DOM to aiScene
-        ConvertToAssimpScene(pScene,doc);
+    // take the raw parse-tree and convert it to a FBX DOM
+    Document doc(parser,settings);
 
-        std::for_each(tokens.begin(),tokens.end(),Util::delete_fun<Token>());
-    }
-    catch(std::exception&) {
-        std::for_each(tokens.begin(),tokens.end(),Util::delete_fun<Token>());
-        throw;
-    }
+    // convert the FBX DOM to aiScene
+    ConvertToAssimpScene(pScene,doc,m_threadPool);
 }
 
 #endif // !ASSIMP_BUILD_NO_FBX_IMPORTER
@@ -65,6 +65,11 @@ Geometry::Geometry(uint64_t id, const Element& element, const std::string& name,
     : Object(id, element,name)
     , skin()
 {
+    // don't parse the deformers if the weights are not read anyway
+    if (!doc.Settings().readWeights) {
+        return;
+    }
+
     const std::vector<const Connection*>& conns = doc.GetConnectionsByDestinationSequenced(ID(),"Deformer");
     for(const Connection* con : conns) {
         const Skin* const sk = ProcessSimpleConnection<Skin>(*con, false, "Skin -> Geometry", element);
@@ -60,6 +60,8 @@ using namespace Util;
 // ------------------------------------------------------------------------------------------------
 Model::Model(uint64_t id, const Element& element, const Document& doc, const std::string& name)
     : Object(id,element,name)
+    , doc(doc)
+    , linksResolved(0)
     , shading("Y")
 {
     const Scope& sc = GetRequiredScope(element);
@@ -75,7 +77,6 @@ Model::Model(uint64_t id, const Element& element, const Document& doc, const std
     }
 
     props = GetPropertyTable(doc,"Model.FbxNode",element,sc);
-    ResolveLinks(element,doc);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -85,16 +86,19 @@ Model::~Model()
 }
 
 // ------------------------------------------------------------------------------------------------
-void Model::ResolveLinks(const Element& element, const Document& doc)
+void Model::ResolveLinks(LinkClass link) const
 {
-    const char* const arr[] = {"Geometry","Material","NodeAttribute"};
+    if (linksResolved & link) {
+        return;
+    }
+    linksResolved |= link;
 
-    // resolve material
-    const std::vector<const Connection*>& conns = doc.GetConnectionsByDestinationSequenced(ID(),arr, 3);
+    const Element& element = SourceElement();
+    const char* const classname = link == Link_Material ? "Material" : (link == Link_Geometry ? "Geometry" : "NodeAttribute");
 
-    materials.reserve(conns.size());
-    geometry.reserve(conns.size());
-    attributes.reserve(conns.size());
+    // only the connections from objects of the requested class are followed,
+    // the others stay unparsed
+    const std::vector<const Connection*>& conns = doc.GetConnectionsByDestinationSequenced(ID(),classname);
     for(const Connection* con : conns) {
 
         // material and geometry links should be Object-Object connections
@@ -108,26 +112,24 @@ void Model::ResolveLinks(const Element& element, const Document& doc)
             continue;
         }
 
-        const Material* const mat = dynamic_cast<const Material*>(ob);
-        if(mat) {
-            materials.push_back(mat);
-            continue;
+        if (link == Link_Material) {
+            if (const Material* const mat = dynamic_cast<const Material*>(ob)) {
+                materials.push_back(mat);
+                continue;
+            }
         }
-
-        const Geometry* const geo = dynamic_cast<const Geometry*>(ob);
-        if(geo) {
-            geometry.push_back(geo);
-            continue;
+        else if (link == Link_Geometry) {
+            if (const Geometry* const geo = dynamic_cast<const Geometry*>(ob)) {
+                geometry.push_back(geo);
+                continue;
+            }
         }
-
-        const NodeAttribute* const att = dynamic_cast<const NodeAttribute*>(ob);
-        if(att) {
+        else if (const NodeAttribute* const att = dynamic_cast<const NodeAttribute*>(ob)) {
             attributes.push_back(att);
             continue;
         }
 
         DOMWarning("source object for model link is neither Material, NodeAttribute nor Geometry, ignoring",&element);
-        continue;
     }
 }
 
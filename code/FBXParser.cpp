@@ -55,12 +55,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXTokenizer.h"
 #include "FBXParser.h"
 #include "FBXUtil.h"
+#include "FBXImportSettings.h"
+#include "ThreadPool.h"
 
 #include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
 #include <assimp/ByteSwapper.h>
 
 #include <iostream>
+#include <algorithm>
+#include <functional>
 
 using namespace Assimp;
 using namespace Assimp::FBX;
@@ -116,7 +120,13 @@ namespace FBX {
 // ------------------------------------------------------------------------------------------------
 Element::Element(const Token& key_token, Parser& parser)
 : key_token(key_token)
+, parser(parser)
+, compound()
 {
+    // the data tokens precede any nested scope, so they are contiguous in the pool
+    std::vector<TokenPtr>& pool = parser.element_tokens;
+    const size_t first = pool.size();
+
     TokenPtr n = NULL;
     do {
         n = parser.AdvanceToNextToken();
@@ -125,7 +135,7 @@ Element::Element(const Token& key_token, Parser& parser)
         }
 
         if (n->Type() == TokenType_DATA) {
-            tokens.push_back(n);
+            pool.push_back(n);
 			TokenPtr prev = n;
             n = parser.AdvanceToNextToken();
             if(!n) {
@@ -136,7 +146,7 @@ Element::Element(const Token& key_token, Parser& parser)
 
 			// some exporters are missing a comma on the next line
 			if (ty == TokenType_DATA && prev->Type() == TokenType_DATA && (n->Line() == prev->Line() + 1)) {
-				tokens.push_back(n);
+				pool.push_back(n);
 				continue;
 			}
 
@@ -146,7 +156,8 @@ Element::Element(const Token& key_token, Parser& parser)
         }
 
         if (n->Type() == TokenType_OPEN_BRACKET) {
-            compound.reset(new Scope(parser));
+            tokens = TokenList(pool, first, pool.size() - first);
+            compound = new (parser.AllocateScope()) Scope(parser);
 
             // current token should be a TOK_CLOSE_BRACKET
             n = parser.CurrentToken();
@@ -161,12 +172,18 @@ Element::Element(const Token& key_token, Parser& parser)
         }
     }
     while(n->Type() != TokenType_KEY && n->Type() != TokenType_CLOSE_BRACKET);
+
+    tokens = TokenList(pool, first, pool.size() - first);
 }
 
 // ------------------------------------------------------------------------------------------------
 Element::~Element()
 {
-     // no need to delete tokens, they are owned by the parser
+    // no need to delete tokens, they are owned by the parser. The same
+    // applies to the storage of the compound scope.
+    if (compound) {
+        compound->~Scope();
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -191,7 +208,7 @@ Scope::Scope(Parser& parser,bool topLevel)
         }
 
         const std::string& str = n->StringContents();
-        elements.insert(ElementMap::value_type(str,new_Element(*n,parser)));
+        elements.insert(ElementMap::value_type(str,new (parser.AllocateElement()) Element(*n,parser)));
 
         // Element() should stop at the next Key token (or right after a Close token)
         n = parser.CurrentToken();
@@ -207,19 +224,33 @@ Scope::Scope(Parser& parser,bool topLevel)
 // ------------------------------------------------------------------------------------------------
 Scope::~Scope()
 {
+    // the storage is owned by the parser
     for(ElementMap::value_type& v : elements) {
-        delete v.second;
+        v.second->~Element();
     }
 }
 
 // ------------------------------------------------------------------------------------------------
-Parser::Parser (const TokenList& tokens, bool is_binary)
+Parser::Parser (const TokenArray& tokens, bool is_binary, ThreadPool* pool, const ImportSettings* settings)
 : tokens(tokens)
 , last()
 , current()
 , cursor(tokens.begin())
 , is_binary(is_binary)
 {
+    // size the pool up front, so it never needs to be reallocated
+    size_t num_data_tokens = 0;
+    for (TokenArray::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+        num_data_tokens += (*it).Type() == TokenType_DATA ? 1 : 0;
+    }
+    element_tokens.reserve(num_data_tokens);
+
+    if (is_binary && pool) {
+        // geometry which is not converted is never read, see ImportSettings::readGeometry
+        const bool skip_geometry = settings && (!settings->readGeometry || !settings->geometryRootNode.empty());
+        InflateBinaryDataArrays(pool, skip_geometry);
+    }
+
     root.reset(new Scope(*this,true));
 }
 
@@ -236,11 +267,27 @@ TokenPtr Parser::AdvanceToNextToken()
     if (cursor == tokens.end()) {
         current = NULL;
     } else {
-        current = *cursor++;
+        current = &*cursor++;
     }
     return current;
 }
 
+// ------------------------------------------------------------------------------------------------
+void* Parser::AllocateElement()
+{
+    // the storage is reserved before the element is constructed, so
+    // nested elements may be allocated while the constructor runs
+    element_storage.emplace_back();
+    return &element_storage.back();
+}
+
+// ------------------------------------------------------------------------------------------------
+void* Parser::AllocateScope()
+{
+    scope_storage.emplace_back();
+    return &scope_storage.back();
+}
+
 // ------------------------------------------------------------------------------------------------
 TokenPtr Parser::CurrentToken() const
 {
@@ -515,77 +562,96 @@ void ReadBinaryDataArrayHead(const char*& data, const char* end, char& type, uin
 
 
 // ------------------------------------------------------------------------------------------------
-// read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header)
-void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
-    std::vector<char>& buff,
-    const Element& /*el*/)
+// decompress zlib/deflate data, next comes ZIP head (0x78 0x01)
+// see http://www.ietf.org/rfc/rfc1950.txt
+void InflateBinaryData(const char* data, uint32_t comp_len, char* out, uint32_t full_length)
 {
-    BE_NCONST uint32_t encmode = SafeParse<uint32_t>(data, end);
-    AI_SWAP4(encmode);
-    data += 4;
+    z_stream zstream;
+    zstream.opaque = Z_NULL;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree  = Z_NULL;
+    zstream.data_type = Z_BINARY;
 
-    // next comes the compressed length
-    BE_NCONST uint32_t comp_len = SafeParse<uint32_t>(data, end);
-    AI_SWAP4(comp_len);
-    data += 4;
+    // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
+    if(Z_OK != inflateInit(&zstream)) {
+        ParseError("failure initializing zlib");
+    }
 
-    ai_assert(data + comp_len == end);
+    zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(data) );
+    zstream.avail_in  = comp_len;
 
-    // determine the length of the uncompressed data by looking at the type signature
-    uint32_t stride = 0;
+    zstream.avail_out = static_cast<uInt>(full_length);
+    zstream.next_out = reinterpret_cast<Bytef*>(out);
+    const int ret = inflate(&zstream, Z_FINISH);
+
+    // terminate zlib
+    inflateEnd(&zstream);
+
+    if (ret != Z_STREAM_END && ret != Z_OK) {
+        ParseError("failure decompressing compressed data section");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// get the element size of a binary data array from its type signature, 0 for unknown types
+uint32_t BinaryDataArrayStride(char type)
+{
     switch(type)
     {
         case 'f':
         case 'i':
-            stride = 4;
-            break;
+            return 4;
 
         case 'd':
         case 'l':
-            stride = 8;
-            break;
+            return 8;
 
         default:
-            ai_assert(false);
+            return 0;
     };
+}
+
+// ------------------------------------------------------------------------------------------------
+// read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header).
+// Returns the uncompressed data, which is either stored in buff or owned by the parser.
+const char* ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
+    std::vector<char>& buff,
+    const Element& el)
+{
+    BE_NCONST uint32_t encmode = SafeParse<uint32_t>(data, end);
+    AI_SWAP4(encmode);
+    data += 4;
+
+    // next comes the compressed length
+    BE_NCONST uint32_t comp_len = SafeParse<uint32_t>(data, end);
+    AI_SWAP4(comp_len);
+    data += 4;
+
+    ai_assert(data + comp_len == end);
+
+    // determine the length of the uncompressed data by looking at the type signature
+    const uint32_t stride = BinaryDataArrayStride(type);
+    ai_assert(stride);
 
     const uint32_t full_length = stride * count;
-    buff.resize(full_length);
 
     if(encmode == 0) {
         ai_assert(full_length == comp_len);
 
         // plain data, no compression
-        std::copy(data, end, buff.begin());
+        buff.assign(data, end);
     }
     else if(encmode == 1) {
-        // zlib/deflate, next comes ZIP head (0x78 0x01)
-        // see http://www.ietf.org/rfc/rfc1950.txt
-
-        z_stream zstream;
-        zstream.opaque = Z_NULL;
-        zstream.zalloc = Z_NULL;
-        zstream.zfree  = Z_NULL;
-        zstream.data_type = Z_BINARY;
-
-        // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-        if(Z_OK != inflateInit(&zstream)) {
-            ParseError("failure initializing zlib");
+        // the array is always the first token of its element
+        const char* inflated = el.GetParser().GetInflatedData(*el.Tokens()[0]);
+        if (inflated) {
+            // decompressed up front by the parser
+            data += comp_len;
+            return inflated;
         }
 
-        zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(data) );
-        zstream.avail_in  = comp_len;
-
-        zstream.avail_out = static_cast<uInt>(buff.size());
-        zstream.next_out = reinterpret_cast<Bytef*>(&*buff.begin());
-        const int ret = inflate(&zstream, Z_FINISH);
-
-        if (ret != Z_STREAM_END && ret != Z_OK) {
-            ParseError("failure decompressing compressed data section");
-        }
-
-        // terminate zlib
-        inflateEnd(&zstream);
+        buff.resize(full_length);
+        InflateBinaryData(data, comp_len, &buff[0], full_length);
     }
 #ifdef ASSIMP_BUILD_DEBUG
     else {
@@ -596,10 +662,82 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
 
     data += comp_len;
     ai_assert(data == end);
+    return buff.empty() ? NULL : &buff[0];
 }
 
 } // !anon
 
+// ------------------------------------------------------------------------------------------------
+void Parser::InflateBinaryDataArrays(ThreadPool* pool, bool skip_geometry)
+{
+    // find the compressed arrays and lay out their uncompressed data,
+    // the token layout has been checked by the tokenizer. The objects
+    // are the elements at depth 1, in the Objects scope.
+    size_t total = 0;
+    unsigned int depth = 0;
+    bool in_geometry = false;
+    for (TokenArray::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+        const Token& t = *it;
+        if (t.Type() == TokenType_OPEN_BRACKET) {
+            ++depth;
+        }
+        else if (t.Type() == TokenType_CLOSE_BRACKET) {
+            --depth;
+        }
+        else if (t.Type() == TokenType_KEY && depth == 1) {
+            in_geometry = skip_geometry && t.end() - t.begin() == 8 && !strncmp(t.begin(), "Geometry", 8);
+        }
+
+        if (in_geometry || t.Type() != TokenType_DATA || static_cast<size_t>(t.end() - t.begin()) < 13) {
+            continue;
+        }
+
+        const uint32_t stride = BinaryDataArrayStride(*t.begin());
+        if (!stride) {
+            continue;
+        }
+
+        BE_NCONST uint32_t count = SafeParse<uint32_t>(t.begin() + 1, t.end());
+        AI_SWAP4(count);
+        BE_NCONST uint32_t encmode = SafeParse<uint32_t>(t.begin() + 5, t.end());
+        AI_SWAP4(encmode);
+        if (encmode != 1 || !count) {
+            continue;
+        }
+
+        const InflatedArray a = { &t, total, stride * count };
+        inflated_arrays.push_back(a);
+        total = (total + a.length + 7) & ~static_cast<size_t>(7);
+    }
+
+    if (inflated_arrays.empty()) {
+        return;
+    }
+    inflated_data.resize(total);
+
+    pool->ParallelFor(0, static_cast<unsigned int>(inflated_arrays.size()), [this](unsigned int i) {
+        const InflatedArray& a = inflated_arrays[i];
+        BE_NCONST uint32_t comp_len = SafeParse<uint32_t>(a.token->begin() + 9, a.token->end());
+        AI_SWAP4(comp_len);
+
+        InflateBinaryData(a.token->begin() + 13, comp_len, &inflated_data[a.offset], a.length);
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* Parser::GetInflatedData(const Token& token) const
+{
+    struct TokenLess {
+        bool operator () (const InflatedArray& a, TokenPtr t) const {
+            return std::less<TokenPtr>()(a.token, t);
+        }
+    };
+
+    std::vector<InflatedArray>::const_iterator it = std::lower_bound(inflated_arrays.begin(),
+        inflated_arrays.end(), &token, TokenLess());
+    return it != inflated_arrays.end() && it->token == &token ? &inflated_data[it->offset] : NULL;
+}
+
 
 // ------------------------------------------------------------------------------------------------
 // read an array of float3 tuples
@@ -632,16 +770,15 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * (type == 'd' ? 8 : 4));
 
         const uint32_t count3 = count / 3;
         out.reserve(count3);
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
+            const double* d = reinterpret_cast<const double*>(array);
             for (unsigned int i = 0; i < count3; ++i, d += 3) {
                 out.push_back(aiVector3D(static_cast<float>(d[0]),
                     static_cast<float>(d[1]),
@@ -656,7 +793,7 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
             }*/
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
+            const float* f = reinterpret_cast<const float*>(array);
             for (unsigned int i = 0; i < count3; ++i, f += 3) {
                 out.push_back(aiVector3D(f[0],f[1],f[2]));
             }
@@ -719,16 +856,15 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * (type == 'd' ? 8 : 4));
 
         const uint32_t count4 = count / 4;
         out.reserve(count4);
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
+            const double* d = reinterpret_cast<const double*>(array);
             for (unsigned int i = 0; i < count4; ++i, d += 4) {
                 out.push_back(aiColor4D(static_cast<float>(d[0]),
                     static_cast<float>(d[1]),
@@ -737,7 +873,7 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
             }
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
+            const float* f = reinterpret_cast<const float*>(array);
             for (unsigned int i = 0; i < count4; ++i, f += 4) {
                 out.push_back(aiColor4D(f[0],f[1],f[2],f[3]));
             }
@@ -798,23 +934,22 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * (type == 'd' ? 8 : 4));
 
         const uint32_t count2 = count / 2;
         out.reserve(count2);
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
+            const double* d = reinterpret_cast<const double*>(array);
             for (unsigned int i = 0; i < count2; ++i, d += 2) {
                 out.push_back(aiVector2D(static_cast<float>(d[0]),
                     static_cast<float>(d[1])));
             }
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
+            const float* f = reinterpret_cast<const float*>(array);
             for (unsigned int i = 0; i < count2; ++i, f += 2) {
                 out.push_back(aiVector2D(f[0],f[1]));
             }
@@ -870,14 +1005,13 @@ void ParseVectorDataArray(std::vector<int>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * 4);
 
         out.reserve(count);
 
-        const int32_t* ip = reinterpret_cast<const int32_t*>(&buff[0]);
+        const int32_t* ip = reinterpret_cast<const int32_t*>(array);
         for (unsigned int i = 0; i < count; ++i, ++ip) {
             BE_NCONST int32_t val = *ip;
             AI_SWAP4(val);
@@ -928,19 +1062,18 @@ void ParseVectorDataArray(std::vector<float>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * (type == 'd' ? 8 : 4));
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
+            const double* d = reinterpret_cast<const double*>(array);
             for (unsigned int i = 0; i < count; ++i, ++d) {
                 out.push_back(static_cast<float>(*d));
             }
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
+            const float* f = reinterpret_cast<const float*>(array);
             for (unsigned int i = 0; i < count; ++i, ++f) {
                 out.push_back(*f);
             }
@@ -990,14 +1123,13 @@ void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * 4);
 
         out.reserve(count);
 
-        const int32_t* ip = reinterpret_cast<const int32_t*>(&buff[0]);
+        const int32_t* ip = reinterpret_cast<const int32_t*>(array);
         for (unsigned int i = 0; i < count; ++i, ++ip) {
             BE_NCONST int32_t val = *ip;
             if(val < 0) {
@@ -1055,14 +1187,13 @@ void ParseVectorDataArray(std::vector<uint64_t>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * 8);
 
         out.reserve(count);
 
-        const uint64_t* ip = reinterpret_cast<const uint64_t*>(&buff[0]);
+        const uint64_t* ip = reinterpret_cast<const uint64_t*>(array);
         for (unsigned int i = 0; i < count; ++i, ++ip) {
             BE_NCONST uint64_t val = *ip;
             AI_SWAP8(val);
@@ -1113,14 +1244,13 @@ void ParseVectorDataArray(std::vector<int64_t>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        const char* array = ReadBinaryDataArray(type, count, data, end, buff, el);
 
         ai_assert(data == end);
-        ai_assert(buff.size() == count * 8);
 
         out.reserve(count);
 
-        const int64_t* ip = reinterpret_cast<const int64_t*>(&buff[0]);
+        const int64_t* ip = reinterpret_cast<const int64_t*>(array);
         for (unsigned int i = 0; i < count; ++i, ++ip) {
             BE_NCONST int64_t val = *ip;
             AI_SWAP8(val);
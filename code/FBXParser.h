@@ -49,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 #include <map>
 #include <memory>
+#include <deque>
+#include <type_traits>
 #include <assimp/LogAux.h>
 #include <assimp/fast_atof.h>
 
@@ -56,10 +58,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXTokenizer.h"
 
 namespace Assimp {
+
+class ThreadPool;
+
 namespace FBX {
 
 class Scope;
 class Parser;
+struct ImportSettings;
 class Element;
 
 // XXX should use C++11's unique_ptr - but assimp's need to keep working with 03
@@ -68,9 +74,6 @@ typedef std::fbx_unordered_multimap< std::string, Element* > ElementMap;
 
 typedef std::pair<ElementMap::const_iterator,ElementMap::const_iterator> ElementCollection;
 
-#   define new_Scope new Scope
-#   define new_Element new Element
-
 
 /** FBX data entity that consists of a key:value tuple.
  *
@@ -90,7 +93,7 @@ public:
     ~Element();
 
     const Scope* Compound() const {
-        return compound.get();
+        return compound;
     }
 
     const Token& KeyToken() const {
@@ -101,10 +104,19 @@ public:
         return tokens;
     }
 
+    const Parser& GetParser() const {
+        return parser;
+    }
+
 private:
     const Token& key_token;
+    const Parser& parser;
+
+    // the data tokens, they are stored in the parser's token pool
     TokenList tokens;
-    std::unique_ptr<Scope> compound;
+
+    // allocated by Parser::AllocateScope()
+    Scope* compound;
 };
 
 /** FBX data entity that consists of a 'scope', a collection
@@ -154,12 +166,19 @@ private:
 
 /** FBX parsing class, takes a list of input tokens and generates a hierarchy
  *  of nested #Scope instances, representing the fbx DOM.*/
-class Parser
+class ASSIMP_API Parser
 {
 public:
-    /** Parse given a token list. Does not take ownership of the tokens -
-     *  the objects must persist during the entire parser lifetime */
-    Parser (const TokenList& tokens,bool is_binary);
+    /** Parse given a token array. Does not take ownership of the tokens -
+     *  the objects must persist during the entire parser lifetime.
+     *
+     *  If a thread pool is given, all compressed binary data arrays are
+     *  decompressed up front, in parallel. Otherwise this happens one at
+     *  a time when the arrays are read. If the import settings restrict
+     *  the geometry which is read, the arrays of the geometry objects are
+     *  left to be decompressed when they are read. */
+    Parser (const TokenArray& tokens,bool is_binary, ThreadPool* pool = NULL,
+        const ImportSettings* settings = NULL);
     ~Parser();
 
     const Scope& GetRootScope() const {
@@ -170,6 +189,10 @@ public:
         return is_binary;
     }
 
+    /** Returns the decompressed contents of a binary data array token or
+     *  NULL if it wasn't decompressed by the constructor. */
+    const char* GetInflatedData(const Token& token) const;
+
 private:
     friend class Scope;
     friend class Element;
@@ -178,13 +201,40 @@ private:
     TokenPtr LastToken() const;
     TokenPtr CurrentToken() const;
 
+    // uninitialized storage for an element or a scope, to be constructed
+    // with placement new. The storage lives as long as the parser.
+    void* AllocateElement();
+    void* AllocateScope();
+
+    void InflateBinaryDataArrays(ThreadPool* pool, bool skip_geometry);
+
 private:
-    const TokenList& tokens;
+    const TokenArray& tokens;
 
     TokenPtr last, current;
-    TokenList::const_iterator cursor;
+    TokenArray::const_iterator cursor;
+
+    // pool for the data tokens of all elements, see #TokenList
+    std::vector<TokenPtr> element_tokens;
+
+    // elements and scopes are stored in blocks rather than allocated one by
+    // one. The storage must be declared before the root scope, which
+    // destroys the tree in it.
+    std::deque< std::aligned_storage<sizeof(Element), alignof(Element)>::type > element_storage;
+    std::deque< std::aligned_storage<sizeof(Scope), alignof(Scope)>::type > scope_storage;
+
     std::unique_ptr<Scope> root;
 
+    // decompressed binary data arrays, sorted by the address of their token.
+    // Their data is stored in inflated_data at an offset aligned to 8 bytes.
+    struct InflatedArray {
+        TokenPtr token;
+        size_t offset;
+        uint32_t length;
+    };
+    std::vector<InflatedArray> inflated_arrays;
+    std::vector<char> inflated_data;
+
     const bool is_binary;
 };
 
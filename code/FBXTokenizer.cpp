@@ -95,7 +95,7 @@ AI_WONT_RETURN void TokenizeError(const std::string& message, unsigned int line,
 
 // process a potential data token up to 'cur', adding it to 'output_tokens'.
 // ------------------------------------------------------------------------------------------------
-void ProcessDataToken( TokenList& output_tokens, const char*& start, const char*& end,
+void ProcessDataToken( TokenArray& output_tokens, const char*& start, const char*& end,
                       unsigned int line,
                       unsigned int column,
                       TokenType type = TokenType_DATA,
@@ -120,7 +120,7 @@ void ProcessDataToken( TokenList& output_tokens, const char*& start, const char*
             TokenizeError("non-terminated double quotes", line, column);
         }
 
-        output_tokens.push_back(new_Token(start,end + 1,type,line,column));
+        output_tokens.emplace_back(start,end + 1,type,line,column);
     }
     else if (must_have_token) {
         TokenizeError("unexpected character, expected data token", line, column);
@@ -132,7 +132,7 @@ void ProcessDataToken( TokenList& output_tokens, const char*& start, const char*
 }
 
 // ------------------------------------------------------------------------------------------------
-void Tokenize(TokenList& output_tokens, const char* input)
+void Tokenize(TokenArray& output_tokens, const char* input)
 {
     ai_assert(input);
 
@@ -187,19 +187,19 @@ void Tokenize(TokenList& output_tokens, const char* input)
 
         case '{':
             ProcessDataToken(output_tokens,token_begin,token_end, line, column);
-            output_tokens.push_back(new_Token(cur,cur+1,TokenType_OPEN_BRACKET,line,column));
+            output_tokens.emplace_back(cur,cur+1,TokenType_OPEN_BRACKET,line,column);
             continue;
 
         case '}':
             ProcessDataToken(output_tokens,token_begin,token_end,line,column);
-            output_tokens.push_back(new_Token(cur,cur+1,TokenType_CLOSE_BRACKET,line,column));
+            output_tokens.emplace_back(cur,cur+1,TokenType_CLOSE_BRACKET,line,column);
             continue;
 
         case ',':
             if (pending_data_token) {
                 ProcessDataToken(output_tokens,token_begin,token_end,line,column,TokenType_DATA,true);
             }
-            output_tokens.push_back(new_Token(cur,cur+1,TokenType_COMMA,line,column));
+            output_tokens.emplace_back(cur,cur+1,TokenType_COMMA,line,column);
             continue;
 
         case ':':
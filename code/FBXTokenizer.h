@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_FBX_TOKENIZER_H
 
 #include "FBXCompileConfig.h"
+#include <assimp/defs.h>
 #include <assimp/ai_assert.h>
 #include <vector>
 #include <string>
@@ -83,7 +84,7 @@ enum TokenType
  *  classified by the #TokenType enumerated types.
  *
  *  Offers iterator protocol. Tokens are immutable. */
-class Token
+class ASSIMP_API Token
 {
 private:
     static const unsigned int BINARY_MARKER = static_cast<unsigned int>(-1);
@@ -153,11 +154,63 @@ private:
     const unsigned int column;
 };
 
-// XXX should use C++11's unique_ptr - but assimp's need to keep working with 03
 typedef const Token* TokenPtr;
-typedef std::vector< TokenPtr > TokenList;
 
-#define new_Token new Token
+/** All tokens of a file, stored by value in one contiguous block instead of
+ *  one heap allocation per token. #TokenPtr's refer to the tokens by address,
+ *  so the array must not be modified once tokenization is complete. */
+typedef std::vector< Token > TokenArray;
+
+/** A list of tokens, stored as a range in a pool of #TokenPtr's which is
+ *  shared by many lists. This is used for the data tokens of the elements of
+ *  a file, which would otherwise need a std::vector each.
+ *
+ *  Offers the read-only part of the std::vector interface. The pool may grow
+ *  while lists refer to it, but must outlive them. */
+class TokenList
+{
+public:
+    typedef const TokenPtr* const_iterator;
+
+    TokenList()
+    : pool()
+    , first()
+    , count() {
+        // empty
+    }
+
+    TokenList(const std::vector< TokenPtr >& pool, size_t first, size_t count)
+    : pool(&pool)
+    , first(first)
+    , count(count) {
+        ai_assert(first + count <= pool.size());
+    }
+
+    const_iterator begin() const {
+        return count ? &(*pool)[first] : NULL;
+    }
+
+    const_iterator end() const {
+        return begin() + count;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return !count;
+    }
+
+    TokenPtr operator[] (size_t index) const {
+        ai_assert(index < count);
+        return (*pool)[first + index];
+    }
+
+private:
+    const std::vector< TokenPtr >* pool;
+    size_t first, count;
+};
 
 
 /** Main FBX tokenizer function. Transform input buffer into a list of preprocessed tokens.
@@ -167,7 +220,7 @@ typedef std::vector< TokenPtr > TokenList;
  * @param output_tokens Receives a list of all tokens in the input data.
  * @param input_buffer Textual input buffer to be processed, 0-terminated.
  * @throw DeadlyImportError if something goes wrong */
-void Tokenize(TokenList& output_tokens, const char* input);
+void ASSIMP_API Tokenize(TokenArray& output_tokens, const char* input);
 
 
 /** Tokenizer function for binary FBX files.
@@ -178,7 +231,7 @@ void Tokenize(TokenList& output_tokens, const char* input);
  * @param input_buffer Binary input buffer to be processed.
  * @param length Length of input buffer, in bytes. There is no 0-terminal.
  * @throw DeadlyImportError if something goes wrong */
-void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int length);
+void ASSIMP_API TokenizeBinary(TokenArray& output_tokens, const char* input, unsigned int length);
 
 
 } // ! FBX
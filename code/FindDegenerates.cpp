@@ -63,7 +63,8 @@ static void updateSceneGraph(aiNode* pNode, unsigned const index);
 // Constructor to be privately used by Importer
 FindDegeneratesProcess::FindDegeneratesProcess()
 : mConfigRemoveDegenerates( false )
-, mConfigCheckAreaOfTriangle( false ){
+, mConfigCheckAreaOfTriangle( false )
+, mMeshRemoved() {
     // empty
 }
 
@@ -90,15 +91,43 @@ void FindDegeneratesProcess::SetupProperties(const Importer* pImp) {
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FindDegeneratesProcess::Execute( aiScene* pScene) {
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FindDegeneratesProcess::IsMeshLocal() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint FindDegeneratesProcess::GetMeshFootprint() const {
+    return MeshFootprint( MeshComponent_Positions | MeshComponent_Faces,
+        MeshComponent_Faces | MeshComponent_MeshList );
+}
+
+// ------------------------------------------------------------------------------------------------
+void FindDegeneratesProcess::BeginMeshPass( aiScene* pScene) {
     ASSIMP_LOG_DEBUG("FindDegeneratesProcess begin");
-    for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
-    {
-        //Do not process point cloud, ExecuteOnMesh works only with faces data
-        if ((pScene->mMeshes[i]->mPrimitiveTypes != aiPrimitiveType::aiPrimitiveType_POINT) && ExecuteOnMesh(pScene->mMeshes[i])) {
-            removeMesh(pScene, i);
-            --i; //the current i is removed, do not skip the next one
+    mMeshRemoved.assign( pScene->mNumMeshes, 0 );
+}
+
+// ------------------------------------------------------------------------------------------------
+void FindDegeneratesProcess::ExecuteOnMesh( aiMesh* mesh, unsigned int meshIndex) {
+    //Do not process point cloud, ExecuteOnMesh works only with faces data
+    if ( mesh->mPrimitiveTypes != aiPrimitiveType::aiPrimitiveType_POINT ) {
+        mMeshRemoved[ meshIndex ] = ExecuteOnMesh( mesh );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void FindDegeneratesProcess::EndMeshPass( aiScene* pScene) {
+    // remove back to front, so the indices of the pending meshes stay valid
+    for ( unsigned int i = pScene->mNumMeshes; i-- > 0; ) {
+        if ( mMeshRemoved[ i ] ) {
+            removeMesh( pScene, i );
         }
     }
+    mMeshRemoved.clear();
     ASSIMP_LOG_DEBUG("FindDegeneratesProcess finished");
 }
 
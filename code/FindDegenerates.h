@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include <assimp/mesh.h>
+#include <vector>
 
 class FindDegeneratesProcessTest;
 namespace Assimp    {
@@ -77,6 +78,15 @@ public:
     ///@returns true if the current mesh should be deleted, false otherwise
     bool ExecuteOnMesh( aiMesh* mesh);
 
+    // -------------------------------------------------------------------
+    // The step works on each mesh independently, see BaseProcess.
+    // Meshes full of degenerates are removed in EndMeshPass().
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* mesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
+
     // -------------------------------------------------------------------
     /// @brief Enable the instant removal of degenerated primitives
     /// @param enabled  true for enabled.
@@ -102,6 +112,8 @@ private:
     bool mConfigRemoveDegenerates;
     //! Configuration option: check for area
     bool mConfigCheckAreaOfTriangle;
+    //! Per-mesh result of the current pass: mesh to be removed or not
+    std::vector<unsigned char> mMeshRemoved;
 };
 
 inline
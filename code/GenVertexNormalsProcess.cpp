@@ -52,13 +52,172 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include <assimp/Exceptional.h>
 #include <assimp/qnan.h>
+#include "ThreadPool.h"
+#include "VertexTriangleAdjacency.h"
+#include "simd.h"
+#include <algorithm>
+#include <functional>
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Computes the normal of each face from its first, second and last vertex. Points and lines
+// get a qnan normal.
+void computeFaceNormals(const aiMesh* pMesh, aiVector3D* faceNormals, ThreadPool* pool)
+{
+    const ai_real qnan = std::numeric_limits<ai_real>::quiet_NaN();
+
+    // the corners are gathered chunk by chunk, so the normals can be computed in bulk
+    static const unsigned int ChunkSize = 1024;
+    const unsigned int numChunks = (pMesh->mNumFaces + ChunkSize - 1) / ChunkSize;
+    const std::function<void(unsigned int)> computeChunk = [&](unsigned int chunk) {
+        std::vector<aiVector3D> corners(3 * ChunkSize);
+        const unsigned int begin = chunk * ChunkSize;
+        const unsigned int count = std::min(pMesh->mNumFaces - begin, ChunkSize);
+        for (unsigned int a = 0; a < count; ++a) {
+            const aiFace& face = pMesh->mFaces[begin + a];
+            if (face.mNumIndices >= 3) {
+                corners[a] = pMesh->mVertices[face.mIndices[0]];
+                corners[ChunkSize + a] = pMesh->mVertices[face.mIndices[1]];
+                corners[2 * ChunkSize + a] = pMesh->mVertices[face.mIndices[face.mNumIndices - 1]];
+            }
+        }
+        ComputeTriangleNormals(&corners[0], &corners[ChunkSize], &corners[2 * ChunkSize], faceNormals + begin, count);
+
+        for (unsigned int a = 0; a < count; ++a) {
+            if (pMesh->mFaces[begin + a].mNumIndices < 3) {
+                // either a point or a line -> no normal vector
+                faceNormals[begin + a] = aiVector3D(qnan);
+            }
+        }
+    };
+
+    if (pool) {
+        pool->ParallelFor(0, numChunks, computeChunk);
+    } else {
+        for (unsigned int chunk = 0; chunk < numChunks; ++chunk) {
+            computeChunk(chunk);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether any vertex is referenced by more than one face corner
+bool hasSharedVertices(const VertexTriangleAdjacency& adj)
+{
+    for (unsigned int i = 0; i < adj.mNumVertices; ++i) {
+        if (adj.mOffsetTable[i + 1] - adj.mOffsetTable[i] > 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes the normals of a mesh whose vertices are shared by several faces. The positions are
+// welded within posEpsilon once, so vertices split at uv seams are smoothed across them, and the
+// faces of each group of welded vertices are taken from the vertex-face adjacency. With an angle
+// limit, the faces are compared to the mean normal of the vertex's own faces.
+void genIndexedVertexNormals(const aiMesh* pMesh, const aiVector3D* faceNormals,
+    const VertexTriangleAdjacency& adj, const SpatialSort& vertexFinder, ai_real posEpsilon,
+    ai_real maxAngle, ThreadPool* pool, aiVector3D* out)
+{
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // one group id per vertex, the vertices of group g are groupVertices[groupOffsets[g]]
+    // to groupVertices[groupOffsets[g+1]-1]
+    std::vector<unsigned int> groupOf;
+    const unsigned int numGroups = vertexFinder.GenerateMappingTable(groupOf, posEpsilon);
+    std::vector<unsigned int> groupOffsets(numGroups + 1, 0), groupVertices(numVertices);
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        ++groupOffsets[groupOf[v] + 1];
+    }
+    for (unsigned int g = 0; g < numGroups; ++g) {
+        groupOffsets[g + 1] += groupOffsets[g];
+    }
+    {
+        std::vector<unsigned int> next(groupOffsets.begin(), groupOffsets.end() - 1);
+        for (unsigned int v = 0; v < numVertices; ++v) {
+            groupVertices[next[groupOf[v]]++] = v;
+        }
+    }
+
+    const bool limited = maxAngle < AI_DEG_TO_RAD( 175.f );
+    const ai_real fLimit = std::cos(maxAngle);
+
+    // Each group only writes the normals of its own vertices, so the groups can be spread
+    // across the threads in blocks.
+    static const unsigned int BlockSize = 4096;
+    const unsigned int numBlocks = (numGroups + BlockSize - 1) / BlockSize;
+    const std::function<void(unsigned int)> smoothBlock = [&](unsigned int block) {
+        const unsigned int end = std::min(numGroups, (block + 1) * BlockSize);
+        for (unsigned int g = block * BlockSize; g < end; ++g) {
+            const unsigned int* members = &groupVertices[groupOffsets[g]];
+            const unsigned int numMembers = groupOffsets[g + 1] - groupOffsets[g];
+
+            if (!limited) {
+                // all vertices of the group get the same normal
+                aiVector3D pcNor;
+                for (unsigned int m = 0; m < numMembers; ++m) {
+                    const unsigned int* faces = adj.GetAdjacentTriangles(members[m]);
+                    const unsigned int numFaces = adj.mOffsetTable[members[m] + 1] - adj.mOffsetTable[members[m]];
+                    for (unsigned int a = 0; a < numFaces; ++a) {
+                        pcNor += faceNormals[faces[a]];
+                    }
+                }
+                for (unsigned int m = 0; m < numMembers; ++m) {
+                    out[members[m]] = pcNor;
+                }
+                continue;
+            }
+
+            for (unsigned int n = 0; n < numMembers; ++n) {
+                const unsigned int v = members[n];
+                const unsigned int* ownFaces = adj.GetAdjacentTriangles(v);
+                const unsigned int numOwnFaces = adj.mOffsetTable[v + 1] - adj.mOffsetTable[v];
+
+                aiVector3D vr;
+                for (unsigned int a = 0; a < numOwnFaces; ++a) {
+                    vr += faceNormals[ownFaces[a]];
+                }
+                vr.NormalizeSafe();
+
+                // the vertex's own faces are always taken, see the verbose code path
+                aiVector3D pcNor;
+                for (unsigned int m = 0; m < numMembers; ++m) {
+                    const unsigned int* faces = adj.GetAdjacentTriangles(members[m]);
+                    const unsigned int numFaces = adj.mOffsetTable[members[m] + 1] - adj.mOffsetTable[members[m]];
+                    for (unsigned int a = 0; a < numFaces; ++a) {
+                        const aiVector3D& fn = faceNormals[faces[a]];
+                        if (!numOwnFaces || members[m] == v || fn * vr >= fLimit) {
+                            pcNor += fn;
+                        }
+                    }
+                }
+                out[v] = pcNor;
+            }
+        }
+    };
+
+    if (pool) {
+        pool->ParallelFor(0, numBlocks, smoothBlock);
+    } else {
+        for (unsigned int block = 0; block < numBlocks; ++block) {
+            smoothBlock(block);
+        }
+    }
+    NormalizeVectors(out, out, numVertices);
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 GenVertexNormalsProcess::GenVertexNormalsProcess()
-: configMaxAngle( AI_DEG_TO_RAD( 175.f ) ) {
+: configMaxAngle( AI_DEG_TO_RAD( 175.f ) )
+, configSpatialSortMethod( SpatialSort::Method_PlaneSort ) {
     // empty
 }
 
@@ -83,23 +242,53 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
     // Get the current value of the AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE property
     configMaxAngle = pImp->GetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE,(ai_real)175.0);
     configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle,(ai_real)175.0),(ai_real)0.0));
+
+    configSpatialSortMethod = pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_METHOD, AI_SPATIAL_SORT_PLANE) == AI_SPATIAL_SORT_GRID ?
+        SpatialSort::Method_HashGrid : SpatialSort::Method_PlaneSort;
 }
 
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenVertexNormalsProcess::Execute( aiScene* pScene)
+{
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenVertexNormalsProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint GenVertexNormalsProcess::GetMeshFootprint() const
+{
+    return MeshFootprint(MeshComponent_Positions | MeshComponent_Normals | MeshComponent_Faces,
+        MeshComponent_Normals);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::BeginMeshPass( aiScene* pScene)
 {
     ASSIMP_LOG_DEBUG("GenVertexNormalsProcess begin");
 
     if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
         throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
     }
+    meshComputed.assign(pScene->mNumMeshes, 0);
+}
 
-    bool bHas = false;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
-        if(GenMeshVertexNormals( pScene->mMeshes[a],a))
-            bHas = true;
-    }
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+    meshComputed[meshIndex] = GenMeshVertexNormals(pMesh, meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::EndMeshPass( aiScene* /*pScene*/)
+{
+    const bool bHas = std::find(meshComputed.begin(), meshComputed.end(), 1) != meshComputed.end();
+    meshComputed.clear();
 
     if (bHas)   {
         ASSIMP_LOG_INFO("GenVertexNormalsProcess finished. "
@@ -128,34 +317,13 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
         return false;
     }
 
+    const bool parallel = NULL != threadPool && threadPool->GetNumThreads() > 1;
+    std::vector<aiVector3D> faceNormals(pMesh->mNumFaces);
+    computeFaceNormals(pMesh, faceNormals.empty() ? NULL : &faceNormals[0], parallel ? threadPool : NULL);
+
     // Allocate the array to hold the output normals
-    const float qnan = std::numeric_limits<ai_real>::quiet_NaN();
     pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-    // Compute per-face normals but store them per-vertex
-    for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
-    {
-        const aiFace& face = pMesh->mFaces[a];
-        if (face.mNumIndices < 3)
-        {
-            // either a point or a line -> no normal vector
-            for (unsigned int i = 0;i < face.mNumIndices;++i) {
-                pMesh->mNormals[face.mIndices[i]] = aiVector3D(qnan);
-            }
-
-            continue;
-        }
-
-        const aiVector3D* pV1 = &pMesh->mVertices[face.mIndices[0]];
-        const aiVector3D* pV2 = &pMesh->mVertices[face.mIndices[1]];
-        const aiVector3D* pV3 = &pMesh->mVertices[face.mIndices[face.mNumIndices-1]];
-        const aiVector3D vNor = ((*pV2 - *pV1) ^ (*pV3 - *pV1)).NormalizeSafe();
-
-        for (unsigned int i = 0;i < face.mNumIndices;++i) {
-            pMesh->mNormals[face.mIndices[i]] = vNor;
-        }
-    }
-
     // Set up a SpatialSort to quickly find all vertices close to a given position
     // check whether we can reuse the SpatialSort of a previous step.
     SpatialSort* vertexFinder = NULL;
@@ -172,13 +340,51 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
         }
     }
     if (!vertexFinder)  {
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
+        _vertexFinder.SetMethod(configSpatialSortMethod);
+        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D), false);
+        _vertexFinder.Finalize(threadPool);
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
     }
+
+    // Meshes which share vertices between faces are smoothed from their adjacency, the
+    // faces of each vertex need not be spread to the vertex normals first. The adjacency
+    // is only built for triangles.
+    if (pMesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) {
+        VertexTriangleAdjacency adj(pMesh->mFaces, pMesh->mNumFaces, pMesh->mNumVertices, false);
+        if (hasSharedVertices(adj)) {
+            genIndexedVertexNormals(pMesh, &faceNormals[0], adj, *vertexFinder, posEpsilon,
+                configMaxAngle, parallel ? threadPool : NULL, pMesh->mNormals);
+            return true;
+        }
+    }
+
+    // Store the face normals per vertex
+    for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
+    {
+        const aiFace& face = pMesh->mFaces[a];
+        for (unsigned int i = 0;i < face.mNumIndices;++i) {
+            pMesh->mNormals[face.mIndices[i]] = faceNormals[a];
+        }
+    }
+
     std::vector<unsigned int> verticesFound;
     aiVector3D* pcNew = new aiVector3D[pMesh->mNumVertices];
 
+    // With more than one thread at hand, run all queries up front in parallel. The found
+    // vertices are the same, so the results don't depend on the number of threads.
+    std::vector<unsigned int> foundOffsets, foundTable;
+    if (parallel) {
+        vertexFinder->FindAllPositions(posEpsilon, foundOffsets, foundTable, threadPool);
+    }
+    const auto findPositions = [&](unsigned int i, std::vector<unsigned int>& found) {
+        if (parallel) {
+            found.assign(foundTable.begin() + foundOffsets[i], foundTable.begin() + foundOffsets[i + 1]);
+        } else {
+            vertexFinder->FindPositions( pMesh->mVertices[i], posEpsilon, found);
+        }
+    };
+
     if (configMaxAngle >= AI_DEG_TO_RAD( 175.f ))   {
         // There is no angle limit. Thus all vertices with positions close
         // to each other will receive the same vertex normal. This allows us
@@ -190,7 +396,7 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
             }
 
             // Get all vertices that share this one ...
-            vertexFinder->FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
+            findPositions(i, verticesFound);
 
             aiVector3D pcNor;
             for (unsigned int a = 0; a < verticesFound.size(); ++a) {
@@ -211,24 +417,40 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
     // Slower code path if a smooth angle is set. There are many ways to achieve
     // the effect, this one is the most straightforward one.
     else    {
+        // Each vertex only writes its own normal, so the vertices can be spread across
+        // the threads in blocks.
         const ai_real fLimit = std::cos(configMaxAngle);
-        for (unsigned int i = 0; i < pMesh->mNumVertices;++i)   {
-            // Get all vertices that share this one ...
-            vertexFinder->FindPositions( pMesh->mVertices[i] , posEpsilon, verticesFound);
-
-            aiVector3D vr = pMesh->mNormals[i];
-
-            aiVector3D pcNor;
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                aiVector3D v = pMesh->mNormals[verticesFound[a]];
+        static const unsigned int BlockSize = 4096;
+        const unsigned int numBlocks = (pMesh->mNumVertices + BlockSize - 1) / BlockSize;
+        const std::function<void(unsigned int)> smoothBlock = [&](unsigned int block) {
+            std::vector<unsigned int> verticesFound;
+            const unsigned int end = std::min(pMesh->mNumVertices, (block + 1) * BlockSize);
+            for (unsigned int i = block * BlockSize; i < end;++i)   {
+                // Get all vertices that share this one ...
+                findPositions(i, verticesFound);
+
+                aiVector3D vr = pMesh->mNormals[i];
+
+                aiVector3D pcNor;
+                for (unsigned int a = 0; a < verticesFound.size(); ++a) {
+                    aiVector3D v = pMesh->mNormals[verticesFound[a]];
+
+                    // Check whether the angle between the two normals is not too large.
+                    // Skip the angle check on our own normal to avoid false negatives
+                    // (v*v is not guaranteed to be 1.0 for all unit vectors v)
+                    if (is_not_qnan(v.x) && (verticesFound[a] == i || (v * vr >= fLimit)))
+                        pcNor += v;
+                }
+                pcNew[i] = pcNor.NormalizeSafe();
+            }
+        };
 
-                // Check whether the angle between the two normals is not too large.
-                // Skip the angle check on our own normal to avoid false negatives
-                // (v*v is not guaranteed to be 1.0 for all unit vectors v)
-                if (is_not_qnan(v.x) && (verticesFound[a] == i || (v * vr >= fLimit)))
-                    pcNor += v;
+        if (parallel) {
+            threadPool->ParallelFor(0, numBlocks, smoothBlock);
+        } else {
+            for (unsigned int block = 0; block < numBlocks; ++block) {
+                smoothBlock(block);
             }
-            pcNew[i] = pcNor.NormalizeSafe();
         }
     }
 
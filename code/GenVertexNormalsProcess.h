@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include <assimp/mesh.h>
+#include <assimp/SpatialSort.h>
+#include <vector>
 
 class GenNormalsTest;
 
@@ -86,6 +88,13 @@ public:
     */
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** The step works on each mesh independently, see BaseProcess. */
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
 
     // setter for configMaxAngle
     inline void SetMaxSmoothAngle(ai_real f)
@@ -107,7 +116,14 @@ private:
 
     /** Configuration option: maximum smoothing angle, in radians*/
     ai_real configMaxAngle;
+
+    /** Configuration option: spatial index used to find close vertices */
+    SpatialSort::Method configSpatialSortMethod;
+
     mutable bool force_ = false;
+
+    /** Per-mesh result of the current pass: normals computed or not */
+    std::vector<unsigned char> meshComputed;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,852 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  GenerateLODsProcess.cpp
+ *  @brief Implementation of the GenerateLODs post-process step.
+ *
+ *  Edges are collapsed into one of their vertices (half-edge collapses), so the simplified
+ *  meshes only use vertices of the original mesh. Vertices with more than one set of attributes
+ *  at the same position (UV seams, hard edges, ...) and vertices on non-manifold edges are never
+ *  removed, vertices on open borders only move along the border.
+ */
+
+#include "GenerateLODsProcess.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/SpatialSort.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/TinyFormatter.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace Assimp;
+using namespace Assimp::Formatter;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Sum of squared distances to a set of weighted planes, stored as symmetric 4x4 matrix
+struct Quadric {
+    double a00, a11, a22, a01, a02, a12;
+    double b0, b1, b2;
+    double c;
+    double w;
+
+    Quadric()
+    : a00(0.0), a11(0.0), a22(0.0), a01(0.0), a02(0.0), a12(0.0)
+    , b0(0.0), b1(0.0), b2(0.0)
+    , c(0.0)
+    , w(0.0) {
+        // empty
+    }
+
+    // adds the plane n*p + d = 0, n must be normalized
+    void AddPlane(double nx, double ny, double nz, double d, double weight) {
+        a00 += weight * nx * nx;
+        a11 += weight * ny * ny;
+        a22 += weight * nz * nz;
+        a01 += weight * nx * ny;
+        a02 += weight * nx * nz;
+        a12 += weight * ny * nz;
+        b0 += weight * nx * d;
+        b1 += weight * ny * d;
+        b2 += weight * nz * d;
+        c += weight * d * d;
+        w += weight;
+    }
+
+    Quadric& operator += (const Quadric& o) {
+        a00 += o.a00; a11 += o.a11; a22 += o.a22;
+        a01 += o.a01; a02 += o.a02; a12 += o.a12;
+        b0 += o.b0; b1 += o.b1; b2 += o.b2;
+        c += o.c;
+        w += o.w;
+        return *this;
+    }
+
+    // weighted mean of the squared distances of the given point to the planes
+    double Error(const aiVector3D& p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        const double r = a00 * x * x + a11 * y * y + a22 * z * z
+            + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+            + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return w > 0.0 ? std::fabs(r) / w : 0.0;
+    }
+};
+
+// Border edges are weighted higher than faces to keep the outline of open meshes
+const double BorderWeight = 10.0;
+
+// How a vertex may be collapsed
+enum VertexKind {
+    // inside of a manifold surface, may be collapsed along any edge
+    Kind_Manifold,
+    // on an open border, may only be collapsed along the border
+    Kind_Border,
+    // on a seam or a non-manifold edge, never collapsed
+    Kind_Locked
+};
+
+// ------------------------------------------------------------------------------------------------
+// An edge collapse, moving position v onto position t, using vertex target at t
+struct Collapse {
+    unsigned int v, t, target;
+    double error;
+
+    bool operator < (const Collapse& o) const {
+        return error < o.error || (error == o.error && v < o.v);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// An edge between two positions, see Simplifier::Simplifier()
+struct Edge {
+    unsigned int a, b, face;
+
+    bool operator < (const Edge& o) const {
+        return a < o.a || (a == o.a && (b < o.b || (b == o.b && face < o.face)));
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// The state of the simplification of a triangle mesh. The faces refer to the vertices of the
+// mesh, vertices at the same position are represented by the one with the lowest index.
+class Simplifier {
+public:
+    explicit Simplifier(const aiMesh* pMesh);
+
+    // collapses edges until there are at most iTargetFaces faces or any further collapse
+    // would exceed the given squared error, returns the number of faces left
+    unsigned int Simplify(unsigned int iTargetFaces, double fMaxError);
+
+    unsigned int GetNumFaces() const {
+        return static_cast<unsigned int>(mIndices.size() / 3);
+    }
+
+    // three vertex indices per face
+    const std::vector<unsigned int>& GetIndices() const {
+        return mIndices;
+    }
+
+private:
+    bool SameAttributes(unsigned int a, unsigned int b) const;
+    void BuildAdjacency();
+    // returns the vertex which replaces v if v can be moved onto t, UINT_MAX otherwise
+    unsigned int CanCollapse(unsigned int v, unsigned int t) const;
+    void DoCollapse(unsigned int v, unsigned int t, unsigned int iTarget, unsigned int& iNumFaces);
+    const aiVector3D& Position(unsigned int idx) const {
+        return mMesh->mVertices[idx];
+    }
+
+    const aiMesh* mMesh;
+
+    // three vertex indices per face, UINT_MAX for faces removed in the current pass
+    std::vector<unsigned int> mIndices;
+
+    // position representative of each vertex
+    std::vector<unsigned int> mPosition;
+
+    // VertexKind and quadric of each position representative
+    std::vector<unsigned char> mKind;
+    std::vector<Quadric> mQuadrics;
+
+    // faces around each position representative, the ones around v are
+    // mAdjacency[mAdjacencyStart[v]] ... mAdjacency[mAdjacencyStart[v+1]-1]
+    std::vector<unsigned int> mAdjacencyStart;
+    std::vector<unsigned int> mAdjacency;
+
+    // bone weights of each vertex, the ones of v are mWeights[mWeightStart[v]] ...
+    std::vector<unsigned int> mWeightStart;
+    std::vector<std::pair<unsigned int, float> > mWeights;
+};
+
+// ------------------------------------------------------------------------------------------------
+Simplifier::Simplifier(const aiMesh* pMesh)
+: mMesh(pMesh)
+{
+    const unsigned int iNumVertices = pMesh->mNumVertices;
+
+    // bone weights per vertex, needed to tell vertices apart
+    if (pMesh->HasBones()) {
+        mWeightStart.assign(iNumVertices + 1, 0);
+        for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+            const aiBone* pBone = pMesh->mBones[b];
+            for (unsigned int w = 0; w < pBone->mNumWeights; ++w) {
+                ++mWeightStart[pBone->mWeights[w].mVertexId + 1];
+            }
+        }
+        for (unsigned int v = 0; v < iNumVertices; ++v) {
+            mWeightStart[v + 1] += mWeightStart[v];
+        }
+        mWeights.resize(mWeightStart[iNumVertices]);
+        std::vector<unsigned int> fill(mWeightStart.begin(), mWeightStart.end() - 1);
+        for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+            const aiBone* pBone = pMesh->mBones[b];
+            for (unsigned int w = 0; w < pBone->mNumWeights; ++w) {
+                const aiVertexWeight& weight = pBone->mWeights[w];
+                mWeights[fill[weight.mVertexId]++] = std::make_pair(b, weight.mWeight);
+            }
+        }
+    }
+
+    // group the vertices at identical positions, the lowest index of a group represents it
+    SpatialSort finder(pMesh->mVertices, iNumVertices, sizeof(aiVector3D));
+    std::vector<unsigned int> foundOffsets, found;
+    finder.FindAllIdenticalPositions(foundOffsets, found);
+
+    // within each group, vertices with identical attributes are the same vertex
+    mPosition.assign(iNumVertices, UINT_MAX);
+    std::vector<unsigned int> wedge(iNumVertices);
+    std::vector<unsigned int> group;
+    for (unsigned int v = 0; v < iNumVertices; ++v) {
+        if (UINT_MAX != mPosition[v]) {
+            continue;
+        }
+        group.assign(1, v);
+        for (unsigned int i = foundOffsets[v]; i < foundOffsets[v + 1]; ++i) {
+            if (UINT_MAX == mPosition[found[i]] && found[i] != v) {
+                group.push_back(found[i]);
+            }
+        }
+        std::sort(group.begin() + 1, group.end());
+        for (unsigned int i = 0; i < group.size(); ++i) {
+            const unsigned int u = group[i];
+            mPosition[u] = v;
+            wedge[u] = u;
+            for (unsigned int j = 0; j < i; ++j) {
+                if (wedge[group[j]] == group[j] && SameAttributes(group[j], u)) {
+                    wedge[u] = group[j];
+                    break;
+                }
+            }
+        }
+    }
+
+    // collect the faces, dropping degenerate ones
+    mIndices.reserve(pMesh->mNumFaces * 3);
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        if (face.mNumIndices != 3) {
+            continue;
+        }
+        const unsigned int i0 = wedge[face.mIndices[0]], i1 = wedge[face.mIndices[1]], i2 = wedge[face.mIndices[2]];
+        const unsigned int p0 = mPosition[i0], p1 = mPosition[i1], p2 = mPosition[i2];
+        if (p0 == p1 || p1 == p2 || p2 == p0) {
+            continue;
+        }
+        mIndices.push_back(i0);
+        mIndices.push_back(i1);
+        mIndices.push_back(i2);
+    }
+    const unsigned int iNumFaces = GetNumFaces();
+
+    // positions with more than one used vertex are on a seam
+    mKind.assign(iNumVertices, Kind_Manifold);
+    std::vector<unsigned int> usedAt(iNumVertices, UINT_MAX);
+    for (unsigned int i = 0; i < mIndices.size(); ++i) {
+        const unsigned int idx = mIndices[i], p = mPosition[idx];
+        if (UINT_MAX == usedAt[p]) {
+            usedAt[p] = idx;
+        }
+        else if (usedAt[p] != idx) {
+            mKind[p] = Kind_Locked;
+        }
+    }
+
+    // face quadrics
+    mQuadrics.resize(iNumVertices);
+    for (unsigned int f = 0; f < iNumFaces; ++f) {
+        const aiVector3D& p0 = Position(mIndices[f * 3]);
+        const aiVector3D& p1 = Position(mIndices[f * 3 + 1]);
+        const aiVector3D& p2 = Position(mIndices[f * 3 + 2]);
+        const aiVector3D n = (p1 - p0) ^ (p2 - p0);
+        const double fLength = n.Length();
+        if (fLength <= 0.0) {
+            continue;
+        }
+        const double nx = n.x / fLength, ny = n.y / fLength, nz = n.z / fLength;
+        const double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+        Quadric q;
+        q.AddPlane(nx, ny, nz, d, fLength * 0.5);
+        for (unsigned int c = 0; c < 3; ++c) {
+            mQuadrics[mPosition[mIndices[f * 3 + c]]] += q;
+        }
+    }
+
+    // find the border edges, used by one face only, and non-manifold ones
+    std::vector<Edge> edges;
+    edges.reserve(iNumFaces * 3);
+    for (unsigned int f = 0; f < iNumFaces; ++f) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            const unsigned int a = mPosition[mIndices[f * 3 + c]], b = mPosition[mIndices[f * 3 + (c + 1) % 3]];
+            const Edge e = { std::min(a, b), std::max(a, b), f };
+            edges.push_back(e);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    std::vector<unsigned int> borderEdges(iNumVertices, 0);
+    for (size_t begin = 0, end; begin < edges.size(); begin = end) {
+        end = begin + 1;
+        while (end < edges.size() && edges[end].a == edges[begin].a && edges[end].b == edges[begin].b) {
+            ++end;
+        }
+        const Edge& e = edges[begin];
+        if (end - begin > 2) {
+            mKind[e.a] = mKind[e.b] = Kind_Locked;
+        }
+        else if (end - begin == 1) {
+            ++borderEdges[e.a];
+            ++borderEdges[e.b];
+
+            // a plane through the edge, perpendicular to the face
+            const aiVector3D& pa = Position(e.a);
+            const aiVector3D& pb = Position(e.b);
+            const unsigned int* idx = &mIndices[e.face * 3];
+            const aiVector3D n = (Position(idx[1]) - Position(idx[0])) ^ (Position(idx[2]) - Position(idx[0]));
+            const aiVector3D en = (pb - pa) ^ n;
+            const double fLength = en.Length();
+            if (fLength > 0.0) {
+                const double nx = en.x / fLength, ny = en.y / fLength, nz = en.z / fLength;
+                const double d = -(nx * pa.x + ny * pa.y + nz * pa.z);
+                Quadric q;
+                q.AddPlane(nx, ny, nz, d, (pb - pa).SquareLength() * BorderWeight);
+                mQuadrics[e.a] += q;
+                mQuadrics[e.b] += q;
+            }
+        }
+    }
+    for (unsigned int v = 0; v < iNumVertices; ++v) {
+        if (Kind_Manifold == mKind[v] && borderEdges[v]) {
+            // vertices where more than one border meets can't move
+            mKind[v] = 2 == borderEdges[v] ? Kind_Border : Kind_Locked;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Simplifier::SameAttributes(unsigned int a, unsigned int b) const
+{
+    const aiMesh* pMesh = mMesh;
+    if (pMesh->mNormals && !(pMesh->mNormals[a] == pMesh->mNormals[b])) {
+        return false;
+    }
+    if (pMesh->mTangents && !(pMesh->mTangents[a] == pMesh->mTangents[b] && pMesh->mBitangents[a] == pMesh->mBitangents[b])) {
+        return false;
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS && pMesh->mColors[c]; ++c) {
+        if (!(pMesh->mColors[c][a] == pMesh->mColors[c][b])) {
+            return false;
+        }
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS && pMesh->mTextureCoords[c]; ++c) {
+        if (!(pMesh->mTextureCoords[c][a] == pMesh->mTextureCoords[c][b])) {
+            return false;
+        }
+    }
+    if (!mWeightStart.empty()) {
+        if (mWeightStart[a + 1] - mWeightStart[a] != mWeightStart[b + 1] - mWeightStart[b]) {
+            return false;
+        }
+        return std::equal(mWeights.begin() + mWeightStart[a], mWeights.begin() + mWeightStart[a + 1],
+            mWeights.begin() + mWeightStart[b]);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Simplifier::BuildAdjacency()
+{
+    const unsigned int iNumVertices = mMesh->mNumVertices;
+    mAdjacencyStart.assign(iNumVertices + 1, 0);
+    for (unsigned int i = 0; i < mIndices.size(); ++i) {
+        ++mAdjacencyStart[mPosition[mIndices[i]] + 1];
+    }
+    for (unsigned int v = 0; v < iNumVertices; ++v) {
+        mAdjacencyStart[v + 1] += mAdjacencyStart[v];
+    }
+    mAdjacency.resize(mIndices.size());
+    std::vector<unsigned int> fill(mAdjacencyStart.begin(), mAdjacencyStart.end() - 1);
+    for (unsigned int i = 0; i < mIndices.size(); ++i) {
+        mAdjacency[fill[mPosition[mIndices[i]]]++] = i / 3;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int Simplifier::CanCollapse(unsigned int v, unsigned int t) const
+{
+    const unsigned int* const piBegin = &mAdjacency[mAdjacencyStart[v]];
+    const unsigned int* const piEnd = &mAdjacency[0] + mAdjacencyStart[v + 1];
+
+    // the vertex at t which replaces v, the faces along the edge must agree on it
+    unsigned int iTarget = UINT_MAX;
+    for (const unsigned int* pi = piBegin; pi != piEnd; ++pi) {
+        const unsigned int* idx = &mIndices[*pi * 3];
+        for (unsigned int c = 0; c < 3; ++c) {
+            if (mPosition[idx[c]] == t) {
+                if (UINT_MAX != iTarget && iTarget != idx[c]) {
+                    return UINT_MAX;
+                }
+                iTarget = idx[c];
+            }
+        }
+    }
+    if (UINT_MAX == iTarget) {
+        return UINT_MAX;
+    }
+
+    // the remaining faces must not flip or degenerate
+    const aiVector3D& pt = Position(t);
+    for (const unsigned int* pi = piBegin; pi != piEnd; ++pi) {
+        const unsigned int* idx = &mIndices[*pi * 3];
+        aiVector3D p[3];
+        bool bHasT = false;
+        unsigned int iCorner = 0;
+        for (unsigned int c = 0; c < 3; ++c) {
+            p[c] = Position(idx[c]);
+            bHasT = bHasT || mPosition[idx[c]] == t;
+            if (mPosition[idx[c]] == v) {
+                iCorner = c;
+            }
+        }
+        if (bHasT) {
+            continue;
+        }
+        const aiVector3D n0 = (p[1] - p[0]) ^ (p[2] - p[0]);
+        p[iCorner] = pt;
+        const aiVector3D n1 = (p[1] - p[0]) ^ (p[2] - p[0]);
+        if (n0 * n1 <= 0.0 && n0.SquareLength() > 0.0) {
+            return UINT_MAX;
+        }
+    }
+    return iTarget;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Simplifier::DoCollapse(unsigned int v, unsigned int t, unsigned int iTarget, unsigned int& iNumFaces)
+{
+    for (unsigned int a = mAdjacencyStart[v]; a < mAdjacencyStart[v + 1]; ++a) {
+        unsigned int* idx = &mIndices[mAdjacency[a] * 3];
+        bool bHasT = false;
+        for (unsigned int c = 0; c < 3; ++c) {
+            bHasT = bHasT || mPosition[idx[c]] == t;
+        }
+        if (bHasT) {
+            idx[0] = idx[1] = idx[2] = UINT_MAX;
+            --iNumFaces;
+            continue;
+        }
+        for (unsigned int c = 0; c < 3; ++c) {
+            if (mPosition[idx[c]] == v) {
+                idx[c] = iTarget;
+            }
+        }
+    }
+    mQuadrics[t] += mQuadrics[v];
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int Simplifier::Simplify(unsigned int iTargetFaces, double fMaxError)
+{
+    unsigned int iNumFaces = GetNumFaces();
+    std::vector<Collapse> collapses, candidates;
+    std::vector<unsigned char> locked;
+
+    while (iNumFaces > iTargetFaces) {
+        BuildAdjacency();
+
+        // the cheapest allowed collapse of each vertex
+        collapses.clear();
+        for (unsigned int v = 0; v < mMesh->mNumVertices; ++v) {
+            if (Kind_Locked == mKind[v] || mAdjacencyStart[v] == mAdjacencyStart[v + 1]) {
+                continue;
+            }
+            candidates.clear();
+            for (unsigned int a = mAdjacencyStart[v]; a < mAdjacencyStart[v + 1]; ++a) {
+                const unsigned int* idx = &mIndices[mAdjacency[a] * 3];
+                for (unsigned int c = 0; c < 3; ++c) {
+                    const unsigned int t = mPosition[idx[c]];
+                    if (t == v) {
+                        continue;
+                    }
+                    if (Kind_Border == mKind[v]) {
+                        // only along the border, i.e. an edge used by one face
+                        unsigned int iShared = 0;
+                        for (unsigned int b = mAdjacencyStart[v]; b < mAdjacencyStart[v + 1]; ++b) {
+                            const unsigned int* other = &mIndices[mAdjacency[b] * 3];
+                            iShared += mPosition[other[0]] == t || mPosition[other[1]] == t || mPosition[other[2]] == t;
+                        }
+                        if (1 != iShared) {
+                            continue;
+                        }
+                    }
+                    Quadric q = mQuadrics[v];
+                    q += mQuadrics[t];
+                    const Collapse col = { v, t, UINT_MAX, q.Error(Position(t)) };
+                    if (col.error <= fMaxError) {
+                        candidates.push_back(col);
+                    }
+                }
+            }
+
+            // take the cheapest one which doesn't flip faces
+            std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) {
+                return a.error < b.error || (a.error == b.error && a.t < b.t);
+            });
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (i && candidates[i].t == candidates[i - 1].t) {
+                    continue;
+                }
+                candidates[i].target = CanCollapse(v, candidates[i].t);
+                if (UINT_MAX != candidates[i].target) {
+                    collapses.push_back(candidates[i]);
+                    break;
+                }
+            }
+        }
+        if (collapses.empty()) {
+            break;
+        }
+        std::sort(collapses.begin(), collapses.end());
+
+        // apply the cheapest ones first. Vertices around a collapse are locked until
+        // the next round, so the adjacency stays valid for the others.
+        locked.assign(mMesh->mNumVertices, 0);
+        unsigned int iApplied = 0;
+        for (size_t i = 0; i < collapses.size() && iNumFaces > iTargetFaces; ++i) {
+            const Collapse& col = collapses[i];
+            if (locked[col.v] || locked[col.t]) {
+                continue;
+            }
+            for (unsigned int a = mAdjacencyStart[col.v]; a < mAdjacencyStart[col.v + 1]; ++a) {
+                const unsigned int* idx = &mIndices[mAdjacency[a] * 3];
+                if (UINT_MAX == idx[0]) {
+                    continue;
+                }
+                for (unsigned int c = 0; c < 3; ++c) {
+                    locked[mPosition[idx[c]]] = 1;
+                }
+            }
+            DoCollapse(col.v, col.t, col.target, iNumFaces);
+            ++iApplied;
+        }
+
+        // remove the collapsed faces
+        size_t iOut = 0;
+        for (size_t i = 0; i < mIndices.size(); i += 3) {
+            if (UINT_MAX != mIndices[i]) {
+                mIndices[iOut++] = mIndices[i];
+                mIndices[iOut++] = mIndices[i + 1];
+                mIndices[iOut++] = mIndices[i + 2];
+            }
+        }
+        mIndices.resize(iOut);
+
+        if (!iApplied) {
+            break;
+        }
+    }
+    return iNumFaces;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies the per-vertex data of the given vertices
+template <typename T>
+T* CopyVertexArray(const T* pData, const std::vector<unsigned int>& vertices)
+{
+    if (!pData) {
+        return NULL;
+    }
+    T* pOut = new T[vertices.size()];
+    for (unsigned int i = 0; i < vertices.size(); ++i) {
+        pOut[i] = pData[vertices[i]];
+    }
+    return pOut;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds a mesh from the faces of the given mesh after simplification
+aiMesh* BuildLODMesh(const aiMesh* pMesh, const std::vector<unsigned int>& indices, unsigned int iLevel)
+{
+    // the used vertices, in the order of their first use
+    std::vector<unsigned int> remap(pMesh->mNumVertices, UINT_MAX);
+    std::vector<unsigned int> vertices;
+    for (unsigned int i = 0; i < indices.size(); ++i) {
+        if (UINT_MAX == remap[indices[i]]) {
+            remap[indices[i]] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(indices[i]);
+        }
+    }
+
+    aiMesh* pOut = new aiMesh();
+    if (pMesh->mName.length > 0) {
+        pOut->mName.Set(format() << pMesh->mName.data << "_LOD" << iLevel);
+    }
+    pOut->mMaterialIndex = pMesh->mMaterialIndex;
+    pOut->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+
+    pOut->mNumVertices = static_cast<unsigned int>(vertices.size());
+    pOut->mVertices = CopyVertexArray(pMesh->mVertices, vertices);
+    pOut->mNormals = CopyVertexArray(pMesh->mNormals, vertices);
+    pOut->mTangents = CopyVertexArray(pMesh->mTangents, vertices);
+    pOut->mBitangents = CopyVertexArray(pMesh->mBitangents, vertices);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        pOut->mColors[c] = CopyVertexArray(pMesh->mColors[c], vertices);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        pOut->mTextureCoords[c] = CopyVertexArray(pMesh->mTextureCoords[c], vertices);
+        pOut->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
+    }
+
+    pOut->mNumFaces = static_cast<unsigned int>(indices.size() / 3);
+    pOut->mFaces = new aiFace[pOut->mNumFaces];
+    for (unsigned int f = 0; f < pOut->mNumFaces; ++f) {
+        aiFace& face = pOut->mFaces[f];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int c = 0; c < 3; ++c) {
+            face.mIndices[c] = remap[indices[f * 3 + c]];
+        }
+    }
+
+    // keep the weights of the remaining vertices, drop bones without any
+    std::vector<aiBone*> bones;
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        const aiBone* pBone = pMesh->mBones[b];
+        std::vector<aiVertexWeight> weights;
+        for (unsigned int w = 0; w < pBone->mNumWeights; ++w) {
+            const unsigned int idx = remap[pBone->mWeights[w].mVertexId];
+            if (UINT_MAX != idx) {
+                weights.push_back(aiVertexWeight(idx, pBone->mWeights[w].mWeight));
+            }
+        }
+        if (weights.empty()) {
+            continue;
+        }
+        aiBone* pOutBone = new aiBone();
+        pOutBone->mName = pBone->mName;
+        pOutBone->mOffsetMatrix = pBone->mOffsetMatrix;
+        pOutBone->mNumWeights = static_cast<unsigned int>(weights.size());
+        pOutBone->mWeights = new aiVertexWeight[weights.size()];
+        std::copy(weights.begin(), weights.end(), pOutBone->mWeights);
+        bones.push_back(pOutBone);
+    }
+    if (!bones.empty()) {
+        pOut->mNumBones = static_cast<unsigned int>(bones.size());
+        pOut->mBones = new aiBone*[bones.size()];
+        std::copy(bones.begin(), bones.end(), pOut->mBones);
+    }
+    return pOut;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends integer entries to the metadata of the scene
+void AddMetadata(aiScene* pScene, const std::vector<std::pair<std::string, int32_t> >& entries)
+{
+    aiMetadata* pOld = pScene->mMetaData;
+    const unsigned int iNumOld = pOld ? pOld->mNumProperties : 0;
+    aiMetadata* pNew = aiMetadata::Alloc(iNumOld + static_cast<unsigned int>(entries.size()));
+
+    // move the existing entries over
+    for (unsigned int i = 0; i < iNumOld; ++i) {
+        pNew->mKeys[i] = pOld->mKeys[i];
+        pNew->mValues[i] = pOld->mValues[i];
+        pOld->mValues[i].mData = NULL;
+    }
+    delete pOld;
+
+    for (unsigned int i = 0; i < entries.size(); ++i) {
+        pNew->Set(iNumOld + i, entries[i].first, entries[i].second);
+    }
+    pScene->mMetaData = pNew;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenerateLODsProcess::GenerateLODsProcess()
+: configLevels(AI_LOD_LEVELS)
+, configRatio(AI_LOD_RATIO)
+, configMaxError(AI_LOD_MAX_ERROR)
+, meshLODs() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenerateLODsProcess::~GenerateLODsProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenerateLODsProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_GenerateLODs) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void GenerateLODsProcess::SetupProperties(const Importer* pImp)
+{
+    configLevels = pImp->GetPropertyInteger(AI_CONFIG_PP_GLOD_LEVELS,AI_LOD_LEVELS);
+    configRatio = pImp->GetPropertyFloat(AI_CONFIG_PP_GLOD_RATIO,AI_LOD_RATIO);
+    configMaxError = pImp->GetPropertyFloat(AI_CONFIG_PP_GLOD_MAX_ERROR,AI_LOD_MAX_ERROR);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenerateLODsProcess::Execute( aiScene* pScene)
+{
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateLODsProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint GenerateLODsProcess::GetMeshFootprint() const
+{
+    return MeshFootprint(MeshComponent_All & ~MeshComponent_MeshList, MeshComponent_MeshList);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::BeginMeshPass( aiScene* pScene)
+{
+    ASSIMP_LOG_DEBUG("GenerateLODsProcess begin");
+
+    meshLODs.assign(pScene->mNumMeshes, std::vector<aiMesh*>());
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+    GenerateLODs(pMesh, meshLODs[meshIndex]);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::EndMeshPass( aiScene* pScene)
+{
+    unsigned int iNumLODs = 0, iNumMeshes = 0;
+    for (unsigned int a = 0; a < meshLODs.size(); ++a) {
+        iNumLODs += static_cast<unsigned int>(meshLODs[a].size());
+        iNumMeshes += !meshLODs[a].empty();
+    }
+    if (!iNumLODs) {
+        meshLODs.clear();
+        ASSIMP_LOG_DEBUG("GenerateLODsProcess finished. No levels of detail were generated");
+        return;
+    }
+
+    // append the levels of detail of each mesh to the mesh list and link them
+    aiMesh** ppcMeshes = new aiMesh*[pScene->mNumMeshes + iNumLODs];
+    std::copy(pScene->mMeshes, pScene->mMeshes + pScene->mNumMeshes, ppcMeshes);
+    std::vector<std::pair<std::string, int32_t> > links;
+    unsigned int iOut = pScene->mNumMeshes;
+    for (unsigned int a = 0; a < meshLODs.size(); ++a) {
+        const std::vector<aiMesh*>& lods = meshLODs[a];
+        if (lods.empty()) {
+            continue;
+        }
+        links.push_back(std::make_pair(std::string(format() << "LOD." << a << ".First"), static_cast<int32_t>(iOut)));
+        links.push_back(std::make_pair(std::string(format() << "LOD." << a << ".Count"), static_cast<int32_t>(lods.size())));
+        std::copy(lods.begin(), lods.end(), ppcMeshes + iOut);
+        iOut += static_cast<unsigned int>(lods.size());
+    }
+    delete[] pScene->mMeshes;
+    pScene->mMeshes = ppcMeshes;
+    pScene->mNumMeshes = iOut;
+    AddMetadata(pScene, links);
+    meshLODs.clear();
+
+    ASSIMP_LOG_INFO_F("GenerateLODsProcess finished. Generated ", iNumLODs, " levels of detail for ", iNumMeshes, " meshes");
+}
+
+// ------------------------------------------------------------------------------------------------
+// Generates the levels of detail of a single mesh
+void GenerateLODsProcess::GenerateLODs( const aiMesh* pMesh, std::vector<aiMesh*>& poLODs) const
+{
+    ai_assert(NULL != pMesh);
+
+    if (!pMesh->HasFaces() || !pMesh->HasPositions() || pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        return;
+    }
+
+    // the error limit is relative to the size of the mesh
+    aiVector3D min = pMesh->mVertices[0], max = pMesh->mVertices[0];
+    for (unsigned int v = 1; v < pMesh->mNumVertices; ++v) {
+        min.x = std::min(min.x, pMesh->mVertices[v].x);
+        min.y = std::min(min.y, pMesh->mVertices[v].y);
+        min.z = std::min(min.z, pMesh->mVertices[v].z);
+        max.x = std::max(max.x, pMesh->mVertices[v].x);
+        max.y = std::max(max.y, pMesh->mVertices[v].y);
+        max.z = std::max(max.z, pMesh->mVertices[v].z);
+    }
+    const double fMaxError = configMaxError * (max - min).Length();
+
+    // each level continues to simplify the previous one
+    Simplifier simplifier(pMesh);
+    unsigned int iNumFaces = simplifier.GetNumFaces();
+    for (unsigned int iLevel = 1; iLevel <= configLevels; ++iLevel) {
+        const unsigned int iTarget = static_cast<unsigned int>(iNumFaces * configRatio);
+        if (!iTarget) {
+            break;
+        }
+        const unsigned int iNewFaces = simplifier.Simplify(iTarget, fMaxError * fMaxError);
+        if (iNewFaces >= iNumFaces) {
+            break;
+        }
+        iNumFaces = iNewFaces;
+        poLODs.push_back(BuildLODMesh(pMesh, simplifier.GetIndices(), iLevel));
+    }
+
+    if (!poLODs.empty() && !DefaultLogger::isNullLogger()) {
+        ASSIMP_LOG_DEBUG_F("Mesh ", pMesh->mName.data, ": generated ", poLODs.size(), " levels of detail, the last has ", iNumFaces, " of ",
+            pMesh->mNumFaces, " faces");
+    }
+}
@@ -0,0 +1,135 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post processing step to generate simplified meshes
+ *  for level of detail rendering */
+#ifndef AI_GENERATELODSPROCESS_H_INC
+#define AI_GENERATELODSPROCESS_H_INC
+
+#include "BaseProcess.h"
+#include <vector>
+
+struct aiMesh;
+
+namespace Assimp
+{
+
+// ---------------------------------------------------------------------------
+/** The GenerateLODsProcess builds a chain of simplified versions of each
+ *  triangle mesh by collapsing edges in the order of their quadric error
+ *  (Garland and Heckbert, "Surface Simplification Using Quadric Error
+ *  Metrics"). The simplified meshes are appended to the scene's mesh list
+ *  and linked to their source mesh through the scene's metadata, see
+ *  #aiProcess_GenerateLODs.
+ */
+class ASSIMP_API GenerateLODsProcess : public BaseProcess
+{
+public:
+
+    GenerateLODsProcess();
+    ~GenerateLODsProcess();
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    // The step works on each mesh independently, see BaseProcess.
+    // The simplified meshes are added to the scene in EndMeshPass().
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    /** Generates the levels of detail for a mesh.
+     * @param pMesh The mesh to simplify. It is not modified.
+     * @param poLODs Receives the simplified meshes, the finest first.
+     */
+    void GenerateLODs( const aiMesh* pMesh, std::vector<aiMesh*>& poLODs) const;
+
+    // setter for configLevels
+    inline void SetLevels(unsigned int n)
+    {
+        configLevels = n;
+    }
+
+    // setter for configRatio
+    inline void SetRatio(float f)
+    {
+        configRatio = f;
+    }
+
+    // setter for configMaxError
+    inline void SetMaxError(float f)
+    {
+        configMaxError = f;
+    }
+
+private:
+    //! Configuration parameter: number of levels to generate
+    unsigned int configLevels;
+
+    //! Configuration parameter: fraction of faces each level keeps
+    float configRatio;
+
+    //! Configuration parameter: maximum error relative to the mesh size
+    float configMaxError;
+
+    //! Per-mesh result of the current pass
+    std::vector<std::vector<aiMesh*> > meshLODs;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENERATELODSPROCESS_H_INC
@@ -0,0 +1,372 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  GenerateMeshletsProcess.cpp
+ *  @brief Implementation of the GenerateMeshlets post-process step.
+ *
+ *  The bounds of the meshlets follow the usual conventions of cluster culling: a bounding
+ *  sphere (Ritter's approximation) for frustum culling and a cone enclosing all face normals
+ *  for backface culling.
+ */
+
+#include "GenerateMeshletsProcess.h"
+#include "VertexTriangleAdjacency.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// Meshlets whose face normals spread wider than this (cosine of the angle to the cone
+// axis) get a degenerate normal cone, culling them would hardly ever succeed
+const ai_real MinConeSpread = ai_real( 0.1 );
+
+// ------------------------------------------------------------------------------------------------
+// Computes the bounding sphere and the normal cone of a meshlet
+void ComputeBounds(const aiMesh* pMesh, const unsigned int* piVertices,
+    const unsigned char* piTriangles, aiMeshlet& meshlet)
+{
+    const aiVector3D* const pcPos = pMesh->mVertices;
+
+    // bounding sphere: start with the sphere around two distant points and grow it
+    // until it contains all other points
+    aiVector3D a = pcPos[piVertices[0]];
+    aiVector3D b = a;
+    ai_real fMax = 0;
+    for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+        const ai_real f = (pcPos[piVertices[i]] - a).SquareLength();
+        if (f > fMax) {
+            fMax = f;
+            b = pcPos[piVertices[i]];
+        }
+    }
+    fMax = 0;
+    for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+        const ai_real f = (pcPos[piVertices[i]] - b).SquareLength();
+        if (f > fMax) {
+            fMax = f;
+            a = pcPos[piVertices[i]];
+        }
+    }
+    aiVector3D vCenter = (a + b) * ai_real( 0.5 );
+    ai_real fRadius = (a - b).Length() * ai_real( 0.5 );
+    for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+        const aiVector3D& p = pcPos[piVertices[i]];
+        const ai_real d = (p - vCenter).Length();
+        if (d > fRadius) {
+            const ai_real fNewRadius = (fRadius + d) * ai_real( 0.5 );
+            vCenter += (p - vCenter) * ((fNewRadius - fRadius) / d);
+            fRadius = fNewRadius;
+        }
+    }
+    meshlet.mCenter = vCenter;
+    meshlet.mRadius = fRadius;
+
+    // normal cone: the axis is the average face normal, the cutoff follows from the
+    // face normal which deviates most from it
+    std::vector<aiVector3D> normals(meshlet.mNumTriangles);
+    aiVector3D vAxis;
+    for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+        const unsigned char* tri = piTriangles + t * 3;
+        const aiVector3D& p0 = pcPos[piVertices[tri[0]]];
+        aiVector3D n = (pcPos[piVertices[tri[1]]] - p0) ^ (pcPos[piVertices[tri[2]]] - p0);
+        const ai_real l = n.Length();
+        normals[t] = l > 0 ? n / l : aiVector3D();
+        vAxis += normals[t];
+    }
+    meshlet.mConeApex = vCenter;
+    meshlet.mConeCutoff = 1;
+    const ai_real fAxisLength = vAxis.Length();
+    if (fAxisLength <= 0) {
+        meshlet.mConeAxis = aiVector3D();
+        return;
+    }
+    vAxis /= fAxisLength;
+    meshlet.mConeAxis = vAxis;
+
+    ai_real fMinDot = 1;
+    for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+        if (normals[t].SquareLength() > 0) {
+            fMinDot = std::min(fMinDot, normals[t] * vAxis);
+        }
+    }
+    if (fMinDot <= MinConeSpread) {
+        return;
+    }
+
+    // move the apex back along the axis until all face planes are in front of it
+    ai_real fMaxT = 0;
+    for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+        if (normals[t].SquareLength() > 0) {
+            const aiVector3D& p0 = pcPos[piVertices[piTriangles[t * 3]]];
+            fMaxT = std::max(fMaxT, ((vCenter - p0) * normals[t]) / (vAxis * normals[t]));
+        }
+    }
+    meshlet.mConeApex = vCenter - vAxis * fMaxT;
+    meshlet.mConeCutoff = std::sqrt(1 - fMinDot * fMinDot);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenerateMeshletsProcess::GenerateMeshletsProcess()
+: configMaxVertices(AI_MESHLET_MAX_VERTICES)
+, configMaxTriangles(AI_MESHLET_MAX_TRIANGLES) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenerateMeshletsProcess::~GenerateMeshletsProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// The step has no flag
+bool GenerateMeshletsProcess::IsActive( unsigned int /*pFlags*/) const
+{
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is enabled by the importer properties
+bool GenerateMeshletsProcess::IsEnabledByProperty( const Importer* pImp) const
+{
+    return pImp->GetPropertyBool(AI_CONFIG_PP_ML_ENABLE,false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void GenerateMeshletsProcess::SetupProperties(const Importer* pImp)
+{
+    configMaxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_ML_MAX_VERTICES,AI_MESHLET_MAX_VERTICES);
+    configMaxTriangles = pImp->GetPropertyInteger(AI_CONFIG_PP_ML_MAX_TRIANGLES,AI_MESHLET_MAX_TRIANGLES);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenerateMeshletsProcess::Execute( aiScene* pScene)
+{
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateMeshletsProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint GenerateMeshletsProcess::GetMeshFootprint() const
+{
+    return MeshFootprint(MeshComponent_Positions | MeshComponent_Faces | MeshComponent_Meshlets,
+        MeshComponent_Meshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::BeginMeshPass( aiScene* /*pScene*/)
+{
+    ASSIMP_LOG_DEBUG("GenerateMeshletsProcess begin");
+
+    if (configMaxVertices < 3 || configMaxVertices > 256) {
+        ASSIMP_LOG_WARN("GenerateMeshletsProcess: AI_CONFIG_PP_ML_MAX_VERTICES must be in [3, 256]");
+        configMaxVertices = std::max(3u, std::min(configMaxVertices, 256u));
+    }
+    if (!configMaxTriangles) {
+        ASSIMP_LOG_WARN("GenerateMeshletsProcess: AI_CONFIG_PP_ML_MAX_TRIANGLES is 0");
+        configMaxTriangles = 1;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int /*meshIndex*/)
+{
+    aiMeshletData* pcData = GenerateMeshlets(pMesh);
+    if (pcData) {
+        delete pMesh->mMeshlets;
+        pMesh->mMeshlets = pcData;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::EndMeshPass( aiScene* pScene)
+{
+    unsigned int iNumMeshlets = 0, iNumTriangles = 0, iNumVertices = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        const aiMeshletData* pcData = pScene->mMeshes[a]->mMeshlets;
+        if (pcData) {
+            iNumMeshlets += pcData->mNumMeshlets;
+            iNumTriangles += pcData->mNumTriangles;
+            iNumVertices += pcData->mNumVertices;
+        }
+    }
+    if (!iNumMeshlets) {
+        ASSIMP_LOG_DEBUG("GenerateMeshletsProcess finished. No meshlets were generated");
+        return;
+    }
+    ASSIMP_LOG_INFO_F("GenerateMeshletsProcess finished. Generated ", iNumMeshlets, " meshlets with ",
+        static_cast<float>(iNumTriangles) / iNumMeshlets, " triangles and ",
+        static_cast<float>(iNumVertices) / iNumMeshlets, " vertices on average");
+}
+
+// ------------------------------------------------------------------------------------------------
+// Partitions a single mesh
+aiMeshletData* GenerateMeshletsProcess::GenerateMeshlets( const aiMesh* pMesh) const
+{
+    ai_assert(NULL != pMesh);
+
+    if (!pMesh->HasFaces() || !pMesh->HasPositions() || pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        return NULL;
+    }
+    const unsigned int iMaxVertices = std::max(3u, std::min(configMaxVertices, 256u));
+    const unsigned int iMaxTriangles = std::max(1u, configMaxTriangles);
+
+    // mLiveTriangles holds the number of faces at each vertex, live the number of
+    // faces which are not part of a meshlet yet
+    VertexTriangleAdjacency adj(pMesh->mFaces, pMesh->mNumFaces, pMesh->mNumVertices, true);
+    std::vector<unsigned int> live(adj.mLiveTriangles, adj.mLiveTriangles + pMesh->mNumVertices);
+    std::vector<bool> emitted(pMesh->mNumFaces, false);
+
+    // index of each vertex in the current meshlet, UINT_MAX if it is not part of it
+    std::vector<unsigned int> local(pMesh->mNumVertices, UINT_MAX);
+
+    std::vector<aiMeshlet> meshlets;
+    std::vector<unsigned int> vertices;
+    std::vector<unsigned char> triangles;
+    aiMeshlet cur;
+
+    unsigned int iSeed = 0;
+    for (;;) {
+        // grow the meshlet by the adjacent face adding the fewest vertices. Among
+        // these, prefer faces at vertices with few remaining faces, this keeps the
+        // unprocessed part of the mesh compact.
+        unsigned int iBest = UINT_MAX, iBestNew = 4, iBestLive = UINT_MAX;
+        for (unsigned int i = 0; i < cur.mNumVertices; ++i) {
+            const unsigned int v = vertices[cur.mVertexOffset + i];
+            if (!live[v]) {
+                continue;
+            }
+            const unsigned int* piAdj = adj.GetAdjacentTriangles(v);
+            for (unsigned int n = 0; n < adj.mLiveTriangles[v]; ++n) {
+                const unsigned int f = piAdj[n];
+                if (emitted[f]) {
+                    continue;
+                }
+                const unsigned int* idx = pMesh->mFaces[f].mIndices;
+                const unsigned int iNew = (local[idx[0]] == UINT_MAX) + (local[idx[1]] == UINT_MAX) + (local[idx[2]] == UINT_MAX);
+                const unsigned int iLive = live[idx[0]] + live[idx[1]] + live[idx[2]];
+                if (iNew < iBestNew || (iNew == iBestNew && iLive < iBestLive)) {
+                    iBest = f;
+                    iBestNew = iNew;
+                    iBestLive = iLive;
+                }
+            }
+        }
+
+        // otherwise continue with the next face in order
+        if (iBest == UINT_MAX) {
+            while (iSeed < pMesh->mNumFaces && emitted[iSeed]) {
+                ++iSeed;
+            }
+            if (iSeed == pMesh->mNumFaces) {
+                break;
+            }
+            iBest = iSeed;
+            const unsigned int* idx = pMesh->mFaces[iBest].mIndices;
+            iBestNew = (local[idx[0]] == UINT_MAX) + (local[idx[1]] == UINT_MAX) + (local[idx[2]] == UINT_MAX);
+        }
+
+        // start a new meshlet if the face doesn't fit
+        if (cur.mNumVertices + iBestNew > iMaxVertices || cur.mNumTriangles == iMaxTriangles) {
+            ComputeBounds(pMesh, &vertices[cur.mVertexOffset], &triangles[cur.mTriangleOffset * 3], cur);
+            meshlets.push_back(cur);
+            for (unsigned int i = 0; i < cur.mNumVertices; ++i) {
+                local[vertices[cur.mVertexOffset + i]] = UINT_MAX;
+            }
+            cur = aiMeshlet();
+            cur.mVertexOffset = static_cast<unsigned int>(vertices.size());
+            cur.mTriangleOffset = static_cast<unsigned int>(triangles.size() / 3);
+
+            // the best face was chosen for the old meshlet, pick the next one from scratch
+            continue;
+        }
+
+        const unsigned int* idx = pMesh->mFaces[iBest].mIndices;
+        for (unsigned int i = 0; i < 3; ++i) {
+            if (local[idx[i]] == UINT_MAX) {
+                local[idx[i]] = cur.mNumVertices++;
+                vertices.push_back(idx[i]);
+            }
+            triangles.push_back(static_cast<unsigned char>(local[idx[i]]));
+            --live[idx[i]];
+        }
+        emitted[iBest] = true;
+        ++cur.mNumTriangles;
+    }
+    if (cur.mNumTriangles) {
+        ComputeBounds(pMesh, &vertices[cur.mVertexOffset], &triangles[cur.mTriangleOffset * 3], cur);
+        meshlets.push_back(cur);
+    }
+
+    aiMeshletData* pcData = new aiMeshletData();
+    pcData->mMaxVertices = iMaxVertices;
+    pcData->mMaxTriangles = iMaxTriangles;
+    pcData->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    pcData->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), pcData->mMeshlets);
+    pcData->mNumVertices = static_cast<unsigned int>(vertices.size());
+    pcData->mVertices = new unsigned int[vertices.size()];
+    std::copy(vertices.begin(), vertices.end(), pcData->mVertices);
+    pcData->mNumTriangles = static_cast<unsigned int>(triangles.size() / 3);
+    pcData->mTriangles = new unsigned char[triangles.size()];
+    std::copy(triangles.begin(), triangles.end(), pcData->mTriangles);
+    return pcData;
+}
@@ -0,0 +1,125 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post processing step to partition meshes into meshlets */
+#ifndef AI_GENERATEMESHLETSPROCESS_H_INC
+#define AI_GENERATEMESHLETSPROCESS_H_INC
+
+#include "BaseProcess.h"
+
+struct aiMesh;
+struct aiMeshletData;
+
+namespace Assimp
+{
+
+// ---------------------------------------------------------------------------
+/** The GenerateMeshletsProcess partitions each triangle mesh into small
+ *  clusters of adjacent triangles. A meshlet is grown from a seed triangle
+ *  by adding the adjacent triangle which introduces the fewest new vertices
+ *  until the vertex or triangle limit is reached. The result is stored in
+ *  aiMesh::mMeshlets. There is no flag for this step, it is enabled by the
+ *  #AI_CONFIG_PP_ML_ENABLE property.
+ */
+class ASSIMP_API GenerateMeshletsProcess : public BaseProcess
+{
+public:
+
+    GenerateMeshletsProcess();
+    ~GenerateMeshletsProcess();
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is enabled by AI_CONFIG_PP_ML_ENABLE
+    bool IsEnabledByProperty( const Importer* pImp) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    // The step works on each mesh independently, see BaseProcess.
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    /** Partitions a mesh into meshlets.
+     * @param pMesh The mesh to partition. It is not modified.
+     * @return The meshlets or NULL if the mesh is not a triangle mesh.
+     */
+    aiMeshletData* GenerateMeshlets( const aiMesh* pMesh) const;
+
+    // setter for configMaxVertices
+    inline void SetMaxVertices(unsigned int n)
+    {
+        configMaxVertices = n;
+    }
+
+    // setter for configMaxTriangles
+    inline void SetMaxTriangles(unsigned int n)
+    {
+        configMaxTriangles = n;
+    }
+
+private:
+    //! Configuration parameter: maximum number of vertices per meshlet
+    unsigned int configMaxVertices;
+
+    //! Configuration parameter: maximum number of triangles per meshlet
+    unsigned int configMaxTriangles;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENERATEMESHLETSPROCESS_H_INC
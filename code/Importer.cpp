@@ -73,14 +73,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "ScenePreprocessor.h"
 #include "ScenePrivate.h"
+#include "ThreadPool.h"
+#include "CountingIOSystem.h"
 #include <assimp/MemoryIOWrapper.h>
-#include <assimp/Profiler.h>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
 #include <assimp/Profiler.h>
 #include <set>
 #include <memory>
 #include <cctype>
+#include <typeinfo>
+#if defined(__GNUC__)
+#   include <cxxabi.h>
+#   include <cstdlib>
+#endif
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -193,6 +199,12 @@ Importer::~Importer()
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    // Stop the post-processing worker threads
+    delete pimpl->mThreadPool;
+
+    // Drop the profiling data of the last import
+    delete pimpl->mProfiler;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -394,6 +406,17 @@ const char* Importer::GetErrorString() const
     return pimpl->mErrorString.c_str();
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the profile of the last import, if recorded
+const ProfilingReport* Importer::GetProfilingReport() const
+{
+    if (!pimpl->mProfiler) {
+        return NULL;
+    }
+    pimpl->mProfiler->GetReport(pimpl->mProfilingReport);
+    return &pimpl->mProfilingReport;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Enable extra-verbose mode
 void Importer::SetExtraVerbose(bool bDo)
@@ -548,6 +571,30 @@ void WriteLogOpening(const std::string& file)
         ASSIMP_LOG_DEBUG(stream.str());
 }
 
+// ------------------------------------------------------------------------------------------------
+// (Re)create the worker threads according to AI_CONFIG_GLOB_NUM_THREADS
+static void SetupThreadPool(ImporterPimpl* pimpl, int numThreads)
+{
+    unsigned int wanted = 1;
+    if (numThreads == 0) {
+        wanted = ThreadPool::GetHardwareConcurrency();
+    } else if (numThreads > 1) {
+        wanted = static_cast<unsigned int>(numThreads);
+    }
+
+    if (pimpl->mThreadPool && pimpl->mThreadPool->GetNumThreads() == wanted) {
+        return;
+    }
+
+    delete pimpl->mThreadPool;
+    pimpl->mThreadPool = NULL;
+
+    if (wanted > 1) {
+        ASSIMP_LOG_DEBUG_F("Using ", wanted, " threads for importing and post processing");
+        pimpl->mThreadPool = new ThreadPool(wanted);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reads the given file and returns its contents if successful.
 const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
@@ -575,24 +622,33 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             FreeScene();
         }
 
+        // Start recording a new profile, if requested
+        delete pimpl->mProfiler;
+        pimpl->mProfiler = GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL;
+        Profiler* profiler = pimpl->mProfiler;
+        ScopedRegion total(profiler, "ReadFile");
+
+        // When profiling, count the bytes read by the importers
+        std::unique_ptr<CountingIOSystem> counter(profiler?new CountingIOSystem(pimpl->mIOHandler):NULL);
+        IOSystem* io = counter ? counter.get() : pimpl->mIOHandler;
+
         // First check if the file is accessible at all
-        if( !pimpl->mIOHandler->Exists( pFile)) {
+        if( !io->Exists( pFile)) {
 
             pimpl->mErrorString = "Unable to open file \"" + pFile + "\".";
             ASSIMP_LOG_ERROR(pimpl->mErrorString);
             return NULL;
         }
 
-        std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
         if (profiler) {
-            profiler->BeginRegion("total");
+            profiler->BeginRegion("CanRead");
         }
 
         // Find an worker class which can handle the file
         BaseImporter* imp = NULL;
         for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
 
-            if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
+            if( pimpl->mImporter[a]->CanRead( pFile, io, false)) {
                 imp = pimpl->mImporter[a];
                 break;
             }
@@ -604,7 +660,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             if (s != std::string::npos) {
                 ASSIMP_LOG_INFO("File extension not known, trying signature-based detection");
                 for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
-                    if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
+                    if( pimpl->mImporter[a]->CanRead( pFile, io, true)) {
                         imp = pimpl->mImporter[a];
                         break;
                     }
@@ -612,19 +668,26 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             }
             // Put a proper error message if no suitable importer was found
             if( !imp)   {
+                if (profiler) {
+                    profiler->EndRegion("CanRead");
+                }
                 pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
                 ASSIMP_LOG_ERROR(pimpl->mErrorString);
                 return NULL;
             }
         }
 
+        if (profiler) {
+            profiler->EndRegion("CanRead");
+        }
+
         // Get file size for progress handler
-        IOStream * fileIO = pimpl->mIOHandler->Open( pFile );
+        IOStream * fileIO = io->Open( pFile );
         uint32_t fileSize = 0;
         if (fileIO)
         {
             fileSize = static_cast<uint32_t>(fileIO->FileSize());
-            pimpl->mIOHandler->Close( fileIO );
+            io->Close( fileIO );
         }
 
         // Dispatch the reading to the worker class for this format
@@ -640,11 +703,18 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             profiler->BeginRegion("import");
         }
 
-        pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
+        // loaders able to parse in parallel use the post-processing threads
+        SetupThreadPool(pimpl, GetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 1));
+        imp->m_threadPool = pimpl->mThreadPool;
+
+        pimpl->mScene = imp->ReadFile( this, pFile, io);
+        imp->m_threadPool = NULL;
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
         if (profiler) {
             profiler->EndRegion("import");
+            profiler->AddCounter("bytes read", counter->GetBytesRead());
+            profiler->AddCounter("files opened", counter->GetFilesOpened());
         }
 
         SetPropertyString("sourceFilePath", pFile);
@@ -656,6 +726,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure)
             {
+                ScopedRegion region(profiler, "ValidateDS");
                 ValidateDSProcess ds;
                 ds.ExecuteOnScene (this);
                 if (!pimpl->mScene) {
@@ -666,14 +737,14 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
             // Preprocess the scene and prepare it for post-processing
             if (profiler) {
-                profiler->BeginRegion("preprocess");
+                profiler->BeginRegion("ScenePreprocessor");
             }
 
             ScenePreprocessor pre(pimpl->mScene);
             pre.ProcessScene();
 
             if (profiler) {
-                profiler->EndRegion("preprocess");
+                profiler->EndRegion("ScenePreprocessor");
             }
 
             // Ensure that the validation process won't be called twice
@@ -686,10 +757,6 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
         // clear any data allocated by post-process steps
         pimpl->mPPShared->Clean();
-
-        if (profiler) {
-            profiler->EndRegion("total");
-        }
     }
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
     catch (std::exception &e)
@@ -712,6 +779,41 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// Returns the profiler to record the post-processing into, NULL if not measuring. Post-processing
+// applied separately from ReadFile() is appended to the profile of the last import.
+static Profiler* SetupProfiler(ImporterPimpl* pimpl, bool measure)
+{
+    if (!measure) {
+        delete pimpl->mProfiler;
+        pimpl->mProfiler = NULL;
+    } else if (!pimpl->mProfiler) {
+        pimpl->mProfiler = new Profiler();
+    }
+    return pimpl->mProfiler;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Derive a readable region name for a post-processing step from its type
+static std::string GetStepName(const BaseProcess* process)
+{
+    const char* name = typeid(*process).name();
+#if defined(__GNUC__)
+    int status = -1;
+    char* demangled = abi::__cxa_demangle(name, NULL, NULL, &status);
+    std::string result(0 == status ? demangled : name);
+    ::free(demangled);
+#else
+    std::string result(name);
+#endif
+    // strip namespaces and MSVC's "class " prefix
+    const std::string::size_type pos = result.find_last_of(": ");
+    if (std::string::npos != pos) {
+        result.erase(0, pos + 1);
+    }
+    return result;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Apply post-processing to the currently bound scene
 const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
@@ -722,8 +824,16 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
         return NULL;
     }
 
+    // steps without a flag of their own may be enabled through the properties
+    std::vector<bool> enabled(pimpl->mPostProcessingSteps.size());
+    bool anyEnabled = false;
+    for (unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); ++a) {
+        enabled[a] = pimpl->mPostProcessingSteps[a]->IsEnabledByProperty(this);
+        anyEnabled = anyEnabled || enabled[a];
+    }
+
     // If no flags are given, return the current scene with no further action
-    if (!pFlags) {
+    if (!pFlags && !anyEnabled) {
         return pimpl->mScene;
     }
 
@@ -731,11 +841,16 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
     ai_assert(_ValidateFlags(pFlags));
     ASSIMP_LOG_INFO("Entering post processing pipeline");
 
+    SetupThreadPool(pimpl, GetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 1));
+    Profiler* profiler = SetupProfiler(pimpl, GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) != 0);
+    ScopedRegion total(profiler, "ApplyPostProcessing");
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
     // list of post-processing steps, so we need to call it manually.
     if (pFlags & aiProcess_ValidateDataStructure)
     {
+        ScopedRegion region(profiler, "ValidateDS");
         ValidateDSProcess ds;
         ds.ExecuteOnScene (this);
         if (!pimpl->mScene) {
@@ -757,21 +872,53 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
 
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
-        if( process->IsActive( pFlags)) {
+        if( process->IsActive( pFlags) || enabled[a]) {
+
+            // collect the run of active mesh-local steps starting here,
+            // they can process each mesh back to back in a single pass
+            std::vector<BaseProcess*> fused;
+            unsigned int last = a;
+            if (!pimpl->bExtraVerbose && process->IsMeshLocal()) {
+                for (unsigned int b = a; b < pimpl->mPostProcessingSteps.size(); ++b) {
+                    BaseProcess* next = pimpl->mPostProcessingSteps[b];
+                    if (!next->IsActive(pFlags) && !enabled[b]) {
+                        continue;
+                    }
+                    if (!next->IsMeshLocal()) {
+                        break;
+                    }
+                    fused.push_back(next);
+                    last = b;
 
+                    // steps adding or removing meshes end the run
+                    if (next->GetMeshFootprint().write & MeshComponent_MeshList) {
+                        break;
+                    }
+                }
+            }
+
+            std::string region;
             if (profiler) {
-                profiler->BeginRegion("postprocess");
+                region = GetStepName(process);
+                for (size_t i = 1; i < fused.size(); ++i) {
+                    region += " + " + GetStepName(fused[i]);
+                }
+                profiler->BeginRegion(region);
             }
 
-            process->ExecuteOnScene ( this );
+            if (fused.size() > 1) {
+                BaseProcess::ExecuteFusedOnScene( this, fused );
+                a = last;
+            } else {
+                process->ExecuteOnScene ( this );
+            }
 
             if (profiler) {
-                profiler->EndRegion("postprocess");
+                profiler->EndRegion(region);
             }
         }
         if( !pimpl->mScene) {
@@ -828,11 +975,16 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     // In debug builds: run basic flag validation
     ASSIMP_LOG_INFO( "Entering customized post processing pipeline" );
 
+    SetupThreadPool( pimpl, GetPropertyInteger( AI_CONFIG_GLOB_NUM_THREADS, 1 ) );
+    Profiler* profiler = SetupProfiler( pimpl, GetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 0 ) != 0 );
+    ScopedRegion total( profiler, "ApplyCustomizedPostProcessing" );
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
     // list of post-processing steps, so we need to call it manually.
     if ( requestValidation )
     {
+        ScopedRegion region( profiler, "ValidateDS" );
         ValidateDSProcess ds;
         ds.ExecuteOnScene( this );
         if ( !pimpl->mScene ) {
@@ -853,16 +1005,9 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler( GetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 0 ) ? new Profiler() : NULL );
-
-    if ( profiler ) {
-        profiler->BeginRegion( "postprocess" );
-    }
-
-    rootProcess->ExecuteOnScene( this );
-
-    if ( profiler ) {
-        profiler->EndRegion( "postprocess" );
+    {
+        ScopedRegion region( profiler, profiler ? GetStepName( rootProcess ) : std::string() );
+        rootProcess->ExecuteOnScene( this );
     }
 
     // If the extra verbose mode is active, execute the ValidateDataStructureStep again - after each step
@@ -1119,6 +1264,21 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
             }
         }
         in.meshes += (sizeof(aiFace) + 3 * sizeof(unsigned int))*mScene->mMeshes[i]->mNumFaces;
+        if (const aiMeshletData* meshlets = mScene->mMeshes[i]->mMeshlets) {
+            in.meshes += sizeof(aiMeshletData) + sizeof(aiMeshlet) * meshlets->mNumMeshlets;
+            in.meshes += sizeof(unsigned int) * meshlets->mNumVertices + 3 * meshlets->mNumTriangles;
+        }
+        if (const aiQuantizedMesh* q = mScene->mMeshes[i]->mQuantized) {
+            in.meshes += sizeof(aiQuantizedMesh);
+            unsigned int perVertex = (q->mPositions ? 6 : 0) + (q->mNormals ? 4 : 0) + (q->mTangents ? 6 : 0);
+            for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS;++a) {
+                perVertex += q->mTextureCoords[a] ? 4 : 0;
+            }
+            for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS;++a) {
+                perVertex += q->mColors[a] ? 4 : 0;
+            }
+            in.meshes += perVertex * q->mNumVertices;
+        }
     }
     in.total += in.meshes;
 
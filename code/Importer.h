@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <string>
 #include <assimp/matrix4x4.h>
+#include <assimp/Profiler.h>
 
 struct aiScene;
 
@@ -58,6 +59,7 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class ThreadPool;
 
 
 //! @cond never
@@ -119,6 +121,17 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Worker threads for the post-processing pipeline, NULL if
+     *  AI_CONFIG_GLOB_NUM_THREADS requests single-threaded processing */
+    ThreadPool* mThreadPool;
+
+    /** Records the import phases, NULL unless AI_CONFIG_GLOB_MEASURE_TIME
+     *  is set. Lives until the next ReadFile() call. */
+    Profiling::Profiler* mProfiler;
+
+    /** Filled by Importer::GetProfilingReport() */
+    Profiling::ProfilingReport mProfilingReport;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 };
@@ -138,7 +151,10 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT
 , mStringProperties()
 , mMatrixProperties()
 , bExtraVerbose( false )
-, mPPShared( nullptr ) {
+, mPPShared( nullptr )
+, mThreadPool( nullptr )
+, mProfiler( nullptr )
+, mProfilingReport() {
     // empty
 }
 //! @endcond
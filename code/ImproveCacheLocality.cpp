@@ -45,7 +45,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * <br>
  * The algorithm is roughly basing on this paper:
  * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
- *   .. although overdraw rduction isn't implemented yet ...
+ * <br>
+ * Alternatively Tom Forsyth's linear-speed vertex cache optimization is used, optionally followed
+ * by an overdraw optimization and a reordering of the vertices for vertex fetch.
  */
 
 
@@ -57,15 +59,130 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <stdio.h>
 #include <stack>
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Simulates a FIFO post-transform cache of the given size with per-vertex time stamps
+class FIFOCache {
+public:
+    FIFOCache(unsigned int numVertices, unsigned int size)
+    : mStamps(numVertices, 0)
+    , mSize(size)
+    , mTime(size + 1) {
+        // empty
+    }
+
+    // returns the number of cache misses caused by the three vertices of a face
+    unsigned int AccessFace(const unsigned int* piIndices) {
+        return Access(piIndices[0]) + Access(piIndices[1]) + Access(piIndices[2]);
+    }
+
+    // returns 1 if the vertex wasn't in the cache
+    unsigned int Access(unsigned int v) {
+        if (mTime - mStamps[v] > mSize) {
+            mStamps[v] = mTime++;
+            return 1;
+        }
+        return 0;
+    }
+
+    // evicts all vertices
+    void Flush() {
+        mTime += mSize + 1;
+    }
+
+private:
+    std::vector<unsigned int> mStamps;
+    unsigned int mSize;
+    unsigned int mTime;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Counts the cache misses of a triangle mesh in a FIFO cache of the given size
+unsigned int CountCacheMisses(const aiMesh* pMesh, unsigned int iCacheSize)
+{
+    FIFOCache cache(pMesh->mNumVertices, iCacheSize);
+    unsigned int iCacheMisses = 0;
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            iCacheMisses += cache.Access(face.mIndices[i]);
+        }
+    }
+    return iCacheMisses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Score of a vertex in Forsyth's algorithm, from its position in the LRU cache (-1 if not
+// cached) and the number of faces which still need it. Higher is better.
+float ForsythVertexScore(int iCachePos, unsigned int iCacheSize, unsigned int iLiveTris)
+{
+    if (!iLiveTris) {
+        // the vertex isn't used anymore
+        return -1.f;
+    }
+
+    float fScore = 0.f;
+    if (iCachePos >= 0) {
+        if (iCachePos < 3) {
+            // used by the last face, these get a fixed score as the paper suggests
+            fScore = 0.75f;
+        }
+        else {
+            const float fScaler = 1.f / (iCacheSize - 3);
+            fScore = std::pow(1.f - (iCachePos - 3) * fScaler, 1.5f);
+        }
+    }
+
+    // favour vertices with few remaining faces to get rid of them quickly
+    fScore += 2.f * std::pow((float)iLiveTris, -0.5f);
+    return fScore;
+}
+
+// ------------------------------------------------------------------------------------------------
+float ForsythFaceScore(const aiFace& face, const std::vector<float>& vertexScore)
+{
+    float fScore = 0.f;
+    for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+        fScore += vertexScore[face.mIndices[i]];
+    }
+    return fScore;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves the per-vertex data from index i to remap[i]
+template <typename T>
+void RemapVertexArray(T*& pData, const std::vector<unsigned int>& remap)
+{
+    if (!pData) {
+        return;
+    }
+    T* pOut = new T[remap.size()];
+    for (unsigned int i = 0; i < remap.size(); ++i) {
+        pOut[remap[i]] = pData[i];
+    }
+    delete[] pData;
+    pData = pOut;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ImproveCacheLocalityProcess::ImproveCacheLocalityProcess() {
-    configCacheDepth = PP_ICL_PTCACHE_SIZE;
+ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
+: configCacheDepth(PP_ICL_PTCACHE_SIZE)
+, configMethod(AI_ICL_METHOD_TIPSIFY)
+, configOverdrawThreshold(0.f)
+, configVertexFetch(false) {
+    // empty
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -88,6 +205,10 @@ void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp)
 {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     configCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+
+    configMethod = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_METHOD,AI_ICL_METHOD_TIPSIFY);
+    configOverdrawThreshold = pImp->GetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD,0.f);
+    configVertexFetch = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_VERTEX_FETCH,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -99,20 +220,59 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
         return;
     }
 
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImproveCacheLocalityProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint ImproveCacheLocalityProcess::GetMeshFootprint() const
+{
+    if (configVertexFetch) {
+        // all per-vertex data is reordered
+        return MeshFootprint(MeshComponent_All & ~MeshComponent_MeshList,
+            MeshComponent_All & ~MeshComponent_MeshList);
+    }
+    return MeshFootprint(MeshComponent_Positions | MeshComponent_Faces, MeshComponent_Faces);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityProcess::BeginMeshPass( aiScene* pScene)
+{
     ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
 
+    meshACMR.assign(pScene->mNumMeshes, 0.f);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+    meshACMR[meshIndex] = ProcessMesh(pMesh, meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityProcess::EndMeshPass( aiScene* pScene)
+{
+    // meshes may have been processed in parallel, so sum up the results in a fixed order
     float out = 0.f;
-    unsigned int numf = 0, numm = 0;
+    unsigned int numf = 0, numv = 0, numm = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
+        const float res = meshACMR[a];
         if (res) {
             numf += pScene->mMeshes[a]->mNumFaces;
+            numv += pScene->mMeshes[a]->mNumVertices;
             out  += res;
             ++numm;
         }
     }
+    meshACMR.clear();
+
     if (!DefaultLogger::isNullLogger()) {
-        ASSIMP_LOG_INFO_F("Cache relevant are ", numm, " meshes (", numf," faces). Average output ACMR is ", out / numf );
+        ASSIMP_LOG_INFO_F("Cache relevant are ", numm, " meshes (", numf," faces). Average output ACMR is ", out / numf, ", ATVR is ", out / numv );
         ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
     }
 }
@@ -121,7 +281,6 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
 // Improves the cache coherency of a specific mesh
 float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum)
 {
-    // TODO: rewrite this to use std::vector or boost::shared_array
     ai_assert(NULL != pMesh);
 
     // Check whether the input data is valid
@@ -144,37 +303,7 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
 
     // Input ACMR is for logging purposes only
     if (!DefaultLogger::isNullLogger())     {
-
-        unsigned int* piFIFOStack = new unsigned int[configCacheDepth];
-        memset(piFIFOStack,0xff,configCacheDepth*sizeof(unsigned int));
-        unsigned int* piCur = piFIFOStack;
-        const unsigned int* const piCurEnd = piFIFOStack + configCacheDepth;
-
-        // count the number of cache misses
-        unsigned int iCacheMisses = 0;
-        for (const aiFace* pcFace = pMesh->mFaces;pcFace != pcEnd;++pcFace) {
-
-            for (unsigned int qq = 0; qq < 3;++qq) {
-                bool bInCache = false;
-
-                for (unsigned int* pp = piFIFOStack;pp < piCurEnd;++pp) {
-                    if (*pp == pcFace->mIndices[qq])    {
-                        // the vertex is in cache
-                        bInCache = true;
-                        break;
-                    }
-                }
-                if (!bInCache)  {
-                    ++iCacheMisses;
-                    if (piCurEnd == piCur) {
-                        piCur = piFIFOStack;
-                    }
-                    *piCur++ = pcFace->mIndices[qq];
-                }
-            }
-        }
-        delete[] piFIFOStack;
-        fACMR = (float)iCacheMisses / pMesh->mNumFaces;
+        fACMR = (float)CountCacheMisses(pMesh, configCacheDepth) / pMesh->mNumFaces;
         if (3.0 == fACMR)   {
             char szBuff[128]; // should be sufficiently large in every case
 
@@ -187,6 +316,59 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
         }
     }
 
+    // allocate an empty output index buffer. We store the output indices in one large array.
+    // Since the number of triangles won't change the input faces can be reused. This is how
+    // we save thousands of redundant mini allocations for aiFace::mIndices
+    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
+    unsigned int* const piIBOutput = new unsigned int[iIdxCnt];
+
+    if (AI_ICL_METHOD_FORSYTH == configMethod) {
+        ReorderForsyth(pMesh, piIBOutput);
+    }
+    else {
+        ReorderTipsify(pMesh, piIBOutput);
+    }
+
+    if (configOverdrawThreshold > 0.f) {
+        ReorderOverdraw(pMesh, piIBOutput);
+    }
+
+    // sort the output index buffer back to the input array
+    const unsigned int* piCSIter = piIBOutput;
+    for (aiFace* pcFace = pMesh->mFaces; pcFace != pcEnd;++pcFace)  {
+        unsigned nind = pcFace->mNumIndices;
+        unsigned * ind = pcFace->mIndices;
+        if (nind > 0) ind[0] = *piCSIter++;
+        if (nind > 1) ind[1] = *piCSIter++;
+        if (nind > 2) ind[2] = *piCSIter++;
+    }
+    delete[] piIBOutput;
+
+    if (configVertexFetch) {
+        ReorderVertexFetch(pMesh);
+    }
+
+    float fACMR2 = 0.0f;
+    if (!DefaultLogger::isNullLogger()) {
+        const unsigned int iCacheMisses = CountCacheMisses(pMesh, configCacheDepth);
+        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
+
+        // very intense verbose logging ... prepare for much text if there are many meshes
+        if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
+            ASSIMP_LOG_DEBUG_F("Mesh ", meshNum, " | ACMR in: ", fACMR, " out: ", fACMR2, " | ~", ((fACMR - fACMR2) / fACMR) * 100.f,
+                "% | ATVR out: ", (float)iCacheMisses / pMesh->mNumVertices);
+        }
+
+        fACMR2 *= pMesh->mNumFaces;
+    }
+
+    return fACMR2;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorders the faces with the Tipsify algorithm
+void ImproveCacheLocalityProcess::ReorderTipsify( aiMesh* pMesh, unsigned int* piIBOutput) const
+{
     // first we need to build a vertex-triangle adjacency list
     VertexTriangleAdjacency adj(pMesh->mFaces,pMesh->mNumFaces, pMesh->mNumVertices,true);
 
@@ -194,11 +376,6 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
     unsigned int* const piCachingStamps = new unsigned int[pMesh->mNumVertices];
     memset(piCachingStamps,0x0,pMesh->mNumVertices*sizeof(unsigned int));
 
-    // allocate an empty output index buffer. We store the output indices in one large array.
-    // Since the number of triangles won't change the input faces can be reused. This is how
-    // we save thousands of redundant mini allocations for aiFace::mIndices
-    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
-    unsigned int* const piIBOutput = new unsigned int[iIdxCnt];
     unsigned int* piCSIter = piIBOutput;
 
     // allocate the flag array to hold the information
@@ -222,7 +399,6 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
     }
     ai_assert(iMaxRefTris > 0);
     unsigned int* piCandidates = new unsigned int[iMaxRefTris*3];
-    unsigned int iCacheMisses = 0;
 
     // ...................................................................................
     /** PSEUDOCODE for the algorithm
@@ -294,7 +470,6 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
                     // if the vertex is not yet in cache, set its cache count
                     if (iStampCnt-piCachingStamps[dp] > configCacheDepth) {
                         piCachingStamps[dp] = iStampCnt++;
-                        ++iCacheMisses;
                     }
                 }
                 // flag triangle as emitted
@@ -354,31 +529,267 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
             }
         }
     }
-    float fACMR2 = 0.0f;
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
+    // delete temporary storage
+    delete[] piCachingStamps;
+    delete[] piCandidates;
+}
 
-        // very intense verbose logging ... prepare for much text if there are many meshes
-        if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
-            ASSIMP_LOG_DEBUG_F("Mesh %u | ACMR in: ", meshNum, " out: ", fACMR, " | ~", fACMR2, ((fACMR - fACMR2) / fACMR) * 100.f);
+// ------------------------------------------------------------------------------------------------
+// Reorders the faces with Tom Forsyth's algorithm, see
+// https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+void ImproveCacheLocalityProcess::ReorderForsyth( aiMesh* pMesh, unsigned int* piIBOutput) const
+{
+    // the score function needs room for the three vertices of the last face
+    const unsigned int iCacheSize = std::max(configCacheDepth, 4u);
+    const unsigned int iNumVertices = pMesh->mNumVertices;
+    const unsigned int iNumFaces = pMesh->mNumFaces;
+
+    VertexTriangleAdjacency adj(pMesh->mFaces,iNumFaces,iNumVertices,true);
+    unsigned int* const piNumTriPtr = adj.mLiveTriangles;
+    const std::vector<unsigned int> piNumTriPtrNoModify(piNumTriPtr, piNumTriPtr + iNumVertices);
+
+    // per-vertex position in the LRU cache and score
+    std::vector<int> cachePos(iNumVertices, -1);
+    std::vector<float> vertexScore(iNumVertices);
+    for (unsigned int v = 0; v < iNumVertices; ++v) {
+        vertexScore[v] = ForsythVertexScore(-1, iCacheSize, piNumTriPtr[v]);
+    }
+
+    // per-face score, pick the best face to start with
+    std::vector<float> faceScore(iNumFaces);
+    std::vector<bool> abEmitted(iNumFaces, false);
+    unsigned int iBest = 0;
+    for (unsigned int f = 0; f < iNumFaces; ++f) {
+        faceScore[f] = ForsythFaceScore(pMesh->mFaces[f], vertexScore);
+        if (faceScore[f] > faceScore[iBest]) {
+            iBest = f;
         }
+    }
 
-        fACMR2 *= pMesh->mNumFaces;
+    // the LRU cache, most recently used vertex first. While a face is added it
+    // holds up to three vertices more than fit into the cache.
+    std::vector<unsigned int> cache, newCache;
+    cache.reserve(iCacheSize + 3);
+    newCache.reserve(iCacheSize + 3);
+    std::vector<unsigned int> addedAt(iNumVertices, UINT_MAX);
+
+    unsigned int iCursor = 0;
+    for (unsigned int n = 0; n < iNumFaces; ++n) {
+        if (UINT_MAX == iBest) {
+            // no face uses a cached vertex, continue with the next face in input order
+            while (abEmitted[iCursor]) {
+                ++iCursor;
+            }
+            iBest = iCursor;
+        }
+
+        // emit the face and move its vertices to the front of the cache
+        const aiFace& face = pMesh->mFaces[iBest];
+        abEmitted[iBest] = true;
+        newCache.clear();
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            const unsigned int dp = face.mIndices[i];
+            *piIBOutput++ = dp;
+            --piNumTriPtr[dp];
+            if (addedAt[dp] != n) {
+                addedAt[dp] = n;
+                newCache.push_back(dp);
+            }
+        }
+        for (unsigned int i = 0; i < cache.size(); ++i) {
+            if (addedAt[cache[i]] != n) {
+                newCache.push_back(cache[i]);
+            }
+        }
+
+        // rescore the cached vertices, including the ones which just dropped out
+        for (unsigned int i = 0; i < newCache.size(); ++i) {
+            const unsigned int dp = newCache[i];
+            cachePos[dp] = i < iCacheSize ? (int)i : -1;
+            vertexScore[dp] = ForsythVertexScore(cachePos[dp], iCacheSize, piNumTriPtr[dp]);
+        }
+
+        // rescore their faces and pick the best one for the next step
+        iBest = UINT_MAX;
+        float fBestScore = -1.f;
+        for (unsigned int i = 0; i < newCache.size(); ++i) {
+            const unsigned int dp = newCache[i];
+            const unsigned int* piList = adj.GetAdjacentTriangles(dp);
+            for (unsigned int tri = 0; tri < piNumTriPtrNoModify[dp]; ++tri) {
+                const unsigned int fidx = piList[tri];
+                if (!abEmitted[fidx]) {
+                    faceScore[fidx] = ForsythFaceScore(pMesh->mFaces[fidx], vertexScore);
+                    if (faceScore[fidx] > fBestScore) {
+                        fBestScore = faceScore[fidx];
+                        iBest = fidx;
+                    }
+                }
+            }
+        }
+
+        if (newCache.size() > iCacheSize) {
+            newCache.resize(iCacheSize);
+        }
+        cache.swap(newCache);
     }
-    // sort the output index buffer back to the input array
-    piCSIter = piIBOutput;
-    for (aiFace* pcFace = pMesh->mFaces; pcFace != pcEnd;++pcFace)  {
-        unsigned nind = pcFace->mNumIndices;
-        unsigned * ind = pcFace->mIndices;
-        if (nind > 0) ind[0] = *piCSIter++;
-        if (nind > 1) ind[1] = *piCSIter++;
-        if (nind > 2) ind[2] = *piCSIter++;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Splits the faces into clusters and sorts them for less overdraw, roughly following
+// Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw".
+void ImproveCacheLocalityProcess::ReorderOverdraw( const aiMesh* pMesh, unsigned int* piIndices) const
+{
+    const unsigned int iNumFaces = pMesh->mNumFaces;
+    FIFOCache cache(pMesh->mNumVertices, configCacheDepth);
+
+    // hard boundaries are where the cache is flushed anyway, i.e. all vertices of a face miss
+    std::vector<unsigned int> hardBoundaries;
+    for (unsigned int f = 0; f < iNumFaces; ++f) {
+        if (cache.AccessFace(piIndices + f * 3) == 3 || !f) {
+            hardBoundaries.push_back(f);
+        }
+    }
+    hardBoundaries.push_back(iNumFaces);
+
+    // soft boundaries split a cluster as soon as its first part on its own doesn't
+    // miss the cache more often than the threshold allows
+    std::vector<unsigned int> clusters;
+    for (unsigned int h = 0; h + 1 < hardBoundaries.size(); ++h) {
+        const unsigned int iBegin = hardBoundaries[h], iEnd = hardBoundaries[h + 1];
+
+        cache.Flush();
+        unsigned int iMisses = 0;
+        for (unsigned int f = iBegin; f < iEnd; ++f) {
+            iMisses += cache.AccessFace(piIndices + f * 3);
+        }
+        const float fThreshold = configOverdrawThreshold * iMisses / (iEnd - iBegin);
+
+        cache.Flush();
+        iMisses = 0;
+        unsigned int iStart = iBegin;
+        clusters.push_back(iBegin);
+        for (unsigned int f = iBegin; f < iEnd; ++f) {
+            iMisses += cache.AccessFace(piIndices + f * 3);
+            if (f + 1 < iEnd && (float)iMisses / (f + 1 - iStart) <= fThreshold) {
+                iStart = f + 1;
+                iMisses = 0;
+                clusters.push_back(iStart);
+                cache.Flush();
+            }
+        }
+    }
+    clusters.push_back(iNumFaces);
+    const unsigned int iNumClusters = static_cast<unsigned int>(clusters.size() - 1);
+
+    // area weighted center and normal of each cluster and the center of the mesh
+    std::vector<aiVector3D> clusterCenter(iNumClusters), clusterNormal(iNumClusters);
+    aiVector3D meshCenter;
+    ai_real fMeshArea = 0.0;
+    for (unsigned int c = 0; c < iNumClusters; ++c) {
+        ai_real fArea = 0.0;
+        for (unsigned int f = clusters[c]; f < clusters[c + 1]; ++f) {
+            const aiVector3D& p0 = pMesh->mVertices[piIndices[f * 3]];
+            const aiVector3D& p1 = pMesh->mVertices[piIndices[f * 3 + 1]];
+            const aiVector3D& p2 = pMesh->mVertices[piIndices[f * 3 + 2]];
+            const aiVector3D n = (p1 - p0) ^ (p2 - p0);
+            const ai_real fFaceArea = n.Length();
+            clusterCenter[c] += (p0 + p1 + p2) * fFaceArea;
+            clusterNormal[c] += n;
+            fArea += fFaceArea;
+        }
+        meshCenter += clusterCenter[c];
+        fMeshArea += fArea;
+        if (fArea > 0.0) {
+            clusterCenter[c] /= fArea * 3;
+        }
+    }
+    if (fMeshArea > 0.0) {
+        meshCenter /= fMeshArea * 3;
     }
 
-    // delete temporary storage
-    delete[] piCachingStamps;
-    delete[] piIBOutput;
-    delete[] piCandidates;
+    // draw the clusters facing away from the center first, they are the likely occluders
+    std::vector<float> sortKey(iNumClusters);
+    std::vector<unsigned int> order(iNumClusters);
+    for (unsigned int c = 0; c < iNumClusters; ++c) {
+        const ai_real fLength = clusterNormal[c].Length();
+        sortKey[c] = fLength > 0.0 ? (float)(((clusterCenter[c] - meshCenter) * clusterNormal[c]) / fLength) : 0.f;
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&sortKey](unsigned int a, unsigned int b) {
+        return sortKey[a] > sortKey[b];
+    });
+
+    const std::vector<unsigned int> input(piIndices, piIndices + iNumFaces * 3);
+    for (unsigned int c = 0; c < iNumClusters; ++c) {
+        const unsigned int* piBegin = &input[clusters[order[c]] * 3];
+        const unsigned int* piEnd = piBegin + (clusters[order[c] + 1] - clusters[order[c]]) * 3;
+        piIndices = std::copy(piBegin, piEnd, piIndices);
+    }
+}
 
-    return fACMR2;
+// ------------------------------------------------------------------------------------------------
+// Sorts the vertices in the order of their first use
+void ImproveCacheLocalityProcess::ReorderVertexFetch( aiMesh* pMesh) const
+{
+    const unsigned int iNumVertices = pMesh->mNumVertices;
+
+    std::vector<unsigned int> remap(iNumVertices, UINT_MAX);
+    unsigned int iNext = 0;
+    bool bIdentity = true;
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            unsigned int& idx = face.mIndices[i];
+            if (UINT_MAX == remap[idx]) {
+                bIdentity = bIdentity && idx == iNext;
+                remap[idx] = iNext++;
+            }
+            idx = remap[idx];
+        }
+    }
+    // unreferenced vertices go to the end
+    for (unsigned int v = 0; v < iNumVertices; ++v) {
+        if (UINT_MAX == remap[v]) {
+            bIdentity = bIdentity && v == iNext;
+            remap[v] = iNext++;
+        }
+    }
+    if (bIdentity) {
+        return;
+    }
+
+    RemapVertexArray(pMesh->mVertices, remap);
+    RemapVertexArray(pMesh->mNormals, remap);
+    RemapVertexArray(pMesh->mTangents, remap);
+    RemapVertexArray(pMesh->mBitangents, remap);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        RemapVertexArray(pMesh->mColors[c], remap);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        RemapVertexArray(pMesh->mTextureCoords[c], remap);
+    }
+
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        aiAnimMesh* pAnim = pMesh->mAnimMeshes[a];
+        if (pAnim->mNumVertices != iNumVertices) {
+            continue;
+        }
+        RemapVertexArray(pAnim->mVertices, remap);
+        RemapVertexArray(pAnim->mNormals, remap);
+        RemapVertexArray(pAnim->mTangents, remap);
+        RemapVertexArray(pAnim->mBitangents, remap);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            RemapVertexArray(pAnim->mColors[c], remap);
+        }
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+            RemapVertexArray(pAnim->mTextureCoords[c], remap);
+        }
+    }
+
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        aiBone* pBone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < pBone->mNumWeights; ++w) {
+            pBone->mWeights[w].mVertexId = remap[pBone->mWeights[w].mVertexId];
+        }
+    }
 }
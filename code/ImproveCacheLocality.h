@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include <assimp/types.h>
+#include <vector>
 
 struct aiMesh;
 
@@ -57,10 +58,12 @@ namespace Assimp
 /** The ImproveCacheLocalityProcess reorders all faces for improved vertex
  *  cache locality. It tries to arrange all faces to fans and to render
  *  faces which share vertices directly one after the other.
+ *  Optionally the faces are also reordered for less overdraw and the
+ *  vertices for sequential vertex fetch.
  *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess
 {
 public:
 
@@ -81,6 +84,32 @@ public:
     // Configures the pp step
     void SetupProperties(const Importer* pImp);
 
+    // -------------------------------------------------------------------
+    // The step works on each mesh independently, see BaseProcess
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
+
+    // setter for configMethod
+    inline void SetMethod(unsigned int method)
+    {
+        configMethod = method;
+    }
+
+    // setter for configOverdrawThreshold
+    inline void SetOverdrawThreshold(float f)
+    {
+        configOverdrawThreshold = f;
+    }
+
+    // setter for configVertexFetch
+    inline void SetVertexFetch(bool b)
+    {
+        configVertexFetch = b;
+    }
+
 protected:
     // -------------------------------------------------------------------
     /** Executes the postprocessing step on the given mesh
@@ -89,10 +118,51 @@ protected:
      */
     float ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
 
+    // -------------------------------------------------------------------
+    /** Reorders the faces of a mesh with the Tipsify algorithm.
+     * @param pMesh The mesh to process.
+     * @param piIBOutput Receives three indices per face.
+     */
+    void ReorderTipsify( aiMesh* pMesh, unsigned int* piIBOutput) const;
+
+    // -------------------------------------------------------------------
+    /** Reorders the faces of a mesh with Tom Forsyth's algorithm.
+     * @param pMesh The mesh to process.
+     * @param piIBOutput Receives three indices per face.
+     */
+    void ReorderForsyth( aiMesh* pMesh, unsigned int* piIBOutput) const;
+
+    // -------------------------------------------------------------------
+    /** Sorts clusters of cache optimized faces for less overdraw.
+     * @param pMesh The mesh the indices belong to.
+     * @param piIndices Three indices per face, reordered in place.
+     */
+    void ReorderOverdraw( const aiMesh* pMesh, unsigned int* piIndices) const;
+
+    // -------------------------------------------------------------------
+    /** Sorts the vertices of a mesh in the order the faces use them.
+     * @param pMesh The mesh to process.
+     */
+    void ReorderVertexFetch( aiMesh* pMesh) const;
+
 private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int configCacheDepth;
+
+    //! Configuration parameter: the reordering algorithm,
+    //! see #AI_CONFIG_PP_ICL_METHOD
+    unsigned int configMethod;
+
+    //! Configuration parameter: ACMR loss accepted for less overdraw,
+    //! 0 to disable the overdraw optimization
+    float configOverdrawThreshold;
+
+    //! Configuration parameter: reorder the vertices for vertex fetch
+    bool configVertexFetch;
+
+    //! Per-mesh result of the current pass, see ProcessMesh()
+    std::vector<float> meshACMR;
 };
 
 } // end of namespace Assimp
@@ -50,15 +50,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "JoinVerticesProcess.h"
 #include "ProcessHelper.h"
+#include "ThreadPool.h"
 #include <assimp/Vertex.h>
 #include <assimp/TinyFormatter.h>
 #include <stdio.h>
-#include <unordered_set>
+#include <string.h>
 
 using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 JoinVerticesProcess::JoinVerticesProcess()
+: configSpatialSortMethod( SpatialSort::Method_PlaneSort )
+, configExactMatch( false )
 {
     // nothing to do here
 }
@@ -76,33 +79,73 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup properties for the step
+void JoinVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    configSpatialSortMethod = pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_METHOD, AI_SPATIAL_SORT_PLANE) == AI_SPATIAL_SORT_GRID ?
+        SpatialSort::Method_HashGrid : SpatialSort::Method_PlaneSort;
+    configExactMatch = pImp->GetPropertyBool(AI_CONFIG_PP_JIV_EXACT_MATCH, false);
+}
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
+{
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool JoinVerticesProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint JoinVerticesProcess::GetMeshFootprint() const
+{
+    // all per-vertex data is rebuilt, bone weights and faces are remapped
+    return MeshFootprint(MeshComponent_All & ~MeshComponent_MeshList,
+        MeshComponent_All & ~MeshComponent_MeshList);
+}
+
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesProcess::BeginMeshPass( aiScene* pScene)
 {
     ASSIMP_LOG_DEBUG("JoinVerticesProcess begin");
 
-    // get the total number of vertices BEFORE the step is executed
-    int iNumOldVertices = 0;
-    if (!DefaultLogger::isNullLogger()) {
-        for( unsigned int a = 0; a < pScene->mNumMeshes; a++)   {
-            iNumOldVertices +=  pScene->mMeshes[a]->mNumVertices;
-        }
-    }
+    // the vertex counts BEFORE the step are taken per mesh in ExecuteOnMesh(),
+    // previous steps fused into the same pass may still change them
+    meshOldVertices.assign(pScene->mNumMeshes, 0);
+    meshNumVertices.assign(pScene->mNumMeshes, 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+    meshOldVertices[meshIndex] = static_cast<int>(pMesh->mNumVertices);
+    meshNumVertices[meshIndex] = ProcessMesh(pMesh, meshIndex);
+}
 
-    // execute the step
-    int iNumVertices = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesProcess::EndMeshPass( aiScene* pScene)
+{
+    int numOldVertices = 0, iNumVertices = 0;
+    for (size_t a = 0; a < meshNumVertices.size(); ++a) {
+        numOldVertices += meshOldVertices[a];
+        iNumVertices += meshNumVertices[a];
+    }
+    meshOldVertices.clear();
+    meshNumVertices.clear();
 
     // if logging is active, print detailed statistics
     if (!DefaultLogger::isNullLogger()) {
-        if (iNumOldVertices == iNumVertices) {
+        if (numOldVertices == iNumVertices) {
             ASSIMP_LOG_DEBUG("JoinVerticesProcess finished ");
         } else {
-            ASSIMP_LOG_INFO_F("JoinVerticesProcess finished | Verts in: ", iNumOldVertices,
+            ASSIMP_LOG_INFO_F("JoinVerticesProcess finished | Verts in: ", numOldVertices,
                 " out: ", iNumVertices, " | ~",
-                ((iNumOldVertices - iNumVertices) / (float)iNumOldVertices) * 100.f );
+                ((numOldVertices - iNumVertices) / (float)numOldVertices) * 100.f );
         }
     }
 
@@ -226,6 +269,170 @@ void updateXMeshVertices(XMesh *pMesh, std::vector<Vertex> &uniqueVertices) {
         }
     }
 }
+
+// One per-vertex component as seen by findExactDuplicates(): an array of fixed-size elements
+struct VertexStream {
+    const unsigned char* data;
+    size_t size;
+};
+
+template<class XMesh>
+void addVertexStreams(const XMesh *pMesh, std::vector<VertexStream> &streams) {
+    // same components as copied by updateXMeshVertices()
+    if (pMesh->mVertices) {
+        VertexStream s = { reinterpret_cast<const unsigned char*>(pMesh->mVertices), sizeof(aiVector3D) };
+        streams.push_back(s);
+    }
+    if (pMesh->mNormals) {
+        VertexStream s = { reinterpret_cast<const unsigned char*>(pMesh->mNormals), sizeof(aiVector3D) };
+        streams.push_back(s);
+    }
+    if (pMesh->mTangents) {
+        VertexStream s = { reinterpret_cast<const unsigned char*>(pMesh->mTangents), sizeof(aiVector3D) };
+        streams.push_back(s);
+    }
+    if (pMesh->mBitangents) {
+        VertexStream s = { reinterpret_cast<const unsigned char*>(pMesh->mBitangents), sizeof(aiVector3D) };
+        streams.push_back(s);
+    }
+    for (unsigned int a = 0; pMesh->HasVertexColors(a); a++) {
+        VertexStream s = { reinterpret_cast<const unsigned char*>(pMesh->mColors[a]), sizeof(aiColor4D) };
+        streams.push_back(s);
+    }
+    for (unsigned int a = 0; pMesh->HasTextureCoords(a); a++) {
+        VertexStream s = { reinterpret_cast<const unsigned char*>(pMesh->mTextureCoords[a]), sizeof(aiVector3D) };
+        streams.push_back(s);
+    }
+}
+
+inline uint64_t hashWords(uint64_t h, const unsigned char *data, size_t size) {
+    // FNV-1a on 32 bit words, all vertex components are a multiple of four bytes large
+    for (size_t i = 0; i < size; i += 4) {
+        uint32_t w;
+        ::memcpy(&w, data + i, 4);
+        h = (h ^ w) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finds vertices which are bit-identical in all components and bone weights, in a single pass
+// over the mesh. The vertices are hashed into an open-addressing table which refers to the
+// unique vertices found so far.
+void findExactDuplicates(const aiMesh *pMesh, const std::vector<bool> &usedVertices,
+        std::vector<Vertex> &uniqueVertices, std::vector<std::vector<Vertex>> &uniqueAnimatedVertices,
+        std::vector<unsigned int> &replaceIndex) {
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // the animated vertices have to match as well, anim meshes share the faces of the base mesh
+    std::vector<VertexStream> streams;
+    addVertexStreams(pMesh, streams);
+    for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+        addVertexStreams(pMesh->mAnimMeshes[animMeshIndex], streams);
+    }
+
+    // gather the bone weights per vertex. mVertexId is replaced by the bone index, so two
+    // vertices only match if they are influenced by the same bones with the same weights.
+    std::vector<unsigned int> weightStart(numVertices + 1, 0);
+    std::vector<aiVertexWeight> weights;
+    if (pMesh->mNumBones) {
+        for (unsigned int a = 0; a < pMesh->mNumBones; a++) {
+            const aiBone *bone = pMesh->mBones[a];
+            for (unsigned int b = 0; bone->mWeights && b < bone->mNumWeights; b++) {
+                ++weightStart[bone->mWeights[b].mVertexId + 1];
+            }
+        }
+        for (unsigned int a = 0; a < numVertices; a++) {
+            weightStart[a + 1] += weightStart[a];
+        }
+        weights.resize(weightStart[numVertices]);
+        std::vector<unsigned int> cursor(weightStart.begin(), weightStart.end() - 1);
+        for (unsigned int a = 0; a < pMesh->mNumBones; a++) {
+            const aiBone *bone = pMesh->mBones[a];
+            for (unsigned int b = 0; bone->mWeights && b < bone->mNumWeights; b++) {
+                aiVertexWeight &w = weights[cursor[bone->mWeights[b].mVertexId]++];
+                w.mVertexId = a;
+                w.mWeight = bone->mWeights[b].mWeight;
+            }
+        }
+    }
+
+    const auto hashVertex = [&](unsigned int v) -> uint64_t {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (const VertexStream &s : streams) {
+            h = hashWords(h, s.data + v * s.size, s.size);
+        }
+        for (unsigned int a = weightStart[v]; a < weightStart[v + 1]; a++) {
+            h = hashWords(h, reinterpret_cast<const unsigned char*>(&weights[a].mVertexId), sizeof(unsigned int));
+            h = hashWords(h, reinterpret_cast<const unsigned char*>(&weights[a].mWeight), sizeof(weights[a].mWeight));
+        }
+        // FNV leaves the low bits badly mixed, but these select the slot
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    };
+
+    const auto isEqual = [&](unsigned int lhs, unsigned int rhs) {
+        for (const VertexStream &s : streams) {
+            if (::memcmp(s.data + lhs * s.size, s.data + rhs * s.size, s.size)) {
+                return false;
+            }
+        }
+        const unsigned int numWeights = weightStart[lhs + 1] - weightStart[lhs];
+        if (numWeights != weightStart[rhs + 1] - weightStart[rhs]) {
+            return false;
+        }
+        for (unsigned int a = 0; a < numWeights; a++) {
+            const aiVertexWeight &lw = weights[weightStart[lhs] + a], &rw = weights[weightStart[rhs] + a];
+            if (lw.mVertexId != rw.mVertexId || ::memcmp(&lw.mWeight, &rw.mWeight, sizeof(lw.mWeight))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // linear probing, the table is kept at most half full
+    size_t numSlots = 16;
+    while (numSlots < size_t(numVertices) * 2) {
+        numSlots <<= 1;
+    }
+    const size_t slotMask = numSlots - 1;
+    std::vector<unsigned int> slots(numSlots, 0xffffffff);
+
+    // hash and source vertex of each unique vertex
+    std::vector<uint64_t> uniqueHash;
+    std::vector<unsigned int> uniqueSource;
+    uniqueHash.reserve(numVertices);
+    uniqueSource.reserve(numVertices);
+
+    for (unsigned int a = 0; a < numVertices; a++) {
+        if (!usedVertices[a]) {
+            continue;
+        }
+
+        const uint64_t h = hashVertex(a);
+        for (size_t slot = h & slotMask; ; slot = (slot + 1) & slotMask) {
+            const unsigned int uidx = slots[slot];
+            if (uidx == 0xffffffff) {
+                // no unique vertex matches it up to now -> so add it
+                slots[slot] = replaceIndex[a] = (unsigned int)uniqueVertices.size();
+                uniqueVertices.push_back(Vertex(pMesh, a));
+                for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+                    uniqueAnimatedVertices[animMeshIndex].push_back(Vertex(pMesh->mAnimMeshes[animMeshIndex], a));
+                }
+                uniqueHash.push_back(h);
+                uniqueSource.push_back(a);
+                break;
+            }
+            if (uniqueHash[uidx] == h && isEqual(a, uniqueSource[uidx])) {
+                replaceIndex[a] = uidx | 0x80000000;
+                break;
+            }
+        }
+    }
+}
+
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -243,13 +450,12 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     // We should care only about used vertices, not all of them
     // (this can happen due to original file vertices buffer being used by
     // multiple meshes)
-    std::unordered_set<unsigned int> usedVertexIndices;
-    usedVertexIndices.reserve(pMesh->mNumVertices);
+    std::vector<bool> usedVertices(pMesh->mNumVertices, false);
     for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
     {
         aiFace& face = pMesh->mFaces[a];
         for( unsigned int b = 0; b < face.mNumIndices; b++) {
-            usedVertexIndices.insert(face.mIndices[b]);
+            usedVertices[face.mIndices[b]] = true;
         }
     }
 
@@ -265,31 +471,6 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
     std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
 
-    // float posEpsilonSqr;
-    SpatialSort* vertexFinder = NULL;
-    SpatialSort _vertexFinder;
-
-    typedef std::pair<SpatialSort,float> SpatPair;
-    if (shared) {
-        std::vector<SpatPair >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)    {
-            SpatPair& blubb = (*avf)[meshIndex];
-            vertexFinder  = &blubb.first;
-            // posEpsilonSqr = blubb.second;
-        }
-    }
-    if (!vertexFinder)  {
-        // bad, need to compute it.
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        // posEpsilonSqr = ComputePositionEpsilon(pMesh);
-    }
-
-    // Again, better waste some bytes than a realloc ...
-    std::vector<unsigned int> verticesFound;
-    verticesFound.reserve(10);
-
     // Run an optimized code path if we don't have multiple UVs or vertex colors.
     // This should yield false in more than 99% of all imports ...
     const bool complex = ( pMesh->GetNumColorChannels() > 0 || pMesh->GetNumUVChannels() > 1);
@@ -304,69 +485,113 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         }
     }
 
-    // Now check each vertex if it brings something new to the table
-    for( unsigned int a = 0; a < pMesh->mNumVertices; a++)  {
-        if (usedVertexIndices.find(a) == usedVertexIndices.end()) {
-            continue;
+    if (configExactMatch) {
+        // bit-identical vertices hash to the same slot, no spatial search needed
+        findExactDuplicates(pMesh, usedVertices, uniqueVertices, uniqueAnimatedVertices, replaceIndex);
+    } else {
+        // float posEpsilonSqr;
+        SpatialSort* vertexFinder = NULL;
+        SpatialSort _vertexFinder;
+
+        typedef std::pair<SpatialSort,float> SpatPair;
+        if (shared) {
+            std::vector<SpatPair >* avf;
+            shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
+            if (avf)    {
+                SpatPair& blubb = (*avf)[meshIndex];
+                vertexFinder  = &blubb.first;
+                // posEpsilonSqr = blubb.second;
+            }
+        }
+        if (!vertexFinder)  {
+            // bad, need to compute it.
+            _vertexFinder.SetMethod(configSpatialSortMethod);
+            _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D), false);
+            _vertexFinder.Finalize(threadPool);
+            vertexFinder = &_vertexFinder;
+            // posEpsilonSqr = ComputePositionEpsilon(pMesh);
         }
 
-        // collect the vertex data
-        Vertex v(pMesh,a);
+        // Again, better waste some bytes than a realloc ...
+        std::vector<unsigned int> verticesFound;
+        verticesFound.reserve(10);
 
-        // collect all vertices that are close enough to the given position
-        vertexFinder->FindIdenticalPositions( v.position, verticesFound);
-        unsigned int matchIndex = 0xffffffff;
+        // With more than one thread at hand, run all queries up front in parallel. The found
+        // vertices are the same, so the result doesn't depend on the number of threads.
+        std::vector<unsigned int> foundOffsets, foundTable;
+        const bool batched = NULL != threadPool && threadPool->GetNumThreads() > 1;
+        if (batched) {
+            vertexFinder->FindAllIdenticalPositions(foundOffsets, foundTable, threadPool);
+        }
 
-        // check all unique vertices close to the position if this vertex is already present among them
-        for( unsigned int b = 0; b < verticesFound.size(); b++) {
-            const unsigned int vidx = verticesFound[b];
-            const unsigned int uidx = replaceIndex[ vidx];
-            if( uidx & 0x80000000)
+        // Now check each vertex if it brings something new to the table
+        for( unsigned int a = 0; a < pMesh->mNumVertices; a++)  {
+            if (!usedVertices[a]) {
                 continue;
+            }
 
-            const Vertex& uv = uniqueVertices[ uidx];
+            // collect the vertex data
+            Vertex v(pMesh,a);
 
-            if (!areVerticesEqual(v, uv, complex)) {
-                continue;
+            // collect all vertices that are close enough to the given position
+            if (batched) {
+                verticesFound.assign(foundTable.begin() + foundOffsets[a], foundTable.begin() + foundOffsets[a + 1]);
+            } else {
+                vertexFinder->FindIdenticalPositions( v.position, verticesFound);
             }
+            unsigned int matchIndex = 0xffffffff;
 
-            if (hasAnimMeshes) {
-                // If given vertex is animated, then it has to be preserver 1 to 1 (base mesh and animated mesh require same topology)
-                // NOTE: not doing this totaly breaks anim meshes as they don't have their own faces (they use pMesh->mFaces)
-                bool breaksAnimMesh = false;
-                for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
-                    const Vertex& animatedUV = uniqueAnimatedVertices[animMeshIndex][ uidx];
-                    Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
-                    if (!areVerticesEqual(aniMeshVertex, animatedUV, complex)) {
-                        breaksAnimMesh = true;
-                        break;
-                    }
-                }
-                if (breaksAnimMesh) {
+            // check all unique vertices close to the position if this vertex is already present among them
+            for( unsigned int b = 0; b < verticesFound.size(); b++) {
+                const unsigned int vidx = verticesFound[b];
+                const unsigned int uidx = replaceIndex[ vidx];
+                if( uidx & 0x80000000)
+                    continue;
+
+                const Vertex& uv = uniqueVertices[ uidx];
+
+                if (!areVerticesEqual(v, uv, complex)) {
                     continue;
                 }
-            }
 
-            // we're still here -> this vertex perfectly matches our given vertex
-            matchIndex = uidx;
-            break;
-        }
+                if (hasAnimMeshes) {
+                    // If given vertex is animated, then it has to be preserver 1 to 1 (base mesh and animated mesh require same topology)
+                    // NOTE: not doing this totaly breaks anim meshes as they don't have their own faces (they use pMesh->mFaces)
+                    bool breaksAnimMesh = false;
+                    for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+                        const Vertex& animatedUV = uniqueAnimatedVertices[animMeshIndex][ uidx];
+                        Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
+                        if (!areVerticesEqual(aniMeshVertex, animatedUV, complex)) {
+                            breaksAnimMesh = true;
+                            break;
+                        }
+                    }
+                    if (breaksAnimMesh) {
+                        continue;
+                    }
+                }
 
-        // found a replacement vertex among the uniques?
-        if( matchIndex != 0xffffffff)
-        {
-            // store where to found the matching unique vertex
-            replaceIndex[a] = matchIndex | 0x80000000;
-        }
-        else
-        {
-            // no unique vertex matches it up to now -> so add it
-            replaceIndex[a] = (unsigned int)uniqueVertices.size();
-            uniqueVertices.push_back( v);
-            if (hasAnimMeshes) {
-                for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
-                    Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
-                    uniqueAnimatedVertices[animMeshIndex].push_back(aniMeshVertex);
+                // we're still here -> this vertex perfectly matches our given vertex
+                matchIndex = uidx;
+                break;
+            }
+
+            // found a replacement vertex among the uniques?
+            if( matchIndex != 0xffffffff)
+            {
+                // store where to found the matching unique vertex
+                replaceIndex[a] = matchIndex | 0x80000000;
+            }
+            else
+            {
+                // no unique vertex matches it up to now -> so add it
+                replaceIndex[a] = (unsigned int)uniqueVertices.size();
+                uniqueVertices.push_back( v);
+                if (hasAnimMeshes) {
+                    for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+                        Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
+                        uniqueAnimatedVertices[animMeshIndex].push_back(aniMeshVertex);
+                    }
                 }
             }
         }
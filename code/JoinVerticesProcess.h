@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include <assimp/types.h>
+#include <assimp/SpatialSort.h>
+#include <vector>
 
 struct aiMesh;
 
@@ -76,6 +78,13 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
@@ -83,6 +92,14 @@ public:
     */
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** The step works on each mesh independently, see BaseProcess. */
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
+
 public:
     // -------------------------------------------------------------------
     /** Unites identical vertices in the given mesh.
@@ -92,6 +109,17 @@ public:
     int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
 private:
+    /** Configuration option: spatial index used to find close vertices */
+    SpatialSort::Method configSpatialSortMethod;
+
+    /** Configuration option: join bit-identical vertices only */
+    bool configExactMatch;
+
+    /** Per-mesh number of input vertices of the current pass */
+    std::vector<int> meshOldVertices;
+
+    /** Per-mesh result of the current pass: number of output vertices */
+    std::vector<int> meshNumVertices;
 };
 
 } // end of namespace Assimp
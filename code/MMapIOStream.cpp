@@ -0,0 +1,214 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file  MMapIOStream.cpp
+ *  @brief Read-only file I/O on top of memory-mapped files
+ */
+
+#include <assimp/ai_assert.h>
+#include <assimp/MMapIOStream.h>
+
+#include <algorithm>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace Assimp;
+
+// ----------------------------------------------------------------------------------
+MMapIOStream::MMapIOStream(const uint8_t* data, size_t size) AI_NO_EXCEPT
+: mData(data)
+, mSize(size)
+, mPos(0) {
+    // empty
+}
+
+// ----------------------------------------------------------------------------------
+MMapIOStream::~MMapIOStream()
+{
+#ifdef _WIN32
+    ::UnmapViewOfFile(mData);
+#else
+    ::munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+}
+
+// ----------------------------------------------------------------------------------
+MMapIOStream* MMapIOStream::Map(const char* pFile)
+{
+    ai_assert(NULL != pFile);
+
+#ifdef _WIN32
+    HANDLE file;
+    bool isUnicode = IsTextUnicode(pFile, static_cast<int>(strlen(pFile)), NULL) != 0;
+    if (isUnicode) {
+        wchar_t fileName16[MAX_PATH];
+        MultiByteToWideChar(CP_UTF8, MB_PRECOMPOSED, pFile, -1, fileName16, MAX_PATH);
+        file = ::CreateFileW(fileName16, GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    } else {
+        file = ::CreateFileA(pFile, GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    }
+    if (INVALID_HANDLE_VALUE == file) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || 0 == size.QuadPart ||
+            static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX) {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    // the view keeps the mapping and the file alive, the handles are not needed anymore
+    HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    ::CloseHandle(file);
+    if (NULL == mapping) {
+        return nullptr;
+    }
+    const void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (NULL == data) {
+        return nullptr;
+    }
+    return new MMapIOStream(static_cast<const uint8_t*>(data), static_cast<size_t>(size.QuadPart));
+#else
+    const int fd = ::open(pFile, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat fileStat;
+    if (0 != ::fstat(fd, &fileStat) || !S_ISREG(fileStat.st_mode) || 0 == fileStat.st_size ||
+            static_cast<unsigned long long>(fileStat.st_size) > SIZE_MAX) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    // the mapping keeps the file alive, the descriptor is not needed anymore
+    const size_t size = static_cast<size_t>(fileStat.st_size);
+    void* data = ::mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == data) {
+        return nullptr;
+    }
+    return new MMapIOStream(static_cast<const uint8_t*>(data), size);
+#endif
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::Read(void* pvBuffer,
+    size_t pSize,
+    size_t pCount)
+{
+    ai_assert(NULL != pvBuffer && 0 != pSize && 0 != pCount);
+    const size_t cnt = std::min(pCount, (mSize - mPos) / pSize), ofs = pSize * cnt;
+
+    ::memcpy(pvBuffer, mData + mPos, ofs);
+    mPos += ofs;
+
+    return cnt;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::Write(const void* /*pvBuffer*/,
+    size_t /*pSize*/,
+    size_t /*pCount*/)
+{
+    return 0;
+}
+
+// ----------------------------------------------------------------------------------
+aiReturn MMapIOStream::Seek(size_t pOffset,
+     aiOrigin pOrigin)
+{
+    if (aiOrigin_SET == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        mPos = pOffset;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        mPos = mSize - pOffset;
+    } else {
+        if (pOffset + mPos > mSize) {
+            return AI_FAILURE;
+        }
+        mPos += pOffset;
+    }
+    return AI_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::Tell() const
+{
+    return mPos;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::FileSize() const
+{
+    return mSize;
+}
+
+// ----------------------------------------------------------------------------------
+void MMapIOStream::Flush()
+{
+    // empty
+}
+
+// ----------------------------------------------------------------------------------
+const uint8_t* MMapIOStream::GetContiguousView(size_t& len)
+{
+    len = mSize;
+    return mData;
+}
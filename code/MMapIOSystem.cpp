@@ -0,0 +1,83 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file  MMapIOSystem.cpp
+ *  @brief IOSystem which maps the files to read into memory
+ */
+
+#include <assimp/MMapIOSystem.h>
+#include <assimp/MMapIOStream.h>
+#include <assimp/ai_assert.h>
+
+#include <string.h>
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+// Open a new file with a given path.
+IOStream* MMapIOSystem::Open( const char* strFile, const char* strMode)
+{
+    ai_assert(NULL != strFile);
+    ai_assert(NULL != strMode);
+
+    // only read-only access can be served from the mapping. On Windows, text mode
+    // translates line endings, so leave that to the C runtime as well.
+    const bool readOnly = NULL != ::strchr(strMode, 'r') && NULL == ::strpbrk(strMode, "wa+");
+#ifdef _WIN32
+    const bool mappable = readOnly && NULL != ::strchr(strMode, 'b');
+#else
+    const bool mappable = readOnly;
+#endif
+    if (mappable) {
+        if (IOStream* stream = MMapIOStream::Map(strFile)) {
+            return stream;
+        }
+    }
+    return DefaultIOSystem::Open(strFile, strMode);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Closes the given file and releases all resources associated with it.
+void MMapIOSystem::Close( IOStream* pFile)
+{
+    delete pFile;
+}
@@ -58,34 +58,28 @@ struct Material;
 
 // ------------------------------------------------------------------------------------------------
 //! \struct Face
-//! \brief  Data structure for a simple obj-face, describes discredit,l.ation and materials
+//! \brief  Data structure for a simple obj-face. The indices of all faces of a mesh are stored
+//!         back to back in Mesh::m_Indices, a face only keeps its offset and counts.
 // ------------------------------------------------------------------------------------------------
 struct Face {
-    typedef std::vector<unsigned int> IndexArray;
-
     //! Primitive type
     aiPrimitiveType m_PrimitiveType;
-    //! Vertex indices
-    IndexArray m_vertices;
-    //! Normal indices
-    IndexArray m_normals;
-    //! Texture coordinates indices
-    IndexArray m_texturCoords;
-    //! Pointer to assigned material
-    Material *m_pMaterial;
+    //! Offset of the first vertex index in Mesh::m_Indices
+    unsigned int m_uiIndexOffset;
+    //! Number of vertex indices
+    unsigned int m_uiNumVertices;
+    //! Number of normal indices, stored after the vertex indices
+    unsigned int m_uiNumNormals;
+    //! Number of texture coordinate indices, stored after the normal indices
+    unsigned int m_uiNumTexCoords;
 
     //! \brief  Default constructor
-    Face( aiPrimitiveType pt = aiPrimitiveType_POLYGON) 
+    Face( aiPrimitiveType pt = aiPrimitiveType_POLYGON)
     : m_PrimitiveType( pt )
-    , m_vertices()
-    , m_normals()
-    , m_texturCoords()
-    , m_pMaterial( 0L ) {
-        // empty
-    }
-
-    //! \brief  Destructor
-    ~Face() {
+    , m_uiIndexOffset( 0 )
+    , m_uiNumVertices( 0 )
+    , m_uiNumNormals( 0 )
+    , m_uiNumTexCoords( 0 ) {
         // empty
     }
 };
@@ -211,8 +205,10 @@ struct Mesh {
     static const unsigned int NoMaterial = ~0u;
     /// The name for the mesh
     std::string m_name;
-    /// Array with pointer to all stored faces
-    std::vector<Face*> m_Faces;
+    /// Array with all stored faces
+    std::vector<Face> m_Faces;
+    /// Vertex, normal and texture coordinate indices of all faces, see Face
+    std::vector<unsigned int> m_Indices;
     /// Assigned material
     Material *m_pMaterial;
     /// Number of stored indices.
@@ -238,11 +234,22 @@ struct Mesh {
 
     /// Destructor
     ~Mesh() {
-        for (std::vector<Face*>::iterator it = m_Faces.begin();
-            it != m_Faces.end(); ++it)
-        {
-            delete *it;
-        }
+        // empty
+    }
+
+    /// Returns the vertex indices of a face of this mesh
+    const unsigned int *getVertices( const Face &face ) const {
+        return m_Indices.data() + face.m_uiIndexOffset;
+    }
+
+    /// Returns the normal indices of a face of this mesh
+    const unsigned int *getNormals( const Face &face ) const {
+        return getVertices( face ) + face.m_uiNumVertices;
+    }
+
+    /// Returns the texture coordinate indices of a face of this mesh
+    const unsigned int *getTexCoords( const Face &face ) const {
+        return getNormals( face ) + face.m_uiNumNormals;
     }
 };
 
@@ -125,8 +125,6 @@ void ObjFileImporter::InternReadFile( const std::string &file, aiScene* pScene,
         throw DeadlyImportError( "OBJ-file is too small.");
     }
 
-    IOStreamBuffer<char> streamedBuffer;
-    streamedBuffer.open( fileStream.get() );
 
     // Allocate buffer and read file into it
     //TextFileToBuffer( fileStream.get(),m_Buffer);
@@ -176,13 +174,24 @@ void ObjFileImporter::InternReadFile( const std::string &file, aiScene* pScene,
     // 1/3rd progress
     m_progress->UpdateFileRead(1, 3);
 
-    // parse the file into a temporary representation
-    ObjFileParser parser( streamedBuffer, modelName, pIOHandler, m_progress, file);
+    // parse the file into a temporary representation, in parallel chunks
+    // if we got worker threads
+    if ( nullptr != m_threadPool ) {
+        ObjFileParser parser( fileStream.get(), modelName, pIOHandler, m_progress, file, m_threadPool );
 
-    // And create the proper return structures out of it
-    CreateDataFromImport(parser.GetModel(), pScene);
+        // And create the proper return structures out of it
+        CreateDataFromImport(parser.GetModel(), pScene);
+    } else {
+        IOStreamBuffer<char> streamedBuffer;
+        streamedBuffer.open( fileStream.get() );
+
+        ObjFileParser parser( streamedBuffer, modelName, pIOHandler, m_progress, file);
 
-    streamedBuffer.close();
+        // And create the proper return structures out of it
+        CreateDataFromImport(parser.GetModel(), pScene);
+
+        streamedBuffer.close();
+    }
 
     // Clean up allocated storage for the next import
     m_Buffer.clear();
@@ -371,18 +380,17 @@ aiMesh *ObjFileImporter::createTopology( const ObjFile::Model* pModel, const Obj
 
     for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++)
     {
-        ObjFile::Face *const inp = pObjMesh->m_Faces[ index ];
-        ai_assert( NULL != inp  );
+        const ObjFile::Face &inp = pObjMesh->m_Faces[ index ];
 
-        if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-            pMesh->mNumFaces += static_cast<unsigned int>(inp->m_vertices.size() - 1);
+        if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+            pMesh->mNumFaces += inp.m_uiNumVertices - 1;
             pMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-        } else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-            pMesh->mNumFaces += static_cast<unsigned int>(inp->m_vertices.size());
+        } else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+            pMesh->mNumFaces += inp.m_uiNumVertices;
             pMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
         } else {
             ++pMesh->mNumFaces;
-            if (inp->m_vertices.size() > 3) {
+            if (inp.m_uiNumVertices > 3) {
                 pMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
             } else {
                 pMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
@@ -401,17 +409,17 @@ aiMesh *ObjFileImporter::createTopology( const ObjFile::Model* pModel, const Obj
 
         // Copy all data from all stored meshes
         for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++) {
-            ObjFile::Face* const inp = pObjMesh->m_Faces[ index ];
-            if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-                for(size_t i = 0; i < inp->m_vertices.size() - 1; ++i) {
+            const ObjFile::Face &inp = pObjMesh->m_Faces[ index ];
+            if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+                for(unsigned int i = 0; i < inp.m_uiNumVertices - 1; ++i) {
                     aiFace& f = pMesh->mFaces[ outIndex++ ];
                     uiIdxCount += f.mNumIndices = 2;
                     f.mIndices = new unsigned int[2];
                 }
                 continue;
             }
-            else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-                for(size_t i = 0; i < inp->m_vertices.size(); ++i) {
+            else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+                for(unsigned int i = 0; i < inp.m_uiNumVertices; ++i) {
                     aiFace& f = pMesh->mFaces[ outIndex++ ];
                     uiIdxCount += f.mNumIndices = 1;
                     f.mIndices = new unsigned int[1];
@@ -420,7 +428,7 @@ aiMesh *ObjFileImporter::createTopology( const ObjFile::Model* pModel, const Obj
             }
 
             aiFace *pFace = &pMesh->mFaces[ outIndex++ ];
-            const unsigned int uiNumIndices = (unsigned int) pObjMesh->m_Faces[ index ]->m_vertices.size();
+            const unsigned int uiNumIndices = inp.m_uiNumVertices;
             uiIdxCount += pFace->mNumIndices = (unsigned int) uiNumIndices;
             if (pFace->mNumIndices > 0) {
                 pFace->mIndices = new unsigned int[ uiNumIndices ];
@@ -481,12 +489,15 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
     // Copy vertices, normals and textures into aiMesh instance
     unsigned int newIndex = 0, outIndex = 0;
     for ( size_t index=0; index < pObjMesh->m_Faces.size(); index++ ) {
-        // Get source face
-        ObjFile::Face *pSourceFace = pObjMesh->m_Faces[ index ];
+        // Get source face and its index arrays
+        const ObjFile::Face *pSourceFace = &pObjMesh->m_Faces[ index ];
+        const unsigned int *vertices = pObjMesh->getVertices( *pSourceFace );
+        const unsigned int *normals = pObjMesh->getNormals( *pSourceFace );
+        const unsigned int *texCoords = pObjMesh->getTexCoords( *pSourceFace );
 
         // Copy all index arrays
-        for ( size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < pSourceFace->m_vertices.size(); vertexIndex++ ) {
-            const unsigned int vertex = pSourceFace->m_vertices.at( vertexIndex );
+        for ( unsigned int vertexIndex = 0, outVertexIndex = 0; vertexIndex < pSourceFace->m_uiNumVertices; vertexIndex++ ) {
+            const unsigned int vertex = vertices[ vertexIndex ];
             if ( vertex >= pModel->m_Vertices.size() ) {
                 throw DeadlyImportError( "OBJ: vertex index out of range" );
             }
@@ -498,8 +509,8 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
             pMesh->mVertices[ newIndex ] = pModel->m_Vertices[ vertex ];
 
             // Copy all normals
-            if ( !pModel->m_Normals.empty() && vertexIndex < pSourceFace->m_normals.size()) {
-                const unsigned int normal = pSourceFace->m_normals.at( vertexIndex );
+            if ( !pModel->m_Normals.empty() && vertexIndex < pSourceFace->m_uiNumNormals) {
+                const unsigned int normal = normals[ vertexIndex ];
                 if ( normal >= pModel->m_Normals.size() ) {
                     throw DeadlyImportError( "OBJ: vertex normal index out of range" );
                 }
@@ -514,9 +525,9 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
             }
 
             // Copy all texture coordinates
-            if ( !pModel->m_TextureCoord.empty() && vertexIndex < pSourceFace->m_texturCoords.size())
+            if ( !pModel->m_TextureCoord.empty() && vertexIndex < pSourceFace->m_uiNumTexCoords)
             {
-                const unsigned int tex = pSourceFace->m_texturCoords.at( vertexIndex );
+                const unsigned int tex = texCoords[ vertexIndex ];
 
                 if ( tex >= pModel->m_TextureCoord.size() )
                     throw DeadlyImportError("OBJ: texture coordinate index out of range");
@@ -528,7 +539,7 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
             // Get destination face
             aiFace *pDestFace = &pMesh->mFaces[ outIndex ];
 
-            const bool last = ( vertexIndex == pSourceFace->m_vertices.size() - 1 );
+            const bool last = ( vertexIndex == pSourceFace->m_uiNumVertices - 1 );
             if (pSourceFace->m_PrimitiveType != aiPrimitiveType_LINE || !last) {
                 pDestFace->mIndices[ outVertexIndex ] = newIndex;
                 outVertexIndex++;
@@ -546,7 +557,7 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
                 if (vertexIndex) {
                     if(!last) {
                         pMesh->mVertices[ newIndex+1 ] = pMesh->mVertices[ newIndex ];
-                        if ( !pSourceFace->m_normals.empty() && !pModel->m_Normals.empty()) {
+                        if ( pSourceFace->m_uiNumNormals > 0 && !pModel->m_Normals.empty()) {
                             pMesh->mNormals[ newIndex+1 ] = pMesh->mNormals[newIndex ];
                         }
                         if ( !pModel->m_TextureCoord.empty() ) {
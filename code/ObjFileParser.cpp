@@ -52,7 +52,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/material.h>
 #include <assimp/Importer.hpp>
+#include <assimp/fast_atof.h>
+#include "ThreadPool.h"
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 
 namespace Assimp {
 
@@ -80,6 +84,33 @@ ObjFileParser::ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::str
     m_progress(progress),
     m_originalObjFileName(originalObjFileName)
 {
+    createModel( modelName );
+
+    // Start parsing the file
+    parseFile( streamBuffer );
+}
+
+ObjFileParser::ObjFileParser( IOStream *stream, const std::string &modelName,
+                              IOSystem *io, ProgressHandler* progress,
+                              const std::string &originalObjFileName, ThreadPool *pool ) :
+    m_DataIt(),
+    m_DataItEnd(),
+    m_pModel(nullptr),
+    m_uiLine(0),
+    m_pIO( io ),
+    m_progress(progress),
+    m_originalObjFileName(originalObjFileName)
+{
+    createModel( modelName );
+
+    // Start parsing the file
+    parseFileParallel( stream, pool );
+}
+
+ObjFileParser::~ObjFileParser() {
+}
+
+void ObjFileParser::createModel( const std::string &modelName ) {
     std::fill_n(m_buffer,Buffersize,0);
 
     // Create the model instance to store all the data
@@ -91,12 +122,6 @@ ObjFileParser::ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::str
     m_pModel->m_pDefaultMaterial->MaterialName.Set( DEFAULT_MATERIAL );
     m_pModel->m_MaterialLib.push_back( DEFAULT_MATERIAL );
     m_pModel->m_MaterialMap[ DEFAULT_MATERIAL ] = m_pModel->m_pDefaultMaterial;
-
-    // Start parsing the file
-    parseFile( streamBuffer );
-}
-
-ObjFileParser::~ObjFileParser() {
 }
 
 void ObjFileParser::setBuffer( std::vector<char> &buffer ) {
@@ -132,111 +157,115 @@ void ObjFileParser::parseFile( IOStreamBuffer<char> &streamBuffer ) {
             m_progress->UpdateFileRead( progressOffset + processed * 2, progressTotal );
         }
 
-        // parse line
-        switch (*m_DataIt) {
-        case 'v': // Parse a vertex texture coordinate
-            {
-                ++m_DataIt;
-                if (*m_DataIt == ' ' || *m_DataIt == '\t') {
-                    size_t numComponents = getNumComponentsInDataDefinition();
-                    if (numComponents == 3) {
-                        // read in vertex definition
-                        getVector3(m_pModel->m_Vertices);
-                    } else if (numComponents == 4) {
-                        // read in vertex definition (homogeneous coords)
-                        getHomogeneousVector3(m_pModel->m_Vertices);
-                    } else if (numComponents == 6) {
-                        // read vertex and vertex-color
-                        getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
-                    }
-                } else if (*m_DataIt == 't') {
-                    // read in texture coordinate ( 2D or 3D )
-                    ++m_DataIt;
-                    getVector( m_pModel->m_TextureCoord );
-                } else if (*m_DataIt == 'n') {
-                    // Read in normal vector definition
-                    ++m_DataIt;
-                    getVector3( m_pModel->m_Normals );
+        parseLine();
+    }
+}
+
+void ObjFileParser::parseLine() {
+    // parse line
+    switch (*m_DataIt) {
+    case 'v': // Parse a vertex texture coordinate
+        {
+            ++m_DataIt;
+            if (*m_DataIt == ' ' || *m_DataIt == '\t') {
+                size_t numComponents = getNumComponentsInDataDefinition();
+                if (numComponents == 3) {
+                    // read in vertex definition
+                    getVector3(m_pModel->m_Vertices);
+                } else if (numComponents == 4) {
+                    // read in vertex definition (homogeneous coords)
+                    getHomogeneousVector3(m_pModel->m_Vertices);
+                } else if (numComponents == 6) {
+                    // read vertex and vertex-color
+                    getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
                 }
+            } else if (*m_DataIt == 't') {
+                // read in texture coordinate ( 2D or 3D )
+                ++m_DataIt;
+                getVector( m_pModel->m_TextureCoord );
+            } else if (*m_DataIt == 'n') {
+                // Read in normal vector definition
+                ++m_DataIt;
+                getVector3( m_pModel->m_Normals );
             }
-            break;
+        }
+        break;
 
-        case 'p': // Parse a face, line or point statement
-        case 'l':
-        case 'f':
-            {
-                getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l'
-                    ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
-            }
-            break;
+    case 'p': // Parse a face, line or point statement
+    case 'l':
+    case 'f':
+        {
+            getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l'
+                ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+        }
+        break;
 
-        case '#': // Parse a comment
-            {
-                getComment();
-            }
-            break;
+    case '#': // Parse a comment
+        {
+            getComment();
+        }
+        break;
 
-        case 'u': // Parse a material desc. setter
-            {
-                std::string name;
+    case 'u': // Parse a material desc. setter
+        {
+            std::string name;
 
-                getNameNoSpace(m_DataIt, m_DataItEnd, name);
+            getNameNoSpace(m_DataIt, m_DataItEnd, name);
 
-                size_t nextSpace = name.find(" ");
-                if (nextSpace != std::string::npos)
-                    name = name.substr(0, nextSpace);
+            size_t nextSpace = name.find(" ");
+            if (nextSpace != std::string::npos)
+                name = name.substr(0, nextSpace);
 
-                if(name == "usemtl")
-                {
-                    getMaterialDesc();
-                }
+            if(name == "usemtl")
+            {
+                getMaterialDesc();
             }
-            break;
+        }
+        break;
 
-        case 'm': // Parse a material library or merging group ('mg')
-            {
-                std::string name;
+    case 'm': // Parse a material library or merging group ('mg')
+        {
+            std::string name;
 
-                getNameNoSpace(m_DataIt, m_DataItEnd, name);
+            getNameNoSpace(m_DataIt, m_DataItEnd, name);
 
-                size_t nextSpace = name.find(" ");
-                if (nextSpace != std::string::npos)
-                    name = name.substr(0, nextSpace);
+            size_t nextSpace = name.find(" ");
+            if (nextSpace != std::string::npos)
+                name = name.substr(0, nextSpace);
 
-                if (name == "mg")
-                    getGroupNumberAndResolution();
-                else if(name == "mtllib")
-                    getMaterialLib();
+            if (name == "mg")
+                getGroupNumberAndResolution();
+            else if(name == "mtllib")
+                getMaterialLib();
 				else
 					goto pf_skip_line;
-            }
-            break;
+        }
+        break;
 
-        case 'g': // Parse group name
-            {
-                getGroupName();
-            }
-            break;
+    case 'g': // Parse group name
+        {
+            getGroupName();
+        }
+        break;
 
-        case 's': // Parse group number
-            {
-                getGroupNumber();
-            }
-            break;
+    case 's': // Parse group number
+        {
+            getGroupNumber();
+        }
+        break;
 
-        case 'o': // Parse object name
-            {
-                getObjectName();
-            }
-            break;
+    case 'o': // Parse object name
+        {
+            getObjectName();
+        }
+        break;
 
-        default:
-            {
+    default:
+        {
 pf_skip_line:
-                m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-            }
-            break;
+            m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
         }
+        break;
     }
 }
 
@@ -407,7 +436,9 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
         return;
     }
 
-    ObjFile::Face *face = new ObjFile::Face( type );
+    m_faceVertices.clear();
+    m_faceNormals.clear();
+    m_faceTexCoords.clear();
     bool hasNormal = false;
 
     const int vSize = static_cast<unsigned int>(m_pModel->m_Vertices.size());
@@ -432,7 +463,10 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
                 //if there are no texture coordinates in the file, but normals
                 if (!vt && vn) {
                     iPos = 1;
-                    iStep++;
+                    // skip the second separator of v//vn, v/vn has none
+                    if (m_DataIt + 1 != m_DataItEnd && *(m_DataIt + 1) == '/') {
+                        iStep++;
+                    }
                 }
             }
             iPos++;
@@ -454,11 +488,11 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
             if ( iVal > 0 ) {
                 // Store parsed index
                 if ( 0 == iPos ) {
-                    face->m_vertices.push_back( iVal - 1 );
+                    m_faceVertices.push_back( iVal - 1 );
                 } else if ( 1 == iPos ) {
-                    face->m_texturCoords.push_back( iVal - 1 );
+                    m_faceTexCoords.push_back( iVal - 1 );
                 } else if ( 2 == iPos ) {
-                    face->m_normals.push_back( iVal - 1 );
+                    m_faceNormals.push_back( iVal - 1 );
                     hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
@@ -466,18 +500,17 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
             } else if ( iVal < 0 ) {
                 // Store relatively index
                 if ( 0 == iPos ) {
-                    face->m_vertices.push_back( vSize + iVal );
+                    m_faceVertices.push_back( vSize + iVal );
                 } else if ( 1 == iPos ) {
-                    face->m_texturCoords.push_back( vtSize + iVal );
+                    m_faceTexCoords.push_back( vtSize + iVal );
                 } else if ( 2 == iPos ) {
-                    face->m_normals.push_back( vnSize + iVal );
+                    m_faceNormals.push_back( vnSize + iVal );
                     hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
                 }
             } else {
                 //On error, std::atoi will return 0 which is not a valid value
-                delete face;
                 throw DeadlyImportError("OBJ: Invalid face indice");
             }
 
@@ -485,21 +518,20 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
         m_DataIt += iStep;
     }
 
-    if ( face->m_vertices.empty() ) {
+    if ( m_faceVertices.empty() ) {
         ASSIMP_LOG_ERROR("Obj: Ignoring empty face");
-        // skip line and clean up
+        // skip line
         m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-        delete face;
         return;
     }
 
-    // Set active material, if one set
-    if( NULL != m_pModel->m_pCurrentMaterial ) {
-        face->m_pMaterial = m_pModel->m_pCurrentMaterial;
-    } else {
-        face->m_pMaterial = m_pModel->m_pDefaultMaterial;
-    }
+    addFace( type, hasNormal );
 
+    // Skip the rest of the line
+    m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+}
+
+void ObjFileParser::addFace( aiPrimitiveType type, bool hasNormal ) {
     // Create a default object, if nothing is there
     if( NULL == m_pModel->m_pCurrent ) {
         createObject( DefaultObjName );
@@ -510,15 +542,23 @@ void ObjFileParser::getFace( aiPrimitiveType type ) {
         createMesh( DefaultObjName );
     }
 
-    // Store the face
-    m_pModel->m_pCurrentMesh->m_Faces.push_back( face );
-    m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int) face->m_vertices.size();
-    m_pModel->m_pCurrentMesh->m_uiUVCoordinates[ 0 ] += (unsigned int) face->m_texturCoords.size();
-    if( !m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal ) {
-        m_pModel->m_pCurrentMesh->m_hasNormals = true;
+    // Store the face, its indices go to the end of the index buffer of the mesh
+    ObjFile::Mesh *mesh = m_pModel->m_pCurrentMesh;
+    ObjFile::Face face( type );
+    face.m_uiIndexOffset = static_cast<unsigned int>( mesh->m_Indices.size() );
+    face.m_uiNumVertices = static_cast<unsigned int>( m_faceVertices.size() );
+    face.m_uiNumNormals = static_cast<unsigned int>( m_faceNormals.size() );
+    face.m_uiNumTexCoords = static_cast<unsigned int>( m_faceTexCoords.size() );
+    mesh->m_Indices.insert( mesh->m_Indices.end(), m_faceVertices.begin(), m_faceVertices.end() );
+    mesh->m_Indices.insert( mesh->m_Indices.end(), m_faceNormals.begin(), m_faceNormals.end() );
+    mesh->m_Indices.insert( mesh->m_Indices.end(), m_faceTexCoords.begin(), m_faceTexCoords.end() );
+    mesh->m_Faces.push_back( face );
+
+    mesh->m_uiNumIndices += face.m_uiNumVertices;
+    mesh->m_uiUVCoordinates[ 0 ] += face.m_uiNumTexCoords;
+    if( !mesh->m_hasNormals && hasNormal ) {
+        mesh->m_hasNormals = true;
     }
-    // Skip the rest of the line
-    m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
 void ObjFileParser::getMaterialDesc() {
@@ -854,6 +894,505 @@ void ObjFileParser::reportErrorTokenInFace()
     ASSIMP_LOG_ERROR("OBJ: Not supported token in face description detected");
 }
 
+// -------------------------------------------------------------------
+//  Parallel parsing
+//
+//  The file is processed in windows of complete lines. Each window is
+//  split into chunks at line boundaries which are parsed concurrently:
+//  vertex data is read into per-chunk arrays and face indices are stored
+//  in a flat list. All other statements change the state of the parser
+//  (material, object, group) and are replayed in file order when the
+//  chunks are merged, together with the faces.
+// -------------------------------------------------------------------
+
+/// Size of the data handed to a single worker thread.
+static const size_t ObjChunkSize = 4 * 1024 * 1024;
+
+/// Smallest chunk worth to be parsed on a separate thread.
+static const size_t ObjMinChunkSize = 64 * 1024;
+
+/// Parsed contents of a range of complete lines.
+struct ObjFileChunk {
+    struct Face {
+        aiPrimitiveType type;
+        /// First entry in indices, each corner takes three entries (vertex,
+        /// texture coordinate and normal index as written, 0 if missing).
+        size_t firstIndex;
+        unsigned int numCorners;
+        /// Elements defined in the chunk before the face, relative indices
+        /// are resolved against these.
+        unsigned int numVertices;
+        unsigned int numTexCoords;
+        unsigned int numNormals;
+        bool hasNormal;
+    };
+
+    /// A statement which is replayed on the parser.
+    struct Statement {
+        /// Number of faces in the chunk preceding the statement.
+        size_t numFaces;
+        std::vector<char> line;
+    };
+
+    std::vector<aiVector3D> vertices;
+    std::vector<aiVector3D> colors;
+    std::vector<aiVector3D> texCoords;
+    std::vector<aiVector3D> normals;
+    std::vector<Face> faces;
+    std::vector<int> indices;
+    std::vector<Statement> statements;
+    std::vector<std::string> errors;
+    unsigned int numLines;
+
+    ObjFileChunk()
+    : numLines( 0 ) {
+        // empty
+    }
+};
+
+// -------------------------------------------------------------------
+//  Returns true if the line which ends at lineEnd is continued by a '\'.
+static bool isContinuedLine( const char *begin, const char *lineEnd ) {
+    const char *start = lineEnd;
+    while ( start != begin && start[ -1 ] != '\n' ) {
+        --start;
+    }
+    return nullptr != std::memchr( start, '\\', lineEnd - start );
+}
+
+// -------------------------------------------------------------------
+//  Returns the position behind the first line end at or after pos which
+//  is not continued, end if there is none.
+static const char *findNextLineBoundary( const char *begin, const char *pos, const char *end ) {
+    while ( pos != end ) {
+        const char *nl = static_cast<const char*>( std::memchr( pos, '\n', end - pos ) );
+        if ( nullptr == nl ) {
+            return end;
+        }
+        if ( !isContinuedLine( begin, nl ) ) {
+            return nl + 1;
+        }
+        pos = nl + 1;
+    }
+    return end;
+}
+
+// -------------------------------------------------------------------
+//  Returns the position behind the last line end in [begin,end) which is
+//  not continued, NULL if there is none.
+static const char *findLastLineBoundary( const char *begin, const char *end ) {
+    const char *cur = end;
+    while ( cur != begin ) {
+        const char *nl = cur - 1;
+        while ( nl != begin && *nl != '\n' ) {
+            --nl;
+        }
+        if ( *nl != '\n' ) {
+            return nullptr;
+        }
+        if ( !isContinuedLine( begin, nl ) ) {
+            return nl + 1;
+        }
+        cur = nl;
+    }
+    return nullptr;
+}
+
+// -------------------------------------------------------------------
+//  Copies the next data line to out the same way IOStreamBuffer::getNextDataLine
+//  does it: a '\' is dropped and makes the following line end a continuation.
+static const char *copyDataLine( const char *cur, const char *end, std::string &out ) {
+    out.clear();
+    bool continuation = false;
+    while ( cur != end ) {
+        if ( '\\' == *cur ) {
+            continuation = true;
+            if ( ++cur == end ) {
+                break;
+            }
+        }
+        if ( IsLineEnd( *cur ) ) {
+            if ( !continuation ) {
+                return cur + 1;
+            }
+            while ( cur != end && *cur != '\n' ) {
+                ++cur;
+            }
+            if ( cur != end ) {
+                ++cur;
+            }
+            continuation = false;
+            continue;
+        }
+        out += *cur;
+        ++cur;
+    }
+    return cur;
+}
+
+// -------------------------------------------------------------------
+//  Counts the numeric tokens in a line, see getNumComponentsInDataDefinition().
+static size_t countComponents( const char *in ) {
+    size_t numComponents( 0 );
+    while ( SkipSpaces( &in ) ) {
+        const bool isNum( IsNumeric( *in ) );
+        SkipToken( in );
+        if ( isNum ) {
+            ++numComponents;
+        }
+    }
+    return numComponents;
+}
+
+// -------------------------------------------------------------------
+//  Reads the next number in a line, missing components read as zero.
+static ai_real readReal( const char *&in ) {
+    ai_real value( 0 );
+    if ( SkipSpaces( &in ) ) {
+        fast_atoreal_move<ai_real>( in, value );
+        while ( !IsSpaceOrNewLine( *in ) ) {
+            ++in;
+        }
+    }
+    return value;
+}
+
+// -------------------------------------------------------------------
+static aiVector3D readVector3( const char *&in ) {
+    const ai_real x = readReal( in );
+    const ai_real y = readReal( in );
+    const ai_real z = readReal( in );
+    return aiVector3D( x, y, z );
+}
+
+// -------------------------------------------------------------------
+//  Parses the indices of a face, line or point statement, see getFace().
+static void parseChunkFace( const char *in, aiPrimitiveType type, ObjFileChunk &chunk ) {
+    // skip the keyword
+    while ( !IsSpaceOrNewLine( *in ) ) {
+        ++in;
+    }
+
+    ObjFileChunk::Face face;
+    face.type = type;
+    face.firstIndex = chunk.indices.size();
+    face.numCorners = 0;
+    face.numVertices = static_cast<unsigned int>( chunk.vertices.size() );
+    face.numTexCoords = static_cast<unsigned int>( chunk.texCoords.size() );
+    face.numNormals = static_cast<unsigned int>( chunk.normals.size() );
+    face.hasNormal = false;
+
+    bool done = false;
+    while ( !done && SkipSpaces( &in ) ) {
+        int slots[ 3 ] = { 0, 0, 0 };
+        unsigned int slot = 0;
+        while ( !IsSpaceOrNewLine( *in ) ) {
+            if ( '/' == *in ) {
+                if ( type == aiPrimitiveType_POINT ) {
+                    chunk.errors.push_back( "Obj: Separator unexpected in point statement" );
+                }
+                ++slot;
+                ++in;
+                continue;
+            }
+            if ( slot > 2 ) {
+                chunk.errors.push_back( "OBJ: Not supported token in face description detected" );
+                done = true;
+                break;
+            }
+
+            //OBJ USES 1 Base ARRAYS!!!!
+            const char *start = in;
+            const int value = strtol10( in, &in );
+            if ( 0 == value || start == in ) {
+                throw DeadlyImportError( "OBJ: Invalid face indice" );
+            }
+            slots[ slot ] = value;
+            if ( 2 == slot ) {
+                face.hasNormal = true;
+            }
+        }
+        chunk.indices.insert( chunk.indices.end(), slots, slots + 3 );
+        ++face.numCorners;
+    }
+
+    chunk.faces.push_back( face );
+}
+
+// -------------------------------------------------------------------
+//  Parses one data line of a chunk, line is terminated by a line end.
+static void parseChunkLine( const char *line, const char *lineEnd, ObjFileChunk &chunk ) {
+    const char *in = line;
+    switch ( *in ) {
+    case 'v':
+        ++in;
+        if ( IsSpace( *in ) ) {
+            const size_t numComponents = countComponents( in );
+            if ( 3 == numComponents ) {
+                chunk.vertices.push_back( readVector3( in ) );
+            } else if ( 4 == numComponents ) {
+                const aiVector3D v = readVector3( in );
+                const ai_real w = readReal( in );
+                if ( w == 0 ) {
+                    throw DeadlyImportError( "OBJ: Invalid component in homogeneous vector (Division by zero)" );
+                }
+                chunk.vertices.push_back( v / w );
+            } else if ( 6 == numComponents ) {
+                chunk.vertices.push_back( readVector3( in ) );
+                chunk.colors.push_back( readVector3( in ) );
+            }
+        } else if ( 't' == *in ) {
+            ++in;
+            const size_t numComponents = countComponents( in );
+            if ( 2 == numComponents ) {
+                const ai_real x = readReal( in );
+                const ai_real y = readReal( in );
+                chunk.texCoords.push_back( aiVector3D( x, y, 0 ) );
+            } else if ( 3 == numComponents ) {
+                chunk.texCoords.push_back( readVector3( in ) );
+            } else {
+                throw DeadlyImportError( "OBJ: Invalid number of components" );
+            }
+        } else if ( 'n' == *in ) {
+            ++in;
+            chunk.normals.push_back( readVector3( in ) );
+        }
+        break;
+
+    case 'f':
+        parseChunkFace( in, aiPrimitiveType_POLYGON, chunk );
+        break;
+
+    case 'l':
+        parseChunkFace( in, aiPrimitiveType_LINE, chunk );
+        break;
+
+    case 'p':
+        parseChunkFace( in, aiPrimitiveType_POINT, chunk );
+        break;
+
+    case 'u':
+    case 'm':
+    case 'g':
+    case 'o':
+        {
+            // state changes are replayed by the parser itself. The line is
+            // padded like the ones returned by IOStreamBuffer.
+            ObjFileChunk::Statement statement;
+            statement.numFaces = chunk.faces.size();
+            statement.line.reserve( lineEnd - line + 2 );
+            statement.line.assign( line, lineEnd );
+            statement.line.push_back( '\n' );
+            statement.line.push_back( '\0' );
+            chunk.statements.push_back( statement );
+        }
+        break;
+
+    default:
+        // comments, smoothing groups and unsupported statements
+        break;
+    }
+}
+
+// -------------------------------------------------------------------
+//  Parses all lines in [begin,end) into chunk.
+static void parseChunk( const char *begin, const char *end, ObjFileChunk &chunk ) {
+    std::string copy;
+    const char *cur = begin;
+    while ( cur != end ) {
+        // find the line end, we also accept a single '\r' to be
+        // consistent with the line-based parser
+        const char *lineEnd = cur;
+        bool continued = false;
+        while ( lineEnd != end && *lineEnd != '\n' && *lineEnd != '\r' ) {
+            continued |= ( '\\' == *lineEnd );
+            ++lineEnd;
+        }
+
+        ++chunk.numLines;
+        if ( continued || lineEnd == end ) {
+            // continued lines are joined, the last line of the file is
+            // copied to get a terminated buffer
+            cur = copyDataLine( cur, end, copy );
+            parseChunkLine( copy.c_str(), copy.c_str() + copy.size(), chunk );
+        } else {
+            parseChunkLine( cur, lineEnd, chunk );
+            cur = lineEnd + 1;
+        }
+
+        // "\r\n" ends a single line, as in the line-based parser
+        if ( cur != end && '\n' == *cur && '\r' == *( cur - 1 ) ) {
+            ++cur;
+        }
+    }
+}
+
+// -------------------------------------------------------------------
+void ObjFileParser::parseFileParallel( IOStream *stream, ThreadPool *pool ) {
+    ai_assert( nullptr != stream );
+    ai_assert( nullptr != pool );
+
+    size_t fileSize = stream->FileSize();
+    const size_t numThreads = pool->GetNumThreads();
+
+    // parse directly from the stream's memory if possible
+    size_t viewSize = 0;
+    const char *view = reinterpret_cast<const char*>( stream->GetContiguousView( viewSize ) );
+    if ( viewSize != fileSize ) {
+        view = nullptr;
+    }
+
+    // a few chunks per thread balance lines of different cost
+    size_t windowSize = 2 * numThreads * ObjChunkSize;
+    std::vector<char> buffer;
+    size_t buffered = 0;
+    size_t filePos = 0;
+    std::vector<ObjFileChunk> chunks;
+    std::vector<std::pair<const char*, const char*> > ranges;
+
+    while ( filePos < fileSize ) {
+        const char *begin, *end;
+        if ( nullptr != view ) {
+            begin = view + filePos;
+            end = view + std::min( fileSize, filePos + windowSize );
+        } else {
+            const size_t wanted = std::min( windowSize, fileSize - filePos );
+            if ( buffered < wanted ) {
+                buffer.resize( wanted );
+                stream->Seek( filePos + buffered, aiOrigin_SET );
+                const size_t read = stream->Read( &buffer[ buffered ], 1, wanted - buffered );
+                if ( read < wanted - buffered ) {
+                    // treat a short read as end of file
+                    fileSize = filePos + buffered + read;
+                }
+                buffered += read;
+            }
+            begin = buffer.empty() ? nullptr : &buffer[ 0 ];
+            end = begin + buffered;
+        }
+
+        // cut the window behind its last complete line
+        const bool atEnd = ( filePos + ( end - begin ) >= fileSize );
+        const char *cut = atEnd ? end : findLastLineBoundary( begin, end );
+        if ( nullptr == cut ) {
+            // no line end in the window at all, try a larger one
+            windowSize *= 2;
+            continue;
+        }
+
+        // split it into chunks at line boundaries
+        const size_t numChunks = std::max<size_t>( 1, std::min<size_t>( 2 * numThreads,
+            ( cut - begin ) / ObjMinChunkSize ) );
+        ranges.clear();
+        const char *chunkBegin = begin;
+        for ( size_t i = 1; i <= numChunks && chunkBegin != cut; ++i ) {
+            const char *chunkEnd = cut;
+            if ( i < numChunks ) {
+                const char *pos = begin + ( cut - begin ) * i / numChunks;
+                chunkEnd = findNextLineBoundary( begin, std::max( pos, chunkBegin ), cut );
+            }
+            if ( chunkEnd != chunkBegin ) {
+                ranges.push_back( std::make_pair( chunkBegin, chunkEnd ) );
+            }
+            chunkBegin = chunkEnd;
+        }
+
+        chunks.clear();
+        chunks.resize( ranges.size() );
+        pool->ParallelFor( 0, static_cast<unsigned int>( ranges.size() ), [&]( unsigned int i ) {
+            parseChunk( ranges[ i ].first, ranges[ i ].second, chunks[ i ] );
+        } );
+
+        for ( size_t i = 0; i < chunks.size(); ++i ) {
+            mergeChunk( chunks[ i ] );
+        }
+
+        // keep the incomplete line for the next window
+        const size_t consumed = cut - begin;
+        filePos += consumed;
+        if ( nullptr == view ) {
+            std::copy( buffer.begin() + consumed, buffer.begin() + buffered, buffer.begin() );
+            buffered -= consumed;
+        }
+
+        // reading is the first third of the import, as in parseFile()
+        const double done = static_cast<double>( filePos ) / static_cast<double>( fileSize );
+        m_progress->UpdateFileRead( 1000 + static_cast<int>( 2000 * done ), 3000 );
+    }
+}
+
+// -------------------------------------------------------------------
+void ObjFileParser::mergeChunk( ObjFileChunk &chunk ) {
+    for ( std::vector<std::string>::const_iterator it = chunk.errors.begin(); it != chunk.errors.end(); ++it ) {
+        ASSIMP_LOG_ERROR( *it );
+    }
+
+    // append the vertex data, faces are resolved against these offsets
+    const int vSize = static_cast<int>( m_pModel->m_Vertices.size() );
+    const int vtSize = static_cast<int>( m_pModel->m_TextureCoord.size() );
+    const int vnSize = static_cast<int>( m_pModel->m_Normals.size() );
+    m_pModel->m_Vertices.insert( m_pModel->m_Vertices.end(), chunk.vertices.begin(), chunk.vertices.end() );
+    m_pModel->m_VertexColors.insert( m_pModel->m_VertexColors.end(), chunk.colors.begin(), chunk.colors.end() );
+    m_pModel->m_TextureCoord.insert( m_pModel->m_TextureCoord.end(), chunk.texCoords.begin(), chunk.texCoords.end() );
+    m_pModel->m_Normals.insert( m_pModel->m_Normals.end(), chunk.normals.begin(), chunk.normals.end() );
+
+    size_t nextStatement = 0;
+    for ( size_t f = 0; f <= chunk.faces.size(); ++f ) {
+        // replay the statements in front of this face
+        while ( nextStatement < chunk.statements.size() && chunk.statements[ nextStatement ].numFaces == f ) {
+            std::vector<char> &line = chunk.statements[ nextStatement++ ].line;
+            m_DataIt = line.begin();
+            m_DataItEnd = line.end();
+            parseLine();
+        }
+        if ( f == chunk.faces.size() ) {
+            break;
+        }
+
+        const ObjFileChunk::Face &rec = chunk.faces[ f ];
+        m_faceVertices.clear();
+        m_faceNormals.clear();
+        m_faceTexCoords.clear();
+
+        // if there are no texture coordinates so far, but normals, the
+        // second index is a normal index, as in getFace()
+        const bool texCoordsAreNormals = ( 0 == vtSize + rec.numTexCoords && 0 < vnSize + rec.numNormals );
+        bool hasNormal = rec.hasNormal;
+        const int *idx = chunk.indices.empty() ? nullptr : &chunk.indices[ rec.firstIndex ];
+        for ( unsigned int c = 0; c < rec.numCorners; ++c, idx += 3 ) {
+            int texCoord = idx[ 1 ], normal = idx[ 2 ];
+            if ( texCoordsAreNormals && 0 != texCoord && 0 == normal ) {
+                normal = texCoord;
+                texCoord = 0;
+                hasNormal = true;
+            }
+            if ( idx[ 0 ] > 0 ) {
+                m_faceVertices.push_back( idx[ 0 ] - 1 );
+            } else if ( idx[ 0 ] < 0 ) {
+                m_faceVertices.push_back( vSize + rec.numVertices + idx[ 0 ] );
+            }
+            if ( texCoord > 0 ) {
+                m_faceTexCoords.push_back( texCoord - 1 );
+            } else if ( texCoord < 0 ) {
+                m_faceTexCoords.push_back( vtSize + rec.numTexCoords + texCoord );
+            }
+            if ( normal > 0 ) {
+                m_faceNormals.push_back( normal - 1 );
+            } else if ( normal < 0 ) {
+                m_faceNormals.push_back( vnSize + rec.numNormals + normal );
+            }
+        }
+
+        if ( m_faceVertices.empty() ) {
+            ASSIMP_LOG_ERROR("Obj: Ignoring empty face");
+            continue;
+        }
+        addFace( rec.type, hasNormal );
+    }
+
+    m_uiLine += chunk.numLines;
+}
+
 // -------------------------------------------------------------------
 
 }   // Namespace Assimp
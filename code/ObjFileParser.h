@@ -63,7 +63,10 @@ namespace ObjFile {
 
 class ObjFileImporter;
 class IOSystem;
+class IOStream;
 class ProgressHandler;
+class ThreadPool;
+struct ObjFileChunk;
 
 /// \class  ObjFileParser
 /// \brief  Parser for a obj waveform file
@@ -79,6 +82,8 @@ public:
     ObjFileParser();
     /// @brief  Constructor with data array.
     ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem* io, ProgressHandler* progress, const std::string &originalObjFileName);
+    /// @brief  Constructor, parses the stream in chunks on the given worker threads.
+    ObjFileParser( IOStream *stream, const std::string &modelName, IOSystem* io, ProgressHandler* progress, const std::string &originalObjFileName, ThreadPool *pool );
     /// @brief  Destructor
     ~ObjFileParser();
     /// @brief  If you want to load in-core data.
@@ -87,8 +92,16 @@ public:
     ObjFile::Model *GetModel() const;
 
 protected:
+    /// Creates the model and its default material.
+    void createModel( const std::string &modelName );
     /// Parse the loaded file
     void parseFile( IOStreamBuffer<char> &streamBuffer );
+    /// Parse the file in line-aligned chunks on several threads
+    void parseFileParallel( IOStream *stream, ThreadPool *pool );
+    /// Parse the line at the current position.
+    void parseLine();
+    /// Append the data of a parsed chunk to the model, in file order.
+    void mergeChunk( ObjFileChunk &chunk );
     /// Method to copy the new delimited word in the current line.
     void copyNextWord(char *pBuffer, size_t length);
     /// Method to copy the new line.
@@ -107,6 +120,8 @@ protected:
     void getVector2(std::vector<aiVector2D> &point2d_array);
     /// Stores the following face.
     void getFace(aiPrimitiveType type);
+    /// Adds the face held in the index scratch buffers to the current mesh.
+    void addFace( aiPrimitiveType type, bool hasNormal );
     /// Reads the material description.
     void getMaterialDesc();
     /// Gets a comment.
@@ -152,6 +167,10 @@ private:
     unsigned int m_uiLine;
     //! Helper buffer
     char m_buffer[Buffersize];
+    //! Index scratch buffers of the face being parsed, reused for every face
+    std::vector<unsigned int> m_faceVertices;
+    std::vector<unsigned int> m_faceNormals;
+    std::vector<unsigned int> m_faceTexCoords;
     /// Pointer to IO system instance.
     IOSystem *m_pIO;
     //! Pointer to progress handler
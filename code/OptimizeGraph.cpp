@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "OptimizeGraph.h"
 #include "ProcessHelper.h"
+#include "simd.h"
 #include <assimp/SceneCombiner.h>
 #include <assimp/Exceptional.h>
 #include <stdio.h>
@@ -194,17 +195,14 @@ void OptimizeGraphProcess::CollectNewChildren(aiNode* nd, std::list<aiNode*>& no
 
                         // manually move the mesh into the right coordinate system
                         const aiMatrix3x3 IT = aiMatrix3x3( (*it)->mTransformation ).Inverse().Transpose();
-                        for (unsigned int a = 0; a < mesh->mNumVertices; ++a) {
+                        TransformPositions((*it)->mTransformation, mesh->mVertices, mesh->mVertices, mesh->mNumVertices);
 
-                            mesh->mVertices[a] *= (*it)->mTransformation;
+                        if (mesh->HasNormals())
+                            TransformDirections(IT, mesh->mNormals, mesh->mNormals, mesh->mNumVertices);
 
-                            if (mesh->HasNormals())
-                                mesh->mNormals[a] *= IT;
-
-                            if (mesh->HasTangentsAndBitangents()) {
-                                mesh->mTangents[a] *= IT;
-                                mesh->mBitangents[a] *= IT;
-                            }
+                        if (mesh->HasTangentsAndBitangents()) {
+                            TransformDirections(IT, mesh->mTangents, mesh->mTangents, mesh->mNumVertices);
+                            TransformDirections(IT, mesh->mBitangents, mesh->mBitangents, mesh->mNumVertices);
                         }
                     }
                     delete *it; // bye, node
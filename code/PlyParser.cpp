@@ -783,6 +783,28 @@ bool PLY::ElementInstance::ParseInstance(const char* &pCur,
 
   std::vector<PLY::PropertyInstance>::iterator i = p_pcOut->alProperties.begin();
   std::vector<PLY::Property>::const_iterator  a = pcElement->alProperties.begin();
+
+  // Lines made of float properties only - most vertex lines - are parsed in one go.
+  // Properties which are missing on the line are handled one by one below.
+  static const size_t MaxBulkProperties = 32;
+  bool bulk = NULL != pCur && pcElement->alProperties.size() <= MaxBulkProperties;
+  for (std::vector<PLY::Property>::const_iterator b = a; bulk && b != pcElement->alProperties.end(); ++b)
+  {
+    bulk = !b->bIsList && b->eType == EDT_Float;
+  }
+  if (bulk)
+  {
+    ai_real values[MaxBulkProperties];
+    size_t parsed = 0;
+    pCur = fast_atoreal_array(pCur, pCur + ::strlen(pCur), values, pcElement->alProperties.size(), &parsed);
+    for (size_t n = 0; n < parsed; ++n, ++i, ++a)
+    {
+      PLY::PropertyInstance::ValueUnion v;
+      v.fFloat = values[n];
+      (*i).avList.push_back(v);
+    }
+  }
+
   for (; i != p_pcOut->alProperties.end(); ++i, ++a)
   {
     if (!(PLY::PropertyInstance::ParseInstance(pCur, &(*a), &(*i))))
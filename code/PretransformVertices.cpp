@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "PretransformVertices.h"
 #include "ProcessHelper.h"
+#include "simd.h"
 #include <assimp/SceneCombiner.h>
 #include <assimp/Exceptional.h>
 
@@ -199,30 +200,22 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
             else
             {
                 // copy positions, transform them to worldspace
-                for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)  {
-                    pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX]+n] = pcNode->mTransformation * pcMesh->mVertices[n];
-                }
-                aiMatrix4x4 mWorldIT = pcNode->mTransformation;
-                mWorldIT.Inverse().Transpose();
-
-                // TODO: implement Inverse() for aiMatrix3x3
-                aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
+                TransformPositions(pcNode->mTransformation, pcMesh->mVertices,
+                    pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
 
                 if (iVFormat & 0x2)
                 {
                     // copy normals, transform them to worldspace
-                    for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)  {
-                        pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX]+n] =
-                            (m * pcMesh->mNormals[n]).Normalize();
-                    }
+                    TransformNormals(pcNode->mTransformation, pcMesh->mNormals,
+                        pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
                 }
                 if (iVFormat & 0x4)
                 {
                     // copy tangents and bitangents, transform them to worldspace
-                    for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)  {
-                        pcMeshOut->mTangents  [aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mTangents[n]).Normalize();
-                        pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mBitangents[n]).Normalize();
-                    }
+                    TransformNormals(pcNode->mTransformation, pcMesh->mTangents,
+                        pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
+                    TransformNormals(pcNode->mTransformation, pcMesh->mBitangents,
+                        pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
                 }
             }
             unsigned int p = 0;
@@ -338,28 +331,14 @@ void PretransformVertices::ApplyTransform(aiMesh* mesh, const aiMatrix4x4& mat)
     if (!mat.IsIdentity()) {
 
         if (mesh->HasPositions()) {
-            for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                mesh->mVertices[i] = mat * mesh->mVertices[i];
-            }
+            TransformPositions(mat, mesh->mVertices, mesh->mVertices, mesh->mNumVertices);
         }
-        if (mesh->HasNormals() || mesh->HasTangentsAndBitangents()) {
-            aiMatrix4x4 mWorldIT = mat;
-            mWorldIT.Inverse().Transpose();
-
-            // TODO: implement Inverse() for aiMatrix3x3
-            aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
-
-            if (mesh->HasNormals()) {
-                for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                    mesh->mNormals[i] = (m * mesh->mNormals[i]).Normalize();
-                }
-            }
-            if (mesh->HasTangentsAndBitangents()) {
-                for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                    mesh->mTangents[i]   = (m * mesh->mTangents[i]).Normalize();
-                    mesh->mBitangents[i] = (m * mesh->mBitangents[i]).Normalize();
-                }
-            }
+        if (mesh->HasNormals()) {
+            TransformNormals(mat, mesh->mNormals, mesh->mNormals, mesh->mNumVertices);
+        }
+        if (mesh->HasTangentsAndBitangents()) {
+            TransformNormals(mat, mesh->mTangents, mesh->mTangents, mesh->mNumVertices);
+            TransformNormals(mat, mesh->mBitangents, mesh->mBitangents, mesh->mNumVertices);
         }
     }
 }
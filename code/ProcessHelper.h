@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 
 #include <assimp/SpatialSort.h>
+#include <assimp/Importer.hpp>
 #include "BaseProcess.h"
 #include <assimp/ParsingUtils.h>
 
@@ -345,23 +346,58 @@ class ComputeSpatialSortProcess : public BaseProcess
             aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
+    typedef std::pair<SpatialSort, ai_real> _Type;
+
+    void SetupProperties( const Importer* pImp)
+    {
+        method = pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_METHOD, AI_SPATIAL_SORT_PLANE) == AI_SPATIAL_SORT_GRID ?
+            SpatialSort::Method_HashGrid : SpatialSort::Method_PlaneSort;
+    }
+
     void Execute( aiScene* pScene)
     {
-        typedef std::pair<SpatialSort, ai_real> _Type;
+        ExecuteMeshPass(pScene);
+    }
+
+    // The spatial sorts are built mesh by mesh, so the step can be fused with
+    // the steps using them (see BaseProcess::ExecuteFusedOnScene()).
+    bool IsMeshLocal() const
+    {
+        return true;
+    }
+
+    MeshFootprint GetMeshFootprint() const
+    {
+        return MeshFootprint(MeshComponent_Positions, 0);
+    }
+
+    void BeginMeshPass( aiScene* pScene)
+    {
         ASSIMP_LOG_DEBUG("Generate spatially-sorted vertex cache");
 
-        std::vector<_Type>* p = new std::vector<_Type>(pScene->mNumMeshes);
-        std::vector<_Type>::iterator it = p->begin();
+        sorts = new std::vector<_Type>(pScene->mNumMeshes);
+        shared->AddProperty(AI_SPP_SPATIAL_SORT,sorts);
+    }
 
-        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it) {
-            aiMesh* mesh = pScene->mMeshes[i];
-            _Type& blubb = *it;
-            blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
-            blubb.second = ComputePositionEpsilon(mesh);
-        }
+    void ExecuteOnMesh( aiMesh* mesh, unsigned int meshIndex)
+    {
+        _Type& blubb = (*sorts)[meshIndex];
+        blubb.first.SetMethod(method);
+        blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D),false);
+        blubb.first.Finalize(threadPool);
+        blubb.second = ComputePositionEpsilon(mesh);
+    }
 
-        shared->AddProperty(AI_SPP_SPATIAL_SORT,p);
+    void EndMeshPass( aiScene* /*pScene*/)
+    {
+        sorts = NULL;
     }
+
+    // owned by the SharedPostProcessInfo
+    std::vector<_Type>* sorts = NULL;
+
+    // spatial index to build, see AI_CONFIG_PP_SPATIAL_SORT_METHOD
+    SpatialSort::Method method = SpatialSort::Method_PlaneSort;
 };
 
 // -------------------------------------------------------------------------------
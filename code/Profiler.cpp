@@ -0,0 +1,259 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Profiler.cpp
+ *  @brief Implementation of the hierarchical import profiler
+ */
+
+#include <assimp/Profiler.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/TinyFormatter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+
+using namespace Assimp;
+using namespace Assimp::Profiling;
+using namespace Assimp::Formatter;
+
+namespace {
+
+    // Each profiler gets a unique serial so the per-thread cache below never
+    // mistakes a new profiler for a destroyed one at the same address.
+    std::atomic<uint64_t> nextSerial(1);
+
+    // --------------------------------------------------------------------------------------------
+    void WriteJsonString(std::ostream& out, const std::string& s) {
+        out << '\"';
+        for (const char c : s) {
+            switch (c) {
+            case '\"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    ::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c));
+                    out << buf;
+                } else {
+                    out << c;
+                }
+            }
+        }
+        out << '\"';
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+struct Profiler::ThreadBuffer {
+    struct OpenRegion {
+        std::string name;
+        Clock::time_point start;
+    };
+
+    std::thread::id id;
+    unsigned int index;
+    std::vector<OpenRegion> open;
+    std::vector<ProfileRegion> done;
+};
+
+// ------------------------------------------------------------------------------------------------
+Profiler::Profiler()
+: mStart(Clock::now())
+, mSerial(nextSerial++) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+Profiler::~Profiler() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+    // the buffer of the profiler used last on this thread is cached, so the
+    // lock is only taken when a thread switches between profilers
+    struct Cache {
+        uint64_t serial;
+        ThreadBuffer* buffer;
+    };
+    static thread_local Cache cache = { 0, nullptr };
+    if (cache.serial == mSerial) {
+        return cache.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const std::thread::id id = std::this_thread::get_id();
+    ThreadBuffer* buffer = nullptr;
+    for (const std::unique_ptr<ThreadBuffer>& t : mThreads) {
+        if (t->id == id) {
+            buffer = t.get();
+            break;
+        }
+    }
+    if (nullptr == buffer) {
+        mThreads.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+        buffer = mThreads.back().get();
+        buffer->id = id;
+        buffer->index = static_cast<unsigned int>(mThreads.size() - 1);
+    }
+
+    cache.serial = mSerial;
+    cache.buffer = buffer;
+    return buffer;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Profiler::BeginRegion(const std::string& region) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+    ASSIMP_LOG_DEBUG((format("START `"),region,"`"));
+
+    ThreadBuffer::OpenRegion r;
+    r.name = region;
+    buffer->open.push_back(r);
+    buffer->open.back().start = Clock::now();
+}
+
+// ------------------------------------------------------------------------------------------------
+void Profiler::EndRegion(const std::string& region) {
+    const Clock::time_point end = Clock::now();
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    // regions are expected to nest, so the innermost one is usually the one
+    // to close. Unbalanced calls end the most recent region of that name.
+    std::vector<ThreadBuffer::OpenRegion>::reverse_iterator it = buffer->open.rbegin();
+    for (; it != buffer->open.rend() && it->name != region; ++it);
+    if (it == buffer->open.rend()) {
+        return;
+    }
+
+    ProfileRegion r;
+    r.name = region;
+    r.thread = buffer->index;
+    r.depth = static_cast<unsigned int>(buffer->open.rend() - it) - 1;
+    r.start = std::chrono::duration<double>(it->start - mStart).count();
+    r.duration = std::chrono::duration<double>(end - it->start).count();
+    buffer->done.push_back(r);
+    buffer->open.erase(std::next(it).base());
+
+    ASSIMP_LOG_DEBUG((format("END   `"),region,"`, dt= ", r.duration," s"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void Profiler::AddCounter(const std::string& name, uint64_t value) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCounters[name] += value;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Profiler::GetReport(ProfilingReport& report) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    report.regions.clear();
+    for (const std::unique_ptr<ThreadBuffer>& t : mThreads) {
+        const size_t first = report.regions.size();
+        report.regions.insert(report.regions.end(), t->done.begin(), t->done.end());
+
+        // regions are recorded when they end, list them by start time
+        std::stable_sort(report.regions.begin() + first, report.regions.end(),
+            [](const ProfileRegion& a, const ProfileRegion& b) {
+                return a.start < b.start;
+            });
+    }
+    report.counters = mCounters;
+}
+
+// ------------------------------------------------------------------------------------------------
+double ProfilingReport::GetTotalTime(const std::string& name) const {
+    double total = 0.0;
+    for (const ProfileRegion& r : regions) {
+        if (r.name == name) {
+            total += r.duration;
+        }
+    }
+    return total;
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t ProfilingReport::GetCounter(const std::string& name) const {
+    std::map<std::string, uint64_t>::const_iterator it = counters.find(name);
+    return it == counters.end() ? 0 : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ProfilingReport::ToChromeTrace() const {
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out.precision(3);
+    out << std::fixed;
+
+    // complete events ("X") with timestamps in microseconds
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const ProfileRegion& r : regions) {
+        out << (first ? "\n" : ",\n") << "{\"name\":";
+        WriteJsonString(out, r.name);
+        out << ",\"cat\":\"assimp\",\"ph\":\"X\",\"pid\":0,\"tid\":" << r.thread
+            << ",\"ts\":" << r.start * 1e6 << ",\"dur\":" << r.duration * 1e6 << "}";
+        first = false;
+    }
+
+    // counters are totals, they are shown at the end of the trace
+    double end = 0.0;
+    for (const ProfileRegion& r : regions) {
+        end = std::max(end, r.start + r.duration);
+    }
+    for (const std::pair<const std::string, uint64_t>& c : counters) {
+        out << (first ? "\n" : ",\n") << "{\"name\":";
+        WriteJsonString(out, c.first);
+        out << ",\"cat\":\"assimp\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":" << end * 1e6
+            << ",\"args\":{\"value\":" << c.second << "}}";
+        first = false;
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out.str();
+}
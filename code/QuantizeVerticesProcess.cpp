@@ -0,0 +1,381 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  QuantizeVerticesProcess.cpp
+ *  @brief Implementation of the QuantizeVertices post-process step.
+ *
+ *  Unit vectors use the octahedral encoding (Meyer et al., "On Floating-Point Normal Vectors"),
+ *  which spends the bits of two 16 bit integers evenly over the sphere.
+ */
+
+#include "QuantizeVerticesProcess.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Converts a value in [-1, 1] to a signed normalized 16 bit integer
+short ToSnorm16(ai_real f)
+{
+    f = std::max(ai_real( -1 ), std::min(f, ai_real( 1 )));
+    return static_cast<short>(std::floor(f * 32767 + ai_real( 0.5 )));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Converts a value in [0, 1] to an unsigned normalized integer with the given maximum
+unsigned int ToUnorm(ai_real f, unsigned int iMax)
+{
+    f = std::max(ai_real( 0 ), std::min(f, ai_real( 1 )));
+    return static_cast<unsigned int>(f * iMax + ai_real( 0.5 ));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Stores the octahedral encoding of a direction, see aiQuantizedMesh::DecodeOctahedral()
+void EncodeOctahedral(const aiVector3D& v, short* out)
+{
+    const ai_real l = std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z);
+    if (l <= 0) {
+        out[0] = out[1] = 0;
+        return;
+    }
+    ai_real x = v.x / l, y = v.y / l;
+    if (v.z < 0) {
+        const ai_real ox = x;
+        x = (1 - std::fabs(y)) * (x >= 0 ? 1 : -1);
+        y = (1 - std::fabs(ox)) * (y >= 0 ? 1 : -1);
+    }
+    out[0] = ToSnorm16(x);
+    out[1] = ToSnorm16(y);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Size of the vertex components in bytes, as floating-point arrays and quantized
+void GetVertexSize(const aiQuantizedMesh* q, unsigned int& iFloat, unsigned int& iQuantized)
+{
+    iFloat = iQuantized = 0;
+    if (q->mPositions) {
+        iFloat += sizeof(aiVector3D);
+        iQuantized += 3 * sizeof(unsigned short);
+    }
+    if (q->mNormals) {
+        iFloat += sizeof(aiVector3D);
+        iQuantized += 2 * sizeof(short);
+    }
+    if (q->mTangents) {
+        iFloat += 2 * sizeof(aiVector3D);
+        iQuantized += 3 * sizeof(short);
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        if (q->mTextureCoords[n]) {
+            iFloat += sizeof(aiVector3D);
+            iQuantized += 2 * sizeof(unsigned short);
+        }
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+        if (q->mColors[n]) {
+            iFloat += sizeof(aiColor4D);
+            iQuantized += 4;
+        }
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+QuantizeVerticesProcess::QuantizeVerticesProcess()
+: configComponents(0)
+, configDropFloats(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+QuantizeVerticesProcess::~QuantizeVerticesProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// The step has no flag
+bool QuantizeVerticesProcess::IsActive( unsigned int /*pFlags*/) const
+{
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is enabled by the importer properties
+bool QuantizeVerticesProcess::IsEnabledByProperty( const Importer* pImp) const
+{
+    return pImp->GetPropertyInteger(AI_CONFIG_PP_QV_COMPONENTS,0) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void QuantizeVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    configComponents = pImp->GetPropertyInteger(AI_CONFIG_PP_QV_COMPONENTS,0);
+    configDropFloats = pImp->GetPropertyBool(AI_CONFIG_PP_QV_DROP_FLOATS,false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void QuantizeVerticesProcess::Execute( aiScene* pScene)
+{
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool QuantizeVerticesProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint QuantizeVerticesProcess::GetMeshFootprint() const
+{
+    unsigned int write = MeshComponent_Quantized;
+    if (configDropFloats) {
+        write |= MeshComponent_Normals | MeshComponent_Tangents | MeshComponent_TexCoords | MeshComponent_Colors;
+    }
+    return MeshFootprint(MeshComponent_All & ~MeshComponent_MeshList, write);
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::BeginMeshPass( aiScene* /*pScene*/)
+{
+    ASSIMP_LOG_DEBUG("QuantizeVerticesProcess begin");
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int /*meshIndex*/)
+{
+    aiQuantizedMesh* q = QuantizeMesh(pMesh);
+    if (!q) {
+        return;
+    }
+    delete pMesh->mQuantized;
+    pMesh->mQuantized = q;
+
+    if (!configDropFloats) {
+        return;
+    }
+
+    // release the arrays which have a quantized copy. The positions are
+    // kept, almost everything relies on them.
+    if (q->mNormals) {
+        delete[] pMesh->mNormals;
+        pMesh->mNormals = NULL;
+    }
+    if (q->mTangents) {
+        delete[] pMesh->mTangents;
+        delete[] pMesh->mBitangents;
+        pMesh->mTangents = pMesh->mBitangents = NULL;
+    }
+
+    // texture coordinate and color channels must stay contiguous, so they
+    // are only released if all of them were quantized
+    bool bAll = true;
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        bAll = bAll && (!pMesh->mTextureCoords[n] || q->mTextureCoords[n]);
+    }
+    for (unsigned int n = 0; bAll && n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        delete[] pMesh->mTextureCoords[n];
+        pMesh->mTextureCoords[n] = NULL;
+        pMesh->mNumUVComponents[n] = 0;
+    }
+    bAll = true;
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+        bAll = bAll && (!pMesh->mColors[n] || q->mColors[n]);
+    }
+    for (unsigned int n = 0; bAll && n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+        delete[] pMesh->mColors[n];
+        pMesh->mColors[n] = NULL;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::EndMeshPass( aiScene* pScene)
+{
+    unsigned int iNumMeshes = 0;
+    size_t iFloatBytes = 0, iQuantizedBytes = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        const aiMesh* pMesh = pScene->mMeshes[a];
+        if (pMesh->mQuantized) {
+            unsigned int iFloat, iQuantized;
+            GetVertexSize(pMesh->mQuantized, iFloat, iQuantized);
+            iFloatBytes += static_cast<size_t>(iFloat) * pMesh->mNumVertices;
+            iQuantizedBytes += static_cast<size_t>(iQuantized) * pMesh->mNumVertices;
+            ++iNumMeshes;
+        }
+    }
+    if (!iNumMeshes) {
+        ASSIMP_LOG_DEBUG("QuantizeVerticesProcess finished. No vertex components were quantized");
+        return;
+    }
+    ASSIMP_LOG_INFO_F("QuantizeVerticesProcess finished. Quantized ", iNumMeshes, " meshes, ",
+        iFloatBytes, " bytes of vertex data are stored in ", iQuantizedBytes, " bytes");
+}
+
+// ------------------------------------------------------------------------------------------------
+// Quantizes a single mesh
+aiQuantizedMesh* QuantizeVerticesProcess::QuantizeMesh( const aiMesh* pMesh) const
+{
+    ai_assert(NULL != pMesh);
+
+    const unsigned int iNumVertices = pMesh->mNumVertices;
+    if (!iNumVertices) {
+        return NULL;
+    }
+    aiQuantizedMesh* q = new aiQuantizedMesh();
+    q->mNumVertices = iNumVertices;
+    bool bAny = false;
+
+    // positions: a uniform scale keeps the dequantization a similarity transform,
+    // so it doesn't distort normals if it is applied as a node transformation
+    if ((configComponents & aiQuantizedComponent_POSITIONS) && pMesh->HasPositions()) {
+        aiVector3D min = pMesh->mVertices[0], max = pMesh->mVertices[0];
+        for (unsigned int i = 1; i < iNumVertices; ++i) {
+            const aiVector3D& p = pMesh->mVertices[i];
+            min.x = std::min(min.x, p.x); min.y = std::min(min.y, p.y); min.z = std::min(min.z, p.z);
+            max.x = std::max(max.x, p.x); max.y = std::max(max.y, p.y); max.z = std::max(max.z, p.z);
+        }
+        const aiVector3D extent = max - min;
+        ai_real fScale = std::max(extent.x, std::max(extent.y, extent.z)) / 65535;
+        if (fScale <= 0) {
+            fScale = 1;
+        }
+        q->mPositionTransform = aiMatrix4x4(fScale, 0, 0, min.x,
+            0, fScale, 0, min.y,
+            0, 0, fScale, min.z,
+            0, 0, 0, 1);
+        q->mPositions = new unsigned short[iNumVertices * 3];
+        for (unsigned int i = 0; i < iNumVertices; ++i) {
+            const aiVector3D p = (pMesh->mVertices[i] - min) / fScale;
+            for (unsigned int c = 0; c < 3; ++c) {
+                q->mPositions[i * 3 + c] = static_cast<unsigned short>(std::min(p[c] + ai_real( 0.5 ), ai_real( 65535 )));
+            }
+        }
+        bAny = true;
+    }
+
+    if ((configComponents & aiQuantizedComponent_NORMALS) && pMesh->HasNormals()) {
+        q->mNormals = new short[iNumVertices * 2];
+        for (unsigned int i = 0; i < iNumVertices; ++i) {
+            EncodeOctahedral(pMesh->mNormals[i], q->mNormals + i * 2);
+        }
+        bAny = true;
+    }
+
+    // tangents: the bitangent is reduced to its handedness relative to the normal
+    if ((configComponents & aiQuantizedComponent_TANGENTS) && pMesh->HasTangentsAndBitangents() && pMesh->HasNormals()) {
+        q->mTangents = new short[iNumVertices * 3];
+        for (unsigned int i = 0; i < iNumVertices; ++i) {
+            EncodeOctahedral(pMesh->mTangents[i], q->mTangents + i * 3);
+            const ai_real fSign = (pMesh->mNormals[i] ^ pMesh->mTangents[i]) * pMesh->mBitangents[i];
+            q->mTangents[i * 3 + 2] = fSign < 0 ? -32767 : 32767;
+        }
+        bAny = true;
+    }
+
+    // texture coordinates: channels inside [0, 1] are stored as they are, so
+    // they can be used as normalized integers without a transform
+    if (configComponents & aiQuantizedComponent_TEXCOORDS) {
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+            if (!pMesh->HasTextureCoords(n) || pMesh->mNumUVComponents[n] > 2) {
+                continue;
+            }
+            const aiVector3D* uv = pMesh->mTextureCoords[n];
+            aiVector2D min(uv[0].x, uv[0].y), max = min;
+            for (unsigned int i = 1; i < iNumVertices; ++i) {
+                min.x = std::min(min.x, uv[i].x); min.y = std::min(min.y, uv[i].y);
+                max.x = std::max(max.x, uv[i].x); max.y = std::max(max.y, uv[i].y);
+            }
+            aiVector2D offset(0, 0), scale(1, 1);
+            if (min.x < 0 || min.y < 0 || max.x > 1 || max.y > 1) {
+                offset = min;
+                scale = max - min;
+                scale.x = scale.x > 0 ? scale.x : 1;
+                scale.y = scale.y > 0 ? scale.y : 1;
+            }
+            q->mTexCoordOffset[n] = offset;
+            q->mTexCoordScale[n] = scale;
+            q->mTextureCoords[n] = new unsigned short[iNumVertices * 2];
+            for (unsigned int i = 0; i < iNumVertices; ++i) {
+                q->mTextureCoords[n][i * 2] = static_cast<unsigned short>(ToUnorm((uv[i].x - offset.x) / scale.x, 65535));
+                q->mTextureCoords[n][i * 2 + 1] = static_cast<unsigned short>(ToUnorm((uv[i].y - offset.y) / scale.y, 65535));
+            }
+            bAny = true;
+        }
+    }
+
+    if (configComponents & aiQuantizedComponent_COLORS) {
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+            if (!pMesh->HasVertexColors(n)) {
+                continue;
+            }
+            q->mColors[n] = new unsigned char[iNumVertices * 4];
+            for (unsigned int i = 0; i < iNumVertices; ++i) {
+                const aiColor4D& c = pMesh->mColors[n][i];
+                unsigned char* out = q->mColors[n] + i * 4;
+                out[0] = static_cast<unsigned char>(ToUnorm(c.r, 255));
+                out[1] = static_cast<unsigned char>(ToUnorm(c.g, 255));
+                out[2] = static_cast<unsigned char>(ToUnorm(c.b, 255));
+                out[3] = static_cast<unsigned char>(ToUnorm(c.a, 255));
+            }
+            bAny = true;
+        }
+    }
+
+    if (!bAny) {
+        delete q;
+        return NULL;
+    }
+    return q;
+}
@@ -0,0 +1,124 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post processing step to quantize vertex components */
+#ifndef AI_QUANTIZEVERTICESPROCESS_H_INC
+#define AI_QUANTIZEVERTICESPROCESS_H_INC
+
+#include "BaseProcess.h"
+
+struct aiMesh;
+struct aiQuantizedMesh;
+
+namespace Assimp
+{
+
+// ---------------------------------------------------------------------------
+/** The QuantizeVerticesProcess stores fixed-point copies of the vertex
+ *  components of each mesh in aiMesh::mQuantized: 16 bit positions with a
+ *  dequantization transform, octahedral normals and tangents, 16 bit
+ *  texture coordinates and 8 bit colors. There is no flag for this step,
+ *  it is enabled by the #AI_CONFIG_PP_QV_COMPONENTS property.
+ */
+class ASSIMP_API QuantizeVerticesProcess : public BaseProcess
+{
+public:
+
+    QuantizeVerticesProcess();
+    ~QuantizeVerticesProcess();
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is enabled by AI_CONFIG_PP_QV_COMPONENTS
+    bool IsEnabledByProperty( const Importer* pImp) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    // The step works on each mesh independently, see BaseProcess.
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    /** Quantizes the configured components of a mesh.
+     * @param pMesh The mesh to quantize. It is not modified.
+     * @return The quantized components or NULL if the mesh has none of them.
+     */
+    aiQuantizedMesh* QuantizeMesh( const aiMesh* pMesh) const;
+
+    // setter for configComponents
+    inline void SetComponents(unsigned int n)
+    {
+        configComponents = n;
+    }
+
+    // setter for configDropFloats
+    inline void SetDropFloats(bool b)
+    {
+        configDropFloats = b;
+    }
+
+private:
+    //! Configuration parameter: the aiQuantizedComponent's to quantize
+    unsigned int configComponents;
+
+    //! Configuration parameter: release the quantized float arrays
+    bool configDropFloats;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_QUANTIZEVERTICESPROCESS_H_INC
@@ -1087,6 +1087,30 @@ void SceneCombiner::Copy( aiMesh** _dest, const aiMesh* src ) {
         aiFace& f = dest->mFaces[i];
         GetArrayCopy(f.mIndices,f.mNumIndices);
     }
+
+    // and of the meshlets
+    if (src->mMeshlets) {
+        aiMeshletData* meshlets = dest->mMeshlets = new aiMeshletData();
+        *meshlets = *src->mMeshlets;
+        GetArrayCopy(meshlets->mMeshlets,meshlets->mNumMeshlets);
+        GetArrayCopy(meshlets->mVertices,meshlets->mNumVertices);
+        GetArrayCopy(meshlets->mTriangles,meshlets->mNumTriangles*3);
+    }
+
+    // and of the quantized vertex components
+    if (src->mQuantized) {
+        aiQuantizedMesh* q = dest->mQuantized = new aiQuantizedMesh();
+        *q = *src->mQuantized;
+        GetArrayCopy(q->mPositions,q->mNumVertices*3);
+        GetArrayCopy(q->mNormals,q->mNumVertices*2);
+        GetArrayCopy(q->mTangents,q->mNumVertices*3);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS;++i) {
+            GetArrayCopy(q->mTextureCoords[i],q->mNumVertices*2);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS;++i) {
+            GetArrayCopy(q->mColors[i],q->mNumVertices*4);
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -45,6 +45,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/SpatialSort.h>
 #include <assimp/ai_assert.h>
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
 
 using namespace Assimp;
 
@@ -60,7 +64,10 @@ SpatialSort::SpatialSort( const aiVector3D* pPositions, unsigned int pNumPositio
 
     // define the reference plane. We choose some arbitrary vector away from all basic axises
     // in the hope that no model spreads all its vertices along this plane.
-    : mPlaneNormal(0.8523f, 0.34321f, 0.5736f)
+    : mMethod(Method_PlaneSort)
+    , mPlaneNormal(0.8523f, 0.34321f, 0.5736f)
+    , mCellSize(0)
+    , mInvCellSize(0)
 {
     mPlaneNormal.Normalize();
     Fill(pPositions,pNumPositions,pElementOffset);
@@ -68,7 +75,10 @@ SpatialSort::SpatialSort( const aiVector3D* pPositions, unsigned int pNumPositio
 
 // ------------------------------------------------------------------------------------------------
 SpatialSort :: SpatialSort()
-: mPlaneNormal(0.8523f, 0.34321f, 0.5736f)
+: mMethod(Method_PlaneSort)
+, mPlaneNormal(0.8523f, 0.34321f, 0.5736f)
+, mCellSize(0)
+, mInvCellSize(0)
 {
     mPlaneNormal.Normalize();
 }
@@ -86,15 +96,216 @@ void SpatialSort::Fill( const aiVector3D* pPositions, unsigned int pNumPositions
     bool pFinalize /*= true */)
 {
     mPositions.clear();
+    mPositionData.clear();
     Append(pPositions,pNumPositions,pElementOffset,pFinalize);
 }
 
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::SetMethod( Method pMethod)
+{
+    mMethod = pMethod;
+}
+
 // ------------------------------------------------------------------------------------------------
 void SpatialSort :: Finalize()
 {
+    if (mMethod == Method_HashGrid) {
+        FinalizeGrid();
+        return;
+    }
     std::sort( mPositions.begin(), mPositions.end());
 }
 
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::Finalize( ThreadPool* pPool)
+{
+    // Below this size spreading the sort isn't worth the synchronization
+    static const size_t MinEntriesPerChunk = 16384;
+
+    unsigned int numChunks = 1;
+    if (mMethod == Method_PlaneSort && NULL != pPool) {
+        while (numChunks < pPool->GetNumThreads() && mPositions.size() / (numChunks * 2) >= MinEntriesPerChunk) {
+            numChunks *= 2;
+        }
+    }
+    if (numChunks == 1) {
+        Finalize();
+        return;
+    }
+
+    // Sort equally sized chunks, then merge neighbouring pairs of them until one is left.
+    // The order of the entries is total, so the result is the same as with std::sort.
+    std::vector<size_t> bounds(numChunks + 1);
+    for (unsigned int c = 0; c <= numChunks; ++c) {
+        bounds[c] = mPositions.size() * c / numChunks;
+    }
+
+    std::vector<Entry>::iterator begin = mPositions.begin();
+    pPool->ParallelFor(0, numChunks, [&](unsigned int c) {
+        std::sort(begin + bounds[c], begin + bounds[c + 1]);
+    });
+    for (unsigned int width = 1; width < numChunks; width *= 2) {
+        pPool->ParallelFor(0, numChunks / (width * 2), [&](unsigned int m) {
+            const unsigned int first = m * width * 2;
+            std::inplace_merge(begin + bounds[first], begin + bounds[first + width], begin + bounds[first + width * 2]);
+        });
+    }
+}
+
+namespace {
+
+    // --------------------------------------------------------------------------------------------
+    // Maps a grid cell to one of the buckets of the hash grid
+    inline unsigned int HashCell( const int pCell[3], unsigned int pMask) {
+        return ((unsigned int)pCell[0] * 73856093u ^ (unsigned int)pCell[1] * 19349663u ^
+            (unsigned int)pCell[2] * 83492791u) & pMask;
+    }
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::FinalizeGrid()
+{
+    mBucketStart.clear();
+    if (mPositions.empty()) {
+        return;
+    }
+
+    mGridOrigin = mGridMax = mPositionData[0];
+    for (std::vector<aiVector3D>::const_iterator it = mPositionData.begin(); it != mPositionData.end(); ++it) {
+        const aiVector3D& v = *it;
+        mGridOrigin.x = std::min(mGridOrigin.x, v.x);
+        mGridOrigin.y = std::min(mGridOrigin.y, v.y);
+        mGridOrigin.z = std::min(mGridOrigin.z, v.z);
+        mGridMax.x = std::max(mGridMax.x, v.x);
+        mGridMax.y = std::max(mGridMax.y, v.y);
+        mGridMax.z = std::max(mGridMax.z, v.z);
+    }
+
+    // Choose the cell size so that there are about as many cells as positions. Dimensions
+    // shorter than a cell - e.g. the thickness of a planar mesh - add no cells, so the size
+    // is recomputed over the remaining ones until it is consistent.
+    const aiVector3D extent = mGridMax - mGridOrigin;
+    const ai_real extents[3] = { extent.x, extent.y, extent.z };
+    bool flat[3] = { false, false, false };
+    double cellSize = 0.0;
+    for (bool changed = true; changed; ) {
+        double volume = 1.0;
+        unsigned int dimensions = 0;
+        for (unsigned int a = 0; a < 3; ++a) {
+            if (!flat[a] && extents[a] > 0) {
+                volume *= extents[a];
+                ++dimensions;
+            } else {
+                flat[a] = true;
+            }
+        }
+        if (!dimensions) {
+            break;
+        }
+        cellSize = std::pow(volume / mPositions.size(), 1.0 / dimensions);
+
+        changed = false;
+        for (unsigned int a = 0; a < 3; ++a) {
+            if (!flat[a] && extents[a] < cellSize) {
+                flat[a] = changed = true;
+            }
+        }
+    }
+
+    // all positions are identical
+    if (cellSize <= 0.0) {
+        cellSize = 1.0;
+    }
+    mCellSize = static_cast<ai_real>(cellSize);
+    mInvCellSize = static_cast<ai_real>(1.0 / cellSize);
+
+    // a power of two number of buckets, at least one per position
+    unsigned int numBuckets = 1;
+    while (numBuckets < mPositions.size() && numBuckets < 0x80000000u) {
+        numBuckets <<= 1;
+    }
+    const unsigned int mask = numBuckets - 1;
+
+    // counting sort of the entries by bucket, keeping their order within each bucket
+    std::vector<unsigned int> buckets(mPositions.size());
+    mBucketStart.assign(numBuckets + 1, 0);
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        int cell[3];
+        GetCell(mPositionData[mPositions[i].mIndex], cell);
+        buckets[i] = HashCell(cell, mask);
+        ++mBucketStart[buckets[i] + 1];
+    }
+    for (unsigned int b = 0; b < numBuckets; ++b) {
+        mBucketStart[b + 1] += mBucketStart[b];
+    }
+
+    std::vector<unsigned int> next(mBucketStart.begin(), mBucketStart.end() - 1);
+    std::vector<Entry> sorted(mPositions.size());
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        sorted[next[buckets[i]]++] = mPositions[i];
+    }
+    mPositions.swap(sorted);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::GetCell( const aiVector3D& pPosition, int pCell[3]) const
+{
+    const aiVector3D rel = (pPosition - mGridOrigin) * mInvCellSize;
+    pCell[0] = static_cast<int>(std::floor(rel.x));
+    pCell[1] = static_cast<int>(std::floor(rel.y));
+    pCell[2] = static_cast<int>(std::floor(rel.z));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Func>
+void SpatialSort::ForEachInBox( const aiVector3D& pMin, const aiVector3D& pMax, Func pFunc) const
+{
+    if (mBucketStart.empty()) {
+        return;
+    }
+
+    // clip the box to the bounding box of the data, cells outside are empty anyways
+    const aiVector3D lo(std::max(pMin.x, mGridOrigin.x), std::max(pMin.y, mGridOrigin.y),
+        std::max(pMin.z, mGridOrigin.z));
+    const aiVector3D hi(std::min(pMax.x, mGridMax.x), std::min(pMax.y, mGridMax.y),
+        std::min(pMax.z, mGridMax.z));
+    if (lo.x > hi.x || lo.y > hi.y || lo.z > hi.z) {
+        return;
+    }
+
+    int first[3], last[3];
+    GetCell(lo, first);
+    GetCell(hi, last);
+
+    // for huge boxes looking at every entry is cheaper than visiting all cells
+    const double numCells = double(last[0] - first[0] + 1) * double(last[1] - first[1] + 1) *
+        double(last[2] - first[2] + 1);
+    if (numCells >= mPositions.size()) {
+        for (std::vector<Entry>::const_iterator it = mPositions.begin(); it != mPositions.end(); ++it) {
+            pFunc(*it);
+        }
+        return;
+    }
+
+    // Different cells may share a bucket, so only the entries in the cell itself count
+    const unsigned int mask = static_cast<unsigned int>(mBucketStart.size() - 2);
+    int cell[3], entryCell[3];
+    for (cell[2] = first[2]; cell[2] <= last[2]; ++cell[2]) {
+        for (cell[1] = first[1]; cell[1] <= last[1]; ++cell[1]) {
+            for (cell[0] = first[0]; cell[0] <= last[0]; ++cell[0]) {
+                const unsigned int bucket = HashCell(cell, mask);
+                for (unsigned int i = mBucketStart[bucket]; i < mBucketStart[bucket + 1]; ++i) {
+                    GetCell(mPositionData[mPositions[i].mIndex], entryCell);
+                    if (entryCell[0] == cell[0] && entryCell[1] == cell[1] && entryCell[2] == cell[2]) {
+                        pFunc(mPositions[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void SpatialSort::Append( const aiVector3D* pPositions, unsigned int pNumPositions,
     unsigned int pElementOffset,
@@ -103,6 +314,7 @@ void SpatialSort::Append( const aiVector3D* pPositions, unsigned int pNumPositio
     // store references to all given positions along with their distance to the reference plane
     const size_t initial = mPositions.size();
     mPositions.reserve(initial + (pFinalize?pNumPositions:pNumPositions*2));
+    mPositionData.reserve(mPositions.capacity());
     for( unsigned int a = 0; a < pNumPositions; a++)
     {
         const char* tempPointer = reinterpret_cast<const char*> (pPositions);
@@ -110,7 +322,8 @@ void SpatialSort::Append( const aiVector3D* pPositions, unsigned int pNumPositio
 
         // store position by index and distance
         ai_real distance = *vec * mPlaneNormal;
-        mPositions.push_back( Entry( static_cast<unsigned int>(a+initial), *vec, distance));
+        mPositions.push_back( Entry( static_cast<unsigned int>(a+initial), distance));
+        mPositionData.push_back( *vec);
     }
 
     if (pFinalize) {
@@ -124,12 +337,22 @@ void SpatialSort::Append( const aiVector3D* pPositions, unsigned int pNumPositio
 void SpatialSort::FindPositions( const aiVector3D& pPosition,
     ai_real pRadius, std::vector<unsigned int>& poResults) const
 {
-    const ai_real dist = pPosition * mPlaneNormal;
-    const ai_real minDist = dist - pRadius, maxDist = dist + pRadius;
-
     // clear the array
     poResults.clear();
 
+    const ai_real pSquared = pRadius*pRadius;
+    if (mMethod == Method_HashGrid) {
+        const aiVector3D radius(pRadius, pRadius, pRadius);
+        ForEachInBox(pPosition - radius, pPosition + radius, [&](const Entry& e) {
+            if( (mPositionData[e.mIndex] - pPosition).SquareLength() < pSquared)
+                poResults.push_back( e.mIndex);
+        });
+        return;
+    }
+
+    const ai_real dist = pPosition * mPlaneNormal;
+    const ai_real minDist = dist - pRadius, maxDist = dist + pRadius;
+
     // quick check for positions outside the range
     if( mPositions.size() == 0)
         return;
@@ -161,10 +384,9 @@ void SpatialSort::FindPositions( const aiVector3D& pPosition,
     // Mow start iterating from there until the first position lays outside of the distance range.
     // Add all positions inside the distance range within the given radius to the result aray
     std::vector<Entry>::const_iterator it = mPositions.begin() + index;
-    const ai_real pSquared = pRadius*pRadius;
     while( it->mDistance < maxDist)
     {
-        if( (it->mPosition - pPosition).SquareLength() < pSquared)
+        if( (mPositionData[it->mIndex] - pPosition).SquareLength() < pSquared)
             poResults.push_back( it->mIndex);
         ++it;
         if( it == mPositions.end())
@@ -263,6 +485,19 @@ void SpatialSort::FindIdenticalPositions( const aiVector3D& pPosition,
     //  subtraction.
     static const int distance3DToleranceInULPs = distanceToleranceInULPs + 1;
 
+    if (mMethod == Method_HashGrid) {
+        poResults.resize( 0 );
+
+        // Positions this close share their coordinates unless they are next to the origin, so
+        // a tiny box around the position finds all of them.
+        const aiVector3D tolerance(ai_real(1e-20), ai_real(1e-20), ai_real(1e-20));
+        ForEachInBox(pPosition - tolerance, pPosition + tolerance, [&](const Entry& e) {
+            if( distance3DToleranceInULPs >= ToBinary((mPositionData[e.mIndex] - pPosition).SquareLength()))
+                poResults.push_back(e.mIndex);
+        });
+        return;
+    }
+
     // Convert the plane distance to its signed integer representation so the ULPs tolerance can be
     //  applied. For some reason, VC won't optimize two calls of the bit pattern conversion.
     const BinFloat minDistBinary = ToBinary( pPosition * mPlaneNormal) - distanceToleranceInULPs;
@@ -298,7 +533,7 @@ void SpatialSort::FindIdenticalPositions( const aiVector3D& pPosition,
     std::vector<Entry>::const_iterator it = mPositions.begin() + index;
     while( ToBinary(it->mDistance) < maxDistBinary)
     {
-        if( distance3DToleranceInULPs >= ToBinary((it->mPosition - pPosition).SquareLength()))
+        if( distance3DToleranceInULPs >= ToBinary((mPositionData[it->mIndex] - pPosition).SquareLength()))
             poResults.push_back(it->mIndex);
         ++it;
         if( it == mPositions.end())
@@ -316,14 +551,35 @@ unsigned int SpatialSort::GenerateMappingTable(std::vector<unsigned int>& fill,
 
     unsigned int t=0;
     const ai_real pSquared = pRadius*pRadius;
+
+    if (mMethod == Method_HashGrid) {
+        // Assign output IDs in vertex order. Each unassigned vertex claims all unassigned
+        // vertices within the radius.
+        std::fill(fill.begin(), fill.end(), UINT_MAX);
+
+        const aiVector3D radius(pRadius, pRadius, pRadius);
+        for (size_t i = 0; i < fill.size(); ++i) {
+            if (fill[i] != UINT_MAX) {
+                continue;
+            }
+            fill[i] = t;
+            const aiVector3D& pos = mPositionData[i];
+            ForEachInBox(pos - radius, pos + radius, [&](const Entry& e) {
+                if (fill[e.mIndex] == UINT_MAX && (mPositionData[e.mIndex] - pos).SquareLength() < pSquared)
+                    fill[e.mIndex] = t;
+            });
+            ++t;
+        }
+        return t;
+    }
     for (size_t i = 0; i < mPositions.size();) {
-        dist = mPositions[i].mPosition * mPlaneNormal;
+        dist = mPositions[i].mDistance;
         maxDist = dist + pRadius;
 
         fill[mPositions[i].mIndex] = t;
-        const aiVector3D& oldpos = mPositions[i].mPosition;
+        const aiVector3D& oldpos = mPositionData[mPositions[i].mIndex];
         for (++i; i < fill.size() && mPositions[i].mDistance < maxDist
-            && (mPositions[i].mPosition - oldpos).SquareLength() < pSquared; ++i)
+            && (mPositionData[mPositions[i].mIndex] - oldpos).SquareLength() < pSquared; ++i)
         {
             fill[mPositions[i].mIndex] = t;
         }
@@ -340,3 +596,74 @@ unsigned int SpatialSort::GenerateMappingTable(std::vector<unsigned int>& fill,
 #endif
     return t;
 }
+
+// ------------------------------------------------------------------------------------------------
+template <typename Query>
+void SpatialSort::FindForAll( Query pQuery, std::vector<unsigned int>& poOffsets,
+    std::vector<unsigned int>& poResults, ThreadPool* pPool) const
+{
+    const unsigned int numPositions = static_cast<unsigned int>(mPositions.size());
+    poOffsets.assign(numPositions + 1, 0);
+    poResults.clear();
+
+    // Each range of positions collects its results separately, several ranges per thread
+    // balance the load. The row sizes go to poOffsets directly.
+    static const unsigned int MinPositionsPerRange = 1024;
+    const unsigned int numThreads = NULL != pPool ? pPool->GetNumThreads() : 1;
+    const unsigned int numRanges = std::max(1u, std::min(numThreads * 4, numPositions / MinPositionsPerRange));
+    std::vector<std::vector<unsigned int> > rangeResults(numRanges);
+
+    const std::function<void(unsigned int)> findRange = [&](unsigned int r) {
+        const unsigned int first = static_cast<unsigned int>(uint64_t(numPositions) * r / numRanges);
+        const unsigned int last = static_cast<unsigned int>(uint64_t(numPositions) * (r + 1) / numRanges);
+        std::vector<unsigned int> found;
+        for (unsigned int i = first; i < last; ++i) {
+            pQuery(mPositionData[i], found);
+            poOffsets[i + 1] = static_cast<unsigned int>(found.size());
+            rangeResults[r].insert(rangeResults[r].end(), found.begin(), found.end());
+        }
+    };
+    const std::function<void(unsigned int)> copyRange = [&](unsigned int r) {
+        const unsigned int first = static_cast<unsigned int>(uint64_t(numPositions) * r / numRanges);
+        std::copy(rangeResults[r].begin(), rangeResults[r].end(), poResults.begin() + poOffsets[first]);
+    };
+
+    if (NULL != pPool) {
+        pPool->ParallelFor(0, numRanges, findRange);
+    } else {
+        for (unsigned int r = 0; r < numRanges; ++r) {
+            findRange(r);
+        }
+    }
+
+    for (unsigned int i = 0; i < numPositions; ++i) {
+        poOffsets[i + 1] += poOffsets[i];
+    }
+    poResults.resize(poOffsets[numPositions]);
+
+    if (NULL != pPool) {
+        pPool->ParallelFor(0, numRanges, copyRange);
+    } else {
+        for (unsigned int r = 0; r < numRanges; ++r) {
+            copyRange(r);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::FindAllPositions( ai_real pRadius, std::vector<unsigned int>& poOffsets,
+    std::vector<unsigned int>& poResults, ThreadPool* pPool) const
+{
+    FindForAll([this, pRadius](const aiVector3D& pPosition, std::vector<unsigned int>& found) {
+        FindPositions(pPosition, pRadius, found);
+    }, poOffsets, poResults, pPool);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::FindAllIdenticalPositions( std::vector<unsigned int>& poOffsets,
+    std::vector<unsigned int>& poResults, ThreadPool* pPool) const
+{
+    FindForAll([this](const aiVector3D& pPosition, std::vector<unsigned int>& found) {
+        FindIdenticalPositions(pPosition, found);
+    }, poOffsets, poResults, pPool);
+}
@@ -0,0 +1,190 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ThreadPool.cpp
+ *  @brief Implementation of the worker pool used by the post-processing
+ *    pipeline.
+ */
+#include "ThreadPool.h"
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool( unsigned int numThreads )
+: mWorkers()
+, mMutex()
+, mWakeUp()
+, mDone()
+, mJob( nullptr )
+, mNext( 0 )
+, mEnd( 0 )
+, mGeneration( 0 )
+, mNumActive( 0 )
+, mShutdown( false )
+, mBusy( false )
+, mFailed( false )
+, mError() {
+    if ( 0 == numThreads ) {
+        numThreads = GetHardwareConcurrency();
+    }
+
+    // the calling thread takes part in every job, so we need one worker less
+    mWorkers.reserve( numThreads - 1 );
+    for ( unsigned int i = 1; i < numThreads; ++i ) {
+        mWorkers.push_back( std::thread( &ThreadPool::WorkerMain, this ) );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        mShutdown = true;
+    }
+    mWakeUp.notify_all();
+
+    for ( std::thread &worker : mWorkers ) {
+        worker.join();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetNumThreads() const {
+    return static_cast<unsigned int>( mWorkers.size() ) + 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetHardwareConcurrency() {
+    const unsigned int num = std::thread::hardware_concurrency();
+    return num ? num : 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor( unsigned int begin, unsigned int end, const std::function<void(unsigned int)>& fn ) {
+    if ( begin >= end ) {
+        return;
+    }
+
+    // Run serially if there is nothing to share or if we're called from
+    // inside another job - the workers are busy with that one already.
+    bool expected = false;
+    if ( mWorkers.empty() || end - begin == 1 || !mBusy.compare_exchange_strong( expected, true ) ) {
+        for ( unsigned int i = begin; i < end; ++i ) {
+            fn( i );
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        mJob = &fn;
+        mNext = begin;
+        mEnd = end;
+        mFailed = false;
+        mNumActive = static_cast<unsigned int>( mWorkers.size() );
+        ++mGeneration;
+    }
+    mWakeUp.notify_all();
+
+    RunJob();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock( mMutex );
+        mDone.wait( lock, [this] { return 0 == mNumActive; } );
+        mJob = nullptr;
+        error = mError;
+        mError = nullptr;
+    }
+    mBusy = false;
+
+    if ( error ) {
+        std::rethrow_exception( error );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::RunJob() {
+    while ( !mFailed ) {
+        const unsigned int i = mNext++;
+        if ( i >= mEnd ) {
+            break;
+        }
+
+        try {
+            ( *mJob )( i );
+        } catch ( ... ) {
+            std::lock_guard<std::mutex> lock( mMutex );
+            if ( !mError ) {
+                mError = std::current_exception();
+            }
+            mFailed = true;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::WorkerMain() {
+    unsigned int generation = 0;
+    for ( ;; ) {
+        {
+            std::unique_lock<std::mutex> lock( mMutex );
+            mWakeUp.wait( lock, [this, generation] { return mShutdown || mGeneration != generation; } );
+            if ( mShutdown ) {
+                return;
+            }
+            generation = mGeneration;
+        }
+
+        RunJob();
+
+        {
+            std::lock_guard<std::mutex> lock( mMutex );
+            if ( 0 == --mNumActive ) {
+                mDone.notify_one();
+            }
+        }
+    }
+}
+
+} // Namespace Assimp
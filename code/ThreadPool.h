@@ -0,0 +1,128 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ThreadPool.h
+ *  @brief Defines a small fixed-size worker pool used to spread independent
+ *    work items (i.e. the meshes of a scene) across several threads.
+ */
+#pragma once
+#ifndef AI_THREADPOOL_H_INC
+#define AI_THREADPOOL_H_INC
+
+#include <assimp/defs.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief A fixed-size pool of worker threads.
+ *
+ *  The pool runs one job at a time: ParallelFor() hands out the indices of
+ *  a range to the workers and to the calling thread, and returns once all
+ *  of them have been processed. Indices are handed out one by one, so work
+ *  items of very different cost (small and huge meshes) are balanced well.
+ *
+ *  The first exception thrown by a work item is rethrown on the calling
+ *  thread, the remaining items are skipped in this case. Nested calls to
+ *  ParallelFor() - from inside a work item - run serially on the calling
+ *  thread.
+ */
+class ASSIMP_API ThreadPool {
+public:
+    /// @brief  The class constructor.
+    /// @param  numThreads  Total number of threads to use, including the
+    ///   calling thread. 0 selects the number of hardware threads.
+    explicit ThreadPool( unsigned int numThreads );
+
+    /// @brief  The class destructor, joins all worker threads.
+    ~ThreadPool();
+
+    /// @brief  Returns the number of threads taking part in a job,
+    ///   including the calling thread.
+    unsigned int GetNumThreads() const;
+
+    /// @brief  Invokes fn(i) for every i in [begin,end).
+    /// @param  begin   First index.
+    /// @param  end     One past the last index.
+    /// @param  fn      Work item, must be safe to call concurrently for
+    ///   different indices.
+    void ParallelFor( unsigned int begin, unsigned int end, const std::function<void(unsigned int)>& fn );
+
+    /// @brief  Returns the number of hardware threads, at least 1.
+    static unsigned int GetHardwareConcurrency();
+
+private:
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool& operator = ( const ThreadPool& ) = delete;
+
+    void WorkerMain();
+    void RunJob();
+
+private:
+    std::vector<std::thread> mWorkers;
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::condition_variable mDone;
+
+    // state of the current job, guarded by mMutex unless atomic
+    const std::function<void(unsigned int)>* mJob;
+    std::atomic<unsigned int> mNext;
+    unsigned int mEnd;
+    unsigned int mGeneration;
+    unsigned int mNumActive;
+    bool mShutdown;
+    std::atomic<bool> mBusy;
+    std::atomic<bool> mFailed;
+    std::exception_ptr mError;
+};
+
+} // Namespace Assimp
+
+#endif // AI_THREADPOOL_H_INC
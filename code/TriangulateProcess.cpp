@@ -64,6 +64,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "PolyTools.h"
 #include <memory>
+#include <algorithm>
 
 //#define AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
 //#define AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -99,18 +100,48 @@ bool TriangulateProcess::IsActive( unsigned int pFlags) const
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void TriangulateProcess::Execute( aiScene* pScene)
+{
+    ExecuteMeshPass(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TriangulateProcess::IsMeshLocal() const
+{
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshFootprint TriangulateProcess::GetMeshFootprint() const
+{
+#ifdef AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
+    return MeshFootprint(MeshComponent_Positions | MeshComponent_Faces, MeshComponent_Faces | MeshComponent_Colors);
+#else
+    return MeshFootprint(MeshComponent_Positions | MeshComponent_Faces, MeshComponent_Faces);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void TriangulateProcess::BeginMeshPass( aiScene* pScene)
 {
     ASSIMP_LOG_DEBUG("TriangulateProcess begin");
 
-    bool bHas = false;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-    {
-        if (pScene->mMeshes[ a ]) {
-            if ( TriangulateMesh( pScene->mMeshes[ a ] ) ) {
-                bHas = true;
-            }
-        }
+    meshTriangulated.assign(pScene->mNumMeshes, 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void TriangulateProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+    if (pMesh) {
+        meshTriangulated[meshIndex] = TriangulateMesh(pMesh);
     }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TriangulateProcess::EndMeshPass( aiScene* /*pScene*/)
+{
+    const bool bHas = std::find(meshTriangulated.begin(), meshTriangulated.end(), 1) != meshTriangulated.end();
+    meshTriangulated.clear();
+
     if ( bHas ) {
         ASSIMP_LOG_INFO( "TriangulateProcess finished. All polygons have been triangulated." );
     } else {
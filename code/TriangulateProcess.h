@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_TRIANGULATEPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 
 struct aiMesh;
 
@@ -82,12 +83,24 @@ public:
     */
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** The step works on each mesh independently, see BaseProcess. */
+    bool IsMeshLocal() const;
+    MeshFootprint GetMeshFootprint() const;
+    void BeginMeshPass( aiScene* pScene);
+    void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex);
+    void EndMeshPass( aiScene* pScene);
+
 public:
     // -------------------------------------------------------------------
     /** Triangulates the given mesh.
      * @param pMesh The mesh to triangulate.
      */
     bool TriangulateMesh( aiMesh* pMesh);
+
+private:
+    /** Per-mesh result of the current pass: triangulated or not */
+    std::vector<unsigned char> meshTriangulated;
 };
 
 } // end of namespace Assimp
@@ -512,6 +512,44 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
     {
         ReportError("aiMesh::mBones is non-null although there are no bones");
     }
+
+    // validate the quantized vertex components, if any
+    if (pMesh->mQuantized && pMesh->mQuantized->mNumVertices != pMesh->mNumVertices)
+    {
+        ReportError("aiQuantizedMesh::mNumVertices is %i, but aiMesh::mNumVertices is %i",
+            pMesh->mQuantized->mNumVertices,pMesh->mNumVertices);
+    }
+
+    // validate the meshlets, if any
+    if (pMesh->mMeshlets)
+    {
+        const aiMeshletData* data = pMesh->mMeshlets;
+        if (data->mNumMeshlets && !data->mMeshlets) {
+            ReportError("aiMeshletData::mMeshlets is NULL (aiMeshletData::mNumMeshlets is %i)",
+                data->mNumMeshlets);
+        }
+        for (unsigned int i = 0; i < data->mNumVertices; ++i)
+        {
+            if (data->mVertices[i] >= pMesh->mNumVertices) {
+                ReportError("aiMeshletData::mVertices[%i] is out of range",i);
+            }
+        }
+        for (unsigned int i = 0; i < data->mNumMeshlets; ++i)
+        {
+            const aiMeshlet& m = data->mMeshlets[i];
+            if (m.mVertexOffset + m.mNumVertices > data->mNumVertices ||
+                m.mTriangleOffset + m.mNumTriangles > data->mNumTriangles) {
+                ReportError("aiMeshletData::mMeshlets[%i] is out of range",i);
+            }
+            for (unsigned int a = 0; a < m.mNumTriangles * 3; ++a)
+            {
+                if (data->mTriangles[m.mTriangleOffset * 3 + a] >= m.mNumVertices) {
+                    ReportError("aiMeshletData::mMeshlets[%i] references a vertex "
+                        "which is not part of it",i);
+                }
+            }
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
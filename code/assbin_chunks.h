@@ -146,6 +146,19 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
      the kinds of vertex components actually present in the mesh. This is a
      bitwise combination of the ASSBIN_MESH_HAS_xxx constants.
 
+   - aiMesh::mMeshlets is stored in a ASSBIN_CHUNK_AIMESHLETS subchunk
+     following the bones if ASSBIN_MESH_HAS_MESHLETS is set. Within it,
+     the meshlets are followed by mVertices and mTriangles, the latter
+     as 3*mNumTriangles bytes.
+
+   - aiMesh::mQuantized is stored in a ASSBIN_CHUNK_AIQUANTIZEDMESH subchunk
+     following the meshlets if ASSBIN_MESH_HAS_QUANTIZED is set. Its
+     mNumVertices is followed by a bitwise combination of the
+     ASSBIN_MESH_HAS_xxx constants for the streams present, then by the
+     streams in order of declaration, each one preceded by its
+     dequantization parameters. mTexCoordOffset and mTexCoordScale are
+     written as two floats each.
+
 [[aiFace]]
 
    - mNumIndices is stored as short
@@ -182,10 +195,14 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 #define ASSBIN_CHUNK_AINODE                     0x123c
 #define ASSBIN_CHUNK_AIMATERIAL                 0x123d
 #define ASSBIN_CHUNK_AIMATERIALPROPERTY         0x123e
+#define ASSBIN_CHUNK_AIMESHLETS                 0x123f
+#define ASSBIN_CHUNK_AIQUANTIZEDMESH            0x1240
 
 #define ASSBIN_MESH_HAS_POSITIONS                   0x1
 #define ASSBIN_MESH_HAS_NORMALS                     0x2
 #define ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS     0x4
+#define ASSBIN_MESH_HAS_MESHLETS                    0x8
+#define ASSBIN_MESH_HAS_QUANTIZED                   0x10
 #define ASSBIN_MESH_HAS_TEXCOORD_BASE               0x100
 #define ASSBIN_MESH_HAS_COLOR_BASE                  0x10000
 
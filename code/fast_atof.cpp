@@ -0,0 +1,421 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  fast_atof.cpp
+ *  @brief Bulk number parsers declared in fast_atof.h
+ */
+
+#include <assimp/fast_atof.h>
+#include "simd.h"
+
+#include <algorithm>
+#include <clocale>
+#include <cstdlib>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define AI_FAST_ATOF_USE_SSE2
+#   include <emmintrin.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+#ifdef AI_FAST_ATOF_USE_SSE2
+const bool s_useSSE2 = CPUSupportsSSE2();
+#endif
+
+// Exactly representable powers of ten, used by the correctly rounded fast path.
+const double s_exactPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Limits of the fast path: the mantissa and the power of ten must both be exact in Real.
+template <typename Real> struct ExactLimits;
+
+template <> struct ExactLimits<float> {
+    static uint64_t MaxMantissa() { return uint64_t(1) << 24; }
+    static int MaxPow10() { return 10; }
+};
+
+template <> struct ExactLimits<double> {
+    static uint64_t MaxMantissa() { return uint64_t(1) << 53; }
+    static int MaxPow10() { return 22; }
+};
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// ------------------------------------------------------------------------------------------------
+// The separators accepted by SkipSpacesAndLineEnd
+inline bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsTokenEnd(const char* p, const char* end) {
+    return p == end || IsBlank(*p) || *p == '\0';
+}
+
+// ------------------------------------------------------------------------------------------------
+inline const char* SkipBlanks(const char* p, const char* end) {
+    while (p != end && IsBlank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline const char* SkipDigits(const char* p, const char* end) {
+    while (p != end && IsDigit(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Accumulates at most maxDigits (<= 19) decimal digits into value, so value must be small
+// enough not to overflow. Returns the number of digits read, p is moved past them.
+inline unsigned int ReadDigits(const char*& p, const char* end, unsigned int maxDigits, uint64_t& value) {
+    unsigned int read = 0;
+#ifdef AI_FAST_ATOF_USE_SSE2
+    if (s_useSSE2) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ascii0 = _mm_set1_epi8('0');
+        const __m128i below0 = _mm_set1_epi8('0' - 1);
+        const __m128i above9 = _mm_set1_epi8('9' + 1);
+        const __m128i mul10 = _mm_setr_epi16(10, 1, 10, 1, 10, 1, 10, 1);
+        const __m128i mul100 = _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1);
+
+        // Convert groups of eight digits: two multiply-add rounds combine them into pairs and
+        // quadruples, the last step is done on the two remaining 32 bit lanes.
+        while (end - p >= 16 && maxDigits - read >= 8) {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, below0), _mm_cmplt_epi8(chars, above9));
+            if ((_mm_movemask_epi8(isDigit) & 0xff) != 0xff) {
+                break;
+            }
+
+            const __m128i digits = _mm_unpacklo_epi8(_mm_sub_epi8(chars, ascii0), zero);
+            const __m128i pairs = _mm_madd_epi16(digits, mul10);
+            const __m128i quads = _mm_madd_epi16(_mm_packs_epi32(pairs, pairs), mul100);
+            const uint32_t high = static_cast<uint32_t>(_mm_cvtsi128_si32(quads));
+            const uint32_t low = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(quads, 4)));
+
+            value = value * 100000000u + high * 10000u + low;
+            p += 8;
+            read += 8;
+        }
+    }
+#endif
+    while (read < maxDigits && p != end && IsDigit(*p)) {
+        value = value * 10u + static_cast<uint64_t>(*p - '0');
+        ++p;
+        ++read;
+    }
+    return read;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies the token at p so the scalar parsers, which rely on a terminator, can't read past end.
+const char* CopyToken(const char* p, const char* end, std::string& token) {
+    const char* tokenEnd = p;
+    while (!IsTokenEnd(tokenEnd, end)) {
+        ++tokenEnd;
+    }
+    token.assign(p, tokenEnd);
+    return tokenEnd;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Any number fast_atoreal_move can parse, at its pace.
+template <typename Real>
+const char* ParseRealScalar(const char* p, const char* end, Real& out) {
+    std::string token;
+    const char* tokenEnd = CopyToken(p, end, token);
+    const char* stop = fast_atoreal_move<Real>(token.c_str(), out);
+
+    // integer overflow, fast_atoreal_move has warned and doesn't move
+    if (stop == token.c_str()) {
+        return tokenEnd;
+    }
+    return p + (stop - token.c_str());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Numbers of the form [+-]digits[.digits][(e|E)[+-]digits], with the same arithmetic as
+// fast_atoreal_move. Returns false for anything else, p is then unchanged.
+template <typename Real>
+bool ParseRealFast(const char*& p, const char* end, Real& out) {
+    const char* c = p;
+    const bool inv = (*c == '-');
+    if (inv || *c == '+') {
+        ++c;
+    }
+    if (c == end || !IsDigit(*c)) {
+        return false;
+    }
+
+    // strtoul10_64 warns on overflow, leave long integers to it
+    uint64_t integer = 0;
+    if (ReadDigits(c, end, 18, integer) == 18 && c != end && IsDigit(*c)) {
+        return false;
+    }
+    Real f = static_cast<Real>(integer);
+
+    if (c != end && *c == '.') {
+        // trailing dots are rare, fast_atoreal_move knows how to treat them
+        if (end - c < 2 || !IsDigit(c[1])) {
+            return false;
+        }
+        ++c;
+
+        uint64_t fraction = 0;
+        const unsigned int diff = ReadDigits(c, end, AI_FAST_ATOF_RELAVANT_DECIMALS, fraction);
+        c = SkipDigits(c, end);
+
+        double pl = static_cast<double>(fraction);
+        pl *= fast_atof_table[diff];
+        f += static_cast<Real>(pl);
+    }
+
+    if (c != end && (*c == 'e' || *c == 'E')) {
+        ++c;
+        const bool einv = (c != end && *c == '-');
+        if (c != end && (einv || *c == '+')) {
+            ++c;
+        }
+        uint64_t e = 0;
+        if (c == end || !IsDigit(*c) || (ReadDigits(c, end, 18, e) == 18 && c != end && IsDigit(*c))) {
+            return false;
+        }
+
+        Real exp = static_cast<Real>(e);
+        if (einv) {
+            exp = -exp;
+        }
+        f *= std::pow(static_cast<Real>(10.0), exp);
+    }
+
+    // e.g. a decimal comma
+    if (!IsTokenEnd(c, end)) {
+        return false;
+    }
+
+    if (inv) {
+        f = -f;
+    }
+    out = f;
+    p = c;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// strtod and strtof round correctly, but expect the decimal point of the current C locale.
+inline double StringToReal(const char* str, double*) {
+    return ::strtod(str, NULL);
+}
+
+inline float StringToReal(const char* str, float*) {
+    return ::strtof(str, NULL);
+}
+
+template <typename Real>
+Real ParseRealLibrary(const char* begin, const char* end) {
+    std::string token(begin, end);
+    const char decimalPoint = *::localeconv()->decimal_point;
+    if (decimalPoint != '.') {
+        std::replace(token.begin(), token.end(), '.', decimalPoint);
+    }
+    return StringToReal(token.c_str(), static_cast<Real*>(NULL));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Same grammar as ParseRealFast, but correctly rounded. Numbers whose mantissa or power of ten
+// is not exact in Real are handed to the C library, which rounds correctly.
+template <typename Real>
+bool ParseRealExact(const char*& p, const char* end, Real& out) {
+    const char* c = p;
+    const bool inv = (*c == '-');
+    if (inv || *c == '+') {
+        ++c;
+    }
+    if (c == end || !IsDigit(*c)) {
+        return false;
+    }
+
+    bool fast = true;
+    uint64_t mantissa = 0;
+    const unsigned int integerDigits = ReadDigits(c, end, 19, mantissa);
+    if (c != end && IsDigit(*c)) {
+        fast = false;
+        c = SkipDigits(c, end);
+    }
+
+    int exp10 = 0;
+    if (c != end && *c == '.') {
+        if (end - c < 2 || !IsDigit(c[1])) {
+            return false;
+        }
+        ++c;
+        if (fast) {
+            exp10 = -static_cast<int>(ReadDigits(c, end, 19 - integerDigits, mantissa));
+            if (c != end && IsDigit(*c)) {
+                fast = false;
+            }
+        }
+        c = SkipDigits(c, end);
+    }
+
+    if (c != end && (*c == 'e' || *c == 'E')) {
+        ++c;
+        const bool einv = (c != end && *c == '-');
+        if (c != end && (einv || *c == '+')) {
+            ++c;
+        }
+        if (c == end || !IsDigit(*c)) {
+            return false;
+        }
+        uint64_t e = 0;
+        if (ReadDigits(c, end, 4, e) == 4 && c != end && IsDigit(*c)) {
+            fast = false;
+            c = SkipDigits(c, end);
+        }
+        exp10 += einv ? -static_cast<int>(e) : static_cast<int>(e);
+    }
+
+    if (!IsTokenEnd(c, end)) {
+        return false;
+    }
+
+    const int maxPow10 = ExactLimits<Real>::MaxPow10();
+    if (fast && mantissa <= ExactLimits<Real>::MaxMantissa() && exp10 >= -maxPow10 && exp10 <= maxPow10) {
+        const Real m = static_cast<Real>(mantissa);
+        const Real scale = static_cast<Real>(s_exactPow10[exp10 < 0 ? -exp10 : exp10]);
+        out = exp10 < 0 ? m / scale : m * scale;
+        if (inv) {
+            out = -out;
+        }
+    } else {
+        out = ParseRealLibrary<Real>(p, c);
+    }
+    p = c;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Real>
+const char* ParseRealArray(const char* in, const char* end, Real* out, size_t count, size_t* parsed, bool exact) {
+    size_t n = 0;
+    in = SkipBlanks(in, end);
+    while (n < count && in != end && *in != '\0') {
+        Real value;
+        if (!(exact ? ParseRealExact(in, end, value) : ParseRealFast(in, end, value))) {
+            in = ParseRealScalar(in, end, value);
+        }
+        out[n++] = value;
+        in = SkipBlanks(in, end);
+    }
+    if (parsed) {
+        *parsed = n;
+    }
+    return in;
+}
+
+} // Namespace
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+const char* fast_atoreal_array(const char* in, const char* end, float* out, size_t count, size_t* parsed, bool exact) {
+    return ParseRealArray(in, end, out, count, parsed, exact);
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* fast_atoreal_array(const char* in, const char* end, double* out, size_t count, size_t* parsed, bool exact) {
+    return ParseRealArray(in, end, out, count, parsed, exact);
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* strtol10_array(const char* in, const char* end, int* out, size_t count, size_t* parsed) {
+    size_t n = 0;
+    in = SkipBlanks(in, end);
+    while (n < count && in != end && *in != '\0') {
+        const char* c = in;
+        const bool inv = (*c == '-');
+        if (inv || *c == '+') {
+            ++c;
+        }
+        if (c == end || !IsDigit(*c)) {
+            break;
+        }
+
+        // strtoul10 wraps around on overflow, so does the truncation of the 64 bit value
+        uint64_t digits = 0;
+        ReadDigits(c, end, 18, digits);
+        unsigned int value = static_cast<unsigned int>(digits);
+        for (; c != end && IsDigit(*c); ++c) {
+            value = value * 10u + static_cast<unsigned int>(*c - '0');
+        }
+        if (!IsTokenEnd(c, end)) {
+            break;
+        }
+
+        int result = static_cast<int>(value);
+        if (inv) {
+            result = -result;
+        }
+        out[n++] = result;
+        in = SkipBlanks(c, end);
+    }
+    if (parsed) {
+        *parsed = n;
+    }
+    return in;
+}
+
+} // Namespace Assimp
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * glTF Extensions Support:
  *   KHR_materials_pbrSpecularGlossiness full
  *   KHR_materials_unlit full
+ *   KHR_mesh_quantization export only
  */
 #ifndef GLTF2ASSET_H_INC
 #define GLTF2ASSET_H_INC
@@ -434,6 +435,7 @@ namespace glTF2
         ComponentType componentType; //!< The datatype of components in the attribute. (required)
         unsigned int count;          //!< The number of attributes referenced by this accessor. (required)
         AttribType::Value type;      //!< Specifies if the attribute is a scalar, vector, or matrix. (required)
+        bool normalized;             //!< Specifies whether integer data values are normalized to [0, 1] or [-1, 1].
         std::vector<float> max;      //!< Maximum value of each component in this attribute.
         std::vector<float> min;      //!< Minimum value of each component in this attribute.
 
@@ -482,7 +484,7 @@ namespace glTF2
             return Indexer(*this);
         }
 
-        Accessor() {}
+        Accessor() : normalized(false) {}
         void Read(Value& obj, Asset& r);
     };
 
@@ -572,7 +574,10 @@ namespace glTF2
 
 		void Read(Value& obj, Asset& r);
 
-        bool LoadFromStream(IOStream& stream, size_t length = 0, size_t baseOffset = 0);
+        /// Loads the buffer contents from the given stream. If the stream exposes its
+        /// contents through IOStream::GetContiguousView() the buffer refers to that
+        /// memory and keeps the stream alive instead of copying the data.
+        bool LoadFromStream(const shared_ptr<IOStream>& stream, size_t length = 0, size_t baseOffset = 0);
 
 		/// \fn void EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
 		/// Mark region of "bufferView" as encoded. When data is request from such region then "bufferView" use decoded data.
@@ -1042,6 +1047,7 @@ namespace glTF2
         {
             bool KHR_materials_pbrSpecularGlossiness;
             bool KHR_materials_unlit;
+            bool KHR_mesh_quantization;
 
         } extensionsUsed;
 
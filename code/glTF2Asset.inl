@@ -379,10 +379,9 @@ inline void Buffer::Read(Value& obj, Asset& r)
         if (byteLength > 0) {
             std::string dir = !r.mCurrentAssetDir.empty() ? (r.mCurrentAssetDir + "/") : "";
 
-            IOStream* file = r.OpenFile(dir + uri, "rb");
+            shared_ptr<IOStream> file(r.OpenFile(dir + uri, "rb"));
             if (file) {
-                bool ok = LoadFromStream(*file, byteLength);
-                delete file;
+                bool ok = LoadFromStream(file, byteLength);
 
                 if (!ok)
                     throw DeadlyImportError("GLTF: error while reading referenced file \"" + std::string(uri) + "\"" );
@@ -394,17 +393,29 @@ inline void Buffer::Read(Value& obj, Asset& r)
     }
 }
 
-inline bool Buffer::LoadFromStream(IOStream& stream, size_t length, size_t baseOffset)
+inline bool Buffer::LoadFromStream(const shared_ptr<IOStream>& stream, size_t length, size_t baseOffset)
 {
-    byteLength = length ? length : stream.FileSize();
+    byteLength = length ? length : stream->FileSize();
+
+#ifdef ASSIMP_API
+    size_t viewSize = 0;
+    const uint8_t* view = stream->GetContiguousView(viewSize);
+    if (view && baseOffset <= viewSize && byteLength <= viewSize - baseOffset) {
+        // the importer only reads buffer data, refer to the view and keep the
+        // stream alive as long as the data is in use
+        shared_ptr<IOStream> owner(stream);
+        mData.reset(const_cast<uint8_t*>(view + baseOffset), [owner](uint8_t*) {});
+        return true;
+    }
+#endif
 
     if (baseOffset) {
-        stream.Seek(baseOffset, aiOrigin_SET);
+        stream->Seek(baseOffset, aiOrigin_SET);
     }
 
     mData.reset(new uint8_t[byteLength], std::default_delete<uint8_t[]>());
 
-    if (stream.Read(mData.get(), byteLength, 1) != 1) {
+    if (stream->Read(mData.get(), byteLength, 1) != 1) {
         return false;
     }
     return true;
@@ -559,6 +570,8 @@ inline void Accessor::Read(Value& obj, Asset& r)
 
     const char* typestr;
     type = ReadMember(obj, "type", typestr) ? AttribType::FromString(typestr) : AttribType::SCALAR;
+
+    normalized = MemberOrDefault(obj, "normalized", false);
 }
 
 inline unsigned int Accessor::GetNumComponents()
@@ -1329,7 +1342,7 @@ inline void Asset::Load(const std::string& pFile, bool isBinary)
 
     // Fill the buffer instance for the current file embedded contents
     if (mBodyLength > 0) {
-        if (!mBodyBuffer->LoadFromStream(*stream, mBodyLength, mBodyOffset)) {
+        if (!mBodyBuffer->LoadFromStream(stream, mBodyLength, mBodyOffset)) {
             throw DeadlyImportError("GLTF: Unable to read gltf file");
         }
     }
@@ -1403,6 +1416,7 @@ inline void Asset::ReadExtensionsUsed(Document& doc)
 
     CHECK_EXT(KHR_materials_pbrSpecularGlossiness);
     CHECK_EXT(KHR_materials_unlit);
+    CHECK_EXT(KHR_mesh_quantization);
 
     #undef CHECK_EXT
 }
@@ -103,6 +103,10 @@ namespace glTF2 {
         obj.AddMember("count", a.count, w.mAl);
         obj.AddMember("type", StringRef(AttribType::ToString(a.type)), w.mAl);
 
+        if (a.normalized) {
+            obj.AddMember("normalized", true, w.mAl);
+        }
+
         Value vTmpMax, vTmpMin;
         obj.AddMember("max", MakeValue(vTmpMax, a.max, w.mAl), w.mAl);
         obj.AddMember("min", MakeValue(vTmpMin, a.min, w.mAl), w.mAl);
@@ -714,10 +718,22 @@ namespace glTF2 {
             if (this->mAsset.extensionsUsed.KHR_materials_unlit) {
               exts.PushBack(StringRef("KHR_materials_unlit"), mAl);
             }
+
+            if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+              exts.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+            }
         }
 
         if (!exts.Empty())
             mDoc.AddMember("extensionsUsed", exts, mAl);
+
+        // quantized attributes can't be read without the extension
+        if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+            Value required;
+            required.SetArray();
+            required.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+            mDoc.AddMember("extensionsRequired", required, mAl);
+        }
     }
 
     template<class T>
@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Header files, standard library.
 #include <memory>
+#include <cmath>
 #include <inttypes.h>
 
 #include "glTF2AssetWriter.h"
@@ -224,6 +225,78 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     return acc;
 }
 
+/*
+ * Export an array of quantized vertex components of type T. Vertex attributes
+ * must be aligned to four bytes, so the elements are padded if required.
+ * min and max hold the stored integer values.
+ */
+template<class T>
+inline Ref<Accessor> ExportQuantizedData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    unsigned int count, const T* data, AttribType::Value type, ComponentType compType, bool normalized)
+{
+    if (!count || !data) {
+        return Ref<Accessor>();
+    }
+
+    const unsigned int numComps = AttribType::GetNumComponents(type);
+    const size_t elemSize = numComps * sizeof(T);
+    const size_t stride = (elemSize + 3) & ~size_t(3);
+
+    size_t offset = buffer->byteLength;
+    size_t padding = (4 - offset % 4) % 4;
+    offset += padding;
+    size_t length = count * stride;
+    buffer->Grow(length + padding);
+
+    // bufferView
+    Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
+    bv->buffer = buffer;
+    bv->byteOffset = unsigned(offset);
+    bv->byteLength = length;
+    bv->byteStride = stride != elemSize ? stride : 0;
+    bv->target = BufferViewTarget_ARRAY_BUFFER;
+
+    // accessor
+    Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshName, "accessor"));
+    acc->bufferView = bv;
+    acc->byteOffset = 0;
+    acc->componentType = compType;
+    acc->count = count;
+    acc->type = type;
+    acc->normalized = normalized;
+
+    // copy the data and calculate min and max values
+    uint8_t* dst = buffer->GetPointer() + offset;
+    memset(dst, 0, length);
+
+    acc->min.assign(numComps, static_cast<float>(data[0]));
+    acc->max.assign(numComps, static_cast<float>(data[0]));
+    for (unsigned int i = 0; i < count; ++i) {
+        const T* src = data + i * numComps;
+        memcpy(dst + i * stride, src, elemSize);
+
+        for (unsigned int j = 0; j < numComps; ++j) {
+            const float valueTmp = static_cast<float>(src[j]);
+            if (valueTmp < acc->min[j]) {
+                acc->min[j] = valueTmp;
+            }
+            if (valueTmp > acc->max[j]) {
+                acc->max[j] = valueTmp;
+            }
+        }
+    }
+
+    return acc;
+}
+
+/*
+ * Quantized positions can be written as they are if the mesh isn't skinned.
+ * The dequantization transform is put into the node of the mesh instead.
+ */
+static bool HasExportableQuantizedPositions(const aiMesh* aim) {
+    return aim->mQuantized && aim->mQuantized->mPositions && !aim->HasBones();
+}
+
 inline void SetSamplerWrap(SamplerWrap& wrap, aiTextureMapMode map)
 {
     switch (map) {
@@ -715,23 +788,69 @@ void glTF2Exporter::ExportMeshes()
 
         p.material = mAsset->materials.Get(aim->mMaterialIndex);
 
+        // vertex components quantized by aiProcess_QuantizeVertices are written
+        // as they are where KHR_mesh_quantization allows it
+        const aiQuantizedMesh* q = aim->mQuantized;
+
 		/******************* Vertices ********************/
-        Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+        Ref<Accessor> v;
+        if (HasExportableQuantizedPositions(aim)) {
+            v = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, q->mPositions, AttribType::VEC3, ComponentType_UNSIGNED_SHORT, false);
+            mAsset->extensionsUsed.KHR_mesh_quantization = true;
+        } else {
+            v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+        }
 		if (v) p.attributes.position.push_back(v);
 
 		/******************** Normals ********************/
-        // Normalize all normals as the validator can emit a warning otherwise
-        if ( nullptr != aim->mNormals) {
-            for ( auto i = 0u; i < aim->mNumVertices; ++i ) {
-                aim->mNormals[ i ].Normalize();
+        Ref<Accessor> n;
+        if (q && q->mNormals) {
+            // glTF has no octahedral encoding, store them as normalized shorts
+            std::vector<int16_t> normals(aim->mNumVertices * 3);
+            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                const aiVector3D normal = q->GetNormal(i);
+                for (unsigned int j = 0; j < 3; ++j) {
+                    normals[i * 3 + j] = static_cast<int16_t>(std::floor(normal[j] * 32767.f + 0.5f));
+                }
+            }
+            n = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, &normals[0], AttribType::VEC3, ComponentType_SHORT, true);
+            mAsset->extensionsUsed.KHR_mesh_quantization = true;
+        } else {
+            // Normalize all normals as the validator can emit a warning otherwise
+            if ( nullptr != aim->mNormals) {
+                for ( auto i = 0u; i < aim->mNumVertices; ++i ) {
+                    aim->mNormals[ i ].Normalize();
+                }
             }
-        }
 
-		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+            n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+        }
         if (n) p.attributes.normal.push_back(n);
 
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            if (q && q->mTextureCoords[i]) {
+                // normalized shorts cover [0, 1] only, other ranges are decoded to floats
+                const bool bUnitRange = q->mTexCoordOffset[i] == aiVector2D() && q->mTexCoordScale[i] == aiVector2D(1, 1);
+                Ref<Accessor> tc;
+                if (bUnitRange) {
+                    std::vector<uint16_t> uvs(q->mTextureCoords[i], q->mTextureCoords[i] + aim->mNumVertices * 2);
+                    for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
+                        uvs[j * 2 + 1] = static_cast<uint16_t>(65535 - uvs[j * 2 + 1]);
+                    }
+                    tc = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, &uvs[0], AttribType::VEC2, ComponentType_UNSIGNED_SHORT, true);
+                } else {
+                    std::vector<aiVector3D> uvs(aim->mNumVertices);
+                    for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
+                        uvs[j] = q->GetTextureCoords(i, j);
+                        uvs[j].y = 1 - uvs[j].y;
+                    }
+                    tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, &uvs[0], AttribType::VEC3, AttribType::VEC2, ComponentType_FLOAT, false);
+                }
+                if (tc) p.attributes.texcoord.push_back(tc);
+                continue;
+            }
+
             // Flip UV y coords
             if (aim -> mNumUVComponents[i] > 1) {
                 for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
@@ -748,9 +867,16 @@ void glTF2Exporter::ExportMeshes()
 		}
 
 		/*************** Vertex colors ****************/
-		for (unsigned int indexColorChannel = 0; indexColorChannel < aim->GetNumColorChannels(); ++indexColorChannel)
+		for (unsigned int indexColorChannel = 0; indexColorChannel < AI_MAX_NUMBER_OF_COLOR_SETS; ++indexColorChannel)
 		{
-			Ref<Accessor> c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, false);
+			Ref<Accessor> c;
+			if (q && q->mColors[indexColorChannel]) {
+				c = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, q->mColors[indexColorChannel], AttribType::VEC4, ComponentType_UNSIGNED_BYTE, true);
+			} else if (aim->mColors[indexColorChannel]) {
+				c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, false);
+			} else {
+				break;
+			}
 			if (c)
 				p.attributes.color.push_back(c);
 		}
@@ -893,9 +1019,7 @@ unsigned int glTF2Exporter::ExportNodeHierarchy(const aiNode* n)
         CopyValue(n->mTransformation, node->matrix.value);
     }
 
-    for (unsigned int i = 0; i < n->mNumMeshes; ++i) {
-        node->meshes.push_back(mAsset->meshes.Get(n->mMeshes[i]));
-    }
+    ExportNodeMeshes(n, node);
 
     for (unsigned int i = 0; i < n->mNumChildren; ++i) {
         unsigned int idx = ExportNode(n->mChildren[i], node);
@@ -922,9 +1046,7 @@ unsigned int glTF2Exporter::ExportNode(const aiNode* n, Ref<Node>& parent)
         CopyValue(n->mTransformation, node->matrix.value);
     }
 
-    for (unsigned int i = 0; i < n->mNumMeshes; ++i) {
-        node->meshes.push_back(mAsset->meshes.Get(n->mMeshes[i]));
-    }
+    ExportNodeMeshes(n, node);
 
     for (unsigned int i = 0; i < n->mNumChildren; ++i) {
         unsigned int idx = ExportNode(n->mChildren[i], node);
@@ -935,6 +1057,33 @@ unsigned int glTF2Exporter::ExportNode(const aiNode* n, Ref<Node>& parent)
 }
 
 
+/*
+ * Add the meshes of a node. Meshes with quantized positions are put into a
+ * child node of their own whose matrix is the dequantization transform, this
+ * also keeps MergeMeshes() from mixing them with other meshes.
+ */
+void glTF2Exporter::ExportNodeMeshes(const aiNode* n, Ref<Node>& node)
+{
+    for (unsigned int i = 0; i < n->mNumMeshes; ++i) {
+        const aiMesh* aim = mScene->mMeshes[n->mMeshes[i]];
+        if (!HasExportableQuantizedPositions(aim)) {
+            node->meshes.push_back(mAsset->meshes.Get(n->mMeshes[i]));
+            continue;
+        }
+
+        std::string name = mAsset->FindUniqueID(node->name + "_quantized", "node");
+        Ref<Node> child = mAsset->nodes.Create(name);
+
+        child->parent = node;
+        child->name = name;
+        child->matrix.isPresent = true;
+        CopyValue(aim->mQuantized->mPositionTransform, child->matrix.value);
+        child->meshes.push_back(mAsset->meshes.Get(n->mMeshes[i]));
+
+        node->children.push_back(child);
+    }
+}
+
 void glTF2Exporter::ExportScene()
 {
     const char* sceneName = "defaultScene";
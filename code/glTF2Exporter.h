@@ -111,6 +111,7 @@ namespace Assimp
         void MergeMeshes();
         unsigned int ExportNodeHierarchy(const aiNode* n);
         unsigned int ExportNode(const aiNode* node, glTF2::Ref<glTF2::Node>& parent);
+        void ExportNodeMeshes(const aiNode* n, glTF2::Ref<glTF2::Node>& node);
         void ExportScene();
         void ExportAnimations();
 
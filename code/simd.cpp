@@ -42,6 +42,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "simd.h"
 
+#include <cmath>
+
+#if !defined(ASSIMP_DOUBLE_PRECISION) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define AI_SIMD_USE_SSE2
+#   include <emmintrin.h>
+#endif
+
 namespace Assimp {
 
 bool CPUSupportsSSE2() {
@@ -75,5 +82,238 @@ bool CPUSupportsSSE2() {
 #endif
 }
 
+#ifdef AI_SIMD_USE_SSE2
+
+namespace {
+
+const bool s_useSSE2 = CPUSupportsSSE2();
+
+// The kernels work on four vectors at a time. They are loaded as three registers and
+// rearranged to one register per component, so each matrix element is applied to four
+// vectors at once. The operations are done in the order of the scalar operator *, the
+// results are the same.
+
+// ------------------------------------------------------------------------------------------------
+inline void LoadSoA(const aiVector3D* in, __m128& x, __m128& y, __m128& z) {
+    const float* f = &in->x;
+    const __m128 v0 = _mm_loadu_ps(f);      // x0 y0 z0 x1
+    const __m128 v1 = _mm_loadu_ps(f + 4);  // y1 z1 x2 y2
+    const __m128 v2 = _mm_loadu_ps(f + 8);  // z2 x3 y3 z3
+
+    x = _mm_shuffle_ps(v0, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)),
+        _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), v2, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void StoreSoA(aiVector3D* out, __m128 x, __m128 y, __m128 z) {
+    float* f = &out->x;
+    _mm_storeu_ps(f, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+        _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(f + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+        _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(f + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+        _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// r = m0 * x + m1 * y + m2 * z
+inline __m128 Dot3(__m128 x, __m128 y, __m128 z, float m0, float m1, float m2) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m0), x), _mm_mul_ps(_mm_set1_ps(m1), y)),
+        _mm_mul_ps(_mm_set1_ps(m2), z));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Same as aiVector3D::Normalize(): multiply by 1 / sqrt(x*x + y*y + z*z). If safe is set,
+// vectors of length zero are left as they are, as aiVector3D::NormalizeSafe() does.
+inline void Normalize(__m128& x, __m128& y, __m128& z, bool safe) {
+    const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+        _mm_mul_ps(z, z)));
+    const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.f), length);
+    if (safe) {
+        const __m128 mask = _mm_cmpgt_ps(length, _mm_setzero_ps());
+        x = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(x, invLength)), _mm_andnot_ps(mask, x));
+        y = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(y, invLength)), _mm_andnot_ps(mask, y));
+        z = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(z, invLength)), _mm_andnot_ps(mask, z));
+    } else {
+        x = _mm_mul_ps(x, invLength);
+        y = _mm_mul_ps(y, invLength);
+        z = _mm_mul_ps(z, invLength);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the number of vectors processed, the rest is left to the scalar code
+size_t TransformPositionsSSE2(const aiMatrix4x4& m, const aiVector3D* in, aiVector3D* out, size_t count) {
+    const size_t numBlocks = count / 4;
+    for (size_t i = 0; i < numBlocks * 4; i += 4) {
+        __m128 x, y, z;
+        LoadSoA(in + i, x, y, z);
+        const __m128 rx = _mm_add_ps(Dot3(x, y, z, m.a1, m.a2, m.a3), _mm_set1_ps(m.a4));
+        const __m128 ry = _mm_add_ps(Dot3(x, y, z, m.b1, m.b2, m.b3), _mm_set1_ps(m.b4));
+        const __m128 rz = _mm_add_ps(Dot3(x, y, z, m.c1, m.c2, m.c3), _mm_set1_ps(m.c4));
+        StoreSoA(out + i, rx, ry, rz);
+    }
+    return numBlocks * 4;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t TransformDirectionsSSE2(const aiMatrix3x3& m, const aiVector3D* in, aiVector3D* out, size_t count,
+        bool normalize) {
+    const size_t numBlocks = count / 4;
+    for (size_t i = 0; i < numBlocks * 4; i += 4) {
+        __m128 x, y, z;
+        LoadSoA(in + i, x, y, z);
+        __m128 rx = Dot3(x, y, z, m.a1, m.a2, m.a3);
+        __m128 ry = Dot3(x, y, z, m.b1, m.b2, m.b3);
+        __m128 rz = Dot3(x, y, z, m.c1, m.c2, m.c3);
+        if (normalize) {
+            Normalize(rx, ry, rz, false);
+        }
+        StoreSoA(out + i, rx, ry, rz);
+    }
+    return numBlocks * 4;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t NormalizeVectorsSSE2(const aiVector3D* in, aiVector3D* out, size_t count) {
+    const size_t numBlocks = count / 4;
+    for (size_t i = 0; i < numBlocks * 4; i += 4) {
+        __m128 x, y, z;
+        LoadSoA(in + i, x, y, z);
+        Normalize(x, y, z, true);
+        StoreSoA(out + i, x, y, z);
+    }
+    return numBlocks * 4;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ComputeTriangleNormalsSSE2(const aiVector3D* v0, const aiVector3D* v1, const aiVector3D* v2,
+        aiVector3D* out, size_t count) {
+    const size_t numBlocks = count / 4;
+    for (size_t i = 0; i < numBlocks * 4; i += 4) {
+        __m128 x0, y0, z0, x1, y1, z1, x2, y2, z2;
+        LoadSoA(v0 + i, x0, y0, z0);
+        LoadSoA(v1 + i, x1, y1, z1);
+        LoadSoA(v2 + i, x2, y2, z2);
+
+        // the edges and their cross product, as operator ^ computes it
+        x1 = _mm_sub_ps(x1, x0);
+        y1 = _mm_sub_ps(y1, y0);
+        z1 = _mm_sub_ps(z1, z0);
+        x2 = _mm_sub_ps(x2, x0);
+        y2 = _mm_sub_ps(y2, y0);
+        z2 = _mm_sub_ps(z2, z0);
+        __m128 nx = _mm_sub_ps(_mm_mul_ps(y1, z2), _mm_mul_ps(z1, y2));
+        __m128 ny = _mm_sub_ps(_mm_mul_ps(z1, x2), _mm_mul_ps(x1, z2));
+        __m128 nz = _mm_sub_ps(_mm_mul_ps(x1, y2), _mm_mul_ps(y1, x2));
+        Normalize(nx, ny, nz, true);
+        StoreSoA(out + i, nx, ny, nz);
+    }
+    return numBlocks * 4;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InterpolateLinearSSE2(const float* a, const float* b, const float* t, const float* span,
+        float* out, size_t count) {
+    const size_t numBlocks = count / 4;
+    for (size_t i = 0; i < numBlocks * 4; i += 4) {
+        const __m128 va = _mm_loadu_ps(a + i);
+        const __m128 vspan = _mm_loadu_ps(span + i);
+
+        // the factor is zero for empty spans, instead of the nan or inf of the division
+        const __m128 mask = _mm_cmpneq_ps(vspan, _mm_setzero_ps());
+        const __m128 factor = _mm_and_ps(mask, _mm_div_ps(_mm_loadu_ps(t + i), vspan));
+        _mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + i), va), factor)));
+    }
+    return numBlocks * 4;
+}
+
+} // namespace
+
+#endif // AI_SIMD_USE_SSE2
+
+// ------------------------------------------------------------------------------------------------
+void TransformPositions(const aiMatrix4x4& mat, const aiVector3D* in, aiVector3D* out, size_t count) {
+    size_t i = 0;
+#ifdef AI_SIMD_USE_SSE2
+    if (s_useSSE2) {
+        i = TransformPositionsSSE2(mat, in, out, count);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = mat * in[i];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformDirections(const aiMatrix3x3& mat, const aiVector3D* in, aiVector3D* out, size_t count,
+        bool normalize) {
+    size_t i = 0;
+#ifdef AI_SIMD_USE_SSE2
+    if (s_useSSE2) {
+        i = TransformDirectionsSSE2(mat, in, out, count, normalize);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = mat * in[i];
+        if (normalize) {
+            out[i].Normalize();
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void NormalizeVectors(const aiVector3D* in, aiVector3D* out, size_t count) {
+    size_t i = 0;
+#ifdef AI_SIMD_USE_SSE2
+    if (s_useSSE2) {
+        i = NormalizeVectorsSSE2(in, out, count);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = in[i];
+        out[i].NormalizeSafe();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ComputeTriangleNormals(const aiVector3D* v0, const aiVector3D* v1, const aiVector3D* v2,
+        aiVector3D* out, size_t count) {
+    size_t i = 0;
+#ifdef AI_SIMD_USE_SSE2
+    if (s_useSSE2) {
+        i = ComputeTriangleNormalsSSE2(v0, v1, v2, out, count);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = ((v1[i] - v0[i]) ^ (v2[i] - v0[i])).NormalizeSafe();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InterpolateLinear(const ai_real* a, const ai_real* b, const ai_real* t, const ai_real* span,
+        ai_real* out, size_t count) {
+    size_t i = 0;
+#ifdef AI_SIMD_USE_SSE2
+    if (s_useSSE2) {
+        i = InterpolateLinearSSE2(a, b, t, span, out, count);
+    }
+#endif
+    for (; i < count; ++i) {
+        const ai_real factor = span[i] != 0 ? t[i] / span[i] : ai_real(0.);
+        out[i] = a[i] + (b[i] - a[i]) * factor;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformNormals(const aiMatrix4x4& mat, const aiVector3D* in, aiVector3D* out, size_t count) {
+    aiMatrix4x4 mWorldIT = mat;
+    mWorldIT.Inverse().Transpose();
+
+    // TODO: implement Inverse() for aiMatrix3x3
+    TransformDirections(aiMatrix3x3(mWorldIT), in, out, count, true);
+}
 
 } // Namespace Assimp
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <assimp/defs.h>
+#include <assimp/types.h>
 
 namespace Assimp {
 
@@ -50,4 +51,57 @@ namespace Assimp {
 /// @return true, if SSE2 is supported. false if SSE2 is not supported.
 bool ASSIMP_API CPUSupportsSSE2();
 
+/// @brief  Transforms an array of positions: out[i] = mat * in[i], translation included.
+/// @param  mat     The transformation.
+/// @param  in      The positions to transform.
+/// @param  out     Receives the transformed positions, may be the same as in.
+/// @param  count   The number of positions.
+/// The results are identical to the ones of the scalar operator *.
+void ASSIMP_API TransformPositions(const aiMatrix4x4& mat, const aiVector3D* in, aiVector3D* out, size_t count);
+
+/// @brief  Transforms an array of directions: out[i] = mat * in[i].
+/// @param  mat         The transformation.
+/// @param  in          The directions to transform.
+/// @param  out         Receives the transformed directions, may be the same as in.
+/// @param  count       The number of directions.
+/// @param  normalize   Normalize the results, as aiVector3D::Normalize() does.
+void ASSIMP_API TransformDirections(const aiMatrix3x3& mat, const aiVector3D* in, aiVector3D* out, size_t count,
+    bool normalize = false);
+
+/// @brief  Transforms an array of normals, tangents or bitangents by the inverse transpose of the
+///         upper 3x3 part of a node transformation and normalizes them.
+/// @param  mat     The node transformation, as applied to the positions by TransformPositions().
+/// @param  in      The normals to transform.
+/// @param  out     Receives the transformed normals, may be the same as in.
+/// @param  count   The number of normals.
+void ASSIMP_API TransformNormals(const aiMatrix4x4& mat, const aiVector3D* in, aiVector3D* out, size_t count);
+
+/// @brief  Normalizes an array of vectors as aiVector3D::NormalizeSafe() does, vectors of
+///         length zero are copied as they are.
+/// @param  in      The vectors to normalize.
+/// @param  out     Receives the normalized vectors, may be the same as in.
+/// @param  count   The number of vectors.
+void ASSIMP_API NormalizeVectors(const aiVector3D* in, aiVector3D* out, size_t count);
+
+/// @brief  Computes the normals of an array of triangles:
+///         out[i] = ((v1[i] - v0[i]) ^ (v2[i] - v0[i])).NormalizeSafe()
+/// @param  v0      The first corner of each triangle.
+/// @param  v1      The second corner of each triangle.
+/// @param  v2      The third corner of each triangle.
+/// @param  out     Receives the normals.
+/// @param  count   The number of triangles.
+void ASSIMP_API ComputeTriangleNormals(const aiVector3D* v0, const aiVector3D* v1, const aiVector3D* v2,
+    aiVector3D* out, size_t count);
+
+/// @brief  Interpolates linearly between pairs of values:
+///         out[i] = a[i] + (b[i] - a[i]) * (span[i] != 0 ? t[i] / span[i] : 0)
+/// @param  a       The values at the start of each span.
+/// @param  b       The values at the end of each span.
+/// @param  t       The offsets into the spans.
+/// @param  span    The lengths of the spans, the value a[i] is taken for spans of length zero.
+/// @param  out     Receives the interpolated values, may be the same as a or b.
+/// @param  count   The number of values.
+void ASSIMP_API InterpolateLinear(const ai_real* a, const ai_real* b, const ai_real* t, const ai_real* span,
+    ai_real* out, size_t count);
+
 } // Namespace Assimp
@@ -355,6 +355,11 @@ void DoTheImportThing( const std::string& pFile)
 }
 @endcode
 
+If your IO system keeps the file contents in memory anyway, override IOStream::GetContiguousView() to return them.
+Readers which support it then parse the data in place instead of copying it first. Assimp::MMapIOSystem is an
+implementation of this for local files: it memory-maps every file opened for reading, which avoids reading huge
+binary files into the heap as a whole.
+
 
 @section custom_io_c Using custom IO logic with the plain-c function interface
 
@@ -1187,20 +1192,35 @@ This page discusses general performance issues related to assimp.
 
 @section perf_profile Profiling
 
-assimp has built-in support for <i>very</i> basic profiling and time measurement. To turn it on, set the <tt>GLOB_MEASURE_TIME</tt>
+assimp has built-in support for basic profiling and time measurement. To turn it on, set the <tt>GLOB_MEASURE_TIME</tt>
 configuration switch to <tt>true</tt> (nonzero). Results are dumped to the log file, so you need to setup
 an appropriate logger implementation with at least one output stream first (see the @link logging Logging Page @endlink
 for the details.).
 
+The same data is available programmatically: after ReadFile() returned, Assimp::Importer::GetProfilingReport() yields
+all timed regions (nested, per thread) and counters such as the number of bytes read from the IOSystem.
+Assimp::Profiling::ProfilingReport::ToChromeTrace() converts it to the Chrome trace event format, so it can be
+viewed in <tt>chrome://tracing</tt> or <tt>https://ui.perfetto.dev</tt>:
+
+@code
+Assimp::Importer importer;
+importer.SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, true);
+importer.ReadFile(file, aiProcessPreset_TargetRealtime_MaxQuality);
+
+const Assimp::Profiling::ProfilingReport* report = importer.GetProfilingReport();
+std::ofstream("import.json") << report->ToChromeTrace();
+@endcode
+
 Note that these measurements are based on a single run of the importer and each of the post processing steps, so
 a single result set is far away from being significant in a statistic sense. While precision can be improved
-by running the test multiple times, the low accuracy of the timings may render the results useless
-for smaller files.
+by running the test multiple times, the timings of smaller files are dominated by noise.
 
-A sample report looks like this (some unrelated log messages omitted, entries grouped for clarity):
+A sample log looks like this (some unrelated log messages omitted, entries grouped for clarity):
 
 @verbatim
-Debug, T5488: START `total`
+Debug, T5488: START `ReadFile`
+Debug, T5488: START `CanRead`
+Debug, T5488: END   `CanRead`, dt= 0.0002 s
 Info,  T5488: Found a matching importer for this file format
 
 
@@ -1209,63 +1229,77 @@ Info,  T5488: BlendModifier: Applied the `Subdivision` modifier to `OBMonkey`
 Debug, T5488: END   `import`, dt= 3.516 s
 
 
-Debug, T5488: START `preprocess`
-Debug, T5488: END   `preprocess`, dt= 0.001 s
+Debug, T5488: START `ScenePreprocessor`
+Debug, T5488: END   `ScenePreprocessor`, dt= 0.001 s
+Debug, T5488: START `ApplyPostProcessing`
 Info,  T5488: Entering post processing pipeline
 
 
-Debug, T5488: START `postprocess`
+Debug, T5488: START `RemoveRedundantMatsProcess`
 Debug, T5488: RemoveRedundantMatsProcess begin
 Debug, T5488: RemoveRedundantMatsProcess finished
-Debug, T5488: END   `postprocess`, dt= 0.001 s
+Debug, T5488: END   `RemoveRedundantMatsProcess`, dt= 0.001 s
 
 
-Debug, T5488: START `postprocess`
+Debug, T5488: START `TriangulateProcess`
 Debug, T5488: TriangulateProcess begin
 Info,  T5488: TriangulateProcess finished. All polygons have been triangulated.
-Debug, T5488: END   `postprocess`, dt= 3.415 s
+Debug, T5488: END   `TriangulateProcess`, dt= 3.415 s
 
 
-Debug, T5488: START `postprocess`
+Debug, T5488: START `SortByPTypeProcess`
 Debug, T5488: SortByPTypeProcess begin
 Info,  T5488: Points: 0, Lines: 0, Triangles: 1, Polygons: 0 (Meshes, X = removed)
 Debug, T5488: SortByPTypeProcess finished
+Debug, T5488: END   `SortByPTypeProcess`, dt= 0.018 s
 
-Debug, T5488: START `postprocess`
+Debug, T5488: START `JoinVerticesProcess`
 Debug, T5488: JoinVerticesProcess begin
 Debug, T5488: Mesh 0 (unnamed) | Verts in: 503808 out: 126345 | ~74.922
 Info,  T5488: JoinVerticesProcess finished | Verts in: 503808 out: 126345 | ~74.9
-Debug, T5488: END   `postprocess`, dt= 2.052 s
+Debug, T5488: END   `JoinVerticesProcess`, dt= 2.052 s
 
-Debug, T5488: START `postprocess`
+Debug, T5488: START `FlipWindingOrderProcess`
 Debug, T5488: FlipWindingOrderProcess begin
 Debug, T5488: FlipWindingOrderProcess finished
-Debug, T5488: END   `postprocess`, dt= 0.006 s
+Debug, T5488: END   `FlipWindingOrderProcess`, dt= 0.006 s
 
 
-Debug, T5488: START `postprocess`
+Debug, T5488: START `LimitBoneWeightsProcess`
 Debug, T5488: LimitBoneWeightsProcess begin
 Debug, T5488: LimitBoneWeightsProcess end
-Debug, T5488: END   `postprocess`, dt= 0.001 s
+Debug, T5488: END   `LimitBoneWeightsProcess`, dt= 0.001 s
 
 
-Debug, T5488: START `postprocess`
+Debug, T5488: START `ImproveCacheLocalityProcess`
 Debug, T5488: ImproveCacheLocalityProcess begin
 Debug, T5488: Mesh 0 | ACMR in: 0.851622 out: 0.718139 | ~15.7
 Info,  T5488: Cache relevant are 1 meshes (251904 faces). Average output ACMR is 0.718139
 Debug, T5488: ImproveCacheLocalityProcess finished.
-Debug, T5488: END   `postprocess`, dt= 1.903 s
+Debug, T5488: END   `ImproveCacheLocalityProcess`, dt= 1.903 s
 
 
 Info,  T5488: Leaving post processing pipeline
-Debug, T5488: END   `total`, dt= 11.269 s
+Debug, T5488: END   `ApplyPostProcessing`, dt= 7.398 s
+Debug, T5488: END   `ReadFile`, dt= 11.269 s
 @endverbatim
 
+Steps which are fused into a single pass over the meshes (see @link threading Threading@endlink) are reported as one region,
+i.e. <tt>ComputeSpatialSortProcess + GenVertexNormalsProcess + CalcTangentsProcess + JoinVerticesProcess</tt>.
+
 In this particular example only one fourth of the total import time was spent on the actual importing, while the rest of the
 time got consumed by the #aiProcess_Triangulate, #aiProcess_JoinIdenticalVertices and #aiProcess_ImproveCacheLocality
 postprocessing steps. A wise selection of postprocessing steps is therefore essential to getting good performance.
 Of course this depends on the individual requirements of your application, in many of the typical use cases of assimp performance won't
 matter (i.e. in an offline content pipeline).
+
+@section perf_bench Benchmarks
+
+The test suite contains a benchmark tool, <tt>assimp_bench</tt>, which is built along with the unit tests. It reports
+the import throughput (MB/s, vertices/s) for every model below <tt>test/models</tt> and the cost of each
+post-processing step on synthetic meshes of growing size (10K to 1M triangles by default, use <tt>--max-triangles</tt>
+for larger ones). <tt>--json</tt> writes the results to a file, so they can be compared between revisions.
+Run <tt>assimp_bench --help</tt> for the list of options.
 */
 
 /**
@@ -1298,7 +1332,22 @@ with 'slow' file formats like X or Collada might scale well with multiple concur
 
 @section automt Internal threading
 
-Internal multi-threading is not currently implemented.
+The post processing pipeline can use several threads. Steps which work on each mesh independently
+(#aiProcess_GenSmoothNormals, #aiProcess_CalcTangentSpace, #aiProcess_JoinIdenticalVertices,
+#aiProcess_Triangulate and #aiProcess_ImproveCacheLocality) distribute the meshes of the scene across
+a pool of worker threads. This is disabled by default - set #AI_CONFIG_GLOB_NUM_THREADS to enable it.
+Scenes with a single huge mesh won't benefit, scenes with many meshes will.
+
+Independent of the number of threads, consecutive per-mesh steps are fused into a single pass: each
+mesh runs through all of them back to back while its data is still in the cache. With
+#aiProcessPreset_TargetRealtime_MaxQuality, for example, #aiProcess_GenSmoothNormals,
+#aiProcess_CalcTangentSpace and #aiProcess_JoinIdenticalVertices share one pass. Steps which need
+to see the whole scene end such a pass. In extra verbose mode (Importer::SetExtraVerbose()) all
+steps are executed one by one.
+
+The worker threads may write to the log. #Assimp::DefaultLogger serializes these writes, but custom
+logger replacements must be thread-safe if multithreading is enabled. Importers themselves are still
+single-threaded.
 */
 
 /**
@@ -1526,6 +1575,10 @@ See the next section for a list of utilities to simplify this task.
 <li>
 Don't trust the input data! Check all offsets!
 </li>
+<li>
+Don't copy the whole file into a buffer of your own if the IOStream offers IOStream::GetContiguousView(). #StreamReader
+does this automatically, the data behind StreamReader::GetPtr() must therefore never be modified.
+</li>
 </ul>
 
 @section util Utilities
@@ -61,6 +61,7 @@ class IOSystem;
 class BaseProcess;
 class SharedPostProcessInfo;
 class IOStream;
+class ThreadPool;
 
 // utility to do char4 to uint32 in a portable manner
 #define AI_MAKE_MAGIC(string) ((uint32_t)((string[0] << 24) + \
@@ -352,6 +353,9 @@ protected:
     std::string m_ErrorText;
     /// Currently set progress handler.
     ProgressHandler* m_progress;
+    /// Worker threads of the hosting #Importer, NULL if the import
+    /// is to run on the calling thread only.
+    ThreadPool* m_threadPool;
 };
 
 
@@ -170,6 +170,15 @@ public:
         // ignore
     }
 
+    // -------------------------------------------------------------------
+    /** Returns everything written to the blob so far. The view is
+     *  invalidated by the next Write() or Seek() past the end. */
+    virtual const uint8_t* GetContiguousView(size_t& len)
+    {
+        len = buffer ? file_size : 0;
+        return buffer;
+    }
+
 
 
 private:
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_IOSTREAM_H_INC
 
 #include "types.h"
+#include <stdint.h>
 
 #ifndef __cplusplus
 #   error This header requires C++ to be used. aiFileIO.h is the \
@@ -122,6 +123,20 @@ public:
      *  See fflush() for more details.
      */
     virtual void Flush() = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Direct access to the contents of the stream, if they are
+     *  available in memory anyway (i.e. for memory-mapped files).
+     *
+     *  Readers use it to parse the data in place instead of copying it
+     *  into a buffer of their own. The view always starts at offset 0
+     *  and covers the whole stream, the read/write cursor is neither
+     *  used nor changed. The data must not be modified.
+     *  @param len Receives the length of the view in bytes.
+     *  @return Pointer to the contents, valid until the stream is
+     *    closed. The default implementation returns NULL, readers must
+     *    fall back to Read() then. */
+    virtual const uint8_t* GetContiguousView(size_t& len);
 }; //! class IOStream
 
 // ----------------------------------------------------------------------------------
@@ -135,6 +150,13 @@ inline
 IOStream::~IOStream() {
     // empty
 }
+
+// ----------------------------------------------------------------------------------
+inline
+const uint8_t* IOStream::GetContiguousView(size_t& len) {
+    len = 0;
+    return NULL;
+}
 // ----------------------------------------------------------------------------------
 
 } //!namespace Assimp
@@ -48,12 +48,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 
 #include <vector>
+#include <algorithm>
 
 namespace Assimp {
 
 // ---------------------------------------------------------------------------
 /**
  *  Implementation of a cached stream buffer.
+ *
+ *  If the stream provides a contiguous view of its contents (see
+ *  IOStream::GetContiguousView()) the blocks are served directly from
+ *  that view instead of being copied into the cache.
  */
 template<class T>
 class IOStreamBuffer {
@@ -113,12 +118,18 @@ public:
     bool getNextBlock( std::vector<T> &buffer );
 
 private:
+    /// @brief  Returns the element at the given position in the current block,
+    ///         positions past the end of the block read as line end.
+    T peek( size_t pos ) const;
+
     IOStream *m_stream;
     size_t m_filesize;
     size_t m_cacheSize;
     size_t m_numBlocks;
     size_t m_blockIdx;
     std::vector<T> m_cache;
+    const T *m_view;
+    const T *m_block;
     size_t m_cachePos;
     size_t m_filePos;
 };
@@ -131,10 +142,11 @@ IOStreamBuffer<T>::IOStreamBuffer( size_t cache )
 , m_cacheSize( cache )
 , m_numBlocks( 0 )
 , m_blockIdx( 0 )
+, m_view( nullptr )
+, m_block( nullptr )
 , m_cachePos( 0 )
 , m_filePos( 0 ) {
-    m_cache.resize( cache );
-    std::fill( m_cache.begin(), m_cache.end(), '\n' );
+    // empty
 }
 
 template<class T>
@@ -170,6 +182,15 @@ bool IOStreamBuffer<T>::open( IOStream *stream ) {
         m_numBlocks++;
     }
 
+    // no need for a cache if we can access the data directly
+    size_t viewSize( 0 );
+    const uint8_t *view = m_stream->GetContiguousView( viewSize );
+    if ( nullptr != view && viewSize == m_filesize ) {
+        m_view = reinterpret_cast<const T*>( view );
+    } else if ( m_cache.size() < m_cacheSize ) {
+        m_cache.resize( m_cacheSize, '\n' );
+    }
+
     return true;
 }
 
@@ -182,6 +203,8 @@ bool IOStreamBuffer<T>::close() {
 
     // init counters and state vars
     m_stream    = nullptr;
+    m_view      = nullptr;
+    m_block     = nullptr;
     m_filesize  = 0;
     m_numBlocks = 0;
     m_blockIdx  = 0;
@@ -206,8 +229,18 @@ size_t IOStreamBuffer<T>::cacheSize() const {
 template<class T>
 inline
 bool IOStreamBuffer<T>::readNextBlock() {
-    m_stream->Seek( m_filePos, aiOrigin_SET );
-    size_t readLen = m_stream->Read( &m_cache[ 0 ], sizeof( T ), m_cacheSize );
+    size_t readLen( 0 );
+    if ( nullptr != m_view ) {
+        // just move the window over the view
+        if ( m_filePos < m_filesize ) {
+            readLen = std::min( m_cacheSize, m_filesize - m_filePos );
+        }
+        m_block = m_view + m_filePos;
+    } else {
+        m_stream->Seek( m_filePos, aiOrigin_SET );
+        readLen = m_stream->Read( &m_cache[ 0 ], sizeof( T ), m_cacheSize );
+        m_block = &m_cache[ 0 ];
+    }
     if ( readLen == 0 ) {
         return false;
     }
@@ -239,10 +272,17 @@ size_t IOStreamBuffer<T>::getFilePos() const {
     return m_filePos;
 }
 
+template<class T>
+inline
+T IOStreamBuffer<T>::peek( size_t pos ) const {
+    return pos < m_cacheSize ? m_block[ pos ] : T( '\n' );
+}
+
 template<class T>
 inline
 bool IOStreamBuffer<T>::getNextDataLine( std::vector<T> &buffer, T continuationToken ) {
-    buffer.resize( m_cacheSize );
+    // one more for the line end, which is appended to an unterminated last line
+    buffer.resize( m_cacheSize + 1 );
     if ( m_cachePos == m_cacheSize || 0 == m_filePos ) {
         if ( !readNextBlock() ) {
             return false;
@@ -252,17 +292,17 @@ bool IOStreamBuffer<T>::getNextDataLine( std::vector<T> &buffer, T continuationT
     bool continuationFound( false );
     size_t i = 0;
     for( ;; ) {
-        if ( continuationToken == m_cache[ m_cachePos ] ) {
+        if ( continuationToken == peek( m_cachePos ) ) {
             continuationFound = true;
             ++m_cachePos;
         }
-        if ( IsLineEnd( m_cache[ m_cachePos ] ) ) {
+        if ( IsLineEnd( peek( m_cachePos ) ) ) {
             if ( !continuationFound ) {
                 // the end of the data line
                 break;
             } else {
                 // skip line end
-                while ( m_cache[m_cachePos] != '\n') {
+                while ( peek( m_cachePos ) != '\n') {
                     ++m_cachePos;
                 }
                 ++m_cachePos;
@@ -270,12 +310,14 @@ bool IOStreamBuffer<T>::getNextDataLine( std::vector<T> &buffer, T continuationT
             }
         }
 
-        buffer[ i ] = m_cache[ m_cachePos ];
+        buffer[ i ] = peek( m_cachePos );
         ++m_cachePos;
         ++i;
         if ( m_cachePos >= m_cacheSize ) {
             if ( !readNextBlock() ) {
-                return false;
+                // the last line of the file lacks its line end
+                buffer[ i ] = '\n';
+                return true;
             }
         }
     }
@@ -301,9 +343,9 @@ bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
        }
       }
 
-    if (IsLineEnd(m_cache[m_cachePos])) {
+    if (IsLineEnd(peek( m_cachePos ))) {
         // skip line end
-        while (m_cache[m_cachePos] != '\n') {
+        while (peek( m_cachePos ) != '\n') {
             ++m_cachePos;
         }
         ++m_cachePos;
@@ -315,8 +357,8 @@ bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
     }
 
     size_t i( 0 );
-    while (!IsLineEnd(m_cache[ m_cachePos ])) {
-        buffer[i] = m_cache[ m_cachePos ];
+    while (!IsLineEnd(peek( m_cachePos ))) {
+        buffer[i] = peek( m_cachePos );
         ++m_cachePos;
         ++i;
         if (m_cachePos >= m_cacheSize) {
@@ -336,14 +378,14 @@ inline
 bool IOStreamBuffer<T>::getNextBlock( std::vector<T> &buffer) {
     // Return the last block-value if getNextLine was used before
     if ( 0 != m_cachePos ) {      
-        buffer = std::vector<T>( m_cache.begin() + m_cachePos, m_cache.end() );
+        buffer = std::vector<T>( m_block + m_cachePos, m_block + m_cacheSize );
         m_cachePos = 0;
     } else {
         if ( !readNextBlock() ) {
             return false;
         }
 
-        buffer = std::vector<T>(m_cache.begin(), m_cache.end());
+        buffer = std::vector<T>( m_block, m_block + m_cacheSize );
     }
 
     return true;
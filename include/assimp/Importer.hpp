@@ -74,6 +74,12 @@ namespace Assimp    {
     class SharedPostProcessInfo;
     class BatchLoader;
 
+    // =======================================================================
+    // Profiler.h
+    namespace Profiling {
+        class ProfilingReport;
+    }
+
     // =======================================================================
     // Holy stuff, only for members of the high council of the Jedi.
     class ImporterPimpl;
@@ -520,6 +526,19 @@ public:
      *   It will work as well for static linkage with Assimp.*/
     aiScene* GetOrphanedScene();
 
+    // -------------------------------------------------------------------
+    /** Returns the timings recorded during the last call to ReadFile()
+     *  and the post-processing applied afterwards.
+     *
+     * Recording is enabled by setting #AI_CONFIG_GLOB_MEASURE_TIME. The
+     * report lists the import phases (format detection, import, validation,
+     * preprocessing and each post-processing step) with the regions of the
+     * worker threads nested below them, and counters such as the number of
+     * bytes read. Include <assimp/Profiler.h> to access it.
+     * @return The report or NULL if nothing was recorded. It remains valid
+     *   until the next call to ReadFile() or GetProfilingReport(). */
+    const Profiling::ProfilingReport* GetProfilingReport() const;
+
     // -------------------------------------------------------------------
     /** Returns whether a given file extension is supported by ASSIMP.
      *
@@ -0,0 +1,127 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file MMapIOStream.h
+ *  @brief Read-only file I/O using memory-mapped files
+ */
+#ifndef AI_MMAPIOSTREAM_H_INC
+#define AI_MMAPIOSTREAM_H_INC
+
+#include <assimp/IOStream.hpp>
+
+namespace Assimp    {
+
+// ----------------------------------------------------------------------------------
+//! @class  MMapIOStream
+//! @brief  Read-only IO implementation on top of a memory-mapped file.
+//!
+//! The file contents are exposed via GetContiguousView(), so readers can
+//! parse them in place instead of copying the whole file into a buffer
+//! of their own. Pages are loaded lazily by the OS and can be dropped
+//! again under memory pressure, which keeps the peak memory usage of
+//! large imports down. Use MMapIOSystem to create instances.
+class ASSIMP_API MMapIOStream : public IOStream
+{
+    friend class MMapIOSystem;
+
+protected:
+    MMapIOStream(const uint8_t* data, size_t size) AI_NO_EXCEPT;
+
+public:
+    /** Destructor public to allow simple deletion to close the file. */
+    ~MMapIOStream ();
+
+    // -------------------------------------------------------------------
+    /** Maps the given file into memory.
+     *  @return NULL if the file does not exist, is empty or the
+     *    platform can't map it. */
+    static MMapIOStream* Map(const char* pFile);
+
+    // -------------------------------------------------------------------
+    /// Read from stream
+    size_t Read(void* pvBuffer,
+        size_t pSize,
+        size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Write to stream, always fails
+    size_t Write(const void* pvBuffer,
+        size_t pSize,
+        size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Seek specific position
+    aiReturn Seek(size_t pOffset,
+        aiOrigin pOrigin);
+
+    // -------------------------------------------------------------------
+    /// Get current seek position
+    size_t Tell() const;
+
+    // -------------------------------------------------------------------
+    /// Get size of file
+    size_t FileSize() const;
+
+    // -------------------------------------------------------------------
+    /// Flush file contents, does nothing
+    void Flush();
+
+    // -------------------------------------------------------------------
+    /// Get the mapped file contents
+    const uint8_t* GetContiguousView(size_t& len);
+
+private:
+    MMapIOStream(const MMapIOStream&);
+    MMapIOStream& operator = (const MMapIOStream&);
+
+    //  Start of the mapping
+    const uint8_t* mData;
+    //  Size of the file
+    size_t mSize;
+    //  Current read position
+    size_t mPos;
+};
+
+} // ns assimp
+
+#endif //!!AI_MMAPIOSTREAM_H_INC
@@ -0,0 +1,80 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file MMapIOSystem.h
+ *  @brief IOSystem which maps the files to read into memory
+ */
+#ifndef AI_MMAPIOSYSTEM_H_INC
+#define AI_MMAPIOSYSTEM_H_INC
+
+#include <assimp/DefaultIOSystem.h>
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** IOSystem which memory-maps files opened for reading and returns
+ *  MMapIOStream instances for them. Readers which support
+ *  IOStream::GetContiguousView() then work on the mapped data directly,
+ *  without copying the whole file to the heap first.
+ *
+ *  Files opened for writing, empty files and files which can't be mapped
+ *  are handled exactly like DefaultIOSystem does. Use it by passing an
+ *  instance to Importer::SetIOHandler().
+ *
+ *  @note The files must not be truncated by other processes while they
+ *    are mapped, reading the missing pages would fault.
+ */
+class ASSIMP_API MMapIOSystem : public DefaultIOSystem {
+public:
+    // -------------------------------------------------------------------
+    /** Open a new file with a given path. */
+    IOStream* Open( const char* pFile, const char* pMode = "rb");
+
+    // -------------------------------------------------------------------
+    /** Closes the given file and releases all resources associated with it. */
+    void Close( IOStream* pFile);
+};
+
+} //!ns Assimp
+
+#endif //AI_MMAPIOSYSTEM_H_INC
@@ -139,6 +139,13 @@ public:
         ai_assert(false); // won't be needed
     }
 
+    // -------------------------------------------------------------------
+    // The stream is backed by a single memory block, hand it out directly
+    const uint8_t* GetContiguousView(size_t& len) {
+        len = length;
+        return buffer;
+    }
+
 private:
     const uint8_t* buffer;
     size_t length,pos;
@@ -40,60 +40,134 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ----------------------------------------------------------------------
 */
 
+
 /** @file Profiler.h
  *  @brief Utility to measure the respective runtime of each import step
  */
 #ifndef INCLUDED_PROFILER_H
 #define INCLUDED_PROFILER_H
 
-#include <chrono>
-#include <assimp/DefaultLogger.hpp>
-#include "TinyFormatter.h"
+#include <assimp/defs.h>
 
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace Assimp {
 namespace Profiling {
 
-using namespace Formatter;
+// ------------------------------------------------------------------------------------------------
+/** A single timed region, as recorded by the Profiler.
+ *  Times are given in seconds, relative to the construction of the profiler.
+ */
+struct ProfileRegion {
+    /** Name passed to Profiler::BeginRegion() */
+    std::string name;
+
+    /** Index of the recording thread, in order of first use */
+    unsigned int thread;
+
+    /** Nesting depth on the recording thread, 0 for top-level regions */
+    unsigned int depth;
+
+    /** Start of the region */
+    double start;
+
+    /** Duration of the region */
+    double duration;
+};
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** All data recorded by a Profiler: the finished regions of all threads,
+ *  sorted by thread and start time, and the accumulated counters.
  */
-class Profiler {
+class ASSIMP_API ProfilingReport {
 public:
-    Profiler() {
-        // empty
-    }
+    std::vector<ProfileRegion> regions;
+    std::map<std::string, uint64_t> counters;
+
+    /** Returns the summed duration of all regions of the given name,
+     *  in seconds. */
+    double GetTotalTime(const std::string& name) const;
+
+    /** Returns the value of a counter, 0 if it was never set. */
+    uint64_t GetCounter(const std::string& name) const;
 
+    /** Serializes the report in the Chrome trace event format. The result
+     *  can be loaded in chrome://tracing or https://ui.perfetto.dev. */
+    std::string ToChromeTrace() const;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Hierarchical profiler based on std::chrono::steady_clock. Regions nest, each thread records
+ *  into its own buffer, so several threads may record at the same time. Timings of finished
+ *  regions are also dumped to the log file.
+ */
+class ASSIMP_API Profiler {
 public:
+    Profiler();
+    ~Profiler();
 
     /** Start a named timer */
-    void BeginRegion(const std::string& region) {
-        regions[region] = std::chrono::system_clock::now();
-        ASSIMP_LOG_DEBUG((format("START `"),region,"`"));
-    }
-
+    void BeginRegion(const std::string& region);
 
     /** End a specific named timer and write its end time to the log */
-    void EndRegion(const std::string& region) {
-        RegionMap::const_iterator it = regions.find(region);
-        if (it == regions.end()) {
-            return;
+    void EndRegion(const std::string& region);
+
+    /** Add a value to a named counter (i.e. bytes read) */
+    void AddCounter(const std::string& name, uint64_t value);
+
+    /** Collect all regions finished so far. Must not be called while
+     *  other threads are recording. */
+    void GetReport(ProfilingReport& report) const;
+
+private:
+    Profiler(const Profiler&);
+    Profiler& operator = (const Profiler&);
+
+    struct ThreadBuffer;
+    ThreadBuffer* GetThreadBuffer();
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point mStart;
+    const uint64_t mSerial;
+
+    mutable std::mutex mMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> mThreads;
+    std::map<std::string, uint64_t> mCounters;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Helper to time a scope. Does nothing if no profiler is given. */
+class ScopedRegion {
+public:
+    ScopedRegion(Profiler* profiler, const std::string& region)
+    : mProfiler(profiler)
+    , mRegion(profiler ? region : std::string()) {
+        if (mProfiler) {
+            mProfiler->BeginRegion(mRegion);
         }
+    }
 
-        std::chrono::duration<double> elapsedSeconds = std::chrono::system_clock::now() - regions[region];
-        ASSIMP_LOG_DEBUG((format("END   `"),region,"`, dt= ", elapsedSeconds.count()," s"));
+    ~ScopedRegion() {
+        if (mProfiler) {
+            mProfiler->EndRegion(mRegion);
+        }
     }
 
 private:
-    typedef std::map<std::string,std::chrono::time_point<std::chrono::system_clock>> RegionMap;
-    RegionMap regions;
+    ScopedRegion(const ScopedRegion&);
+    ScopedRegion& operator = (const ScopedRegion&);
+
+    Profiler* mProfiler;
+    const std::string mRegion;
 };
 
 }
 }
 
 #endif
-
@@ -46,21 +46,37 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <vector>
 #include <assimp/types.h>
+#include <assimp/config.h>
 
 namespace Assimp {
 
+class ThreadPool;
+
 // ------------------------------------------------------------------------------------------------
 /** A little helper class to quickly find all vertices in the epsilon environment of a given
  * position. Construct an instance with an array of positions. The class stores the given positions
  * by their indices and sorts them by their distance to an arbitrary chosen plane.
  * You can then query the instance for all vertices close to a given position in an average O(log n)
  * time, with O(n) worst case complexity when all vertices lay on the plane. The plane is chosen
- * so that it avoids common planes in usual data sets. */
+ * so that it avoids common planes in usual data sets.
+ *
+ * Alternatively the positions can be bucketed into a uniform grid (see #SetMethod()), which
+ * answers queries in O(1) on average regardless of how the vertices are laid out. */
 // ------------------------------------------------------------------------------------------------
 class ASSIMP_API SpatialSort
 {
 public:
 
+    /** The ways to index the positions */
+    enum Method {
+        /** Sort by distance to a reference plane. This is the default. */
+        Method_PlaneSort = AI_SPATIAL_SORT_PLANE,
+
+        /** Hash the positions into the cells of a uniform grid. The cell size is
+         *  derived from the bounding box and the number of positions. */
+        Method_HashGrid = AI_SPATIAL_SORT_GRID
+    };
+
     SpatialSort();
 
     // ------------------------------------------------------------------------------------
@@ -79,6 +95,17 @@ public:
 
 public:
 
+    // ------------------------------------------------------------------------------------
+    /** Selects how the positions are indexed. Takes effect with the next call to
+     *  #Finalize(), i.e. it should be set before the data is filled in.
+     *  The results of the queries don't depend on the method, only their order does.*/
+    void SetMethod( Method pMethod);
+
+    /** Returns the method selected by #SetMethod(). */
+    Method GetMethod() const {
+        return mMethod;
+    }
+
     // ------------------------------------------------------------------------------------
     /** Sets the input data for the SpatialSort. This replaces existing data, if any.
      *  The new data receives new indices in ascending order.
@@ -111,6 +138,12 @@ public:
      *  can be called to query the spatial sort.*/
     void Finalize();
 
+    // ------------------------------------------------------------------------------------
+    /** Same as #Finalize(), but sorts in parallel on the threads of the given pool.
+     *  The result is identical to the one of #Finalize().
+     * @param pPool Worker pool, may be NULL. */
+    void Finalize( ThreadPool* pPool);
+
     // ------------------------------------------------------------------------------------
     /** Returns an iterator for all positions close to the given position.
      * @param pPosition The position to look for vertices.
@@ -142,31 +175,83 @@ public:
     unsigned int GenerateMappingTable(std::vector<unsigned int>& fill,
         ai_real pRadius) const;
 
+    // ------------------------------------------------------------------------------------
+    /** Runs #FindPositions() for all positions in the spatial sort at once, in parallel on
+     *  the threads of the given pool. The results are stored as a compressed table: the
+     *  positions close to position i are poResults[poOffsets[i]] to
+     *  poResults[poOffsets[i+1]-1], in the order #FindPositions() returns them.
+     * @param pRadius Maximal distance from the position a vertex may have to be counted in.
+     * @param poOffsets Receives numPositions+1 offsets into poResults.
+     * @param poResults Receives the indices of the found positions.
+     * @param pPool Worker pool, may be NULL. */
+    void FindAllPositions( ai_real pRadius, std::vector<unsigned int>& poOffsets,
+        std::vector<unsigned int>& poResults, ThreadPool* pPool = NULL) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Same as #FindAllPositions() for #FindIdenticalPositions(). */
+    void FindAllIdenticalPositions( std::vector<unsigned int>& poOffsets,
+        std::vector<unsigned int>& poResults, ThreadPool* pPool = NULL) const;
+
 protected:
+    /** Builds the grid of #Method_HashGrid from the entries in mPositions. */
+    void FinalizeGrid();
+
+    /** Grid cell containing the given position */
+    void GetCell( const aiVector3D& pPosition, int pCell[3]) const;
+
+    /** Calls pFunc for all entries in the grid cells which overlap the given box. */
+    template <typename Func>
+    void ForEachInBox( const aiVector3D& pMin, const aiVector3D& pMax, Func pFunc) const;
+
+    /** Runs pQuery(position, results) for all positions and stores the results
+     *  as described at #FindAllPositions(). */
+    template <typename Query>
+    void FindForAll( Query pQuery, std::vector<unsigned int>& poOffsets,
+        std::vector<unsigned int>& poResults, ThreadPool* pPool) const;
+
+    /** How the positions are indexed */
+    Method mMethod;
+
     /** Normal of the sorting plane, normalized. The center is always at (0, 0, 0) */
     aiVector3D mPlaneNormal;
 
-    /** An entry in a spatially sorted position array. Consists of a vertex index,
-     * its position and its pre-calculated distance from the reference plane */
+    /** An entry in a spatially sorted position array. Consists of a vertex index
+     * and its pre-calculated distance from the reference plane. The position itself
+     * is kept in mPositionData, so sorting moves as little data as possible. */
     struct Entry {
         unsigned int mIndex; ///< The vertex referred by this entry
-        aiVector3D mPosition; ///< Position
         ai_real mDistance; ///< Distance of this vertex to the sorting plane
-
         Entry() AI_NO_EXCEPT
-        : mIndex( 999999999 ), mPosition(), mDistance( 99999. ) {
-            // empty        
+        : mIndex( 999999999 ), mDistance( 99999. ) {
+            // empty
         }
-        Entry( unsigned int pIndex, const aiVector3D& pPosition, ai_real pDistance)
-        : mIndex( pIndex), mPosition( pPosition), mDistance( pDistance) {
+        Entry( unsigned int pIndex, ai_real pDistance)
+        : mIndex( pIndex), mDistance( pDistance) {
             // empty
         }
-
-        bool operator < (const Entry& e) const { return mDistance < e.mDistance; }
+        // ties are broken by index, so parallel and serial sorting agree
+        bool operator < (const Entry& e) const {
+            return mDistance < e.mDistance || (mDistance == e.mDistance && mIndex < e.mIndex);
+        }
     };
 
-    // all positions, sorted by distance to the sorting plane
+    // all positions, sorted by distance to the sorting plane. For #Method_HashGrid
+    // they are sorted by grid bucket instead.
     std::vector<Entry> mPositions;
+
+    /** Copy of all positions in the order they were added, indexed by Entry::mIndex */
+    std::vector<aiVector3D> mPositionData;
+
+    /** #Method_HashGrid: bounding box of the positions, the grid starts at its minimum.
+     *  Also the edge length and inverse edge length of the grid cells. */
+    aiVector3D mGridOrigin;
+    aiVector3D mGridMax;
+    ai_real mCellSize;
+    ai_real mInvCellSize;
+
+    /** #Method_HashGrid: cells are hashed into a power-of-two number of buckets. The entries
+     *  of bucket b are mPositions[mBucketStart[b]] to mPositions[mBucketStart[b+1]-1]. */
+    std::vector<unsigned int> mBucketStart;
 };
 
 } // end of namespace Assimp
@@ -88,6 +88,7 @@ public:
      *    template parameter and this parameter is meaningless.  */
     StreamReader(std::shared_ptr<IOStream> stream, bool le = false)
         : stream(stream)
+        , ownsBuffer(false)
         , le(le)
     {
         ai_assert(stream);
@@ -97,6 +98,7 @@ public:
     // ---------------------------------------------------------------------
     StreamReader(IOStream* stream, bool le = false)
         : stream(std::shared_ptr<IOStream>(stream))
+        , ownsBuffer(false)
         , le(le)
     {
         ai_assert(stream);
@@ -105,7 +107,9 @@ public:
 
     // ---------------------------------------------------------------------
     ~StreamReader() {
-        delete[] buffer;
+        if (ownsBuffer) {
+            delete[] buffer;
+        }
     }
 
     // deprecated, use overloaded operator>> instead
@@ -195,7 +199,8 @@ public:
     }
 
     // ---------------------------------------------------------------------
-    /** Get the current file pointer */
+    /** Get the current file pointer. The data must not be modified,
+     *  it may be the memory of the stream itself. */
     int8_t* GetPtr() const  {
         return current;
     }
@@ -305,12 +310,26 @@ private:
             throw DeadlyImportError("StreamReader: Unable to open file");
         }
 
-        const size_t s = stream->FileSize() - stream->Tell();
+        const size_t pos = stream->Tell();
+        const size_t s = stream->FileSize() - pos;
         if (!s) {
             throw DeadlyImportError("StreamReader: File is empty or EOF is already reached");
         }
 
+        // Read directly from the stream's memory if it offers it. The reader
+        // holds a reference to the stream, so the view outlives the reader.
+        // The data is never written through, despite the non-const pointers.
+        size_t viewSize = 0;
+        const uint8_t* view = stream->GetContiguousView(viewSize);
+        if (view && viewSize == pos + s) {
+            current = buffer = const_cast<int8_t*>(reinterpret_cast<const int8_t*>(view + pos));
+            end = limit = &buffer[s];
+            stream->Seek(0, aiOrigin_END);
+            return;
+        }
+
         current = buffer = new int8_t[s];
+        ownsBuffer = true;
         const size_t read = stream->Read(current,1,s);
         // (read < s) can only happen if the stream was opened in text mode, in which case FileSize() is not reliable
         ai_assert(read <= s);
@@ -320,6 +339,7 @@ private:
 private:
     std::shared_ptr<IOStream> stream;
     int8_t *buffer, *current, *end, *limit;
+    bool ownsBuffer;
     bool le;
 };
 
@@ -106,6 +106,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * LIMITBONEWEIGHTS
  * VALIDATEDS
  * IMPROVECACHELOCALITY
+ * GENERATELODS
+ * GENERATEMESHLETS
+ * QUANTIZEVERTICES
  * FIXINFACINGNORMALS
  * REMOVE_REDUNDANTMATERIALS
  * OPTIMIZEGRAPH
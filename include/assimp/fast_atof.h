@@ -368,6 +368,38 @@ ai_real fast_atof( const char** inout) {
     return ret;
 }
 
+// ------------------------------------------------------------------------------------
+//! Bulk variant of fast_atoreal_move for long runs of numbers, e.g. the contents of a
+//! Collada <float_array> or the properties of a PLY vertex line.
+//!
+//! Parses up to \p count whitespace-separated reals from [in,end) into \p out. Leading
+//! and trailing blanks and line ends are skipped; parsing stops early at the end of
+//! the range or at a '\0'. The range does not need to be terminated, nothing beyond
+//! \p end is read. Digits are scanned with SSE2 where available.
+//!
+//! By default the results are bit-identical to those of fast_atoreal_move. If
+//! \p exact is true, every number is correctly rounded to the nearest Real instead,
+//! at the price of falling back to strtod for numbers with many significant digits.
+//!
+//! A token which is not a number throws std::invalid_argument, as fast_atoreal_move.
+//! @param parsed Receives the number of values written to \p out. Optional.
+//! @return Pointer to the first character after the last parsed number and the blanks
+//!   following it.
+// ------------------------------------------------------------------------------------
+ASSIMP_API const char* fast_atoreal_array(const char* in, const char* end, float* out,
+    size_t count, size_t* parsed = NULL, bool exact = false);
+
+ASSIMP_API const char* fast_atoreal_array(const char* in, const char* end, double* out,
+    size_t count, size_t* parsed = NULL, bool exact = false);
+
+// ------------------------------------------------------------------------------------
+//! Bulk variant of strtol10 with the same conventions as fast_atoreal_array().
+//! A token which is not an integer stops the parsing; the returned pointer then
+//! points to it.
+// ------------------------------------------------------------------------------------
+ASSIMP_API const char* strtol10_array(const char* in, const char* end, int* out,
+    size_t count, size_t* parsed = NULL);
+
 } //! namespace Assimp
 
 #endif // FAST_A_TO_F_H_INCLUDED
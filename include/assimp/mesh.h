@@ -545,6 +545,242 @@ enum aiMorphingMethod
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief A meshlet is a small cluster of triangles of a mesh.
+ *
+ *  Meshlets are generated by the GenerateMeshlets step, see
+ *  #AI_CONFIG_PP_ML_ENABLE. A meshlet
+ *  refers to a range of aiMeshletData::mVertices and a range of
+ *  aiMeshletData::mTriangles. Its bounds can be used for per-cluster
+ *  frustum and backface culling.
+ */
+struct aiMeshlet {
+    //! Index of the first entry in aiMeshletData::mVertices
+    unsigned int mVertexOffset;
+
+    //! Index of the first triangle in aiMeshletData::mTriangles
+    unsigned int mTriangleOffset;
+
+    //! Number of vertices and triangles of the meshlet
+    unsigned int mNumVertices;
+    unsigned int mNumTriangles;
+
+    //! Bounding sphere of the meshlet
+    C_STRUCT aiVector3D mCenter;
+    ai_real mRadius;
+
+    //! Normal cone of the meshlet. The meshlet is backfacing for a viewer
+    //! at position p if dot(normalize(mConeApex - p), mConeAxis) >= mConeCutoff.
+    //! mConeCutoff is 1 if the meshlet can't be culled this way.
+    C_STRUCT aiVector3D mConeApex;
+    C_STRUCT aiVector3D mConeAxis;
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+    aiMeshlet() AI_NO_EXCEPT
+    : mVertexOffset( 0 )
+    , mTriangleOffset( 0 )
+    , mNumVertices( 0 )
+    , mNumTriangles( 0 )
+    , mCenter()
+    , mRadius( 0 )
+    , mConeApex()
+    , mConeAxis()
+    , mConeCutoff( 1 ) {
+        // empty
+    }
+#endif // __cplusplus
+};
+
+// ---------------------------------------------------------------------------
+/** @brief The meshlet partitioning of a mesh.
+ *
+ *  Each meshlet references up to mMaxVertices entries of mVertices, which
+ *  are indices into the vertex streams of the mesh. Its triangles are
+ *  stored as three local indices each into this vertex range, so a meshlet
+ *  never has more than 256 vertices.
+ */
+struct aiMeshletData {
+    //! The limits the meshlets were built with
+    unsigned int mMaxVertices;
+    unsigned int mMaxTriangles;
+
+    //! The meshlets
+    unsigned int mNumMeshlets;
+    C_STRUCT aiMeshlet* mMeshlets;
+
+    //! Mesh vertex indices referenced by the meshlets
+    unsigned int mNumVertices;
+    unsigned int* mVertices;
+
+    //! Number of triangles. mTriangles holds 3*mNumTriangles local indices.
+    unsigned int mNumTriangles;
+    unsigned char* mTriangles;
+
+#ifdef __cplusplus
+    aiMeshletData() AI_NO_EXCEPT
+    : mMaxVertices( 0 )
+    , mMaxTriangles( 0 )
+    , mNumMeshlets( 0 )
+    , mMeshlets( nullptr )
+    , mNumVertices( 0 )
+    , mVertices( nullptr )
+    , mNumTriangles( 0 )
+    , mTriangles( nullptr ) {
+        // empty
+    }
+
+    ~aiMeshletData() {
+        delete [] mMeshlets;
+        delete [] mVertices;
+        delete [] mTriangles;
+    }
+#endif // __cplusplus
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Enumerates the vertex components which can be quantized.
+ *
+ *  Used by the #AI_CONFIG_PP_QV_COMPONENTS property.
+ */
+enum aiQuantizedComponent
+{
+    /** 16 bit positions, see aiQuantizedMesh::mPositions */
+    aiQuantizedComponent_POSITIONS = 0x1,
+
+    /** 16 bit octahedral normals, see aiQuantizedMesh::mNormals */
+    aiQuantizedComponent_NORMALS = 0x2,
+
+    /** 16 bit octahedral tangents, see aiQuantizedMesh::mTangents */
+    aiQuantizedComponent_TANGENTS = 0x4,
+
+    /** 16 bit texture coordinates, see aiQuantizedMesh::mTextureCoords */
+    aiQuantizedComponent_TEXCOORDS = 0x8,
+
+    /** 8 bit vertex colors, see aiQuantizedMesh::mColors */
+    aiQuantizedComponent_COLORS = 0x10,
+
+    /** This value is not used. It is just here to force the
+     *  compiler to map this enum to a 32 Bit integer.
+     */
+#ifndef SWIG
+    _aiQuantizedComponent_Force32Bit = INT_MAX
+#endif
+}; //! enum aiQuantizedComponent
+
+// ---------------------------------------------------------------------------
+/** @brief Compact fixed-point copies of the vertex components of a mesh.
+ *
+ *  Generated by the QuantizeVertices step, see #AI_CONFIG_PP_QV_COMPONENTS.
+ *  The streams are laid out as GPUs and the glTF KHR_mesh_quantization
+ *  extension expect them, so exporters can write them without conversion.
+ *  A NULL pointer means the component is not quantized. Each stream has
+ *  aiQuantizedMesh::mNumVertices entries, in the order of the mesh vertices.
+ */
+struct aiQuantizedMesh
+{
+    //! Number of vertices, equal to aiMesh::mNumVertices
+    unsigned int mNumVertices;
+
+    //! Positions, 3 unsigned 16 bit integers per vertex. The position
+    //! is mPositionTransform * (x, y, z). The transform is a uniform
+    //! scale followed by a translation.
+    unsigned short* mPositions;
+    C_STRUCT aiMatrix4x4 mPositionTransform;
+
+    //! Normals, 2 signed normalized 16 bit integers per vertex holding
+    //! the octahedral encoding of the unit normal.
+    short* mNormals;
+
+    //! Tangents, 3 signed 16 bit integers per vertex: the octahedral
+    //! encoding of the unit tangent as for mNormals and the sign of the
+    //! bitangent, +-32767. The bitangent is sign * cross(normal, tangent).
+    short* mTangents;
+
+    //! Texture coordinates of two-dimensional UV channels, 2 unsigned
+    //! normalized 16 bit integers per vertex. The coordinate is
+    //! mTexCoordOffset[n] + mTexCoordScale[n] * (u, v), the offset is
+    //! 0 and the scale is 1 if all coordinates were inside [0, 1].
+    unsigned short* mTextureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    C_STRUCT aiVector2D mTexCoordOffset[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    C_STRUCT aiVector2D mTexCoordScale[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+
+    //! Vertex colors, 4 unsigned normalized 8 bit integers per vertex
+    unsigned char* mColors[AI_MAX_NUMBER_OF_COLOR_SETS];
+
+#ifdef __cplusplus
+
+    aiQuantizedMesh() AI_NO_EXCEPT
+    : mNumVertices( 0 )
+    , mPositions( nullptr )
+    , mPositionTransform()
+    , mNormals( nullptr )
+    , mTangents( nullptr ) {
+        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a ) {
+            mTextureCoords[a] = nullptr;
+            mTexCoordScale[a] = aiVector2D( 1, 1 );
+        }
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+            mColors[a] = nullptr;
+        }
+    }
+
+    ~aiQuantizedMesh() {
+        delete [] mPositions;
+        delete [] mNormals;
+        delete [] mTangents;
+        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+            delete [] mTextureCoords[a];
+        }
+        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; a++) {
+            delete [] mColors[a];
+        }
+    }
+
+    //! Decodes a quantized position
+    aiVector3D GetPosition( unsigned int pIndex) const {
+        const unsigned short* p = mPositions + pIndex * 3;
+        return mPositionTransform * aiVector3D( p[0], p[1], p[2] );
+    }
+
+    //! Decodes an octahedral encoded unit vector
+    static aiVector3D DecodeOctahedral( const short* p) {
+        aiVector3D v( p[0] / 32767.f, p[1] / 32767.f, 0 );
+        v.z = 1 - ( v.x < 0 ? -v.x : v.x ) - ( v.y < 0 ? -v.y : v.y );
+        const ai_real t = v.z < 0 ? -v.z : ai_real( 0 );
+        v.x += v.x >= 0 ? -t : t;
+        v.y += v.y >= 0 ? -t : t;
+        return v.Normalize();
+    }
+
+    //! Decodes a quantized normal
+    aiVector3D GetNormal( unsigned int pIndex) const {
+        return DecodeOctahedral( mNormals + pIndex * 2 );
+    }
+
+    //! Decodes a quantized tangent, the bitangent is
+    //! handedness * (normal ^ tangent)
+    aiVector3D GetTangent( unsigned int pIndex, ai_real& handedness) const {
+        handedness = mTangents[pIndex * 3 + 2] < 0 ? ai_real( -1 ) : ai_real( 1 );
+        return DecodeOctahedral( mTangents + pIndex * 3 );
+    }
+
+    //! Decodes a quantized texture coordinate
+    aiVector3D GetTextureCoords( unsigned int pChannel, unsigned int pIndex) const {
+        const unsigned short* p = mTextureCoords[pChannel] + pIndex * 2;
+        return aiVector3D( mTexCoordOffset[pChannel].x + mTexCoordScale[pChannel].x * ( p[0] / 65535.f ),
+            mTexCoordOffset[pChannel].y + mTexCoordScale[pChannel].y * ( p[1] / 65535.f ), 0 );
+    }
+
+    //! Decodes a quantized vertex color
+    aiColor4D GetColor( unsigned int pChannel, unsigned int pIndex) const {
+        const unsigned char* p = mColors[pChannel] + pIndex * 4;
+        return aiColor4D( p[0] / 255.f, p[1] / 255.f, p[2] / 255.f, p[3] / 255.f );
+    }
+
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -711,6 +947,16 @@ struct aiMesh
      *  Method of morphing when animeshes are specified. 
      */
     unsigned int mMethod;
+
+    /** Meshlet partitioning of the mesh, generated by the
+     *  GenerateMeshlets step (#AI_CONFIG_PP_ML_ENABLE). NULL if not present.
+     */
+    C_STRUCT aiMeshletData* mMeshlets;
+
+    /** Quantized copies of the vertex components, generated by the
+     *  QuantizeVertices step. NULL if not present.
+     */
+    C_STRUCT aiQuantizedMesh* mQuantized;
 	
 #ifdef __cplusplus
 
@@ -732,7 +978,9 @@ struct aiMesh
     , mMaterialIndex( 0 )
     , mNumAnimMeshes( 0 )
     , mAnimMeshes(nullptr)
-    , mMethod( 0 ) {
+    , mMethod( 0 )
+    , mMeshlets( nullptr )
+    , mQuantized( nullptr ) {
         for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a ) {
             mNumUVComponents[a] = 0;
             mTextureCoords[a] = nullptr;
@@ -771,6 +1019,8 @@ struct aiMesh
             delete [] mAnimMeshes;
         }
 
+        delete mMeshlets;
+        delete mQuantized;
         delete [] mFaces;
     }
 
@@ -839,6 +1089,16 @@ struct aiMesh
         return mBones != nullptr && mNumBones > 0;
     }
 
+    //! Check whether the mesh has quantized vertex components
+    bool HasQuantizedData() const {
+        return mQuantized != nullptr && mNumVertices > 0;
+    }
+
+    //! Check whether the mesh has been partitioned into meshlets
+    bool HasMeshlets() const {
+        return mMeshlets != nullptr && mMeshlets->mNumMeshlets > 0;
+    }
+
 #endif // __cplusplus
 };
 
@@ -278,6 +278,10 @@ enum aiPostProcessSteps
      * If you intend to render huge models in hardware, this step might
      * be of interest to you. The <tt>#AI_CONFIG_PP_ICL_PTCACHE_SIZE</tt>
      * importer property can be used to fine-tune the cache optimization.
+     * <tt>#AI_CONFIG_PP_ICL_METHOD</tt> selects a different algorithm,
+     * <tt>#AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD</tt> and
+     * <tt>#AI_CONFIG_PP_ICL_VERTEX_FETCH</tt> enable an additional overdraw
+     * and vertex fetch optimization.
      */
     aiProcess_ImproveCacheLocality = 0x800,
 
@@ -316,6 +320,25 @@ enum aiPostProcessSteps
     */
     aiProcess_FixInfacingNormals = 0x2000,
 
+    // -------------------------------------------------------------------------
+    /** <hr>Generates simplified versions of the meshes for level of detail
+     * rendering.
+     *
+     * Each triangle mesh is simplified by edge collapses ordered by their
+     * quadric error. Vertices on UV, normal or other attribute seams are not
+     * moved, and the simplified meshes keep the bone weights of their
+     * vertices. The levels of detail are appended to aiScene::mMeshes, from
+     * the finest to the coarsest, and named after the original mesh with a
+     * "_LOD<level>" suffix. They are not referenced by any node; instead the
+     * scene's metadata holds the entries "LOD.<mesh>.First" and
+     * "LOD.<mesh>.Count" (both int32) for each mesh with levels of detail,
+     * where <mesh> is the index of the original mesh.
+     * Use <tt>#AI_CONFIG_PP_GLOD_LEVELS</tt>, <tt>#AI_CONFIG_PP_GLOD_RATIO</tt>
+     * and <tt>#AI_CONFIG_PP_GLOD_MAX_ERROR</tt> to configure the step.
+     * It works best on meshes processed by #aiProcess_JoinIdenticalVertices.
+    */
+    aiProcess_GenerateLODs = 0x4000,
+
     // -------------------------------------------------------------------------
     /** <hr>This step splits meshes with more than one primitive type in
      *  homogeneous sub-meshes.
@@ -232,6 +232,24 @@ aiProcess_RemoveRedundantMaterials = 0x1000
 #
 aiProcess_FixInfacingNormals = 0x2000
 
+## <hr>Generates simplified versions of the meshes for level of detail
+# rendering.
+#
+# Each triangle mesh is simplified by edge collapses ordered by their
+# quadric error. Vertices on UV, normal or other attribute seams are not
+# moved, and the simplified meshes keep the bone weights of their
+# vertices. The levels of detail are appended to aiScene::mMeshes, from
+# the finest to the coarsest, and named after the original mesh with a
+# "_LOD<level>" suffix. They are not referenced by any node; instead the
+# scene's metadata holds the entries "LOD.<mesh>.First" and
+# "LOD.<mesh>.Count" (both int32) for each mesh with levels of detail,
+# where <mesh> is the index of the original mesh.
+# Use <tt>#AI_CONFIG_PP_GLOD_LEVELS</tt>, <tt>#AI_CONFIG_PP_GLOD_RATIO</tt>
+# and <tt>#AI_CONFIG_PP_GLOD_MAX_ERROR</tt> to configure the step.
+# It works best on meshes processed by #aiProcess_JoinIdenticalVertices.
+#
+aiProcess_GenerateLODs = 0x4000
+
 ## <hr>This step splits meshes with more than one primitive type in 
 #  homogeneous sub-meshes. 
 #
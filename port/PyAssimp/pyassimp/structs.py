@@ -1,6 +1,6 @@
 #-*- coding: UTF-8 -*-
 
-from ctypes import POINTER, c_void_p, c_int, c_uint, c_char, c_float, Structure, c_char_p, c_double, c_ubyte, c_size_t, c_uint32
+from ctypes import POINTER, c_void_p, c_int, c_uint, c_char, c_float, Structure, c_char_p, c_double, c_ubyte, c_short, c_ushort, c_size_t, c_uint32
 
 
 class Vector2D(Structure):
@@ -70,7 +70,7 @@ class String(Structure):
     See 'types.h' for details.
     """ 
 
-    MAXLEN = 1024
+    MAXLEN = 1024
 
     _fields_ = [
             # Binary length of the string excluding the terminal 0. This is NOT the
@@ -610,6 +610,88 @@ class AnimMesh(Structure):
         ]
 
 
+class Meshlet(Structure):
+    """
+    See 'mesh.h' for details.
+    """ 
+
+    _fields_ = [
+            # Index of the first entry in aiMeshletData::mVertices
+            ("mVertexOffset", c_uint),
+
+            # Index of the first triangle in aiMeshletData::mTriangles
+            ("mTriangleOffset", c_uint),
+
+            # Number of vertices and triangles of the meshlet
+            ("mNumVertices", c_uint),
+            ("mNumTriangles", c_uint),
+
+            # Bounding sphere of the meshlet
+            ("mCenter", Vector3D),
+            ("mRadius", c_float),
+
+            # Normal cone of the meshlet
+            ("mConeApex", Vector3D),
+            ("mConeAxis", Vector3D),
+            ("mConeCutoff", c_float),
+        ]
+
+class MeshletData(Structure):
+    """
+    See 'mesh.h' for details.
+    """ 
+
+    _fields_ = [
+            # The limits the meshlets were built with
+            ("mMaxVertices", c_uint),
+            ("mMaxTriangles", c_uint),
+
+            # The meshlets
+            ("mNumMeshlets", c_uint),
+            ("mMeshlets", POINTER(Meshlet)),
+
+            # Mesh vertex indices referenced by the meshlets
+            ("mNumVertices", c_uint),
+            ("mVertices", POINTER(c_uint)),
+
+            # Three local vertex indices per triangle
+            ("mNumTriangles", c_uint),
+            ("mTriangles", POINTER(c_ubyte)),
+        ]
+
+class QuantizedMesh(Structure):
+    """
+    See 'mesh.h' for details.
+    """ 
+
+    AI_MAX_NUMBER_OF_TEXTURECOORDS = 0x8
+    AI_MAX_NUMBER_OF_COLOR_SETS = 0x8
+
+    _fields_ = [
+            # Number of vertices, equal to aiMesh::mNumVertices
+            ("mNumVertices", c_uint),
+
+            # Positions, 3 unsigned 16 bit integers per vertex, and their
+            # dequantization transform
+            ("mPositions", POINTER(c_ushort)),
+            ("mPositionTransform", Matrix4x4),
+
+            # Octahedral normals, 2 signed normalized 16 bit integers per vertex
+            ("mNormals", POINTER(c_short)),
+
+            # Octahedral tangents and bitangent sign, 3 signed 16 bit integers per vertex
+            ("mTangents", POINTER(c_short)),
+
+            # Texture coordinates, 2 unsigned normalized 16 bit integers per vertex,
+            # and their dequantization offset and scale
+            ("mTextureCoords", POINTER(c_ushort) * AI_MAX_NUMBER_OF_TEXTURECOORDS),
+            ("mTexCoordOffset", Vector2D * AI_MAX_NUMBER_OF_TEXTURECOORDS),
+            ("mTexCoordScale", Vector2D * AI_MAX_NUMBER_OF_TEXTURECOORDS),
+
+            # Vertex colors, 4 unsigned normalized 8 bit integers per vertex
+            ("mColors", POINTER(c_ubyte) * AI_MAX_NUMBER_OF_COLOR_SETS),
+        ]
+
 class Mesh(Structure):
     """
     See 'mesh.h' for details.
@@ -757,6 +839,12 @@ class Mesh(Structure):
             # Method of morphing when animeshes are specified.
             ("mMethod", c_uint),
 
+            # Meshlet partitioning of the mesh, NULL if not present.
+            ("mMeshlets", POINTER(MeshletData)),
+
+            # Quantized copies of the vertex components, NULL if not present.
+            ("mQuantized", POINTER(QuantizedMesh)),
+
         ]
 
 class Camera(Structure):
@@ -0,0 +1,537 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Main.cpp
+ *  @brief assimp_bench - measures the throughput of the importers and the
+ *    cost of each post-processing step.
+ *
+ *  Two kinds of benchmarks are run:
+ *   - import/<path>: reads every supported file below the model directory
+ *     (test/models by default) without post-processing and reports MB/s
+ *     and vertices/s.
+ *   - step/<flag>/<triangles>: applies a single aiProcess_XXX flag to a
+ *     synthetic mesh of the given size and reports triangles/s and
+ *     vertices/s. Scene creation is not timed.
+ *
+ *  Results are printed as a table and optionally written as JSON, so they
+ *  can be compared between revisions.
+ */
+
+#include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/version.h>
+#include <assimp/config.h>
+#include "Importer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <dirent.h>
+#   include <sys/stat.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// ------------------------------------------------------------------------------------------------
+struct Options {
+    std::string modelDir;
+    std::string filter;
+    std::string jsonFile;
+    double minTime;
+    unsigned int minTriangles;
+    unsigned int maxTriangles;
+    int numThreads;
+    bool runImporters;
+    bool runSteps;
+
+    Options()
+    : modelDir(ASSIMP_TEST_MODELS_DIR)
+    , minTime(0.2)
+    , minTriangles(10000)
+    , maxTriangles(1000000)
+    , numThreads(1)
+    , runImporters(true)
+    , runSteps(true) {
+        // empty
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+struct Result {
+    std::string name;
+    unsigned int iterations;
+    double meanTime;
+    double minTime;
+    double bytes;
+    double vertices;
+    double triangles;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct StepDesc {
+    const char* name;
+    unsigned int flag;
+
+    // the synthetic mesh is made of quads instead of triangles
+    bool polygons;
+
+    // the synthetic mesh has no normals
+    bool noNormals;
+};
+
+// One entry per aiProcess_XXX flag. ValidateDataStructure is measured as well,
+// it is run as part of most presets.
+const StepDesc Steps[] = {
+    { "CalcTangentSpace",         aiProcess_CalcTangentSpace,         false, false },
+    { "JoinIdenticalVertices",    aiProcess_JoinIdenticalVertices,    false, false },
+    { "MakeLeftHanded",           aiProcess_MakeLeftHanded,           false, false },
+    { "Triangulate",              aiProcess_Triangulate,              true,  false },
+    { "RemoveComponent",          aiProcess_RemoveComponent,          false, false },
+    { "GenNormals",               aiProcess_GenNormals,               false, true  },
+    { "GenSmoothNormals",         aiProcess_GenSmoothNormals,         false, true  },
+    { "SplitLargeMeshes",         aiProcess_SplitLargeMeshes,         false, false },
+    { "PreTransformVertices",     aiProcess_PreTransformVertices,     false, false },
+    { "LimitBoneWeights",         aiProcess_LimitBoneWeights,         false, false },
+    { "ValidateDataStructure",    aiProcess_ValidateDataStructure,    false, false },
+    { "ImproveCacheLocality",     aiProcess_ImproveCacheLocality,     false, false },
+    { "RemoveRedundantMaterials", aiProcess_RemoveRedundantMaterials, false, false },
+    { "FixInfacingNormals",       aiProcess_FixInfacingNormals,       false, false },
+    { "GenerateLODs",             aiProcess_GenerateLODs,             false, false },
+    { "SortByPType",              aiProcess_SortByPType,              false, false },
+    { "FindDegenerates",          aiProcess_FindDegenerates,          false, false },
+    { "FindInvalidData",          aiProcess_FindInvalidData,          false, false },
+    { "GenUVCoords",              aiProcess_GenUVCoords,              false, false },
+    { "TransformUVCoords",        aiProcess_TransformUVCoords,        false, false },
+    { "FindInstances",            aiProcess_FindInstances,            false, false },
+    { "OptimizeMeshes",           aiProcess_OptimizeMeshes,           false, false },
+    { "OptimizeGraph",            aiProcess_OptimizeGraph,            false, false },
+    { "FlipUVs",                  aiProcess_FlipUVs,                  false, false },
+    { "FlipWindingOrder",         aiProcess_FlipWindingOrder,         false, false },
+    { "SplitByBoneCount",         aiProcess_SplitByBoneCount,         false, false },
+    { "Debone",                   aiProcess_Debone,                   false, false },
+    { "GlobalScale",              aiProcess_GlobalScale,              false, false },
+    { "EmbedTextures",            aiProcess_EmbedTextures,            false, false },
+    { "ForceGenNormals",          aiProcess_ForceGenNormals,          false, false },
+    { "DropNormals",              aiProcess_DropNormals,              false, false },
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Builds a scene with a single, gently curved grid mesh of (about) the given number of
+ *  triangles. The mesh is in the verbose format the importers produce: every face has its
+ *  own vertices, so JoinIdenticalVertices has work to do. */
+aiScene* CreateGridScene(unsigned int numTriangles, bool polygons, bool noNormals) {
+    const unsigned int side = std::max(1u, static_cast<unsigned int>(std::sqrt(numTriangles / 2.0)));
+    const unsigned int numQuads = side * side;
+    const unsigned int cornersPerFace = polygons ? 4 : 3;
+    const unsigned int numFaces = polygons ? numQuads : numQuads * 2;
+
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = polygons ? aiPrimitiveType_POLYGON : aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = numFaces * cornersPerFace;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    if (!noNormals) {
+        mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    }
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+
+    const float scale = 1.f / side;
+    unsigned int v = 0, f = 0;
+    for (unsigned int y = 0; y < side; ++y) {
+        for (unsigned int x = 0; x < side; ++x) {
+            static const unsigned int quad[6][2] = { {0,0}, {1,0}, {1,1}, {0,0}, {1,1}, {0,1} };
+            static const unsigned int poly[4][2] = { {0,0}, {1,0}, {1,1}, {0,1} };
+            const unsigned int (*corners)[2] = polygons ? poly : quad;
+            const unsigned int numCorners = polygons ? 4 : 6;
+
+            for (unsigned int c = 0; c < numCorners; ++c) {
+                if (0 == c % cornersPerFace) {
+                    aiFace& face = mesh->mFaces[f++];
+                    face.mNumIndices = cornersPerFace;
+                    face.mIndices = new unsigned int[cornersPerFace];
+                }
+                aiFace& face = mesh->mFaces[f - 1];
+                face.mIndices[c % cornersPerFace] = v;
+
+                const float u = (x + corners[c][0]) * scale, w = (y + corners[c][1]) * scale;
+                const float h = 0.1f * std::sin(u * 6.283185f) * std::cos(w * 6.283185f);
+                mesh->mVertices[v] = aiVector3D(u, w, h);
+                if (mesh->mNormals) {
+                    const float dx = -0.6283185f * std::cos(u * 6.283185f) * std::cos(w * 6.283185f);
+                    const float dy = 0.6283185f * std::sin(u * 6.283185f) * std::sin(w * 6.283185f);
+                    mesh->mNormals[v] = aiVector3D(dx, dy, 1.f).Normalize();
+                }
+                mesh->mTextureCoords[0][v] = aiVector3D(u, w, 0.f);
+                ++v;
+            }
+        }
+    }
+
+    aiScene* scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = mesh;
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[1];
+    scene->mMaterials[0] = new aiMaterial();
+    scene->mRootNode = new aiNode("root");
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CountGeometry(const aiScene* scene, double& vertices, double& triangles) {
+    vertices = triangles = 0.0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        vertices += mesh->mNumVertices;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            if (mesh->mFaces[f].mNumIndices >= 3) {
+                triangles += mesh->mFaces[f].mNumIndices - 2;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Matches(const Options& opt, const std::string& name) {
+    return opt.filter.empty() || std::string::npos != name.find(opt.filter);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Runs the given function until the minimum time is reached. The function returns the time
+ *  spent in the measured part of one iteration, or a negative value on failure. */
+template <typename Fn>
+bool Measure(const Options& opt, Result& result, Fn fn) {
+    result.iterations = 0;
+    result.meanTime = 0.0;
+    result.minTime = 0.0;
+
+    double total = 0.0;
+    while (0 == result.iterations || total < opt.minTime) {
+        const double t = fn();
+        if (t < 0.0) {
+            return false;
+        }
+        result.minTime = result.iterations ? std::min(result.minTime, t) : t;
+        total += t;
+        ++result.iterations;
+    }
+    result.meanTime = total / result.iterations;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PrintResult(const Result& r) {
+    std::printf("%-56s %8u %12.3f %12.3f", r.name.c_str(), r.iterations, r.meanTime * 1e3, r.minTime * 1e3);
+    if (r.bytes > 0.0) {
+        std::printf(" %10.2f MB/s", r.bytes / r.meanTime / (1024.0 * 1024.0));
+    }
+    if (r.triangles > 0.0) {
+        std::printf(" %10.3f Mtri/s", r.triangles / r.meanTime * 1e-6);
+    }
+    std::printf(" %10.3f Mvert/s\n", r.vertices / r.meanTime * 1e-6);
+    std::fflush(stdout);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ListFiles(const std::string& dir, std::vector<std::string>& out) {
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE h = ::FindFirstFileA((dir + "\\*").c_str(), &data);
+    if (INVALID_HANDLE_VALUE == h) {
+        return;
+    }
+    do {
+        const std::string name = data.cFileName;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            ListFiles(dir + "/" + name, out);
+        } else {
+            out.push_back(dir + "/" + name);
+        }
+    } while (::FindNextFileA(h, &data));
+    ::FindClose(h);
+#else
+    DIR* d = ::opendir(dir.c_str());
+    if (NULL == d) {
+        return;
+    }
+    while (const dirent* e = ::readdir(d)) {
+        const std::string name = e->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        const std::string path = dir + "/" + name;
+        struct stat st;
+        if (0 != ::stat(path.c_str(), &st)) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            ListFiles(path, out);
+        } else {
+            out.push_back(path);
+        }
+    }
+    ::closedir(d);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunImporters(const Options& opt, std::vector<Result>& results) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, opt.numThreads);
+
+    std::vector<std::string> files;
+    ListFiles(opt.modelDir, files);
+    std::sort(files.begin(), files.end());
+
+    for (const std::string& file : files) {
+        const std::string::size_type dot = file.find_last_of('.');
+        if (std::string::npos == dot || !importer.IsExtensionSupported(file.substr(dot))) {
+            continue;
+        }
+
+        Result r = Result();
+        r.name = "import/" + file.substr(opt.modelDir.length() + 1);
+        if (!Matches(opt, r.name)) {
+            continue;
+        }
+
+        // skip files which don't load, the test suite covers them
+        const aiScene* scene = importer.ReadFile(file, 0);
+        if (NULL == scene) {
+            continue;
+        }
+        CountGeometry(scene, r.vertices, r.triangles);
+        r.triangles = 0.0;
+
+        std::ifstream in(file.c_str(), std::ios::binary | std::ios::ate);
+        r.bytes = static_cast<double>(in.tellg());
+
+        const bool ok = Measure(opt, r, [&importer, &file]() {
+            const Clock::time_point start = Clock::now();
+            const bool success = NULL != importer.ReadFile(file, 0);
+            const double t = std::chrono::duration<double>(Clock::now() - start).count();
+            return success ? t : -1.0;
+        });
+        if (ok) {
+            PrintResult(r);
+            results.push_back(r);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunSteps(const Options& opt, std::vector<Result>& results) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, opt.numThreads);
+
+    for (unsigned long long size = opt.minTriangles; size <= opt.maxTriangles; size *= 10) {
+        for (const StepDesc& step : Steps) {
+            Result r = Result();
+            r.name = std::string("step/") + step.name + "/" + std::to_string(size);
+            if (!Matches(opt, r.name)) {
+                continue;
+            }
+
+            std::unique_ptr<aiScene> source(CreateGridScene(static_cast<unsigned int>(size),
+                step.polygons, step.noNormals));
+            CountGeometry(source.get(), r.vertices, r.triangles);
+
+            const bool ok = Measure(opt, r, [&importer, &source, &step]() {
+                // hand a fresh copy of the scene to the importer, the step may change it
+                aiScene* scene = NULL;
+                SceneCombiner::CopyScene(&scene, source.get());
+                importer.FreeScene();
+                importer.Pimpl()->mScene = scene;
+
+                const Clock::time_point start = Clock::now();
+                const bool success = NULL != importer.ApplyPostProcessing(step.flag);
+                const double t = std::chrono::duration<double>(Clock::now() - start).count();
+                return success ? t : -1.0;
+            });
+            importer.FreeScene();
+
+            if (ok) {
+                PrintResult(r);
+                results.push_back(r);
+            } else {
+                std::fprintf(stderr, "%s failed: %s\n", r.name.c_str(), importer.GetErrorString());
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string JsonString(const std::string& s) {
+    std::string out = "\"";
+    for (const char c : s) {
+        if ('\"' == c || '\\' == c) {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteJson(const Options& opt, const std::vector<Result>& results, std::ostream& out) {
+    out.imbue(std::locale::classic());
+    out << "{\n  \"context\": {\n"
+        << "    \"assimp_version\": \"" << aiGetVersionMajor() << "." << aiGetVersionMinor()
+        << "." << aiGetVersionRevision() << "\",\n"
+        << "    \"threads\": " << opt.numThreads << ",\n"
+        << "    \"min_time\": " << opt.minTime << "\n  },\n"
+        << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": " << JsonString(r.name)
+            << ", \"iterations\": " << r.iterations
+            << ", \"mean_time_s\": " << r.meanTime
+            << ", \"min_time_s\": " << r.minTime
+            << ", \"vertices\": " << r.vertices
+            << ", \"vertices_per_s\": " << r.vertices / r.meanTime;
+        if (r.bytes > 0.0) {
+            out << ", \"bytes\": " << r.bytes
+                << ", \"mb_per_s\": " << r.bytes / r.meanTime / (1024.0 * 1024.0);
+        }
+        if (r.triangles > 0.0) {
+            out << ", \"triangles\": " << r.triangles
+                << ", \"triangles_per_s\": " << r.triangles / r.meanTime;
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* Usage =
+"assimp_bench [options]\n\n"
+" --models <dir>         Directory to search for models to import (default: test/models)\n"
+" --filter <text>        Only run benchmarks whose name contains <text>\n"
+" --json <file>          Write the results as JSON to <file>\n"
+" --min-time <seconds>   Minimum time to run each benchmark (default: 0.2)\n"
+" --min-triangles <n>    Smallest synthetic mesh for the step benchmarks (default: 10000)\n"
+" --max-triangles <n>    Largest synthetic mesh for the step benchmarks (default: 1000000)\n"
+" --threads <n>          Value of AI_CONFIG_GLOB_NUM_THREADS (default: 1)\n"
+" --importers-only       Skip the post-processing benchmarks\n"
+" --steps-only           Skip the importer benchmarks\n";
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--models" && hasValue) {
+            opt.modelDir = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            opt.filter = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            opt.jsonFile = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            opt.minTime = std::atof(argv[++i]);
+        } else if (arg == "--min-triangles" && hasValue) {
+            opt.minTriangles = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--max-triangles" && hasValue) {
+            opt.maxTriangles = static_cast<unsigned int>(std::strtoul(argv[++i], NULL, 10));
+        } else if (arg == "--threads" && hasValue) {
+            opt.numThreads = std::atoi(argv[++i]);
+        } else if (arg == "--importers-only") {
+            opt.runSteps = false;
+        } else if (arg == "--steps-only") {
+            opt.runImporters = false;
+        } else {
+            std::fputs(Usage, stderr);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::printf("%-56s %8s %12s %12s\n", "benchmark", "iters", "mean [ms]", "min [ms]");
+
+    std::vector<Result> results;
+    if (opt.runImporters) {
+        RunImporters(opt, results);
+    }
+    if (opt.runSteps) {
+        RunSteps(opt, results);
+    }
+
+    if (!opt.jsonFile.empty()) {
+        std::ofstream out(opt.jsonFile.c_str());
+        if (!out) {
+            std::fprintf(stderr, "Unable to write %s\n", opt.jsonFile.c_str());
+            return 1;
+        }
+        WriteJson(opt, results, out);
+    }
+    return 0;
+}
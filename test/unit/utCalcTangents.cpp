@@ -0,0 +1,269 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <CalcTangentsProcess.h>
+#include <ThreadPool.h>
+#include <assimp/scene.h>
+#include <cmath>
+
+using namespace Assimp;
+
+namespace {
+
+// runs the step on a single mesh, as the mesh pass of the importer would
+bool Process(CalcTangentsProcess& process, aiMesh* pMesh)
+{
+    aiScene scene;
+    scene.mNumMeshes = 1;
+    process.BeginMeshPass(&scene);
+    process.ExecuteOnMesh(pMesh, 0);
+    process.EndMeshPass(&scene);
+    scene.mNumMeshes = 0;
+    return pMesh->mTangents != NULL;
+}
+
+void ExpectVector(const aiVector3D& expected, const aiVector3D& actual)
+{
+    EXPECT_NEAR(expected.x, actual.x, 1e-5f);
+    EXPECT_NEAR(expected.y, actual.y, 1e-5f);
+    EXPECT_NEAR(expected.z, actual.z, 1e-5f);
+}
+
+// A single quad in the xy plane, u goes along x and v along y unless mirrored
+aiMesh* CreateQuad(bool mirrorU)
+{
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh->mNumVertices = 4;
+    mesh->mVertices = new aiVector3D[4];
+    mesh->mNormals = new aiVector3D[4];
+    mesh->mTextureCoords[0] = new aiVector3D[4];
+    mesh->mNumUVComponents[0] = 2;
+    const float corners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+    for (unsigned int i = 0; i < 4; ++i) {
+        mesh->mVertices[i] = aiVector3D(corners[i][0], corners[i][1], 0.f);
+        mesh->mNormals[i] = aiVector3D(0.f, 0.f, 1.f);
+        mesh->mTextureCoords[0][i] = aiVector3D(mirrorU ? -corners[i][0] : corners[i][0], corners[i][1], 0.f);
+    }
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[1];
+    mesh->mFaces[0].mIndices = new unsigned int[mesh->mFaces[0].mNumIndices = 4];
+    for (unsigned int i = 0; i < 4; ++i) {
+        mesh->mFaces[0].mIndices[i] = i;
+    }
+    return mesh;
+}
+
+// A part of a cylinder around the y axis in the verbose format, each triangle has its own
+// copies of the vertices
+aiMesh* CreateCylinder(unsigned int segments, unsigned int rows)
+{
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumFaces = segments * rows * 2;
+    mesh->mNumVertices = mesh->mNumFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+
+    unsigned int v = 0;
+    for (unsigned int y = 0; y < rows; ++y) {
+        for (unsigned int x = 0; x < segments; ++x) {
+            const unsigned int quad[6][2] = { { x, y }, { x + 1, y }, { x + 1, y + 1 },
+                { x, y }, { x + 1, y + 1 }, { x, y + 1 } };
+            for (unsigned int c = 0; c < 6; ++c, ++v) {
+                const float angle = quad[c][0] * 0.1f;
+                mesh->mVertices[v] = aiVector3D(std::sin(angle), (float)quad[c][1], std::cos(angle));
+                mesh->mNormals[v] = aiVector3D(std::sin(angle), 0.f, std::cos(angle));
+                mesh->mTextureCoords[0][v] = aiVector3D(quad[c][0] * 0.1f, quad[c][1] * 0.5f, 0.f);
+                if (c % 3 == 0) {
+                    aiFace& face = mesh->mFaces[v / 3];
+                    face.mIndices = new unsigned int[face.mNumIndices = 3];
+                }
+                mesh->mFaces[v / 3].mIndices[c % 3] = v;
+            }
+        }
+    }
+    return mesh;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST(CalcTangentsTest, testMikkTSpaceQuad)
+{
+    CalcTangentsProcess process;
+    process.SetMikkTSpace(true);
+    std::unique_ptr<aiMesh> mesh(CreateQuad(false));
+    ASSERT_TRUE(Process(process, mesh.get()));
+    for (unsigned int i = 0; i < 4; ++i) {
+        ExpectVector(aiVector3D(1.f, 0.f, 0.f), mesh->mTangents[i]);
+        ExpectVector(aiVector3D(0.f, 1.f, 0.f), mesh->mBitangents[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(CalcTangentsTest, testMikkTSpaceMirroredQuad)
+{
+    // the tangent follows u, the bitangent still points along v
+    CalcTangentsProcess process;
+    process.SetMikkTSpace(true);
+    std::unique_ptr<aiMesh> mesh(CreateQuad(true));
+    ASSERT_TRUE(Process(process, mesh.get()));
+    for (unsigned int i = 0; i < 4; ++i) {
+        ExpectVector(aiVector3D(-1.f, 0.f, 0.f), mesh->mTangents[i]);
+        ExpectVector(aiVector3D(0.f, 1.f, 0.f), mesh->mBitangents[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(CalcTangentsTest, testMikkTSpaceSmoothsCopies)
+{
+    CalcTangentsProcess process;
+    process.SetMikkTSpace(true);
+    std::unique_ptr<aiMesh> mesh(CreateCylinder(10, 2));
+    ASSERT_TRUE(Process(process, mesh.get()));
+
+    for (unsigned int a = 0; a < mesh->mNumVertices; ++a) {
+        // the tangent runs around the cylinder, in the direction of u
+        const aiVector3D& n = mesh->mNormals[a];
+        ExpectVector(aiVector3D(n.z, 0.f, -n.x), mesh->mTangents[a]);
+        ExpectVector(aiVector3D(0.f, 1.f, 0.f), mesh->mBitangents[a]);
+
+        // all copies of a vertex share the same tangent space
+        for (unsigned int b = 0; b < a; ++b) {
+            if (mesh->mVertices[a] == mesh->mVertices[b]) {
+                EXPECT_EQ(mesh->mTangents[b], mesh->mTangents[a]);
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(CalcTangentsTest, testMikkTSpaceWithThreadPool)
+{
+    CalcTangentsProcess process;
+    process.SetMikkTSpace(true);
+    std::unique_ptr<aiMesh> serial(CreateCylinder(100, 50));
+    ASSERT_TRUE(Process(process, serial.get()));
+
+    ThreadPool pool(4);
+    process.SetThreadPool(&pool);
+    std::unique_ptr<aiMesh> parallel(CreateCylinder(100, 50));
+    ASSERT_TRUE(Process(process, parallel.get()));
+
+    for (unsigned int a = 0; a < serial->mNumVertices; ++a) {
+        EXPECT_EQ(serial->mTangents[a], parallel->mTangents[a]);
+        EXPECT_EQ(serial->mBitangents[a], parallel->mBitangents[a]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(CalcTangentsTest, testMikkTSpaceSplitsMirroredSeam)
+{
+    // two triangles sharing the edge from vertex 0 to vertex 1 at x = 0. The texture is mirrored
+    // at the edge, so the shared vertices get a different tangent on either side.
+    std::unique_ptr<aiMesh> guard(new aiMesh());
+    aiMesh* mesh = guard.get();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 4;
+    mesh->mVertices = new aiVector3D[4];
+    mesh->mNormals = new aiVector3D[4];
+    mesh->mTextureCoords[0] = new aiVector3D[4];
+    mesh->mNumUVComponents[0] = 2;
+    const float positions[4][2] = { { 0, 0 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+    for (unsigned int i = 0; i < 4; ++i) {
+        mesh->mVertices[i] = aiVector3D(positions[i][0], positions[i][1], 0.f);
+        mesh->mNormals[i] = aiVector3D(0.f, 0.f, 1.f);
+        mesh->mTextureCoords[0][i] = aiVector3D(std::fabs(positions[i][0]), positions[i][1], 0.f);
+    }
+    const unsigned int indices[2][3] = { { 0, 3, 1 }, { 0, 1, 2 } };
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mIndices = new unsigned int[mesh->mFaces[f].mNumIndices = 3];
+        std::copy(indices[f], indices[f] + 3, mesh->mFaces[f].mIndices);
+    }
+
+    // a bone, to check the copies are weighted as well
+    mesh->mNumBones = 1;
+    mesh->mBones = new aiBone*[1];
+    mesh->mBones[0] = new aiBone();
+    mesh->mBones[0]->mNumWeights = 4;
+    mesh->mBones[0]->mWeights = new aiVertexWeight[4];
+    for (unsigned int i = 0; i < 4; ++i) {
+        mesh->mBones[0]->mWeights[i] = aiVertexWeight(i, 0.25f * (i + 1));
+    }
+
+    CalcTangentsProcess process;
+    process.SetMikkTSpace(true);
+    ASSERT_TRUE(Process(process, mesh));
+
+    // the shared vertices are split, the first face keeps them
+    ASSERT_EQ(6u, mesh->mNumVertices);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(indices[0][i], mesh->mFaces[0].mIndices[i]);
+    }
+    EXPECT_EQ(2u, mesh->mFaces[1].mIndices[2]);
+    for (unsigned int f = 0; f < 2; ++f) {
+        const float u = f == 0 ? 1.f : -1.f;
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int p = mesh->mFaces[f].mIndices[i];
+            EXPECT_EQ(mesh->mVertices[p], aiVector3D(positions[indices[f][i]][0], positions[indices[f][i]][1], 0.f));
+            ExpectVector(aiVector3D(u, 0.f, 0.f), mesh->mTangents[p]);
+            ExpectVector(aiVector3D(0.f, 1.f, 0.f), mesh->mBitangents[p]);
+        }
+    }
+    for (unsigned int i = 0; i < 2; ++i) {
+        EXPECT_EQ(4u + i, mesh->mFaces[1].mIndices[i]);
+    }
+
+    ASSERT_EQ(6u, mesh->mBones[0]->mNumWeights);
+    EXPECT_EQ(4u, mesh->mBones[0]->mWeights[4].mVertexId);
+    EXPECT_EQ(0.25f, mesh->mBones[0]->mWeights[4].mWeight);
+    EXPECT_EQ(5u, mesh->mBones[0]->mWeights[5].mVertexId);
+    EXPECT_EQ(0.5f, mesh->mBones[0]->mWeights[5].mWeight);
+}
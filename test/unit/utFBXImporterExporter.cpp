@@ -44,6 +44,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include "SceneDiffer.h"
 #include "AbstractImportExportBase.h"
+#include "FBXConverter.h"
+#include "FBXDocument.h"
+#include "FBXImportSettings.h"
+#include "FBXParser.h"
+#include "FBXTokenizer.h"
+#include "ThreadPool.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -51,6 +57,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/types.h>
 
+#include <fstream>
+#include <iterator>
+
 using namespace Assimp;
 
 class utFBXImporterExporter : public AbstractImportExportBase {
@@ -114,3 +123,213 @@ TEST_F(utFBXImporterExporter, importUnitScaleFactor) {
     scene->mMetaData->Get("UnitScaleFactor", factor);
     EXPECT_DOUBLE_EQ(500.0, factor);
 }
+
+TEST_F(utFBXImporterExporter, importBinaryFromMemory) {
+    // binary files are tokenized in-place from the memory block
+    FILE *f = ::fopen(ASSIMP_TEST_MODELS_DIR "/FBX/box.fbx", "rb");
+    ASSERT_NE(nullptr, f);
+    ::fseek(f, 0, SEEK_END);
+    std::vector<char> buff(::ftell(f));
+    ::fseek(f, 0, SEEK_SET);
+    EXPECT_EQ(buff.size(), ::fread(&buff[0], 1, buff.size(), f));
+    ::fclose(f);
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(&buff[0], buff.size(), aiProcess_ValidateDataStructure, "fbx");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(1u, scene->mNumMeshes);
+    EXPECT_EQ(36u, scene->mMeshes[0]->mNumVertices);
+}
+
+TEST_F(utFBXImporterExporter, importParallelInflate) {
+    // with worker threads the compressed arrays are inflated up front
+    const char* files[] = {
+        ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx",
+        ASSIMP_TEST_MODELS_DIR "/FBX/box.fbx"
+    };
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        SCOPED_TRACE(files[i]);
+        Assimp::Importer serial, parallel;
+        parallel.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+        const aiScene *a = serial.ReadFile(files[i], aiProcess_ValidateDataStructure);
+        const aiScene *b = parallel.ReadFile(files[i], aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, a);
+        ASSERT_NE(nullptr, b);
+        ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+        for (unsigned int m = 0; m < a->mNumMeshes; ++m) {
+            const aiMesh *ma = a->mMeshes[m], *mb = b->mMeshes[m];
+            ASSERT_EQ(ma->mNumVertices, mb->mNumVertices);
+            ASSERT_EQ(ma->mNumFaces, mb->mNumFaces);
+            EXPECT_TRUE(std::equal(ma->mVertices, ma->mVertices + ma->mNumVertices, mb->mVertices));
+            ASSERT_EQ(ma->HasNormals(), mb->HasNormals());
+            if (ma->HasNormals()) {
+                EXPECT_TRUE(std::equal(ma->mNormals, ma->mNormals + ma->mNumVertices, mb->mNormals));
+            }
+        }
+    }
+}
+
+TEST_F(utFBXImporterExporter, importParallelMeshes) {
+    // meshes converted on worker threads end up in the same order and
+    // with the same materials as the serially converted ones
+    const char* files[] = {
+        ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx",
+        ASSIMP_TEST_MODELS_DIR "/FBX/global_settings.fbx"
+    };
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        SCOPED_TRACE(files[i]);
+        Assimp::Importer serial, parallel;
+        parallel.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+        const aiScene *a = serial.ReadFile(files[i], aiProcess_ValidateDataStructure);
+        const aiScene *b = parallel.ReadFile(files[i], aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, a);
+        ASSERT_NE(nullptr, b);
+        ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+        EXPECT_EQ(a->mNumMaterials, b->mNumMaterials);
+        for (unsigned int m = 0; m < a->mNumMeshes; ++m) {
+            const aiMesh *ma = a->mMeshes[m], *mb = b->mMeshes[m];
+            EXPECT_STREQ(ma->mName.C_Str(), mb->mName.C_Str());
+            EXPECT_EQ(ma->mMaterialIndex, mb->mMaterialIndex);
+            EXPECT_EQ(ma->mPrimitiveTypes, mb->mPrimitiveTypes);
+            EXPECT_EQ(ma->mNumBones, mb->mNumBones);
+            ASSERT_EQ(ma->mNumFaces, mb->mNumFaces);
+            for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+                ASSERT_EQ(ma->mFaces[f].mNumIndices, mb->mFaces[f].mNumIndices);
+                EXPECT_TRUE(std::equal(ma->mFaces[f].mIndices, ma->mFaces[f].mIndices + ma->mFaces[f].mNumIndices,
+                    mb->mFaces[f].mIndices));
+            }
+            ASSERT_EQ(ma->HasTextureCoords(0), mb->HasTextureCoords(0));
+            if (ma->HasTextureCoords(0)) {
+                EXPECT_TRUE(std::equal(ma->mTextureCoords[0], ma->mTextureCoords[0] + ma->mNumVertices, mb->mTextureCoords[0]));
+            }
+        }
+    }
+}
+
+TEST_F(utFBXImporterExporter, importAnimationKeyTolerance) {
+    // the translation ramps up linearly and stays constant for the second half,
+    // the rotation about z is linear throughout and the scaling is constant
+    Assimp::Importer all;
+    const aiScene *a = all.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/animation_keys.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, a);
+    ASSERT_EQ(1u, a->mNumAnimations);
+    ASSERT_EQ(1u, a->mAnimations[0]->mNumChannels);
+    EXPECT_EQ(11u, a->mAnimations[0]->mChannels[0]->mNumPositionKeys);
+    EXPECT_EQ(11u, a->mAnimations[0]->mChannels[0]->mNumRotationKeys);
+
+    Assimp::Importer reduced;
+    reduced.SetPropertyFloat(AI_CONFIG_IMPORT_FBX_ANIMATION_KEY_TOLERANCE, 1e-3f);
+    const aiScene *b = reduced.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/animation_keys.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, b);
+    ASSERT_EQ(1u, b->mNumAnimations);
+    EXPECT_DOUBLE_EQ(a->mAnimations[0]->mDuration, b->mAnimations[0]->mDuration);
+
+    const aiNodeAnim *na = a->mAnimations[0]->mChannels[0];
+    const aiNodeAnim *nb = b->mAnimations[0]->mChannels[0];
+    ASSERT_EQ(3u, nb->mNumPositionKeys);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(na->mPositionKeys[i * 5].mTime, nb->mPositionKeys[i].mTime);
+        EXPECT_EQ(na->mPositionKeys[i * 5].mValue, nb->mPositionKeys[i].mValue);
+    }
+    ASSERT_EQ(2u, nb->mNumRotationKeys);
+    EXPECT_DOUBLE_EQ(na->mRotationKeys[10].mTime, nb->mRotationKeys[1].mTime);
+    EXPECT_EQ(2u, nb->mNumScalingKeys);
+}
+
+TEST_F(utFBXImporterExporter, importSelectedGeometry) {
+    // without geometry only the node hierarchy remains
+    {
+        Assimp::Importer importer;
+        importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_GEOMETRY, false);
+        const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, scene);
+        EXPECT_EQ(0u, scene->mNumMeshes);
+        EXPECT_NE(0u, scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE);
+        EXPECT_EQ(21u, scene->mRootNode->mNumChildren);
+    }
+
+    // geometry of a single node
+    Assimp::Importer full;
+    const aiScene *reference = full.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, reference);
+    const aiNode *refNode = reference->mRootNode->FindNode("Zahn");
+    ASSERT_NE(nullptr, refNode);
+    ASSERT_NE(0u, refNode->mNumMeshes);
+
+    Assimp::Importer importer;
+    importer.SetPropertyString(AI_CONFIG_IMPORT_FBX_GEOMETRY_ROOT_NODE, "Zahn");
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(refNode->mNumMeshes, scene->mNumMeshes);
+    EXPECT_EQ(21u, scene->mRootNode->mNumChildren);
+    const aiNode *node = scene->mRootNode->FindNode("Zahn");
+    ASSERT_NE(nullptr, node);
+    EXPECT_EQ(refNode->mNumMeshes, node->mNumMeshes);
+    const aiNode *other = scene->mRootNode->FindNode("Kopf");
+    ASSERT_NE(nullptr, other);
+    EXPECT_EQ(0u, other->mNumMeshes);
+}
+
+namespace {
+
+// Converts spider.fbx with the given settings and counts the geometry objects, the ones which
+// have been parsed and the ones whose vertices have been inflated up front by the parser.
+void countParsedGeometry(const FBX::ImportSettings &settings, unsigned int &parsed, unsigned int &inflated,
+        unsigned int &total) {
+    std::ifstream file(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", std::ios::binary);
+    ASSERT_TRUE(file.good());
+    const std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    FBX::TokenArray tokens;
+    FBX::TokenizeBinary(tokens, &contents[0], static_cast<unsigned int>(contents.size()));
+
+    ThreadPool pool(4);
+    FBX::Parser parser(tokens, true, &pool, &settings);
+    FBX::Document doc(parser, settings);
+    aiScene scene;
+    FBX::ConvertToAssimpScene(&scene, doc);
+
+    parsed = inflated = total = 0;
+    for (const FBX::ObjectMap::value_type &v : doc.Objects()) {
+        const FBX::Element &element = v.second->GetElement();
+        const FBX::Token &key = element.KeyToken();
+        if (std::string(key.begin(), key.end()) != "Geometry") {
+            continue;
+        }
+        ++total;
+        parsed += v.second->IsConstructed() ? 1 : 0;
+
+        const FBX::Element *vertices = (*element.Compound())["Vertices"];
+        ASSERT_NE(nullptr, vertices);
+        inflated += parser.GetInflatedData(*vertices->Tokens()[0]) ? 1 : 0;
+    }
+}
+
+} // namespace
+
+TEST_F(utFBXImporterExporter, importSelectedGeometryUnparsed) {
+    // all geometry is read and inflated up front by default
+    unsigned int parsed = 0, inflated = 0, total = 0;
+    {
+        FBX::ImportSettings settings;
+        countParsedGeometry(settings, parsed, inflated, total);
+        EXPECT_LT(1u, total);
+        EXPECT_EQ(total, parsed);
+        EXPECT_EQ(total, inflated);
+    }
+
+    // the geometry of the other nodes is never parsed, nor inflated
+    {
+        FBX::ImportSettings settings;
+        settings.readGeometry = false;
+        countParsedGeometry(settings, parsed, inflated, total);
+        EXPECT_EQ(0u, parsed);
+        EXPECT_EQ(0u, inflated);
+    }
+
+    FBX::ImportSettings settings;
+    settings.geometryRootNode = "Zahn";
+    countParsedGeometry(settings, parsed, inflated, total);
+    EXPECT_EQ(1u, parsed);
+    EXPECT_EQ(0u, inflated);
+}
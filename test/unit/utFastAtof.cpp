@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/fast_atof.h>
+#include <assimp/ParsingUtils.h>
 
 namespace {
 
@@ -188,3 +189,89 @@ TEST_F(FastAtofTest, FastAtof)
 {
     RunTest<ai_real>(FastAtofWrapper());
 }
+
+TEST_F(FastAtofTest, FastAtorealArrayMatchesFastAtorealMove)
+{
+    const std::string numbers = "0 1.354 1054E-3\t-1054E-3\r\n-10.54E30 -345554.54e-5 549067 "
+        "34563.65683598734 0.000001e-301 12.345e19 -.1e+9 .125 1e20 400012 006 5.300 "
+        "3.14159265358979323846264 1,5 7. inf -Inf 0.1234567890123 ";
+
+    std::vector<float> expected;
+    for (const char* c = numbers.c_str(); *c != '\0'; ) {
+        float value;
+        c = Assimp::fast_atoreal_move<float>(c, value);
+        expected.push_back(value);
+        Assimp::SkipSpacesAndLineEnd(&c);
+    }
+
+    std::vector<float> values(expected.size() + 1);
+    size_t parsed = 0;
+    const char* end = numbers.c_str() + numbers.size();
+    EXPECT_EQ(end, Assimp::fast_atoreal_array(numbers.c_str(), end, &values[0], values.size(), &parsed));
+    ASSERT_EQ(expected.size(), parsed);
+    for (size_t i = 0; i < parsed; ++i) {
+        EXPECT_EQ(expected[i], values[i]) << "at index " << i;
+    }
+}
+
+TEST_F(FastAtofTest, FastAtorealArrayStopsAtCountAndEnd)
+{
+    const char numbers[] = "  1.5 2.5 3.5 4.5";
+    double values[4] = { 0.0, 0.0, 0.0, 0.0 };
+    size_t parsed = 0;
+
+    const char* next = Assimp::fast_atoreal_array(numbers, numbers + sizeof(numbers) - 1, values, 2, &parsed);
+    EXPECT_EQ(2u, parsed);
+    EXPECT_EQ(numbers + 10, next);
+
+    // the range ends in the middle of "3.5", nothing behind it must be read
+    Assimp::fast_atoreal_array(next, numbers + 11, values + 2, 2, &parsed);
+    EXPECT_EQ(1u, parsed);
+    EXPECT_EQ(3.0, values[2]);
+}
+
+TEST_F(FastAtofTest, FastAtorealArrayRejectsGarbage)
+{
+    const char numbers[] = "1.0 abc";
+    float values[2];
+    EXPECT_THROW(Assimp::fast_atoreal_array(numbers, numbers + sizeof(numbers) - 1, values, 2), std::invalid_argument);
+}
+
+TEST_F(FastAtofTest, FastAtorealArrayExactIsCorrectlyRounded)
+{
+    const char* numbers[] = {
+        "0.1", "-0.3", "1.354", "123456.789", "3.4028234e38", "1e-45", "0.1000000000000000055511151231257827",
+        "9007199254740993", "16777217", "2.2250738585072014e-308", "4.9406564584124654e-324", "1234567e-20",
+        "79228162514264337593543950335", "0.000123456789", "-45.000001e3"
+    };
+
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); ++i) {
+        const char* str = numbers[i];
+        const char* end = str + ::strlen(str);
+
+        double d = 0.0;
+        Assimp::fast_atoreal_array(str, end, &d, 1, NULL, true);
+        EXPECT_EQ(::strtod(str, NULL), d) << str;
+
+        float f = 0.f;
+        Assimp::fast_atoreal_array(str, end, &f, 1, NULL, true);
+        EXPECT_EQ(::strtof(str, NULL), f) << str;
+    }
+}
+
+TEST_F(FastAtofTest, Strtol10Array)
+{
+    const char numbers[] = "0 1 -1 +42\n123456789 1234567890123 2147483647 -2147483647 7/8 9";
+    int values[16];
+    size_t parsed = 0;
+
+    const char* next = Assimp::strtol10_array(numbers, numbers + sizeof(numbers) - 1, values, 16, &parsed);
+    ASSERT_EQ(8u, parsed);
+    EXPECT_EQ(0, ::strncmp(next, "7/8", 3));
+
+    const char* c = numbers;
+    for (size_t i = 0; i < parsed; ++i) {
+        EXPECT_EQ(Assimp::strtol10(c, &c), values[i]) << "at index " << i;
+        Assimp::SkipSpacesAndLineEnd(&c);
+    }
+}
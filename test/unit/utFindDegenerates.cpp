@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <FindDegenerates.h>
+#include <ThreadPool.h>
+#include <assimp/scene.h>
 
 
 using namespace std;
@@ -146,3 +148,52 @@ TEST_F(FindDegeneratesProcessTest, testDegeneratesRemovalWithAreaCheck) {
 
     EXPECT_EQ(mesh->mNumUVComponents[1]-100, mesh->mNumFaces);
 }
+
+static aiMesh* createTriangleMesh(bool degenerated) {
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 3;
+    mesh->mVertices = new aiVector3D[3];
+    mesh->mVertices[0] = aiVector3D(0.f, 0.f, 0.f);
+    mesh->mVertices[1] = degenerated ? aiVector3D(0.f, 0.f, 0.f) : aiVector3D(1.f, 0.f, 0.f);
+    mesh->mVertices[2] = aiVector3D(0.f, 1.f, 0.f);
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[1];
+    mesh->mFaces[0].mNumIndices = 3;
+    mesh->mFaces[0].mIndices = new unsigned int[3];
+    for (unsigned int i = 0; i < 3; ++i) {
+        mesh->mFaces[0].mIndices[i] = i;
+    }
+    return mesh;
+}
+
+TEST_F(FindDegeneratesProcessTest, testMeshRemovalPerMeshPass) {
+    // meshes full of degenerates are removed after all meshes have been
+    // processed - possibly in parallel - and the node graph is updated
+    aiScene scene;
+    scene.mNumMeshes = 4;
+    scene.mMeshes = new aiMesh*[4];
+    scene.mMeshes[0] = createTriangleMesh(false);
+    scene.mMeshes[1] = createTriangleMesh(true);
+    scene.mMeshes[2] = createTriangleMesh(true);
+    scene.mMeshes[3] = createTriangleMesh(false);
+    scene.mRootNode = new aiNode();
+    scene.mRootNode->mNumMeshes = 4;
+    scene.mRootNode->mMeshes = new unsigned int[4];
+    for (unsigned int i = 0; i < 4; ++i) {
+        scene.mRootNode->mMeshes[i] = i;
+    }
+
+    ASSERT_TRUE(process->IsMeshLocal());
+    ThreadPool pool(2);
+    process->SetThreadPool(&pool);
+    process->EnableAreaCheck(false);
+    process->EnableInstantRemoval(true);
+    process->Execute(&scene);
+
+    ASSERT_EQ(2U, scene.mNumMeshes);
+    EXPECT_EQ(1U, scene.mMeshes[1]->mNumFaces);
+    ASSERT_EQ(2U, scene.mRootNode->mNumMeshes);
+    EXPECT_EQ(0U, scene.mRootNode->mMeshes[0]);
+    EXPECT_EQ(1U, scene.mRootNode->mMeshes[1]);
+}
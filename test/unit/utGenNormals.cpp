@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 #include <GenVertexNormalsProcess.h>
+#include <ThreadPool.h>
 
 using namespace ::std;
 using namespace ::Assimp;
@@ -89,3 +90,126 @@ TEST_F(GenNormalsTest, testSimpleTriangle)
     piProcess->GenMeshVertexNormals(pcMesh, 0);
     EXPECT_TRUE(pcMesh->mNormals != NULL);
 }
+
+namespace {
+
+// Two triangles at a right angle which share vertex 1. Vertex 4 is a copy of vertex 0,
+// as at a uv seam.
+aiMesh* CreateFoldedMesh()
+{
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 5;
+    mesh->mVertices = new aiVector3D[5];
+    mesh->mVertices[0] = aiVector3D(0.0f,0.0f,0.0f);
+    mesh->mVertices[1] = aiVector3D(1.0f,0.0f,0.0f);
+    mesh->mVertices[2] = aiVector3D(0.0f,1.0f,0.0f);
+    mesh->mVertices[3] = aiVector3D(0.0f,0.0f,1.0f);
+    mesh->mVertices[4] = aiVector3D(0.0f,0.0f,0.0f);
+
+    const unsigned int indices[] = { 0, 1, 2, 1, 4, 3 };
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        mesh->mFaces[i].mIndices = new unsigned int[mesh->mFaces[i].mNumIndices = 3];
+        std::copy(indices + i * 3, indices + i * 3 + 3, mesh->mFaces[i].mIndices);
+    }
+    return mesh;
+}
+
+void ExpectNormal(const aiVector3D& expected, const aiVector3D& actual)
+{
+    EXPECT_NEAR(expected.x, actual.x, 1e-5f);
+    EXPECT_NEAR(expected.y, actual.y, 1e-5f);
+    EXPECT_NEAR(expected.z, actual.z, 1e-5f);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSharedVertices)
+{
+    std::unique_ptr<aiMesh> mesh(CreateFoldedMesh());
+    piProcess->GenMeshVertexNormals(mesh.get(), 0);
+    ASSERT_TRUE(mesh->mNormals != NULL);
+
+    // vertices 0 and 4 are smoothed together as well
+    const aiVector3D smooth = aiVector3D(0.0f,1.0f,1.0f).Normalize();
+    ExpectNormal(smooth, mesh->mNormals[0]);
+    ExpectNormal(smooth, mesh->mNormals[1]);
+    ExpectNormal(aiVector3D(0.0f,0.0f,1.0f), mesh->mNormals[2]);
+    ExpectNormal(aiVector3D(0.0f,1.0f,0.0f), mesh->mNormals[3]);
+    ExpectNormal(smooth, mesh->mNormals[4]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSharedVerticesNearlyEqual)
+{
+    // the copy at the seam differs within the position epsilon and by the sign of zero
+    std::unique_ptr<aiMesh> mesh(CreateFoldedMesh());
+    mesh->mVertices[4] = aiVector3D(-0.0f,1e-7f,-0.0f);
+    piProcess->GenMeshVertexNormals(mesh.get(), 0);
+    ASSERT_TRUE(mesh->mNormals != NULL);
+
+    const aiVector3D smooth = aiVector3D(0.0f,1.0f,1.0f).Normalize();
+    ExpectNormal(smooth, mesh->mNormals[0]);
+    ExpectNormal(smooth, mesh->mNormals[4]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSharedVerticesAngleLimit)
+{
+    std::unique_ptr<aiMesh> mesh(CreateFoldedMesh());
+    piProcess->SetMaxSmoothAngle(AI_DEG_TO_RAD(30.f));
+    piProcess->GenMeshVertexNormals(mesh.get(), 0);
+    ASSERT_TRUE(mesh->mNormals != NULL);
+
+    // the copies at the seam keep the normals of their own faces, vertex 1 can't be split
+    ExpectNormal(aiVector3D(0.0f,0.0f,1.0f), mesh->mNormals[0]);
+    ExpectNormal(aiVector3D(0.0f,1.0f,1.0f).Normalize(), mesh->mNormals[1]);
+    ExpectNormal(aiVector3D(0.0f,1.0f,0.0f), mesh->mNormals[4]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSharedVerticesWithThreadPool)
+{
+    // an indexed height field, large enough to be split across the threads
+    const unsigned int size = 150;
+    aiMesh* meshes[2];
+    for (unsigned int m = 0; m < 2; ++m) {
+        aiMesh* mesh = meshes[m] = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = size * size;
+        mesh->mVertices = new aiVector3D[size * size];
+        for (unsigned int y = 0; y < size; ++y) {
+            for (unsigned int x = 0; x < size; ++x) {
+                mesh->mVertices[y * size + x] = aiVector3D((float)x, (float)y, std::sin(x * 0.3f) * std::cos(y * 0.2f));
+            }
+        }
+        mesh->mNumFaces = (size - 1) * (size - 1) * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int y = 0, f = 0; y + 1 < size; ++y) {
+            for (unsigned int x = 0; x + 1 < size; ++x, f += 2) {
+                const unsigned int i = y * size + x;
+                const unsigned int quad[6] = { i, i + 1, i + size + 1, i, i + size + 1, i + size };
+                for (unsigned int t = 0; t < 2; ++t) {
+                    mesh->mFaces[f + t].mIndices = new unsigned int[mesh->mFaces[f + t].mNumIndices = 3];
+                    std::copy(quad + t * 3, quad + t * 3 + 3, mesh->mFaces[f + t].mIndices);
+                }
+            }
+        }
+    }
+
+    piProcess->SetMaxSmoothAngle(AI_DEG_TO_RAD(20.f));
+    piProcess->GenMeshVertexNormals(meshes[0], 0);
+
+    ThreadPool pool(4);
+    piProcess->SetThreadPool(&pool);
+    piProcess->GenMeshVertexNormals(meshes[1], 0);
+
+    for (unsigned int i = 0; i < size * size; ++i) {
+        EXPECT_EQ(meshes[0]->mNormals[i], meshes[1]->mNormals[i]);
+    }
+    delete meshes[0];
+    delete meshes[1];
+}
@@ -0,0 +1,249 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <GenerateLODsProcess.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <set>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+// A flat grid of size x size quads in the xy plane. Vertices with x == seam are
+// duplicated with a different uv, as at a texture seam, unless seam is 0.
+aiMesh* CreateGrid(unsigned int size, unsigned int seam)
+{
+    std::vector<aiVector3D> positions, uvs;
+    std::vector<unsigned int> index((size + 1) * (size + 1)), seamIndex((size + 1) * (size + 1));
+    for (unsigned int y = 0; y <= size; ++y) {
+        for (unsigned int x = 0; x <= size; ++x) {
+            const unsigned int i = y * (size + 1) + x;
+            index[i] = seamIndex[i] = static_cast<unsigned int>(positions.size());
+            positions.push_back(aiVector3D((ai_real)x, (ai_real)y, 0.0));
+            uvs.push_back(aiVector3D((ai_real)x / size, (ai_real)y / size, 0.0));
+            if (seam && x == seam) {
+                seamIndex[i] = static_cast<unsigned int>(positions.size());
+                positions.push_back(positions.back());
+                uvs.push_back(uvs.back() + aiVector3D(1.0, 0.0, 0.0));
+            }
+        }
+    }
+
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = static_cast<unsigned int>(positions.size());
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+    std::copy(positions.begin(), positions.end(), mesh->mVertices);
+    std::copy(uvs.begin(), uvs.end(), mesh->mTextureCoords[0]);
+
+    mesh->mNumFaces = size * size * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            // quads right of the seam use the duplicated vertices
+            const std::vector<unsigned int>& idx = seam && x >= seam ? seamIndex : index;
+            const unsigned int i0 = idx[y * (size + 1) + x], i1 = idx[y * (size + 1) + x + 1];
+            const unsigned int i2 = idx[(y + 1) * (size + 1) + x + 1], i3 = idx[(y + 1) * (size + 1) + x];
+            const unsigned int corners[2][3] = { { i0, i1, i2 }, { i0, i2, i3 } };
+            for (unsigned int t = 0; t < 2; ++t) {
+                aiFace& face = mesh->mFaces[(y * size + x) * 2 + t];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned int[3];
+                std::copy(corners[t], corners[t] + 3, face.mIndices);
+            }
+        }
+    }
+    return mesh;
+}
+
+aiScene* CreateScene(aiMesh* mesh)
+{
+    aiScene* scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = mesh;
+    return scene;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateLODsTest, testLODChain)
+{
+    GenerateLODsProcess process;
+    std::unique_ptr<aiScene> scene(CreateScene(CreateGrid(20, 0)));
+    process.Execute(scene.get());
+
+    ASSERT_TRUE(NULL != scene->mMetaData);
+    int32_t first = 0, count = 0;
+    ASSERT_TRUE(scene->mMetaData->Get("LOD.0.First", first));
+    ASSERT_TRUE(scene->mMetaData->Get("LOD.0.Count", count));
+    EXPECT_EQ(1, first);
+    EXPECT_EQ(AI_LOD_LEVELS, count);
+    ASSERT_EQ(static_cast<unsigned int>(first + count), scene->mNumMeshes);
+
+    unsigned int faces = scene->mMeshes[0]->mNumFaces;
+    for (int32_t i = 0; i < count; ++i) {
+        const aiMesh* lod = scene->mMeshes[first + i];
+        EXPECT_LE(lod->mNumFaces, static_cast<unsigned int>(faces * AI_LOD_RATIO));
+        EXPECT_GT(lod->mNumFaces, 0u);
+        EXPECT_TRUE(lod->HasTextureCoords(0));
+        faces = lod->mNumFaces;
+
+        // the grid is flat, so is the simplified one, and it still faces +z
+        for (unsigned int v = 0; v < lod->mNumVertices; ++v) {
+            EXPECT_EQ(0.0, lod->mVertices[v].z);
+        }
+        for (unsigned int f = 0; f < lod->mNumFaces; ++f) {
+            const unsigned int* idx = lod->mFaces[f].mIndices;
+            const aiVector3D n = (lod->mVertices[idx[1]] - lod->mVertices[idx[0]]) ^ (lod->mVertices[idx[2]] - lod->mVertices[idx[0]]);
+            EXPECT_GT(n.z, 0.0);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateLODsTest, testSeamIsKept)
+{
+    GenerateLODsProcess process;
+    process.SetLevels(1);
+    process.SetRatio(0.25f);
+    std::unique_ptr<aiScene> scene(CreateScene(CreateGrid(20, 10)));
+    process.Execute(scene.get());
+    ASSERT_EQ(2u, scene->mNumMeshes);
+
+    // all vertices on the seam are still there, on both of its sides
+    const aiMesh* lod = scene->mMeshes[1];
+    EXPECT_LT(lod->mNumFaces, scene->mMeshes[0]->mNumFaces);
+    std::set<std::pair<ai_real, ai_real> > seam;
+    for (unsigned int v = 0; v < lod->mNumVertices; ++v) {
+        if (lod->mVertices[v].x == 10.0) {
+            seam.insert(std::make_pair(lod->mVertices[v].y, lod->mTextureCoords[0][v].x));
+        }
+    }
+    EXPECT_EQ(42u, seam.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateLODsTest, testBoneWeights)
+{
+    aiMesh* mesh = CreateGrid(20, 0);
+    mesh->mNumBones = 1;
+    mesh->mBones = new aiBone*[1];
+    mesh->mBones[0] = new aiBone();
+    mesh->mBones[0]->mName.Set("bone");
+    mesh->mBones[0]->mNumWeights = mesh->mNumVertices;
+    mesh->mBones[0]->mWeights = new aiVertexWeight[mesh->mNumVertices];
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        mesh->mBones[0]->mWeights[v] = aiVertexWeight(v, mesh->mVertices[v].x / 20.f);
+    }
+
+    GenerateLODsProcess process;
+    process.SetLevels(1);
+    std::unique_ptr<aiScene> scene(CreateScene(mesh));
+    process.Execute(scene.get());
+    ASSERT_EQ(2u, scene->mNumMeshes);
+
+    // each vertex keeps its weight
+    const aiMesh* lod = scene->mMeshes[1];
+    ASSERT_EQ(1u, lod->mNumBones);
+    EXPECT_EQ(lod->mNumVertices, lod->mBones[0]->mNumWeights);
+    for (unsigned int w = 0; w < lod->mBones[0]->mNumWeights; ++w) {
+        const aiVertexWeight& weight = lod->mBones[0]->mWeights[w];
+        EXPECT_EQ(lod->mVertices[weight.mVertexId].x / 20.f, weight.mWeight);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateLODsTest, testMaxError)
+{
+    // bend the grid, so every collapse has an error
+    aiMesh* mesh = CreateGrid(20, 0);
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        const aiVector3D& p = mesh->mVertices[v];
+        mesh->mVertices[v].z = (p.x * p.x + p.y * p.y) * (ai_real)0.1;
+    }
+
+    GenerateLODsProcess process;
+    process.SetMaxError(1e-5f);
+    std::unique_ptr<aiScene> scene(CreateScene(mesh));
+    process.Execute(scene.get());
+    EXPECT_EQ(1u, scene->mNumMeshes);
+    EXPECT_TRUE(NULL == scene->mMetaData);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateLODsTest, testImport)
+{
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenerateLODs | aiProcess_ValidateDataStructure);
+    ASSERT_TRUE(NULL != scene);
+    ASSERT_TRUE(NULL != scene->mMetaData);
+
+    // every mesh with levels of detail links to meshes with fewer faces
+    unsigned int numLinked = 0;
+    for (unsigned int a = 0; a < scene->mNumMeshes; ++a) {
+        int32_t first = 0, count = 0;
+        const std::string key = "LOD." + std::to_string(a);
+        if (!scene->mMetaData->Get(key + ".First", first)) {
+            continue;
+        }
+        ASSERT_TRUE(scene->mMetaData->Get(key + ".Count", count));
+        ASSERT_LE(static_cast<unsigned int>(first + count), scene->mNumMeshes);
+        unsigned int faces = scene->mMeshes[a]->mNumFaces;
+        for (int32_t i = 0; i < count; ++i) {
+            EXPECT_LT(scene->mMeshes[first + i]->mNumFaces, faces);
+            EXPECT_EQ(scene->mMeshes[a]->mMaterialIndex, scene->mMeshes[first + i]->mMaterialIndex);
+            faces = scene->mMeshes[first + i]->mNumFaces;
+        }
+        numLinked += count;
+    }
+    EXPECT_GT(numLinked, 0u);
+}
@@ -0,0 +1,254 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <GenerateMeshletsProcess.h>
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <set>
+
+using namespace Assimp;
+
+namespace {
+
+// A flat grid of size x size quads in the xy plane, facing +z
+aiMesh* CreateGrid(unsigned int size)
+{
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = (size + 1) * (size + 1);
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int y = 0; y <= size; ++y) {
+        for (unsigned int x = 0; x <= size; ++x) {
+            mesh->mVertices[y * (size + 1) + x] = aiVector3D((ai_real)x, (ai_real)y, 0.0);
+        }
+    }
+
+    mesh->mNumFaces = size * size * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            const unsigned int i0 = y * (size + 1) + x, i1 = i0 + 1;
+            const unsigned int i3 = i0 + size + 1, i2 = i3 + 1;
+            const unsigned int corners[2][3] = { { i0, i1, i2 }, { i0, i2, i3 } };
+            for (unsigned int t = 0; t < 2; ++t) {
+                aiFace& face = mesh->mFaces[(y * size + x) * 2 + t];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned int[3];
+                std::copy(corners[t], corners[t] + 3, face.mIndices);
+            }
+        }
+    }
+    return mesh;
+}
+
+// The faces of a mesh as sorted index triples
+std::multiset<std::vector<unsigned int> > GetFaces(const aiMesh* mesh)
+{
+    std::multiset<std::vector<unsigned int> > faces;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        std::vector<unsigned int> tri(mesh->mFaces[f].mIndices, mesh->mFaces[f].mIndices + 3);
+        std::sort(tri.begin(), tri.end());
+        faces.insert(tri);
+    }
+    return faces;
+}
+
+// Checks the limits of all meshlets and that they cover each face exactly once
+void CheckMeshlets(const aiMesh* mesh, const aiMeshletData* data, unsigned int maxVertices, unsigned int maxTriangles)
+{
+    std::multiset<std::vector<unsigned int> > faces;
+    for (unsigned int i = 0; i < data->mNumMeshlets; ++i) {
+        const aiMeshlet& m = data->mMeshlets[i];
+        EXPECT_GT(m.mNumTriangles, 0u);
+        EXPECT_LE(m.mNumVertices, maxVertices);
+        EXPECT_LE(m.mNumTriangles, maxTriangles);
+        for (unsigned int t = 0; t < m.mNumTriangles; ++t) {
+            std::vector<unsigned int> tri;
+            for (unsigned int c = 0; c < 3; ++c) {
+                const unsigned char l = data->mTriangles[(m.mTriangleOffset + t) * 3 + c];
+                ASSERT_LT(l, m.mNumVertices);
+                tri.push_back(data->mVertices[m.mVertexOffset + l]);
+            }
+            std::sort(tri.begin(), tri.end());
+            faces.insert(tri);
+        }
+
+        // the bounding sphere contains all vertices
+        for (unsigned int v = 0; v < m.mNumVertices; ++v) {
+            const aiVector3D& p = mesh->mVertices[data->mVertices[m.mVertexOffset + v]];
+            EXPECT_LE((p - m.mCenter).Length(), m.mRadius * 1.0001f);
+        }
+    }
+    EXPECT_TRUE(faces == GetFaces(mesh));
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateMeshletsTest, testGrid)
+{
+    std::unique_ptr<aiMesh> mesh(CreateGrid(20));
+    GenerateMeshletsProcess process;
+    std::unique_ptr<aiMeshletData> data(process.GenerateMeshlets(mesh.get()));
+    ASSERT_TRUE(NULL != data.get());
+    EXPECT_EQ(static_cast<unsigned int>(AI_MESHLET_MAX_VERTICES), data->mMaxVertices);
+    EXPECT_EQ(static_cast<unsigned int>(AI_MESHLET_MAX_TRIANGLES), data->mMaxTriangles);
+    EXPECT_EQ(mesh->mNumFaces, data->mNumTriangles);
+    CheckMeshlets(mesh.get(), data.get(), AI_MESHLET_MAX_VERTICES, AI_MESHLET_MAX_TRIANGLES);
+
+    // 800 triangles need at least 7 meshlets, compact clusters shouldn't need many more
+    EXPECT_LE(data->mNumMeshlets, 12u);
+
+    // all faces point to +z, so do the normal cones, which are as narrow as possible
+    for (unsigned int i = 0; i < data->mNumMeshlets; ++i) {
+        const aiMeshlet& m = data->mMeshlets[i];
+        EXPECT_NEAR(1.0, m.mConeAxis.z, 1e-5);
+        EXPECT_NEAR(0.0, m.mConeCutoff, 1e-3);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateMeshletsTest, testSmallLimits)
+{
+    std::unique_ptr<aiMesh> mesh(CreateGrid(10));
+    GenerateMeshletsProcess process;
+    process.SetMaxVertices(4);
+    process.SetMaxTriangles(2);
+    std::unique_ptr<aiMeshletData> data(process.GenerateMeshlets(mesh.get()));
+    ASSERT_TRUE(NULL != data.get());
+    CheckMeshlets(mesh.get(), data.get(), 4, 2);
+
+    // each quad fits a meshlet
+    EXPECT_EQ(100u, data->mNumMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateMeshletsTest, testNormalCone)
+{
+    // a grid folded along x = 5 by 90 degrees, so the face normals are +z and -x
+    std::unique_ptr<aiMesh> mesh(CreateGrid(10));
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        aiVector3D& p = mesh->mVertices[v];
+        if (p.x > 5.0) {
+            p.z = p.x - 5.0f;
+            p.x = 5.0;
+        }
+    }
+    GenerateMeshletsProcess process;
+    process.SetMaxTriangles(256);
+    process.SetMaxVertices(256);
+    std::unique_ptr<aiMeshletData> data(process.GenerateMeshlets(mesh.get()));
+    ASSERT_TRUE(NULL != data.get());
+    ASSERT_EQ(1u, data->mNumMeshlets);
+    CheckMeshlets(mesh.get(), data.get(), 256, 256);
+
+    // the cone axis lies between both normals and the cone spans 90 degrees
+    const aiMeshlet& m = data->mMeshlets[0];
+    EXPECT_NEAR(-std::sqrt(0.5), m.mConeAxis.x, 1e-5);
+    EXPECT_NEAR(std::sqrt(0.5), m.mConeAxis.z, 1e-5);
+    EXPECT_NEAR(std::sqrt(0.5), m.mConeCutoff, 1e-5);
+
+    // seen from behind the fold, the meshlet is backfacing, seen from the front it is not
+    const aiVector3D back(10.0, 5.0, -5.0), front(0.0, 5.0, 10.0);
+    aiVector3D d = m.mConeApex - back;
+    EXPECT_GE(d.Normalize() * m.mConeAxis, m.mConeCutoff);
+    d = m.mConeApex - front;
+    EXPECT_LT(d.Normalize() * m.mConeAxis, m.mConeCutoff);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(GenerateMeshletsTest, testImport)
+{
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_ML_MAX_VERTICES, 32);
+    importer.SetPropertyInteger(AI_CONFIG_PP_ML_MAX_TRIANGLES, 48);
+    importer.SetPropertyBool(AI_CONFIG_PP_ML_ENABLE, true);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality |
+        aiProcess_ValidateDataStructure);
+    ASSERT_TRUE(NULL != scene);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+            continue;
+        }
+        ASSERT_TRUE(mesh->HasMeshlets());
+        CheckMeshlets(mesh, mesh->mMeshlets, 32, 48);
+    }
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+    // the meshlets survive a round trip through assbin
+    Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob(scene, "assbin");
+    ASSERT_TRUE(NULL != blob);
+    Importer reader;
+    const aiScene* copy = reader.ReadFileFromMemory(blob->data, blob->size, aiProcess_ValidateDataStructure, "assbin");
+    ASSERT_TRUE(NULL != copy);
+    ASSERT_EQ(scene->mNumMeshes, copy->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMeshletData* a = scene->mMeshes[i]->mMeshlets;
+        const aiMeshletData* b = copy->mMeshes[i]->mMeshlets;
+        ASSERT_EQ(NULL == a, NULL == b);
+        if (!a) {
+            continue;
+        }
+        EXPECT_EQ(a->mMaxVertices, b->mMaxVertices);
+        EXPECT_EQ(a->mMaxTriangles, b->mMaxTriangles);
+        ASSERT_EQ(a->mNumMeshlets, b->mNumMeshlets);
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumTriangles, b->mNumTriangles);
+        EXPECT_TRUE(std::equal(a->mVertices, a->mVertices + a->mNumVertices, b->mVertices));
+        EXPECT_TRUE(std::equal(a->mTriangles, a->mTriangles + a->mNumTriangles * 3, b->mTriangles));
+        for (unsigned int m = 0; m < a->mNumMeshlets; ++m) {
+            EXPECT_EQ(a->mMeshlets[m].mVertexOffset, b->mMeshlets[m].mVertexOffset);
+            EXPECT_EQ(a->mMeshlets[m].mNumTriangles, b->mMeshlets[m].mNumTriangles);
+            EXPECT_EQ(a->mMeshlets[m].mCenter, b->mMeshlets[m].mCenter);
+            EXPECT_EQ(a->mMeshlets[m].mConeCutoff, b->mMeshlets[m].mConeCutoff);
+        }
+    }
+#endif
+}
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOStreamBuffer.h>
 #include "TestIOStream.h"
 #include "UnitTestFileGenerator.h"
+#include <assimp/MemoryIOWrapper.h>
 
 class IOStreamBufferTest : public ::testing::Test {
     // empty
@@ -144,3 +145,42 @@ TEST_F( IOStreamBufferTest, accessBlockIndexTest ) {
 
 }
 
+TEST_F( IOStreamBufferTest, readFromViewTest ) {
+    // a memory stream exposes its data, lines are served without a copy
+    const char text[] = "first line\nsecond\r\nthird one\n";
+    MemoryIOStream myStream( reinterpret_cast<const uint8_t*>( text ), sizeof( text ) - 1 );
+
+    IOStreamBuffer<char> myBuffer( 16 );
+    EXPECT_TRUE( myBuffer.open( &myStream ) );
+    EXPECT_EQ( 2U, myBuffer.getNumBlocks() );
+
+    std::vector<char> line;
+    const char *expected[] = { "first line", "second", "third one" };
+    for ( const char *exp : expected ) {
+        EXPECT_TRUE( myBuffer.getNextLine( line ) );
+        EXPECT_EQ( std::string( exp ), std::string( &line[ 0 ], strlen( exp ) ) );
+        EXPECT_EQ( '\n', line[ strlen( exp ) ] );
+    }
+    EXPECT_FALSE( myBuffer.getNextLine( line ) );
+    EXPECT_TRUE( myBuffer.close() );
+}
+
+
+TEST_F( IOStreamBufferTest, readUnterminatedDataLineTest ) {
+    // the last data line is returned even though the file does not end with a line end
+    const char text[] = "v 1 2 3\nf 1 \\\n2 3";
+    MemoryIOStream myStream( reinterpret_cast<const uint8_t*>( text ), sizeof( text ) - 1 );
+
+    IOStreamBuffer<char> myBuffer;
+    EXPECT_TRUE( myBuffer.open( &myStream ) );
+
+    std::vector<char> line;
+    const char *expected[] = { "v 1 2 3", "f 1 2 3" };
+    for ( const char *exp : expected ) {
+        EXPECT_TRUE( myBuffer.getNextDataLine( line, '\\' ) );
+        EXPECT_EQ( std::string( exp ), std::string( &line[ 0 ], strlen( exp ) ) );
+        EXPECT_EQ( '\n', line[ strlen( exp ) ] );
+    }
+    EXPECT_FALSE( myBuffer.getNextDataLine( line, '\\' ) );
+    EXPECT_TRUE( myBuffer.close() );
+}
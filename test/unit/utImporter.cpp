@@ -44,10 +44,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../../include/assimp/postprocess.h"
 #include "../../include/assimp/scene.h"
+#include <assimp/config.h>
 #include <assimp/Importer.hpp>
 #include <assimp/BaseImporter.h>
 #include "TestIOSystem.h"
 #include <assimp/DefaultIOSystem.h>
+#include <assimp/Profiler.h>
 
 using namespace ::std;
 using namespace ::Assimp;
@@ -278,3 +280,99 @@ TEST_F( ImporterTest, SearchFileHeaderForTokenTest ) {
     //DefaultIOSystem ioSystem;
 //    BaseImporter::SearchFileHeaderForToken( &ioSystem, assetPath, Token, 2 )
 }
+
+// ------------------------------------------------------------------------------------------------
+static void ExpectEqualMeshes(const aiScene* expected, const aiScene* sc)
+{
+    ASSERT_EQ(expected->mNumMeshes, sc->mNumMeshes);
+    for (unsigned int i = 0; i < sc->mNumMeshes; ++i) {
+        const aiMesh* a = expected->mMeshes[i];
+        const aiMesh* b = sc->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        ASSERT_EQ(a->HasNormals(), b->HasNormals());
+        ASSERT_EQ(a->HasTangentsAndBitangents(), b->HasTangentsAndBitangents());
+        for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+            EXPECT_EQ(a->mVertices[v], b->mVertices[v]);
+            if (a->HasNormals()) {
+                EXPECT_EQ(a->mNormals[v], b->mNormals[v]);
+            }
+            if (a->HasTangentsAndBitangents()) {
+                EXPECT_EQ(a->mTangents[v], b->mTangents[v]);
+            }
+        }
+        for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+            ASSERT_EQ(a->mFaces[f].mNumIndices, b->mFaces[f].mNumIndices);
+            for (unsigned int n = 0; n < a->mFaces[f].mNumIndices; ++n) {
+                EXPECT_EQ(a->mFaces[f].mIndices[n], b->mFaces[f].mIndices[n]);
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testMultithreadedPostProcessing)
+{
+    // Distributing the meshes across threads must not change the results
+    const unsigned int flags = aiProcessPreset_TargetRealtime_MaxQuality;
+
+    Importer serial;
+    const aiScene* expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_TRUE(NULL != expected);
+
+    pImp->SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    const aiScene* sc = pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_TRUE(NULL != sc);
+
+    ExpectEqualMeshes(expected, sc);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testFusedPostProcessing)
+{
+    // Fusing the mesh-local steps into one pass must not change the results.
+    // The extra verbose mode runs every step on its own.
+    const unsigned int flags = aiProcessPreset_TargetRealtime_MaxQuality;
+
+    Importer unfused;
+    unfused.SetExtraVerbose(true);
+    const aiScene* expected = unfused.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_TRUE(NULL != expected);
+
+    const aiScene* sc = pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_TRUE(NULL != sc);
+
+    ExpectEqualMeshes(expected, sc);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testProfilingReport)
+{
+    const unsigned int flags = aiProcess_ValidateDataStructure | aiProcessPreset_TargetRealtime_MaxQuality;
+
+    EXPECT_TRUE(pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags));
+    EXPECT_TRUE(NULL == pImp->GetProfilingReport());
+
+    pImp->SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, true);
+    EXPECT_TRUE(pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags));
+
+    const Profiling::ProfilingReport* report = pImp->GetProfilingReport();
+    ASSERT_TRUE(NULL != report);
+    ASSERT_FALSE(report->regions.empty());
+    EXPECT_EQ("ReadFile", report->regions[0].name);
+    EXPECT_EQ(0U, report->regions[0].depth);
+
+    bool foundStep = false;
+    for (const Profiling::ProfileRegion& r : report->regions) {
+        foundStep = foundStep || std::string::npos != r.name.find("TriangulateProcess");
+    }
+    EXPECT_TRUE(foundStep);
+    EXPECT_GT(report->GetTotalTime("import"), 0.0);
+    EXPECT_GT(report->GetTotalTime("CanRead"), 0.0);
+    EXPECT_GT(report->GetTotalTime("ValidateDS"), 0.0);
+    EXPECT_GT(report->GetTotalTime("ScenePreprocessor"), 0.0);
+
+    // at least spider.obj and its material library
+    EXPECT_GT(report->GetCounter("bytes read"), 0U);
+    EXPECT_LE(2U, report->GetCounter("files opened"));
+}
@@ -41,4 +41,170 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 
-#include "UnitTestPCH.h"
\ No newline at end of file
+#include "UnitTestPCH.h"
+
+#include <ImproveCacheLocality.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <utility>
+
+using namespace Assimp;
+
+namespace {
+
+typedef std::vector<std::pair<aiVector3D, std::pair<aiVector3D, aiVector3D> > > FaceList;
+
+// runs the step on a single mesh, as the mesh pass of the importer would
+void Process(ImproveCacheLocalityProcess& process, aiMesh* pMesh)
+{
+    aiScene scene;
+    scene.mNumMeshes = 1;
+    scene.mMeshes = new aiMesh*[1];
+    scene.mMeshes[0] = pMesh;
+    process.BeginMeshPass(&scene);
+    process.ExecuteOnMesh(pMesh, 0);
+    process.EndMeshPass(&scene);
+
+    // the mesh is owned by the caller
+    scene.mMeshes[0] = NULL;
+}
+
+// A grid of size x size quads, with the faces in a scrambled order
+aiMesh* CreateGrid(unsigned int size)
+{
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = (size + 1) * (size + 1);
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int y = 0; y <= size; ++y) {
+        for (unsigned int x = 0; x <= size; ++x) {
+            mesh->mVertices[y * (size + 1) + x] = aiVector3D((ai_real)x, (ai_real)y, 0.0);
+        }
+    }
+
+    mesh->mNumFaces = size * size * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int q = 0; q < size * size; ++q) {
+        // visit the quads in a fixed pseudo random order
+        const unsigned int s = (q * 7919) % (size * size);
+        const unsigned int x = s % size, y = s / size;
+        const unsigned int i0 = y * (size + 1) + x, i1 = i0 + 1, i2 = i0 + size + 2, i3 = i0 + size + 1;
+        const unsigned int idx[2][3] = { { i0, i1, i2 }, { i0, i2, i3 } };
+        for (unsigned int t = 0; t < 2; ++t) {
+            aiFace& face = mesh->mFaces[q * 2 + t];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            std::copy(idx[t], idx[t] + 3, face.mIndices);
+        }
+    }
+    return mesh;
+}
+
+// the faces as position triples, sorted, to compare meshes regardless of the order
+FaceList GetFaces(const aiMesh* mesh)
+{
+    FaceList faces;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        const unsigned int* idx = mesh->mFaces[f].mIndices;
+        faces.push_back(std::make_pair(mesh->mVertices[idx[0]],
+            std::make_pair(mesh->mVertices[idx[1]], mesh->mVertices[idx[2]])));
+    }
+    std::sort(faces.begin(), faces.end());
+    return faces;
+}
+
+// misses in a FIFO cache of the given size
+unsigned int CountMisses(const aiMesh* mesh, unsigned int cacheSize)
+{
+    std::vector<unsigned int> fifo;
+    unsigned int misses = 0;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int v = mesh->mFaces[f].mIndices[i];
+            if (std::find(fifo.begin(), fifo.end(), v) == fifo.end()) {
+                ++misses;
+                fifo.push_back(v);
+                if (fifo.size() > cacheSize) {
+                    fifo.erase(fifo.begin());
+                }
+            }
+        }
+    }
+    return misses;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST(ImproveCacheLocalityTest, testTipsify)
+{
+    ImproveCacheLocalityProcess process;
+    std::unique_ptr<aiMesh> mesh(CreateGrid(20));
+    const FaceList faces = GetFaces(mesh.get());
+    const unsigned int misses = CountMisses(mesh.get(), PP_ICL_PTCACHE_SIZE);
+
+    Process(process, mesh.get());
+    EXPECT_EQ(faces, GetFaces(mesh.get()));
+    EXPECT_LT(CountMisses(mesh.get(), PP_ICL_PTCACHE_SIZE), misses);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ImproveCacheLocalityTest, testForsyth)
+{
+    ImproveCacheLocalityProcess process;
+    process.SetMethod(AI_ICL_METHOD_FORSYTH);
+    std::unique_ptr<aiMesh> mesh(CreateGrid(20));
+    const FaceList faces = GetFaces(mesh.get());
+    const unsigned int misses = CountMisses(mesh.get(), PP_ICL_PTCACHE_SIZE);
+
+    Process(process, mesh.get());
+    EXPECT_EQ(faces, GetFaces(mesh.get()));
+    EXPECT_LT(CountMisses(mesh.get(), PP_ICL_PTCACHE_SIZE), misses);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ImproveCacheLocalityTest, testOverdraw)
+{
+    ImproveCacheLocalityProcess process;
+    process.SetOverdrawThreshold(1.05f);
+    std::unique_ptr<aiMesh> mesh(CreateGrid(20));
+    const FaceList faces = GetFaces(mesh.get());
+
+    Process(process, mesh.get());
+    EXPECT_EQ(faces, GetFaces(mesh.get()));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ImproveCacheLocalityTest, testVertexFetch)
+{
+    ImproveCacheLocalityProcess process;
+    process.SetVertexFetch(true);
+    std::unique_ptr<aiMesh> mesh(CreateGrid(20));
+    const FaceList faces = GetFaces(mesh.get());
+
+    // the bone weight of a vertex must move with it
+    mesh->mNumBones = 1;
+    mesh->mBones = new aiBone*[1];
+    mesh->mBones[0] = new aiBone();
+    mesh->mBones[0]->mNumWeights = 1;
+    mesh->mBones[0]->mWeights = new aiVertexWeight[1];
+    mesh->mBones[0]->mWeights[0] = aiVertexWeight(5, 1.f);
+    const aiVector3D weighted = mesh->mVertices[5];
+
+    Process(process, mesh.get());
+    EXPECT_EQ(faces, GetFaces(mesh.get()));
+    EXPECT_EQ(weighted, mesh->mVertices[mesh->mBones[0]->mWeights[0].mVertexId]);
+
+    // the faces use the vertices in ascending order
+    unsigned int next = 0;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int v = mesh->mFaces[f].mIndices[i];
+            EXPECT_LE(v, next);
+            if (v == next) {
+                ++next;
+            }
+        }
+    }
+    EXPECT_EQ(mesh->mNumVertices, next);
+}
@@ -43,7 +43,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
 #include <JoinVerticesProcess.h>
+#include <ThreadPool.h>
 
 
 using namespace std;
@@ -143,3 +145,57 @@ TEST_F(JoinVerticesTest, testProcess)
     EXPECT_EQ(150.f*299.f*3.f, fSum); // gaussian sum equation
 }
 
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(JoinVerticesTest, testProcessWithThreadPool)
+{
+    // the vertex queries are batched and run on the pool
+    ThreadPool pool(4);
+    piProcess->SetThreadPool(&pool);
+    piProcess->ProcessMesh(pcMesh,0);
+
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+
+    float fSum = 0.f;
+    for (unsigned int i = 0; i < 300;++i)
+    {
+        aiVector3D& v = pcMesh->mVertices[i];
+        fSum += v.x + v.y + v.z;
+    }
+    EXPECT_EQ(150.f*299.f*3.f, fSum);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(JoinVerticesTest, testProcessExactMatch)
+{
+    // a slightly moved copy is joined by the default epsilon compare only
+    pcMesh->mVertices[300].x += 1e-6f;
+
+    // a bone tells two more copies apart
+    pcMesh->mNumBones = 1;
+    pcMesh->mBones = new aiBone*[1];
+    pcMesh->mBones[0] = new aiBone();
+    pcMesh->mBones[0]->mNumWeights = 1;
+    pcMesh->mBones[0]->mWeights = new aiVertexWeight[1];
+    pcMesh->mBones[0]->mWeights[0] = aiVertexWeight(601, 1.f);
+
+    Importer imp;
+    imp.SetPropertyBool(AI_CONFIG_PP_JIV_EXACT_MATCH, true);
+    piProcess->SetupProperties(&imp);
+    piProcess->ProcessMesh(pcMesh,0);
+
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(302U, pcMesh->mNumVertices);
+
+    // vertices are numbered in order of appearance
+    EXPECT_EQ(pcMesh->mFaces[0].mIndices[0], pcMesh->mFaces[200].mIndices[0]);
+    EXPECT_EQ(300U, pcMesh->mFaces[100].mIndices[0]);
+    EXPECT_EQ(1U, pcMesh->mFaces[100].mIndices[1]);
+    EXPECT_EQ(301U, pcMesh->mFaces[200].mIndices[1]);
+    EXPECT_EQ(pcMesh->mVertices[1], pcMesh->mVertices[301]);
+
+    ASSERT_EQ(1U, pcMesh->mNumBones);
+    ASSERT_EQ(1U, pcMesh->mBones[0]->mNumWeights);
+    EXPECT_EQ(301U, pcMesh->mBones[0]->mWeights[0].mVertexId);
+}
@@ -0,0 +1,162 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Importer.hpp>
+#include <assimp/MMapIOStream.h>
+#include <assimp/MMapIOSystem.h>
+#include <assimp/StreamReader.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utMMapIOSystem : public ::testing::Test {
+    // empty
+};
+
+static const char* TestFile = ASSIMP_TEST_MODELS_DIR "/3DS/RotatingCube.3DS";
+
+// ------------------------------------------------------------------------------------------------
+static std::vector<uint8_t> ReadWithDefaultIOSystem(const char* file) {
+    DefaultIOSystem io;
+    std::unique_ptr<IOStream> stream(io.Open(file, "rb"));
+    std::vector<uint8_t> data(stream->FileSize());
+    EXPECT_EQ(data.size(), stream->Read(&data[0], 1, data.size()));
+    return data;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utMMapIOSystem, viewMatchesFileContents ) {
+    const std::vector<uint8_t> expected = ReadWithDefaultIOSystem(TestFile);
+
+    MMapIOSystem io;
+    IOStream* stream = io.Open(TestFile, "rb");
+    ASSERT_TRUE(NULL != stream);
+    ASSERT_EQ(expected.size(), stream->FileSize());
+
+    size_t len = 0;
+    const uint8_t* view = stream->GetContiguousView(len);
+    ASSERT_TRUE(NULL != view);
+    ASSERT_EQ(expected.size(), len);
+    EXPECT_EQ(0, ::memcmp(&expected[0], view, len));
+
+    // the view doesn't move the cursor, Read() and Seek() work as usual
+    EXPECT_EQ(0U, stream->Tell());
+    uint8_t buffer[16];
+    EXPECT_EQ(16U, stream->Read(buffer, 1, 16));
+    EXPECT_EQ(0, ::memcmp(&expected[0], buffer, 16));
+    EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(4, aiOrigin_END));
+    EXPECT_EQ(expected.size() - 4, stream->Tell());
+    EXPECT_EQ(1U, stream->Read(buffer, 4, 2));
+    EXPECT_EQ(aiReturn_FAILURE, stream->Seek(len + 1, aiOrigin_SET));
+    EXPECT_EQ(0U, stream->Write(buffer, 1, 1));
+
+    io.Close(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utMMapIOSystem, fallbackToDefaultIOSystem ) {
+    MMapIOSystem io;
+    EXPECT_TRUE(NULL == io.Open(ASSIMP_TEST_MODELS_DIR "/does/not/exist.3ds", "rb"));
+
+    // files opened for writing are not mapped
+    IOStream* stream = io.Open("utMMapIOSystem.bin", "wb");
+    ASSERT_TRUE(NULL != stream);
+    EXPECT_EQ(4U, stream->Write("test", 1, 4));
+    size_t len = 0;
+    EXPECT_TRUE(NULL == stream->GetContiguousView(len));
+    EXPECT_EQ(0U, len);
+    io.Close(stream);
+
+    stream = io.Open("utMMapIOSystem.bin", "rb");
+    ASSERT_TRUE(NULL != stream);
+    EXPECT_TRUE(NULL != stream->GetContiguousView(len));
+    EXPECT_EQ(4U, len);
+    io.Close(stream);
+    EXPECT_TRUE(io.DeleteFile("utMMapIOSystem.bin"));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utMMapIOSystem, streamReaderUsesView ) {
+    MMapIOSystem io;
+    IOStream* stream = io.Open(TestFile, "rb");
+    ASSERT_TRUE(NULL != stream);
+    ASSERT_EQ(aiReturn_SUCCESS, stream->Seek(2, aiOrigin_SET));
+
+    size_t len = 0;
+    const uint8_t* view = stream->GetContiguousView(len);
+
+    StreamReaderLE reader(stream);
+    EXPECT_EQ(reinterpret_cast<const int8_t*>(view + 2), reader.GetPtr());
+    EXPECT_EQ(len - 2, reader.GetRemainingSize());
+    EXPECT_EQ(static_cast<uint16_t>(view[2] | (view[3] << 8)), reader.GetU2());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F( utMMapIOSystem, importMatchesDefaultIOSystem ) {
+    Importer reference;
+    const aiScene* expected = reference.ReadFile(TestFile, aiProcess_ValidateDataStructure);
+    ASSERT_TRUE(NULL != expected);
+
+    Importer importer;
+    importer.SetIOHandler(new MMapIOSystem());
+    const aiScene* scene = importer.ReadFile(TestFile, aiProcess_ValidateDataStructure);
+    ASSERT_TRUE(NULL != scene);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        ASSERT_EQ(expected->mMeshes[i]->mNumVertices, scene->mMeshes[i]->mNumVertices);
+        for (unsigned int v = 0; v < scene->mMeshes[i]->mNumVertices; ++v) {
+            EXPECT_EQ(expected->mMeshes[i]->mVertices[v], scene->mMeshes[i]->mVertices[v]);
+        }
+    }
+
+    // text formats go through BaseImporter::TextFileToBuffer
+    EXPECT_TRUE(NULL != importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", aiProcess_ValidateDataStructure));
+    EXPECT_TRUE(NULL != importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure));
+}
@@ -48,6 +48,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Importer.hpp>
 #include <assimp/Exporter.hpp>
 #include <assimp/postprocess.h>
+#include <assimp/config.h>
+#include <sstream>
 
 using namespace Assimp;
 
@@ -396,3 +398,118 @@ TEST_F(utObjImportExport, import_point_cloud) {
     ASSERT_NE(nullptr, scene);
 }
 
+
+static void expectEqualObjScenes(const aiScene *expected, const aiScene *actual) {
+    ASSERT_NE(nullptr, expected);
+    ASSERT_NE(nullptr, actual);
+    ASSERT_EQ(expected->mNumMeshes, actual->mNumMeshes);
+    EXPECT_EQ(expected->mNumMaterials, actual->mNumMaterials);
+    EXPECT_EQ(expected->mRootNode->mNumChildren, actual->mRootNode->mNumChildren);
+    for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = actual->mMeshes[i];
+        EXPECT_STREQ(a->mName.C_Str(), b->mName.C_Str());
+        EXPECT_EQ(a->mMaterialIndex, b->mMaterialIndex);
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        ASSERT_EQ(a->HasNormals(), b->HasNormals());
+        if (a->HasNormals()) {
+            EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+        }
+        ASSERT_EQ(a->HasTextureCoords(0), b->HasTextureCoords(0));
+        if (a->HasTextureCoords(0)) {
+            EXPECT_EQ(0, memcmp(a->mTextureCoords[0], b->mTextureCoords[0], a->mNumVertices * sizeof(aiVector3D)));
+        }
+        ASSERT_EQ(a->HasVertexColors(0), b->HasVertexColors(0));
+        for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+            ASSERT_EQ(a->mFaces[f].mNumIndices, b->mFaces[f].mNumIndices);
+            EXPECT_EQ(0, memcmp(a->mFaces[f].mIndices, b->mFaces[f].mIndices, a->mFaces[f].mNumIndices * sizeof(unsigned int)));
+        }
+    }
+}
+
+TEST_F(utObjImportExport, parallel_import_Test) {
+    static const char *files[] = {
+        "/OBJ/spider.obj",
+        "/OBJ/box.obj",
+        "/OBJ/box_without_lineending.obj",
+        "/OBJ/cube_usemtl.obj",
+        "/OBJ/cube_mtllib_after_g.obj",
+        "/OBJ/cube_with_vertexcolors.obj",
+        "/OBJ/concave_polygon.obj",
+        "/OBJ/number_formats.obj",
+        "/OBJ/regr01.obj",
+        "/OBJ/testmixed.obj",
+        "/OBJ/WusonOBJ.obj"
+    };
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        const std::string file = std::string(ASSIMP_TEST_MODELS_DIR) + files[i];
+        Assimp::Importer serial, parallel;
+        parallel.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+        SCOPED_TRACE(file);
+        expectEqualObjScenes(serial.ReadFile(file, aiProcess_ValidateDataStructure),
+            parallel.ReadFile(file, aiProcess_ValidateDataStructure));
+    }
+}
+
+TEST_F(utObjImportExport, parallel_import_chunks_Test) {
+    // large enough to be split into several chunks, with state changes,
+    // relative indices and continued lines spread over all of them
+    std::stringstream stream;
+    stream << "mtllib nonexistent.mtl\n";
+    for (int g = 0; g < 400; ++g) {
+        stream << "g group" << (g % 7) << "\r\n";
+        stream << "usemtl mat" << (g % 3) << "\n";
+        for (int v = 0; v < 60; ++v) {
+            stream << "v " << g << ".5 " << v << " -" << v * 0.25 << "\n";
+            stream << "vt 0." << v << " 0.5\n";
+            stream << "vn 0 0 1\n";
+        }
+        stream << "s 1\n";
+        for (int f = 0; f < 20; ++f) {
+            const int a = (g * 60) + 3 * f + 1;
+            if (f % 2) {
+                stream << "f " << a << "/" << a << "/" << a << " " << a + 1 << "/" << a + 1 << "/" << a + 1
+                       << " \\\n" << a + 2 << "/" << a + 2 << "/" << a + 2 << "\n";
+            } else {
+                stream << "f " << (a - (g + 1) * 60 - 1) << "//" << (a - (g + 1) * 60 - 1) << " -2//-2 -3//-3\n";
+            }
+        }
+        stream << "# comment " << g << "\n";
+    }
+    stream << "l 1 2 3\np 4";
+    const std::string model = stream.str();
+    ASSERT_GT(model.size(), 256u * 1024u);
+
+    Assimp::Importer serial, parallel;
+    parallel.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    expectEqualObjScenes(serial.ReadFileFromMemory(model.c_str(), model.size(), aiProcess_ValidateDataStructure, "obj"),
+        parallel.ReadFileFromMemory(model.c_str(), model.size(), aiProcess_ValidateDataStructure, "obj"));
+}
+
+TEST_F(utObjImportExport, parallel_import_normals_without_texcoords_Test) {
+    // with normals but no texture coordinates, f 1/1 refers to a normal
+    std::stringstream stream;
+    for (int g = 0; g < 300; ++g) {
+        for (int v = 0; v < 60; ++v) {
+            stream << "v " << g << ".5 " << v << " -" << v * 0.25 << "\n";
+            stream << "vn 0 " << (v % 2) << " " << ((v + 1) % 2) << "\n";
+        }
+        for (int f = 0; f < 20; ++f) {
+            const int a = (g * 60) + 3 * f + 1;
+            stream << "f " << a << "/" << a << " " << a + 1 << "/" << a + 1 << " -1/-1\n";
+        }
+    }
+    const std::string model = stream.str();
+    ASSERT_GT(model.size(), 256u * 1024u);
+
+    Assimp::Importer serial, parallel;
+    parallel.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    const aiScene *expected = serial.ReadFileFromMemory(model.c_str(), model.size(), aiProcess_ValidateDataStructure, "obj");
+    const aiScene *actual = parallel.ReadFileFromMemory(model.c_str(), model.size(), aiProcess_ValidateDataStructure, "obj");
+    expectEqualObjScenes(expected, actual);
+    ASSERT_NE(nullptr, actual);
+    ASSERT_EQ(1u, actual->mNumMeshes);
+    EXPECT_TRUE(actual->mMeshes[0]->HasNormals());
+    EXPECT_FALSE(actual->mMeshes[0]->HasTextureCoords(0));
+}
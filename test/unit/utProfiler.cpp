@@ -45,6 +45,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Profiler.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <thread>
+
 using namespace ::Assimp;
 using namespace ::Assimp::Profiling;
 
@@ -75,3 +77,67 @@ TEST_F( utProfiler, addRegion_success ) {
     //UTLogStream *stream( (UTLogStream*) m_stream );
     //EXPECT_FALSE( stream->m_messages.empty() );
 }
+
+TEST_F( utProfiler, nestedRegions_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "outer" );
+    myProfiler.BeginRegion( "inner" );
+    myProfiler.EndRegion( "inner" );
+    myProfiler.BeginRegion( "inner" );
+    myProfiler.EndRegion( "inner" );
+    myProfiler.EndRegion( "outer" );
+
+    // ending an unknown region is ignored
+    myProfiler.EndRegion( "unknown" );
+
+    ProfilingReport report;
+    myProfiler.GetReport( report );
+    ASSERT_EQ( 3U, report.regions.size() );
+    EXPECT_EQ( "outer", report.regions[ 0 ].name );
+    EXPECT_EQ( 0U, report.regions[ 0 ].depth );
+    EXPECT_EQ( "inner", report.regions[ 1 ].name );
+    EXPECT_EQ( 1U, report.regions[ 1 ].depth );
+    EXPECT_LE( report.regions[ 0 ].start, report.regions[ 1 ].start );
+    EXPECT_LE( report.regions[ 2 ].start + report.regions[ 2 ].duration,
+        report.regions[ 0 ].start + report.regions[ 0 ].duration );
+    EXPECT_GE( report.regions[ 0 ].duration, report.GetTotalTime( "inner" ) );
+}
+
+TEST_F( utProfiler, threadBuffers_success ) {
+    Profiler myProfiler;
+    {
+        ScopedRegion region( &myProfiler, "main" );
+        std::thread worker( [ &myProfiler ]() {
+            ScopedRegion region( &myProfiler, "worker" );
+        } );
+        worker.join();
+    }
+    myProfiler.AddCounter( "bytes", 10 );
+    myProfiler.AddCounter( "bytes", 5 );
+
+    ProfilingReport report;
+    myProfiler.GetReport( report );
+    ASSERT_EQ( 2U, report.regions.size() );
+    EXPECT_EQ( "main", report.regions[ 0 ].name );
+    EXPECT_EQ( 0U, report.regions[ 0 ].thread );
+    EXPECT_EQ( "worker", report.regions[ 1 ].name );
+    EXPECT_EQ( 1U, report.regions[ 1 ].thread );
+    EXPECT_EQ( 0U, report.regions[ 1 ].depth );
+    EXPECT_EQ( 15U, report.GetCounter( "bytes" ) );
+    EXPECT_EQ( 0U, report.GetCounter( "unknown" ) );
+}
+
+TEST_F( utProfiler, chromeTrace_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "a \"quoted\" region" );
+    myProfiler.EndRegion( "a \"quoted\" region" );
+    myProfiler.AddCounter( "bytes read", 42 );
+
+    ProfilingReport report;
+    myProfiler.GetReport( report );
+    const std::string trace = report.ToChromeTrace();
+    EXPECT_EQ( 0U, trace.find( "{\"traceEvents\":[" ) );
+    EXPECT_NE( std::string::npos, trace.find( "\"name\":\"a \\\"quoted\\\" region\"" ) );
+    EXPECT_NE( std::string::npos, trace.find( "\"ph\":\"X\"" ) );
+    EXPECT_NE( std::string::npos, trace.find( "\"args\":{\"value\":42}" ) );
+}
@@ -0,0 +1,237 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <QuantizeVerticesProcess.h>
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+// A mesh with all components quantized by the step. The first texture
+// coordinate channel is inside [0, 1], the second one is not.
+aiMesh* CreateMesh()
+{
+    const unsigned int num = 100;
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = num;
+    mesh->mVertices = new aiVector3D[num];
+    mesh->mNormals = new aiVector3D[num];
+    mesh->mTangents = new aiVector3D[num];
+    mesh->mBitangents = new aiVector3D[num];
+    mesh->mTextureCoords[0] = new aiVector3D[num];
+    mesh->mTextureCoords[1] = new aiVector3D[num];
+    mesh->mNumUVComponents[0] = mesh->mNumUVComponents[1] = 2;
+    mesh->mColors[0] = new aiColor4D[num];
+    for (unsigned int i = 0; i < num; ++i) {
+        const ai_real a = i * 0.37f, b = i * 0.11f;
+        mesh->mVertices[i] = aiVector3D(std::sin(a) * 10 - 3, std::cos(b) * 2 + 5, i * 0.25f);
+        mesh->mNormals[i] = aiVector3D(std::cos(a) * std::cos(b), std::sin(a) * std::cos(b), std::sin(b));
+
+        // any vector orthogonal to the normal
+        aiVector3D t = mesh->mNormals[i] ^ aiVector3D(0.3f, 0.5f, 0.8f);
+        mesh->mTangents[i] = t.Normalize();
+        mesh->mBitangents[i] = (mesh->mNormals[i] ^ mesh->mTangents[i]) * (i % 2 ? -1.0f : 1.0f);
+
+        mesh->mTextureCoords[0][i] = aiVector3D(i / 99.0f, 1 - i / 99.0f, 0);
+        mesh->mTextureCoords[1][i] = aiVector3D(i * 0.5f - 20, std::sin(a) * 3, 0);
+        mesh->mColors[0][i] = aiColor4D(i / 99.0f, 0.5f, 1, 0.25f);
+    }
+
+    mesh->mNumFaces = num - 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiFace& face = mesh->mFaces[f];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        face.mIndices[0] = f;
+        face.mIndices[1] = f + 1;
+        face.mIndices[2] = f + 2;
+    }
+    return mesh;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST(QuantizeVerticesTest, testErrorBounds)
+{
+    std::unique_ptr<aiMesh> mesh(CreateMesh());
+    QuantizeVerticesProcess process;
+    process.SetComponents(aiQuantizedComponent_POSITIONS | aiQuantizedComponent_NORMALS |
+        aiQuantizedComponent_TANGENTS | aiQuantizedComponent_TEXCOORDS | aiQuantizedComponent_COLORS);
+    std::unique_ptr<aiQuantizedMesh> q(process.QuantizeMesh(mesh.get()));
+    ASSERT_TRUE(NULL != q.get());
+    ASSERT_EQ(mesh->mNumVertices, q->mNumVertices);
+    ASSERT_TRUE(NULL != q->mPositions);
+    ASSERT_TRUE(NULL != q->mNormals);
+    ASSERT_TRUE(NULL != q->mTangents);
+    ASSERT_TRUE(NULL != q->mTextureCoords[0]);
+    ASSERT_TRUE(NULL != q->mTextureCoords[1]);
+    ASSERT_TRUE(NULL != q->mColors[0]);
+
+    // the largest extent is 24.75 along z, one step is 1/65535 of it
+    const ai_real posError = 24.75f / 65535 * 0.51f;
+
+    // the unit range channel needs no dequantization parameters
+    EXPECT_EQ(aiVector2D(), q->mTexCoordOffset[0]);
+    EXPECT_EQ(aiVector2D(1, 1), q->mTexCoordScale[0]);
+    EXPECT_NE(aiVector2D(1, 1), q->mTexCoordScale[1]);
+
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        const aiVector3D p = q->GetPosition(i);
+        EXPECT_NEAR(mesh->mVertices[i].x, p.x, posError);
+        EXPECT_NEAR(mesh->mVertices[i].y, p.y, posError);
+        EXPECT_NEAR(mesh->mVertices[i].z, p.z, posError);
+
+        // 16 bit octahedral encoding is good for much better than 0.01 degrees
+        EXPECT_GT(q->GetNormal(i) * mesh->mNormals[i], 0.99999f);
+
+        ai_real handedness;
+        EXPECT_GT(q->GetTangent(i, handedness) * mesh->mTangents[i], 0.99999f);
+        EXPECT_EQ(i % 2 ? -1.0f : 1.0f, handedness);
+
+        const aiVector3D uv0 = q->GetTextureCoords(0, i), uv1 = q->GetTextureCoords(1, i);
+        EXPECT_NEAR(mesh->mTextureCoords[0][i].x, uv0.x, 1e-5);
+        EXPECT_NEAR(mesh->mTextureCoords[0][i].y, uv0.y, 1e-5);
+        EXPECT_NEAR(mesh->mTextureCoords[1][i].x, uv1.x, 50.0 / 65535);
+        EXPECT_NEAR(mesh->mTextureCoords[1][i].y, uv1.y, 6.0 / 65535);
+
+        const aiColor4D c = q->GetColor(0, i);
+        EXPECT_NEAR(mesh->mColors[0][i].r, c.r, 0.5 / 255 + 1e-6);
+        EXPECT_NEAR(mesh->mColors[0][i].a, c.a, 0.5 / 255 + 1e-6);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(QuantizeVerticesTest, testComponents)
+{
+    std::unique_ptr<aiMesh> mesh(CreateMesh());
+    QuantizeVerticesProcess process;
+    process.SetComponents(aiQuantizedComponent_NORMALS | aiQuantizedComponent_COLORS);
+    std::unique_ptr<aiQuantizedMesh> q(process.QuantizeMesh(mesh.get()));
+    ASSERT_TRUE(NULL != q.get());
+    EXPECT_TRUE(NULL == q->mPositions);
+    EXPECT_TRUE(NULL != q->mNormals);
+    EXPECT_TRUE(NULL == q->mTangents);
+    EXPECT_TRUE(NULL == q->mTextureCoords[0]);
+    EXPECT_TRUE(NULL != q->mColors[0]);
+
+    // nothing to quantize
+    process.SetComponents(0);
+    EXPECT_TRUE(NULL == process.QuantizeMesh(mesh.get()));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(QuantizeVerticesTest, testImport)
+{
+    // without the property the step doesn't run
+    {
+        Importer importer;
+        const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+        ASSERT_TRUE(NULL != scene);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            EXPECT_FALSE(scene->mMeshes[i]->HasQuantizedData());
+        }
+    }
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_QV_COMPONENTS, aiQuantizedComponent_POSITIONS |
+        aiQuantizedComponent_NORMALS | aiQuantizedComponent_TEXCOORDS);
+    importer.SetPropertyBool(AI_CONFIG_PP_QV_DROP_FLOATS, true);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_ValidateDataStructure);
+    ASSERT_TRUE(NULL != scene);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        ASSERT_TRUE(mesh->HasQuantizedData());
+        EXPECT_TRUE(NULL != mesh->mQuantized->mPositions);
+
+        // positions stay, the other quantized components are released
+        EXPECT_TRUE(mesh->HasPositions());
+        EXPECT_EQ(NULL != mesh->mQuantized->mNormals, !mesh->HasNormals());
+        EXPECT_EQ(NULL != mesh->mQuantized->mTextureCoords[0], !mesh->HasTextureCoords(0));
+    }
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+    // the quantized components survive a round trip through assbin
+    Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob(scene, "assbin");
+    ASSERT_TRUE(NULL != blob);
+    Importer reader;
+    const aiScene* copy = reader.ReadFileFromMemory(blob->data, blob->size, aiProcess_ValidateDataStructure, "assbin");
+    ASSERT_TRUE(NULL != copy);
+    ASSERT_EQ(scene->mNumMeshes, copy->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiQuantizedMesh* a = scene->mMeshes[i]->mQuantized;
+        const aiQuantizedMesh* b = copy->mMeshes[i]->mQuantized;
+        ASSERT_TRUE(NULL != b);
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        EXPECT_EQ(a->mPositionTransform, b->mPositionTransform);
+        EXPECT_TRUE(std::equal(a->mPositions, a->mPositions + a->mNumVertices * 3, b->mPositions));
+        ASSERT_EQ(NULL == a->mNormals, NULL == b->mNormals);
+        if (a->mNormals) {
+            EXPECT_TRUE(std::equal(a->mNormals, a->mNormals + a->mNumVertices * 2, b->mNormals));
+        }
+        ASSERT_EQ(NULL == a->mTextureCoords[0], NULL == b->mTextureCoords[0]);
+        if (a->mTextureCoords[0]) {
+            EXPECT_EQ(a->mTexCoordOffset[0], b->mTexCoordOffset[0]);
+            EXPECT_EQ(a->mTexCoordScale[0], b->mTexCoordScale[0]);
+            EXPECT_TRUE(std::equal(a->mTextureCoords[0], a->mTextureCoords[0] + a->mNumVertices * 2, b->mTextureCoords[0]));
+        }
+    }
+
+    // glTF 2 writes the quantized components with KHR_mesh_quantization
+    blob = exporter.ExportToBlob(scene, "glb2");
+    ASSERT_TRUE(NULL != blob);
+    const std::string glb(static_cast<const char*>(blob->data), blob->size);
+    EXPECT_NE(std::string::npos, glb.find("\"extensionsRequired\":[\"KHR_mesh_quantization\"]"));
+    EXPECT_NE(std::string::npos, glb.find("\"normalized\":true"));
+#endif
+}
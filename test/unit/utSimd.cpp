@@ -60,3 +60,101 @@ TEST_F( utSimd, SSE2SupportedTest ) {
         std::cout << "Not supported" << std::endl;
     }
 }
+
+namespace {
+
+// some vectors which aren't a multiple of the block size long
+std::vector<aiVector3D> MakeVectors() {
+    std::vector<aiVector3D> vectors;
+    for ( unsigned int i = 0; i < 103; ++i ) {
+        vectors.push_back( aiVector3D( i * 0.37f - 12.f, 1.f / ( i + 1 ), ( i % 7 ) * -2.5f + 0.1f ) );
+    }
+    return vectors;
+}
+
+aiMatrix4x4 MakeTransform() {
+    aiMatrix4x4 scaling, rotation, translation;
+    aiMatrix4x4::Scaling( aiVector3D( 2.f, 0.5f, -3.f ), scaling );
+    aiMatrix4x4::Rotation( 0.7f, aiVector3D( 1.f, 2.f, 3.f ).Normalize(), rotation );
+    aiMatrix4x4::Translation( aiVector3D( 4.f, -5.f, 6.f ), translation );
+    return translation * rotation * scaling;
+}
+
+} // namespace
+
+TEST_F( utSimd, TransformPositionsTest ) {
+    const aiMatrix4x4 mat = MakeTransform();
+    std::vector<aiVector3D> vectors = MakeVectors();
+    const std::vector<aiVector3D> in = vectors;
+
+    // in place
+    TransformPositions( mat, &vectors[ 0 ], &vectors[ 0 ], vectors.size() );
+    for ( size_t i = 0; i < in.size(); ++i ) {
+        const aiVector3D expected = mat * in[ i ];
+        EXPECT_EQ( expected, vectors[ i ] );
+    }
+}
+
+TEST_F( utSimd, TransformNormalsTest ) {
+    const aiMatrix4x4 mat = MakeTransform();
+    const std::vector<aiVector3D> in = MakeVectors();
+    std::vector<aiVector3D> out( in.size() );
+    TransformNormals( mat, &in[ 0 ], &out[ 0 ], in.size() );
+
+    aiMatrix4x4 mWorldIT = mat;
+    mWorldIT.Inverse().Transpose();
+    const aiMatrix3x3 m = aiMatrix3x3( mWorldIT );
+    for ( size_t i = 0; i < in.size(); ++i ) {
+        const aiVector3D expected = ( m * in[ i ] ).Normalize();
+        EXPECT_EQ( expected, out[ i ] );
+    }
+
+    // without normalization
+    TransformDirections( m, &in[ 0 ], &out[ 0 ], in.size() );
+    for ( size_t i = 0; i < in.size(); ++i ) {
+        const aiVector3D expected = m * in[ i ];
+        EXPECT_EQ( expected, out[ i ] );
+    }
+}
+
+TEST_F( utSimd, ComputeTriangleNormalsTest ) {
+    std::vector<aiVector3D> v0 = MakeVectors(), v1 = v0, v2 = v0;
+    std::rotate( v1.begin(), v1.begin() + 1, v1.end() );
+    std::rotate( v2.begin(), v2.begin() + 5, v2.end() );
+
+    // a degenerate triangle, its normal is left at zero
+    v1[ 2 ] = v2[ 2 ] = v0[ 2 ];
+
+    std::vector<aiVector3D> out( v0.size() );
+    ComputeTriangleNormals( &v0[ 0 ], &v1[ 0 ], &v2[ 0 ], &out[ 0 ], v0.size() );
+    for ( size_t i = 0; i < v0.size(); ++i ) {
+        const aiVector3D expected = ( ( v1[ i ] - v0[ i ] ) ^ ( v2[ i ] - v0[ i ] ) ).NormalizeSafe();
+        EXPECT_EQ( expected, out[ i ] );
+    }
+    EXPECT_EQ( aiVector3D(), out[ 2 ] );
+
+    // normalize in place
+    NormalizeVectors( &v0[ 0 ], &v0[ 0 ], v0.size() );
+    for ( size_t i = 0; i < v0.size(); ++i ) {
+        EXPECT_EQ( MakeVectors()[ i ].NormalizeSafe(), v0[ i ] );
+    }
+}
+
+TEST_F( utSimd, InterpolateLinearTest ) {
+    std::vector<ai_real> a, b, t, span;
+    for ( unsigned int i = 0; i < 103; ++i ) {
+        a.push_back( i * 0.37f - 12.f );
+        b.push_back( ( i % 7 ) * -2.5f + 0.1f );
+        t.push_back( static_cast<ai_real>( i % 5 ) );
+        // some empty spans, which take the first value
+        span.push_back( static_cast<ai_real>( i % 3 ) * 3.f );
+    }
+
+    std::vector<ai_real> out( a.size() );
+    InterpolateLinear( &a[ 0 ], &b[ 0 ], &t[ 0 ], &span[ 0 ], &out[ 0 ], a.size() );
+    for ( size_t i = 0; i < a.size(); ++i ) {
+        const ai_real factor = span[ i ] != 0 ? t[ i ] / span[ i ] : ai_real( 0. );
+        EXPECT_EQ( a[ i ] + ( b[ i ] - a[ i ] ) * factor, out[ i ] );
+    }
+    EXPECT_EQ( a[ 0 ], out[ 0 ] );
+}
@@ -0,0 +1,196 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include <assimp/SpatialSort.h>
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+using namespace ::Assimp;
+
+class utSpatialSort : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // A flat 64x64 grid, every position three times - the worst case for sorting by
+        // distance to a plane - plus a few vertices off the plane.
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                for (int copy = 0; copy < 3; ++copy) {
+                    positions.push_back(aiVector3D(x * 0.5f, y * 0.5f, 0.f));
+                }
+            }
+        }
+        for (int i = 0; i < 100; ++i) {
+            positions.push_back(aiVector3D(i * 0.37f, 3.f - i * 0.11f, i * 0.05f));
+        }
+    }
+
+    void Fill(SpatialSort& sort, SpatialSort::Method method) {
+        sort.SetMethod(method);
+        sort.Fill(&positions[0], static_cast<unsigned int>(positions.size()), sizeof(aiVector3D));
+    }
+
+    std::vector<aiVector3D> positions;
+};
+
+TEST_F(utSpatialSort, DefaultMethodIsPlaneSort) {
+    SpatialSort sort;
+    EXPECT_EQ(SpatialSort::Method_PlaneSort, sort.GetMethod());
+}
+
+TEST_F(utSpatialSort, HashGridFindsTheSamePositions) {
+    SpatialSort planeSort, hashGrid;
+    Fill(planeSort, SpatialSort::Method_PlaneSort);
+    Fill(hashGrid, SpatialSort::Method_HashGrid);
+
+    std::vector<unsigned int> expected, found;
+    const ai_real radii[] = { ai_real(1e-5), ai_real(0.6), ai_real(4.0), ai_real(100.0) };
+    for (size_t r = 0; r < sizeof(radii) / sizeof(radii[0]); ++r) {
+        for (size_t i = 0; i < positions.size(); i += 7) {
+            planeSort.FindPositions(positions[i], radii[r], expected);
+            hashGrid.FindPositions(positions[i], radii[r], found);
+            std::sort(expected.begin(), expected.end());
+            std::sort(found.begin(), found.end());
+            ASSERT_EQ(expected, found) << "vertex " << i << ", radius " << radii[r];
+        }
+    }
+
+    for (size_t i = 0; i < positions.size(); i += 5) {
+        planeSort.FindIdenticalPositions(positions[i], expected);
+        hashGrid.FindIdenticalPositions(positions[i], found);
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        ASSERT_EQ(expected, found) << "vertex " << i;
+    }
+
+    // outside of the bounding box
+    hashGrid.FindPositions(aiVector3D(-10.f, 0.f, 0.f), ai_real(1.0), found);
+    EXPECT_TRUE(found.empty());
+}
+
+TEST_F(utSpatialSort, HashGridMappingTable) {
+    SpatialSort planeSort, hashGrid;
+    Fill(planeSort, SpatialSort::Method_PlaneSort);
+    Fill(hashGrid, SpatialSort::Method_HashGrid);
+
+    std::vector<unsigned int> expected, mapping;
+    const unsigned int numExpected = planeSort.GenerateMappingTable(expected, ai_real(1e-4));
+    const unsigned int num = hashGrid.GenerateMappingTable(mapping, ai_real(1e-4));
+    // the first vertex off the plane coincides with a grid position
+    EXPECT_EQ(64u * 64u + 99u, num);
+    EXPECT_EQ(numExpected, num);
+
+    // the copies of a grid position share their output index
+    ASSERT_EQ(positions.size(), mapping.size());
+    for (size_t i = 0; i < 64 * 64 * 3; i += 3) {
+        EXPECT_EQ(mapping[i], mapping[i + 1]);
+        EXPECT_EQ(mapping[i], mapping[i + 2]);
+        EXPECT_GT(num, mapping[i]);
+    }
+}
+
+TEST_F(utSpatialSort, HashGridIdenticalPositions) {
+    const aiVector3D same[] = { aiVector3D(1.f, 2.f, 3.f), aiVector3D(1.f, 2.f, 3.f), aiVector3D(1.f, 2.f, 3.f) };
+    SpatialSort hashGrid;
+    hashGrid.SetMethod(SpatialSort::Method_HashGrid);
+    hashGrid.Fill(same, 3, sizeof(aiVector3D));
+
+    std::vector<unsigned int> found;
+    hashGrid.FindPositions(same[0], ai_real(1e-5), found);
+    EXPECT_EQ(3u, found.size());
+
+    std::vector<unsigned int> mapping;
+    EXPECT_EQ(1u, hashGrid.GenerateMappingTable(mapping, ai_real(1e-5)));
+}
+
+TEST_F(utSpatialSort, ParallelFinalizeMatchesSerial) {
+    // large enough to be sorted in several chunks, with many equal plane distances
+    std::vector<aiVector3D> many;
+    for (int i = 0; i < 100000; ++i) {
+        many.push_back(aiVector3D(float(i % 97), float(i % 89), float(i % 83)));
+    }
+
+    SpatialSort serial, parallel;
+    serial.Fill(&many[0], static_cast<unsigned int>(many.size()), sizeof(aiVector3D));
+
+    ThreadPool pool(4);
+    parallel.Fill(&many[0], static_cast<unsigned int>(many.size()), sizeof(aiVector3D), false);
+    parallel.Finalize(&pool);
+
+    // the result order reflects the order of the entries
+    std::vector<unsigned int> expected, found;
+    for (size_t i = 0; i < many.size(); i += 997) {
+        serial.FindPositions(many[i], ai_real(1.5), expected);
+        parallel.FindPositions(many[i], ai_real(1.5), found);
+        ASSERT_EQ(expected, found) << "vertex " << i;
+    }
+}
+
+TEST_F(utSpatialSort, FindAllPositions) {
+    ThreadPool pool(4);
+    const SpatialSort::Method methods[] = { SpatialSort::Method_PlaneSort, SpatialSort::Method_HashGrid };
+    for (size_t m = 0; m < 2; ++m) {
+        SpatialSort sort;
+        Fill(sort, methods[m]);
+
+        std::vector<unsigned int> offsets, table, serialOffsets, serialTable, expected;
+        sort.FindAllPositions(ai_real(0.6), offsets, table, &pool);
+        sort.FindAllPositions(ai_real(0.6), serialOffsets, serialTable);
+        EXPECT_EQ(serialOffsets, offsets);
+        EXPECT_EQ(serialTable, table);
+
+        ASSERT_EQ(positions.size() + 1, offsets.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            sort.FindPositions(positions[i], ai_real(0.6), expected);
+            ASSERT_EQ(expected, std::vector<unsigned int>(table.begin() + offsets[i], table.begin() + offsets[i + 1]))
+                << "vertex " << i;
+        }
+
+        sort.FindAllIdenticalPositions(offsets, table, &pool);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            sort.FindIdenticalPositions(positions[i], expected);
+            ASSERT_EQ(expected, std::vector<unsigned int>(table.begin() + offsets[i], table.begin() + offsets[i + 1]))
+                << "vertex " << i;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2018, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace ::Assimp;
+
+class utThreadPool : public ::testing::Test {
+    // empty
+};
+
+TEST_F( utThreadPool, numThreads ) {
+    ThreadPool single( 1 );
+    EXPECT_EQ( 1U, single.GetNumThreads() );
+
+    ThreadPool four( 4 );
+    EXPECT_EQ( 4U, four.GetNumThreads() );
+
+    ThreadPool hw( 0 );
+    EXPECT_EQ( ThreadPool::GetHardwareConcurrency(), hw.GetNumThreads() );
+}
+
+TEST_F( utThreadPool, parallelForVisitsEachIndexOnce ) {
+    ThreadPool pool( 4 );
+    std::vector<std::atomic<int>> visits( 1000 );
+    for ( auto &v : visits ) {
+        v = 0;
+    }
+
+    // run several jobs in a row to make sure the workers pick up each of them
+    for ( int run = 0; run < 10; ++run ) {
+        pool.ParallelFor( 0, 1000, [&visits]( unsigned int i ) {
+            ++visits[ i ];
+        } );
+    }
+    for ( auto &v : visits ) {
+        EXPECT_EQ( 10, v );
+    }
+}
+
+TEST_F( utThreadPool, emptyRange ) {
+    ThreadPool pool( 2 );
+    int calls = 0;
+    pool.ParallelFor( 5, 5, [&calls]( unsigned int ) { ++calls; } );
+    EXPECT_EQ( 0, calls );
+}
+
+TEST_F( utThreadPool, nestedParallelFor ) {
+    ThreadPool pool( 3 );
+    std::atomic<int> sum( 0 );
+    pool.ParallelFor( 0, 8, [&pool, &sum]( unsigned int ) {
+        pool.ParallelFor( 0, 8, [&sum]( unsigned int j ) {
+            sum += j;
+        } );
+    } );
+    EXPECT_EQ( 8 * 28, sum );
+}
+
+TEST_F( utThreadPool, exceptionIsPassedToCaller ) {
+    ThreadPool pool( 4 );
+    EXPECT_THROW( pool.ParallelFor( 0, 100, []( unsigned int i ) {
+        if ( 42 == i ) {
+            throw std::runtime_error( "fail" );
+        }
+    } ), std::runtime_error );
+
+    // the pool must still be usable afterwards
+    std::atomic<int> calls( 0 );
+    pool.ParallelFor( 0, 100, [&calls]( unsigned int ) { ++calls; } );
+    EXPECT_EQ( 100, calls );
+}
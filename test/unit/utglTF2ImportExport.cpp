@@ -375,6 +375,26 @@ TEST_F(utglTF2ImportExport, importglTF2FromMemory) {
     EXPECT_EQ( nullptr, Scene );*/
 }
 
+TEST_F(utglTF2ImportExport, importBinaryglTF2FromMemory) {
+    // the body buffer refers to the memory block instead of a copy
+    const std::vector<char> buff = ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb");
+    ASSERT_FALSE(buff.empty());
+
+    Assimp::Importer fileImporter, memImporter;
+    const aiScene *fromFile = fileImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb", aiProcess_ValidateDataStructure);
+    const aiScene *fromMem = memImporter.ReadFileFromMemory(&buff[0], buff.size(), aiProcess_ValidateDataStructure, "glb");
+    ASSERT_NE(nullptr, fromFile);
+    ASSERT_NE(nullptr, fromMem);
+
+    ASSERT_EQ(fromFile->mNumMeshes, fromMem->mNumMeshes);
+    for (unsigned int i = 0; i < fromFile->mNumMeshes; ++i) {
+        const aiMesh *a = fromFile->mMeshes[i], *b = fromMem->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+    }
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 TEST_F( utglTF2ImportExport, exportglTF2FromFileTest ) {
     EXPECT_TRUE( exporterTest() );